@@ -19,6 +19,153 @@
 #include <sys/shm.h>
 #endif
 
+/*----------------------------------------------------------------------------*/
+/* xint_io_buffer_size() - Return the size in bytes of the I/O buffer that
+ * each Worker Thread of this target needs.
+ */
+static int
+xint_io_buffer_size(target_data_t *tdp) {
+	int					page_size;		// Size of a page of memory
+	int					pages;			// Size of buffer in pages
+
+
+	// Calaculate the number of pages needed for a buffer
+	page_size = getpagesize();
+	pages = tdp->td_xfer_size / page_size;
+	if (tdp->td_xfer_size % page_size)
+		pages++; // Round up to page size
+	if ((tdp->td_target_options & TO_ENDTOEND)) {
+		// Add one page for the e2e header
+		pages++; 
+
+		// If its XNI, add another page for XNI, better would be for XNI to
+		// pack all of the header data (and do the hton, ntoh calls)
+		xdd_plan_t *planp = tdp->td_planp;
+		if (PLAN_ENABLE_XNI & planp->plan_options) {
+			pages++;
+		}
+	}
+	return(pages * page_size);
+} // End of xint_io_buffer_size()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_init_io_buffer_pool() - Allocate the huge page buffer pool for a target
+ * This is called by the Target Thread before the Worker Threads are started
+ * when the "-hugepages" option is used. One region big enough for the I/O
+ * buffers of all the Worker Threads is mapped from huge pages of size
+ * td_hugepage_size and each Worker Thread later takes its own slice of it
+ * in xdd_init_io_buffers(). Using a few large pages instead of many small
+ * ones cuts down on TLB misses and on the work needed to pin the pages for
+ * O_DIRECT I/O or to register them for XNI.
+ *
+ * If the system has no free huge pages of the requested size, an ordinary
+ * mapping aligned to the huge page size is used instead and the kernel is
+ * asked to back it with transparent huge pages.
+ *
+ * If "numa_node" is not negative then the pool is bound to that NUMA node.
+ *
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xdd_init_io_buffer_pool(target_data_t *tdp, int32_t numa_node) {
+#if (LINUX)
+	unsigned char	*poolp;			// Start of the pool
+	unsigned char	*mapp;			// Start of the fallback mapping
+	size_t			slice_size;		// Size of the buffer for one Worker Thread
+	size_t			pool_size;		// Size of the pool rounded up to huge pages
+	size_t			huge_size;		// Size of a huge page
+	int				flags;			// mmap() flags
+
+
+	tdp->td_buffer_poolp = NULL;
+	if (tdp->td_hugepage_size == 0)
+		return(0);
+
+	huge_size = tdp->td_hugepage_size;
+	slice_size = xint_io_buffer_size(tdp);
+	pool_size = slice_size * tdp->td_queue_depth;
+	pool_size = ((pool_size + huge_size - 1) / huge_size) * huge_size;
+
+	poolp = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+	flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+	// The page size is encoded as log2(size) in the flags
+	flags |= (__builtin_ctzll(huge_size) << MAP_HUGE_SHIFT);
+#endif
+	poolp = mmap(NULL, pool_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+#endif
+	if (poolp != MAP_FAILED) {
+		tdp->td_buffer_pool_hugetlb = 1;
+		tdp->td_buffer_pool_mapp = poolp;
+		tdp->td_buffer_pool_map_size = pool_size;
+	} else {
+		if (xgp->global_options & GO_VERBOSE)
+			fprintf(xgp->output,"%s: INFORMATION: Target %d: No free %lld byte huge pages - using transparent huge pages for the I/O buffers\n",
+				xgp->progname,
+				tdp->td_target_number,
+				(long long int)huge_size);
+		// Map an extra huge page so the pool can start on a huge page boundary
+		mapp = mmap(NULL, pool_size + huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapp == MAP_FAILED) {
+			fprintf(xgp->errout,"%s: xdd_init_io_buffer_pool: Target %d: ERROR: Cannot map %lld bytes for the I/O buffer pool\n",
+				xgp->progname,
+				tdp->td_target_number,
+				(long long int)pool_size);
+			perror("Reason");
+			return(-1);
+		}
+		poolp = (unsigned char *)((((uintptr_t)mapp) + huge_size - 1) & ~((uintptr_t)huge_size - 1));
+#if defined(MADV_HUGEPAGE)
+		madvise(poolp, pool_size, MADV_HUGEPAGE);
+#endif
+		tdp->td_buffer_pool_hugetlb = 0;
+		tdp->td_buffer_pool_mapp = mapp;
+		tdp->td_buffer_pool_map_size = pool_size + huge_size;
+	}
+
+	if (numa_node >= 0) {
+		if (xint_numa_bind_buffer(poolp, pool_size, numa_node))
+			fprintf(xgp->errout,"%s: xdd_init_io_buffer_pool: Target %d: WARNING: Cannot bind I/O buffer pool to NUMA node %d\n",
+				xgp->progname,
+				tdp->td_target_number,
+				numa_node);
+	}
+
+	tdp->td_buffer_poolp = poolp;
+	tdp->td_buffer_pool_size = pool_size;
+	tdp->td_buffer_pool_slice = slice_size;
+	return(0);
+#else
+	fprintf(xgp->errout,"%s: Huge page I/O buffers not supported on this OS - using normal buffers\n",
+		xgp->progname);
+	tdp->td_hugepage_size = 0;
+	tdp->td_buffer_poolp = NULL;
+	return(0);
+#endif
+} /* end of xdd_init_io_buffer_pool() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_buffer_pool_cleanup() - Unmap the huge page buffer pool of a target
+ * once its Worker Threads are done with their slices of it.
+ */
+void
+xdd_io_buffer_pool_cleanup(target_data_t *tdp) {
+#if (LINUX)
+	if (tdp->td_buffer_pool_mapp == NULL)
+		return;
+	if (munmap(tdp->td_buffer_pool_mapp, tdp->td_buffer_pool_map_size)) {
+		fprintf(xgp->errout,"%s: xdd_io_buffer_pool_cleanup: Target %d: ERROR: Cannot unmap the I/O buffer pool\n",
+			xgp->progname,
+			tdp->td_target_number);
+		perror("Reason");
+	}
+	tdp->td_buffer_pool_mapp = NULL;
+	tdp->td_buffer_pool_map_size = 0;
+	tdp->td_buffer_poolp = NULL;
+#endif
+} /* end of xdd_io_buffer_pool_cleanup() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_init_io_buffers() - set up the I/O buffers
  * This routine will allocate the memory used as the I/O buffer for a Worker
@@ -32,6 +179,12 @@
  * a normal malloc/valloc memory chunk. This is done using the "-sharedmemory"
  * command line option.
  *
+ * With the "-hugepages" option the buffer is a slice of the huge page pool
+ * that xdd_init_io_buffer_pool() set up for the target instead.
+ *
+ * When the Worker Thread has a NUMA node (the "-numa" option) the buffer
+ * is bound to the memory of that node before it is first touched.
+ *
  * The size of the buffer depends on whether it is being used for network
  * I/O as in an End-to-end operation. For End-to-End operations, the size
  * of the buffer is 1 page larger than for non-End-to-End operations.
@@ -64,8 +217,6 @@ xdd_init_io_buffers(worker_data_t *wdp) {
 	void 				*shmat_status;	// Status of shmat()
 	int 				buf_shmid;		// Shared Memory ID
 	int					buffer_size;	// Size of buffer in bytes
-	int					page_size;		// Size of a page of memory
-	int					pages;			// Size of buffer in pages
 #ifdef WIN32
 	LPVOID lpMsgBuf; /* Used for the error messages */
 #endif
@@ -74,27 +225,20 @@ xdd_init_io_buffers(worker_data_t *wdp) {
 	wdp->wd_bufp = NULL;
 	wdp->wd_buf_size = 0;
 
-	// Calaculate the number of pages needed for a buffer
-	page_size = getpagesize();
-	pages = tdp->td_xfer_size / page_size;
-	if (tdp->td_xfer_size % page_size)
-		pages++; // Round up to page size
-	if ((tdp->td_target_options & TO_ENDTOEND)) {
-		// Add one page for the e2e header
-		pages++; 
+	// This is the actual size of the I/O buffer
+	buffer_size = xint_io_buffer_size(tdp);
 
-		// If its XNI, add another page for XNI, better would be for XNI to
-		// pack all of the header data (and do the hton, ntoh calls)
-		xdd_plan_t *planp = tdp->td_planp;
-		if (PLAN_ENABLE_XNI & planp->plan_options) {
-			pages++;
-		}
+	/* Take this Worker Thread's slice of the huge page pool if there is one.
+	 * The pool has already been bound to the NUMA node of the target.
+	 */
+	if (tdp->td_buffer_poolp) {
+		bufp = tdp->td_buffer_poolp + ((size_t)wdp->wd_worker_number * tdp->td_buffer_pool_slice);
+		xdd_lock_memory(bufp, buffer_size, "RW BUFFER");
+		wdp->wd_bufp = bufp;
+		wdp->wd_buf_size = buffer_size;
+		return(bufp);
 	}
 
-	
-	// This is the actual size of the I/O buffer
-	buffer_size = pages * page_size;
-
 	/* Check to see if we want to use a shared memory segment and allocate it using shmget() and shmat().
 	 * NOTE: This is not supported by all operating systems. 
 	 */
@@ -168,6 +312,16 @@ xdd_init_io_buffers(worker_data_t *wdp) {
 	}
 	/* Memory allocation must have succeeded */
 
+	/* Move the buffer to the NUMA node of this Worker Thread if there is one */
+	if (wdp->wd_numa_node >= 0) {
+		if (xint_numa_bind_buffer(bufp, buffer_size, wdp->wd_numa_node))
+			fprintf(xgp->errout,"%s: xdd_init_io_buffers: Target %d WorkerThread %d: WARNING: Cannot bind I/O buffer to NUMA node %d\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				wdp->wd_numa_node);
+	}
+
 	/* Lock all pages in memory */
 	xdd_lock_memory(bufp, buffer_size, "RW BUFFER");
 
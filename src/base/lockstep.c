@@ -146,7 +146,7 @@ if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_befor
 			// Release the WORKER_Thread to let it start working on this task.
 			// This effectively causes the I/O operation to be issued.
 if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_before_io_op:p:%p:::wdp:%p:RELEASING_WORKER_THREAD bytes_remaining=%lld\n",(long long int)pclk_now()-xgp->debug_base_time,tdp,wdp,(long long int)tdp->td_current_bytes_remaining);
-			xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+			xdd_worker_thread_release(tdp,wdp);
 if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_before_io_op:p:%p:::wdp:%p:WORKER_THREAD_RELEASED bytes_remaining=%lld\n",(long long int)pclk_now()-xgp->debug_base_time,tdp,wdp,(long long int)tdp->td_current_bytes_remaining);
 			ops_remaining--;
 		}
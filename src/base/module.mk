@@ -14,17 +14,21 @@ BASE_SRC := $(DIR)/heartbeat.c \
 	$(DIR)/target_open.c \
 	$(DIR)/target_pass.c \
 	$(DIR)/target_pass_e2e_specific.c \
+	$(DIR)/target_pass_io_uring.c \
 	$(DIR)/target_pass_wt_locator.c \
 	$(DIR)/target_thread.c \
 	$(DIR)/target_ttd_after_pass.c \
 	$(DIR)/target_ttd_before_io_op.c \
 	$(DIR)/target_ttd_before_pass.c \
 	$(DIR)/verify.c \
+	$(DIR)/worker_pool.c \
 	$(DIR)/worker_thread.c \
 	$(DIR)/worker_thread_cleanup.c \
 	$(DIR)/worker_thread_init.c \
 	$(DIR)/worker_thread_io.c \
+	$(DIR)/worker_thread_io_copy.c \
 	$(DIR)/worker_thread_io_for_os.c \
+	$(DIR)/worker_thread_io_mmap.c \
 	$(DIR)/worker_thread_ttd_after_io_op.c \
 	$(DIR)/worker_thread_ttd_before_io_op.c \
 	$(DIR)/xint_plan.c
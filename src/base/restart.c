@@ -195,10 +195,10 @@ xdd_restart_monitor(void *data) {
 			perror("Reason");
 			return(0);
 		}
-		if (current_tdp->td_target_options & TO_E2E_DESTINATION) {
+		if (current_tdp->td_target_options & (TO_E2E_DESTINATION|TO_IO_COPY)) {
 			xdd_restart_create_restart_file(rp);
 		} else {
-			fprintf(xgp->output,"%s: xdd_restart_monitor: INFO: No restart file being created for target %d [ %s ] because this is not the destination side of an E2E operation.\n", 
+			fprintf(xgp->output,"%s: xdd_restart_monitor: INFO: No restart file being created for target %d [ %s ] because this is not the destination side of an E2E operation or a local copy.\n", 
 				xgp->progname,
 				current_tdp->td_target_number,
 				current_tdp->td_target_full_pathname);
@@ -306,7 +306,7 @@ xdd_restart_monitor(void *data) {
 				} // End of FOR loop that scans the TOT for the restart offset to use
 	            */
 				// ...and write it to the restart file and sync sync sync
-				if (current_tdp->td_target_options & TO_E2E_DESTINATION) // Restart files are only written on the destination side
+				if (current_tdp->td_target_options & (TO_E2E_DESTINATION|TO_IO_COPY)) // Restart files are only written on the destination side
 					xdd_restart_write_restart_file(rp);
 
 			}
@@ -30,11 +30,23 @@ xdd_target_thread_cleanup(target_data_t *tdp) {
 		wdp->wd_task.task_request = TASK_REQ_STOP;
 		tdp->td_occupant.occupant_type |= XDD_OCCUPANT_TYPE_CLEANUP;
 		// Release this Worker Thread
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		xdd_worker_thread_release(tdp,wdp);
 
 		// get the next Worker in this chain
 		wdp = wdp->wd_next_wdp;
 	}
+	// Tear down the io_uring if there is one
+	xint_io_uring_cleanup(tdp);
+	// Unmap the target if it was mapped
+	xint_mmap_cleanup(tdp);
+	// Close the source file of a local copy
+	xint_copy_cleanup(tdp);
+	// Free the list of foreground streams
+	if (tdp->td_stream_foregroundpp) {
+		free(tdp->td_stream_foregroundpp);
+		tdp->td_stream_foregroundpp = NULL;
+	}
+
 	if (tdp->td_target_options & TO_DELETEFILE) {
 #ifdef WIN32
 		DeleteFile(tdp->td_target_full_pathname);
@@ -62,6 +74,9 @@ xdd_target_thread_cleanup(target_data_t *tdp) {
                 	perror("reason");
 		}
 	}
+
+	// Unmap the huge page buffer pool now that nothing uses the I/O buffers
+	xdd_io_buffer_pool_cleanup(tdp);
     
 } // End of xdd_target_thread_cleanup()
 
@@ -60,26 +60,20 @@ xint_target_init(target_data_t *tdp) {
 	/* Perform pretruncation if needed */
 	xint_target_pretruncate(tdp);
 
-	// The Seek List
-	// There is one Seek List per target.
-	// This list contains all the locations in a implied order that need to be accessed
-	// during a single pass. 
-	// It is this list that is used by xdd_issue() to assign I/O tasks to the WorkerThreads.
+	// The Seek Locations
+	// There is one seek generator per target.
+	// It produces all the locations in a implied order that need to be accessed
+	// during a single pass, one operation at a time as they are issued.
+	// A full Seek List is only built when it is loaded from or saved to a file.
 	//
 	tdp->td_seekhdr.seek_total_ops = tdp->td_target_ops;
-	tdp->td_seekhdr.seeks = (seek_t *)calloc((int32_t)tdp->td_seekhdr.seek_total_ops,sizeof(seek_t));
-	if (tdp->td_seekhdr.seeks == 0) {
-		fprintf(xgp->errout,"%s: xdd_target_thread_init: ERROR: Cannot allocate memory for access list for Target %d name '%s' - terminating\n",
-			xgp->progname,
-			tdp->td_target_number,
-			tdp->td_target_full_pathname);
+	status = xdd_init_seek_list(tdp);
+	if (status) {
 		fflush(xgp->errout);
 		xgp->abort = 1;
 		return(-1);
 	}
 
-	xdd_init_seek_list(tdp);
-
 	// Set up the timestamp table - Note: This must be done *after* the seek list is initialized
 	xdd_ts_setup(tdp); 
 
@@ -131,11 +125,44 @@ xint_target_init(target_data_t *tdp) {
 			return(-1);
 	}
 
+	// Build the block library for the reducible data pattern before the WorkerThreads write anything
+	status = xdd_datapattern_library_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Set up the ring of available WorkerThreads before the WorkerThreads put themselves on it
+	status = xint_worker_ring_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Run the tasks of this target in the shared Worker Thread pool if there is one
+	xint_worker_pool_attach(tdp);
+
 	// Start the WorkerThreads
 	status = xint_target_init_start_worker_threads(tdp);
 	if (status) 
 		return(-1);
 
+	// Set up the io_uring if the Target Thread is going to issue the I/O
+	status = xint_io_uring_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Map the target if the Worker Threads are going to copy to and from a mapping
+	status = xint_mmap_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Open the source file if the target is the destination of a local copy
+	status = xint_copy_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Start streaming timestamps if requested - this needs the WorkerThreads
+	status = xdd_ts_stream_start(tdp);
+	if (status) 
+		return(-1);
+
 	// If this is XNI, perform the connection here
 	xdd_plan_t *planp = tdp->td_planp;
 	if (PLAN_ENABLE_XNI & planp->plan_options) {
@@ -247,12 +274,22 @@ xint_target_init_start_worker_threads(target_data_t *tdp) {
 	int32_t			status;					// Status of subtroutine calls
 	int32_t			e2e_addr_index;			// index into the e2e address table
 	int32_t			e2e_addr_port;			// Port number in the e2e address table
+	int32_t			target_numa_node;		// NUMA node for the target or -1 for none
+	int32_t			numa_addr_index;		// e2e address table index that numa_node was found for
 
 	
 	// Now let's start up all the WorkerThreads for this target
 	wdp = tdp->td_next_wdp; // This is the first WorkerThread
 	e2e_addr_index = 0;
 	e2e_addr_port = 0;
+	target_numa_node = xint_numa_target_node(tdp);
+	numa_addr_index = 0;
+
+	// Set up the huge page buffer pool that the WorkerThreads take their I/O buffers from
+	status = xdd_init_io_buffer_pool(tdp, target_numa_node);
+	if (status) 
+		return(-1);
+
 	for (q = 0; q < tdp->td_queue_depth; q++ ) {
 	    pthread_attr_t worker_thread_attr;
 
@@ -261,6 +298,17 @@ xint_target_init_start_worker_threads(target_data_t *tdp) {
 	    
 	    // Start a WorkerThread and wait for it to initialize
 	    wdp->wd_worker_number = q;
+	    wdp->wd_numa_node = target_numa_node;
+
+	    // With the shared Worker Thread pool there is no thread to start - just set up the WorkerThread Data
+	    if (tdp->td_worker_poolp) {
+		pthread_attr_destroy(&worker_thread_attr);
+		status = xint_worker_pool_add_worker(tdp, wdp);
+		if (status)
+		    return(-1);
+		wdp = wdp->wd_next_wdp;
+		continue;
+	    }
 	    if (tdp->td_target_options & TO_ENDTOEND) {
 
 		// Find an e2e entry that has a valid port count
@@ -278,6 +326,14 @@ xint_target_init_start_worker_threads(target_data_t *tdp) {
 						     sizeof(tdp->td_e2ep->e2e_address_table[e2e_addr_index].cpu_set),
 						     &tdp->td_e2ep->e2e_address_table[e2e_addr_index].cpu_set);
 #endif
+		// With "-numa auto" each address uses the node of its own network interface
+		if ((target_numa_node >= 0) && (tdp->td_numa_node == XINT_NUMA_AUTO) && (e2e_addr_index != numa_addr_index)) {
+		    numa_addr_index = e2e_addr_index;
+		    wdp->wd_numa_node = xint_numa_host_node(tdp->td_e2ep->e2e_address_table[e2e_addr_index].hostname);
+		    if (wdp->wd_numa_node < 0)
+			wdp->wd_numa_node = target_numa_node;
+		    target_numa_node = wdp->wd_numa_node;
+		}
 		// Roll over to the begining of the list if that is required
 		e2e_addr_port++;
 		if (e2e_addr_port == tdp->td_e2ep->e2e_address_table[e2e_addr_index].port_count) {
@@ -290,6 +346,17 @@ xint_target_init_start_worker_threads(target_data_t *tdp) {
 			    wdp->wd_e2ep->e2e_dest_port, wdp->wd_worker_number);
 	    }
 
+	    // Place the WorkerThread on its NUMA node - this replaces any e2e address table CPU set
+	    if (wdp->wd_numa_node >= 0) {
+		status = xint_numa_worker_affinity(&worker_thread_attr, wdp->wd_numa_node, q);
+		if (status) {
+		    fprintf(xgp->errout,"%s: xdd_target_init_start_worker_threads: Target %d WorkerThread %d: WARNING: Cannot place WorkerThread on NUMA node %d\n",
+			    xgp->progname,
+			    tdp->td_target_number,
+			    q,
+			    wdp->wd_numa_node);
+		}
+	    }
 	    
 	    status = pthread_create(&wdp->wd_thread, &worker_thread_attr, xdd_worker_thread, wdp);
 	    if (status) {
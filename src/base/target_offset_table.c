@@ -75,15 +75,15 @@ int tot_init(tot_t** table, size_t queue_depth, size_t num_reqs)
 	}
     
     // Initialize all the table entries
-	// Note: The TOT wait structures reside in the Worker Data Structure
-	// and are initialized as part of worker_thread_init().
+	// No op has been released through any entry yet so all the sequence
+	// numbers start out at zero. 
 	tp = *table;
     for (i = 0; i < tp->tot_entries; i++) {
-        tp->tot_entry[i].tot_waitp = 0;
+        tp->tot_entry[i].tot_sequence = 0;
+        tp->tot_entry[i].tot_waiters = 0;
         tp->tot_entry[i].tot_op_number = -1;
         tp->tot_entry[i].tot_byte_offset = -1;
         tp->tot_entry[i].tot_io_size = 0;
-        tp->tot_entry[i].tot_status = TOT_ENTRY_AVAILABLE;
     }
 
     // Perform cleanup if inititalization did not complete successfully
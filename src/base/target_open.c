@@ -77,6 +77,9 @@ xdd_target_reopen(target_data_t *tdp) {
 	int32_t		status;		// Status of the open call
 
 
+	// Unmap the existing target before it is closed - it gets mapped again after it is opened
+	xint_mmap_unmap(tdp);
+
 	// Close the existing target
 #if (WIN32)
 	CloseHandle(tdp->td_file_desc);
@@ -100,7 +103,10 @@ xdd_target_reopen(target_data_t *tdp) {
 			tdp->td_target_full_pathname);
 		fflush(xgp->errout);
 		xgp->abort = 1;
+		return;
 	}
+	if (xint_mmap_map(tdp)) 
+		xgp->abort = 1;
 	return;
 } // End of xdd_target_reopen()
 
@@ -296,7 +302,8 @@ if (xgp->global_options & GO_DEBUG_OPEN) fprintf(stderr,"DEBUG_OPEN: %lld: xdd_t
 			xdd_sg_set_reserved_size(tdp,tdp->td_file_desc);
 			xdd_sg_get_version(tdp,tdp->td_file_desc);
 		} else {
-			tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|O_WRONLY, 0666); /* write only */
+			// A file cannot be mapped for writing unless it is open for reading too
+			tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|((tdp->td_target_options & TO_IO_MMAP)?O_RDWR:O_WRONLY), 0666); /* write only */
 if (xgp->global_options & GO_DEBUG_OPEN) fprintf(stderr,"DEBUG_OPEN: %lld: xdd_target_open_for_os: Target: %d: Worker: %d: WRITE ONLY: file_desc: %d\n ", (long long int)pclk_now(),tdp->td_target_number,tdp->td_queue_depth,tdp->td_file_desc);
 		}
 	} else if (tdp->td_rwratio == 1.0) { /* read only */
@@ -65,10 +65,14 @@ xdd_target_pass(xdd_plan_t* planp, target_data_t *tdp) {
 		if (tdp->td_target_options & TO_E2E_SOURCE)
 		    xdd_targetpass_e2e_loop_src(planp, tdp);
 		else xdd_targetpass_e2e_loop_dst(planp, tdp);
+	} else if (tdp->td_target_options & TO_IO_URING) { // The Target Thread issues all the I/O
+	    xdd_target_pass_io_uring_loop(planp, tdp);
 	} else { // Normal operations (other than E2E)
 	    xdd_target_pass_loop(planp, tdp);
 	}
 	tdp->td_current_state |= TARGET_CURRENT_STATE_PASS_COMPLETE;
+	// Background streams of other targets read this while they run
+	__atomic_store_n(&tdp->td_stream_pass_complete, tdp->td_counters.tc_pass_number, __ATOMIC_RELEASE);
 /////////////////////////////// PSEUDO-Loop Ends  Here /////////////////////////
 	// If this is an E2E operation and we had gotten canceled - just return
 	if ((tdp->td_target_options & TO_ENDTOEND) && (xgp->canceled))
@@ -135,9 +139,7 @@ xdd_target_pass_loop(xdd_plan_t* planp, target_data_t *tdp) {
 		status = xdd_target_ttd_before_io_op(tdp, wdp);
 		if (status != XDD_RC_GOOD) {
 			// Mark this worker thread NOT BUSY and break out of this loop
-			pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-			wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
-			pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+			xdd_worker_thread_return(tdp,wdp);
 			break;
 		}
 
@@ -146,7 +148,7 @@ xdd_target_pass_loop(xdd_plan_t* planp, target_data_t *tdp) {
 
 		// Release the Worker Thread to let it start working on this task.
 		// This effectively causes the I/O operation to be issued.
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		xdd_worker_thread_release(tdp,wdp);
 
 	} // End of WHILE loop that transfers data for a single pass
 //
@@ -162,7 +164,11 @@ xdd_target_pass_loop(xdd_plan_t* planp, target_data_t *tdp) {
 	// Wait for all Worker Threads to complete their most recent task
 	// The easiest way to do this is to get the Worker Thread pointer for each
 	// Worker Thread specifically and then reset it's "busy" bit to 0.
-	for (q = 0; q < tdp->td_queue_depth; q++) {
+	// When the Worker Threads are on the lock-free ring they are all collected
+	// from the ring instead.
+	if (tdp->td_worker_ringp) 
+		xdd_worker_ring_collect_all(tdp);
+	else for (q = 0; q < tdp->td_queue_depth; q++) {
 		wdp = xdd_get_specific_worker_thread(tdp,q);
 		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
 		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
@@ -182,6 +188,7 @@ void
 xdd_target_pass_task_setup(worker_data_t *wdp) {
 	target_data_t	*tdp;
 	xdd_ts_tte_t	*ttep;
+	seek_t			*seekp;	// The seek entry for this operation
 
 	tdp = wdp->wd_tdp;
 	// Assign an IO task to this worker thread
@@ -191,10 +198,11 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 	wdp->wd_task.task_file_desc = tdp->td_file_desc;
 
 	// Set the Operation Type
-	if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) { // Write Operation
+	seekp = xdd_get_seek_entry(tdp, tdp->td_counters.tc_current_op_number);
+	if (seekp->operation == SO_OP_WRITE) { // Write Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_WRITE;
 		wdp->wd_task.task_op_string = "WRITE";
-	} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) { // READ Operation
+	} else if (seekp->operation == SO_OP_READ) { // READ Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_READ;
 		wdp->wd_task.task_op_string = "READ";
 	} else { 
@@ -203,9 +211,11 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 	}
 	 
 	// Figure out the transfer size to use for this I/O
-	if (tdp->td_current_bytes_remaining < (uint64_t)tdp->td_xfer_size)
-		wdp->wd_task.task_xfer_size = tdp->td_current_bytes_remaining;
+	if ((tdp->td_rsmp) || (tdp->td_replayp))
+		wdp->wd_task.task_xfer_size = seekp->reqsize * tdp->td_block_size;
 	else wdp->wd_task.task_xfer_size = tdp->td_xfer_size;
+	if (tdp->td_current_bytes_remaining < (uint64_t)wdp->wd_task.task_xfer_size)
+		wdp->wd_task.task_xfer_size = tdp->td_current_bytes_remaining;
 
 	// Set the location to seek to 
 	wdp->wd_task.task_byte_offset = tdp->td_counters.tc_current_byte_offset;
@@ -213,20 +223,14 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 	// Remember the operation number for this target
 	wdp->wd_task.task_op_number = tdp->td_counters.tc_current_op_number;
 
+	// Remember when this operation was due if it is an open-loop arrival so that its latency includes the backlog
+	if ((tdp->td_arrivalp) && (tdp->td_arrivalp->arrival_rate > 0.0))
+		wdp->wd_task.task_time_to_issue = tdp->td_arrivalp->arrival_intended;
+	else wdp->wd_task.task_time_to_issue = 0;
+
    	// If time stamping is on then assign a time stamp entry to this Worker Thread
    	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-		tdp->td_ts_table.ts_current_entry++;
-		if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-			if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-				tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-		} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-			tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-		}
-		ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
-		ttep->tte_worker_thread_number = wdp->wd_worker_number;
-		ttep->tte_thread_id = wdp->wd_thread_id;
+		ttep = xdd_ts_assign_entry(tdp, wdp);
 		ttep->tte_op_type = wdp->wd_task.task_op_type;
 		ttep->tte_op_number = wdp->wd_task.task_op_number;
 		ttep->tte_byte_offset = wdp->wd_task.task_byte_offset;
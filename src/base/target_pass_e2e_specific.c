@@ -80,18 +80,7 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 
    		// If time stamping is on then assign a time stamp entry to this Worker Thread
    		if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-			wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-			ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-			tdp->td_ts_table.ts_current_entry++;
-			if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-				if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-					tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-			} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-				tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-			}
-			ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
-			ttep->tte_worker_thread_number = wdp->wd_worker_number;
-			ttep->tte_thread_id     = wdp->wd_thread_id;
+			ttep = xdd_ts_assign_entry(tdp, wdp);
 			ttep->tte_op_type = TASK_OP_TYPE_WRITE;
 			ttep->tte_op_number = -1; 		// to be filled in after data received
 			ttep->tte_byte_offset = -1; 	// to be filled in after data received
@@ -100,7 +89,7 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 		}
 
 		// Release the Worker Thread to let it start working on this task
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		xdd_worker_thread_release(tdp,wdp);
 		// At this point the Worker Thread is running. The first thing it will do is perform all the 
 		// Things To Do (ttd) before the I/O operation. This includes receiving data from the Source
 		// which will block until it gets the data. Once the data is received, the Worker Thread will
@@ -176,7 +165,7 @@ xdd_targetpass_e2e_loop_src(xdd_plan_t* planp, target_data_t *tdp) {
 		xdd_targetpass_e2e_task_setup_src(wdp);
 
 		// Release the Worker Thread to let it start working on this task
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		xdd_worker_thread_release(tdp,wdp);
 
 	} // End of WHILE loop that transfers data for a single pass
 
@@ -215,6 +204,7 @@ void
 xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 	target_data_t	*tdp;
 	xdd_ts_tte_t	*ttep;
+	seek_t			*seekp;	// The seek entry for this operation
 
 	tdp = wdp->wd_tdp;
 	// Assign an IO task to this worker thread
@@ -224,10 +214,11 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 	wdp->wd_task.task_file_desc = tdp->td_file_desc;
 
 	// Set the Operation Type
-	if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) { // Write Operation
+	seekp = xdd_get_seek_entry(tdp, tdp->td_counters.tc_current_op_number);
+	if (seekp->operation == SO_OP_WRITE) { // Write Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_WRITE;
 		wdp->wd_task.task_op_string = "WRITE";
-	} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) { // READ Operation
+	} else if (seekp->operation == SO_OP_READ) { // READ Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_READ;
 		wdp->wd_task.task_op_string = "READ";
 	} else { 
@@ -248,6 +239,11 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 	// Remember the operation number for this target
 	wdp->wd_task.task_op_number = tdp->td_counters.tc_current_op_number;
 
+	// Remember when this operation was due if it is an open-loop arrival so that its latency includes the backlog
+	if ((tdp->td_arrivalp) && (tdp->td_arrivalp->arrival_rate > 0.0))
+		wdp->wd_task.task_time_to_issue = tdp->td_arrivalp->arrival_intended;
+	else wdp->wd_task.task_time_to_issue = 0;
+
 	wdp->wd_e2ep->e2e_msg_sequence_number = tdp->td_e2ep->e2e_msg_sequence_number;
 	tdp->td_e2ep->e2e_msg_sequence_number++;
 
@@ -256,18 +252,7 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 
    	// If time stamping is on then assign a time stamp entry to this Worker Thread
    	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-		ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-		tdp->td_ts_table.ts_current_entry++;
-		if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-			if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-				tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-		} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-			tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-		}
-		ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
-		ttep->tte_worker_thread_number = wdp->wd_worker_number;
-		ttep->tte_thread_id = wdp->wd_thread_id;
+		ttep = xdd_ts_assign_entry(tdp, wdp);
 		ttep->tte_op_type = wdp->wd_task.task_op_type;
 		ttep->tte_op_number = wdp->wd_task.task_op_number;
 		ttep->tte_byte_offset = wdp->wd_task.task_byte_offset;
@@ -311,25 +296,14 @@ xdd_targetpass_e2e_eof_src(target_data_t *tdp) {
 
    		// If time stamping is on then assign a time stamp entry to this Worker Thread
    		if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-			wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-			ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-			tdp->td_ts_table.ts_current_entry++;
-			if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-				if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-					tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-			} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-				tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-			}
-			ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
-			ttep->tte_worker_thread_number = wdp->wd_worker_number;
-			ttep->tte_thread_id = wdp->wd_thread_id;
+			ttep = xdd_ts_assign_entry(tdp, wdp);
 			ttep->tte_op_type = TASK_OP_TYPE_EOF;
 			ttep->tte_op_number = -1*wdp->wd_worker_number;
 			ttep->tte_byte_offset = -1;
 		}
 	
 		// Release the Worker Thread to let it start working on this task
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		xdd_worker_thread_release(tdp,wdp);
 	
 	}
 } // End of xdd_targetpass_eof_source_side()
@@ -0,0 +1,488 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that implement the io_uring I/O engine.
+ * When the "-ioengine uring" option is specified for a target, the Target Thread
+ * keeps up to td_queue_depth I/O operations in flight through a single io_uring
+ * instead of handing each operation to a Worker Thread that blocks in pread()/pwrite().
+ * The Worker Data Structs are still used as I/O "slots" because they own the
+ * I/O buffers, the task, the time stamp entry, and the per-worker counters.
+ * This allows the normal before/after I/O processing and the results
+ * reporting to be used without modification.
+ *
+ * The ring is driven with the raw io_uring_setup()/io_uring_enter() system calls
+ * so that liburing is not required.
+ */
+#include "xint.h"
+
+#if (LINUX) && defined(HAVE_LINUX_IO_URING_H)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define XINT_HAVE_IO_URING 1
+#endif
+#endif
+
+#ifdef XINT_HAVE_IO_URING
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_setup() - Thin wrapper around the io_uring_setup system call
+ */
+static int
+xint_io_uring_setup(uint32_t entries, struct io_uring_params *paramsp) {
+	return((int)syscall(__NR_io_uring_setup, entries, paramsp));
+} // End of xint_io_uring_setup()
+
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_enter() - Thin wrapper around the io_uring_enter system call
+ */
+static int
+xint_io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+	return((int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0));
+} // End of xint_io_uring_enter()
+#endif // XINT_HAVE_IO_URING
+
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_init() - Create the io_uring for this target and put all
+ * the Worker Data Structs on the free slot stack.
+ * This must be called after the Worker Threads have initialized because the
+ * I/O buffers are allocated by the Worker Threads.
+ *
+ * This subroutine is called within the context of a Target Thread.
+ *
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_io_uring_init(target_data_t *tdp) {
+#ifdef XINT_HAVE_IO_URING
+	xint_io_uring_t			*urp;		// Pointer to the io_uring structure for this target
+	struct io_uring_params	params;		// Parameters passed to/returned by io_uring_setup()
+	worker_data_t			*wdp;		// Pointer to a Worker Data Struct
+	unsigned char			*sq_ptr;	// Base of the SQ ring mapping
+	unsigned char			*cq_ptr;	// Base of the CQ ring mapping
+
+
+	if (!(tdp->td_target_options & TO_IO_URING))
+		return(0);
+
+	// The io_uring engine issues plain positioned reads and writes from the Target Thread.
+	// Anything that depends on a Worker Thread doing the I/O itself falls back to the normal path.
+	if (tdp->td_target_options & (TO_ENDTOEND | TO_SGIO | TO_READAFTERWRITE |
+		TO_ORDERING_STORAGE_SERIAL | TO_ORDERING_STORAGE_LOOSE) || (tdp->td_lsp)) {
+		fprintf(xgp->errout,"%s: xint_io_uring_init: Target %d: WARNING: The io_uring engine cannot be used with e2e, sgio, raw, lockstep, or storage ordering - using the sync engine\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_target_options &= ~TO_IO_URING;
+		return(0);
+	}
+
+	urp = malloc(sizeof(xint_io_uring_t));
+	if (urp == NULL) {
+		fprintf(xgp->errout,"%s: xint_io_uring_init: Target %d: ERROR: Cannot allocate %d bytes of memory for the io_uring structure\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(int)sizeof(xint_io_uring_t));
+		return(-1);
+	}
+	memset(urp, 0, sizeof(xint_io_uring_t));
+	urp->ring_fd = -1;
+
+	memset(&params, 0, sizeof(params));
+	urp->ring_fd = xint_io_uring_setup(tdp->td_queue_depth, &params);
+	if (urp->ring_fd < 0) {
+		fprintf(xgp->errout,"%s: xint_io_uring_init: Target %d: WARNING: io_uring_setup for %d entries failed - using the sync engine\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_queue_depth);
+		perror("Reason");
+		free(urp);
+		tdp->td_target_options &= ~TO_IO_URING;
+		return(0);
+	}
+	urp->ring_entries = params.sq_entries;
+
+	// Map the submission and completion rings. Newer kernels put both rings in a single mapping.
+	urp->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	urp->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		if (urp->cq_ring_size > urp->sq_ring_size)
+			urp->sq_ring_size = urp->cq_ring_size;
+		urp->cq_ring_size = urp->sq_ring_size;
+	}
+	sq_ptr = mmap(0, urp->sq_ring_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, urp->ring_fd, IORING_OFF_SQ_RING);
+	if (sq_ptr == MAP_FAILED)
+		goto map_failed;
+	urp->sq_ring_ptr = sq_ptr;
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		cq_ptr = sq_ptr;
+	} else {
+		cq_ptr = mmap(0, urp->cq_ring_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, urp->ring_fd, IORING_OFF_CQ_RING);
+		if (cq_ptr == MAP_FAILED)
+			goto map_failed;
+	}
+	urp->cq_ring_ptr = cq_ptr;
+	urp->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	urp->sqes = mmap(0, urp->sqes_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, urp->ring_fd, IORING_OFF_SQES);
+	if (urp->sqes == MAP_FAILED) {
+		urp->sqes = NULL;
+		goto map_failed;
+	}
+
+	urp->sq_head = (uint32_t *)(sq_ptr + params.sq_off.head);
+	urp->sq_tail = (uint32_t *)(sq_ptr + params.sq_off.tail);
+	urp->sq_ring_mask = (uint32_t *)(sq_ptr + params.sq_off.ring_mask);
+	urp->sq_array = (uint32_t *)(sq_ptr + params.sq_off.array);
+	urp->cq_head = (uint32_t *)(cq_ptr + params.cq_off.head);
+	urp->cq_tail = (uint32_t *)(cq_ptr + params.cq_off.tail);
+	urp->cq_ring_mask = (uint32_t *)(cq_ptr + params.cq_off.ring_mask);
+	urp->cqes = cq_ptr + params.cq_off.cqes;
+
+	// Every Worker Data Struct is an I/O slot
+	urp->free_wdp = malloc(tdp->td_queue_depth * sizeof(worker_data_t *));
+	if (urp->free_wdp == NULL) {
+		fprintf(xgp->errout,"%s: xint_io_uring_init: Target %d: ERROR: Cannot allocate memory for the io_uring slot list\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_uringp = urp;
+		xint_io_uring_cleanup(tdp);
+		return(-1);
+	}
+	urp->free_count = 0;
+	wdp = tdp->td_next_wdp;
+	while (wdp) {
+		urp->free_wdp[urp->free_count++] = wdp;
+		wdp = wdp->wd_next_wdp;
+	}
+
+	tdp->td_uringp = urp;
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xint_io_uring_init: Target: %d: Worker: -: ring_fd: %d: sq_entries: %d: cq_entries: %d: features: 0x%x\n", (long long int)pclk_now(),tdp->td_target_number,urp->ring_fd,params.sq_entries,params.cq_entries,params.features);
+	return(0);
+
+map_failed:
+	fprintf(xgp->errout,"%s: xint_io_uring_init: Target %d: ERROR: Cannot map the io_uring rings\n",
+		xgp->progname,
+		tdp->td_target_number);
+	perror("Reason");
+	tdp->td_uringp = urp;
+	xint_io_uring_cleanup(tdp);
+	return(-1);
+#else
+	if (tdp->td_target_options & TO_IO_URING) {
+		fprintf(xgp->errout,"%s: xint_io_uring_init: Target %d: WARNING: The io_uring engine is not supported on this system - using the sync engine\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_target_options &= ~TO_IO_URING;
+	}
+	return(0);
+#endif
+} // End of xint_io_uring_init()
+
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_cleanup() - Unmap and close the io_uring for this target
+ */
+void
+xint_io_uring_cleanup(target_data_t *tdp) {
+#ifdef XINT_HAVE_IO_URING
+	xint_io_uring_t	*urp;
+
+
+	urp = tdp->td_uringp;
+	if (urp == NULL)
+		return;
+	if (urp->sqes)
+		munmap(urp->sqes, urp->sqes_size);
+	if ((urp->cq_ring_ptr) && (urp->cq_ring_ptr != urp->sq_ring_ptr))
+		munmap(urp->cq_ring_ptr, urp->cq_ring_size);
+	if (urp->sq_ring_ptr)
+		munmap(urp->sq_ring_ptr, urp->sq_ring_size);
+	if (urp->ring_fd >= 0)
+		close(urp->ring_fd);
+	if (urp->free_wdp)
+		free(urp->free_wdp);
+	free(urp);
+	tdp->td_uringp = NULL;
+#endif
+} // End of xint_io_uring_cleanup()
+
+#ifdef XINT_HAVE_IO_URING
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_complete_op() - Do all the processing for an I/O operation
+ * that has completed. This is the io_uring equivalent of the second half of
+ * xdd_io_for_os() plus the post-I/O part of xdd_worker_thread_io().
+ * The caller must have set task_io_status and errno.
+ */
+static void
+xint_io_uring_complete_op(worker_data_t *wdp) {
+	target_data_t		*tdp;		// Pointer to the parent Target Data Structure
+	xdd_ts_tte_t		*ttep;		// Pointer to a Timestamp Table Entry
+	int					save_errno;	// errno from the I/O operation
+
+
+	tdp = wdp->wd_tdp;
+	save_errno = errno;
+	// Record the ending time for this op
+	nclk_now(&wdp->wd_counters.tc_current_op_end_time);
+	// Time stamp if requested
+	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
+		ttep = wdp->wd_ts_ttep;
+		ttep->tte_disk_end = wdp->wd_counters.tc_current_op_end_time;
+		ttep->tte_disk_xfer_size = wdp->wd_task.task_io_status;
+		ttep->tte_disk_processor_end = xdd_get_processor();
+	}
+	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_IO;
+
+	// Check the data that was just read if requested
+	if ((wdp->wd_task.task_op_type == TASK_OP_TYPE_READ) && 
+		(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM)) && 
+		(wdp->wd_task.task_io_status == (ssize_t)wdp->wd_task.task_xfer_size)) 
+		__atomic_add_fetch(&tdp->td_dpp->data_pattern_compare_errors, xdd_verify(wdp, wdp->wd_task.task_op_number), __ATOMIC_RELAXED);
+
+	// Update counters and status in this Worker Data, the Target Data, and do the post-I/O checks
+	errno = save_errno;
+	xdd_worker_thread_update_local_counters(wdp);
+	xdd_worker_thread_update_target_counters(wdp);
+	xdd_worker_thread_ttd_after_io_op(wdp);
+	xdd_ts_commit_entry(wdp);
+
+	// Put this slot back on the free stack
+	tdp->td_uringp->free_wdp[tdp->td_uringp->free_count++] = wdp;
+} // End of xint_io_uring_complete_op()
+
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_queue_op() - Start the I/O operation described by the task
+ * in the specified Worker Data Struct. Reads and writes are placed on the
+ * submission queue. NOOPs and NULL targets are completed immediately.
+ */
+static void
+xint_io_uring_queue_op(worker_data_t *wdp) {
+	target_data_t		*tdp;		// Pointer to the parent Target Data Structure
+	xint_io_uring_t		*urp;		// Pointer to the io_uring structure
+	xdd_ts_tte_t		*ttep;		// Pointer to a Timestamp Table Entry
+	struct io_uring_sqe	*sqep;		// Submission Queue Entry for this op
+	uint32_t			tail;		// SQ tail index
+	uint32_t			index;		// SQE index
+
+
+	tdp = wdp->wd_tdp;
+	urp = tdp->td_uringp;
+
+	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE)
+		xdd_datapattern_fill(wdp);
+
+	// Record the starting time for this op
+	wdp->wd_current_state |= WORKER_CURRENT_STATE_IO;
+	nclk_now(&wdp->wd_counters.tc_current_op_start_time);
+	wdp->wd_counters.tc_current_op_end_time = 0;
+	// Time stamp if requested
+	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
+		ttep = wdp->wd_ts_ttep;
+		ttep->tte_disk_start = wdp->wd_counters.tc_current_op_start_time;
+		ttep->tte_disk_processor_start = xdd_get_processor();
+	}
+
+	if ((wdp->wd_task.task_op_type == TASK_OP_TYPE_NOOP) || (tdp->td_target_options & TO_NULL_TARGET)) {
+		// Make it look like a successful I/O
+		wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
+		errno = 0;
+		xint_io_uring_complete_op(wdp);
+		return;
+	}
+
+	tail = *urp->sq_tail;
+	index = tail & *urp->sq_ring_mask;
+	sqep = &((struct io_uring_sqe *)urp->sqes)[index];
+	memset(sqep, 0, sizeof(*sqep));
+	sqep->opcode = (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) ? IORING_OP_WRITE : IORING_OP_READ;
+	sqep->fd = wdp->wd_task.task_file_desc;
+	sqep->addr = (uint64_t)(uintptr_t)wdp->wd_task.task_datap;
+	sqep->len = wdp->wd_task.task_xfer_size;
+	sqep->off = wdp->wd_task.task_byte_offset;
+	sqep->user_data = (uint64_t)(uintptr_t)wdp;
+	urp->sq_array[index] = index;
+	__atomic_store_n(urp->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	urp->ring_to_submit++;
+	urp->ring_inflight++;
+
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xint_io_uring_queue_op: Target: %d: Worker: %d: %s: file_desc: %d: datap: %p: xfer_size: %d: byte_offset: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_op_string,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset);
+} // End of xint_io_uring_queue_op()
+
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_submit_and_reap() - Pass any queued SQEs to the kernel,
+ * wait for at least "wait_nr" completions, and process every completion
+ * that is available.
+ *
+ * A full completion ring (EBUSY) or a kernel that is short of resources
+ * (EAGAIN) is not an error - the completions that are there are processed
+ * and the caller tries again.
+ *
+ * Return value is 0 if everything succeeded or -1 if io_uring_enter failed.
+ */
+static int32_t
+xint_io_uring_submit_and_reap(target_data_t *tdp, uint32_t wait_nr) {
+	xint_io_uring_t		*urp;		// Pointer to the io_uring structure
+	struct io_uring_cqe	*cqep;		// Completion Queue Entry
+	worker_data_t		*wdp;		// The slot that owns a completion
+	uint32_t			head;		// CQ head index
+	int					status;		// Status of io_uring_enter()
+
+
+	urp = tdp->td_uringp;
+	if ((urp->ring_to_submit > 0) || (wait_nr > 0)) {
+		tdp->td_current_state |= TARGET_CURRENT_STATE_IO;
+		do {
+			status = xint_io_uring_enter(urp->ring_fd, urp->ring_to_submit, wait_nr, (wait_nr > 0) ? IORING_ENTER_GETEVENTS : 0);
+		} while ((status < 0) && (errno == EINTR));
+		tdp->td_current_state &= ~TARGET_CURRENT_STATE_IO;
+		if ((status < 0) && (errno != EBUSY) && (errno != EAGAIN)) {
+			fprintf(xgp->errout,"%s: xint_io_uring_submit_and_reap: Target %d: ERROR: io_uring_enter failed: to_submit=%d, wait_nr=%d\n",
+				xgp->progname,
+				tdp->td_target_number,
+				urp->ring_to_submit,
+				wait_nr);
+			perror("Reason");
+			return(-1);
+		}
+		if (status > 0)
+			urp->ring_to_submit -= status;
+	}
+
+	head = *urp->cq_head;
+	while (head != __atomic_load_n(urp->cq_tail, __ATOMIC_ACQUIRE)) {
+		cqep = &((struct io_uring_cqe *)urp->cqes)[head & *urp->cq_ring_mask];
+		wdp = (worker_data_t *)(uintptr_t)cqep->user_data;
+		if (cqep->res < 0) {
+			wdp->wd_task.task_io_status = -1;
+			errno = -cqep->res;
+		} else {
+			wdp->wd_task.task_io_status = cqep->res;
+			errno = 0;
+		}
+		head++;
+		__atomic_store_n(urp->cq_head, head, __ATOMIC_RELEASE);
+		urp->ring_inflight--;
+		xint_io_uring_complete_op(wdp);
+	}
+	return(0);
+} // End of xint_io_uring_submit_and_reap()
+
+/*----------------------------------------------------------------------------*/
+/* xint_io_uring_drain() - Wait for every operation that is still in flight.
+ * The kernel owns the buffers and slots of these operations until their
+ * completions have been reaped, so the pass cannot end before that even if
+ * it was canceled or io_uring_enter failed.
+ */
+static void
+xint_io_uring_drain(target_data_t *tdp) {
+	xint_io_uring_t		*urp;		// Pointer to the io_uring structure
+
+
+	urp = tdp->td_uringp;
+	while (urp->ring_inflight > 0) {
+		if (xint_io_uring_submit_and_reap(tdp, 1)) {
+			fprintf(xgp->errout,"%s: xint_io_uring_drain: Target %d: ERROR: Cannot reap %d operations that are still in flight - they are left to the kernel when the ring is closed\n",
+				xgp->progname,
+				tdp->td_target_number,
+				urp->ring_inflight);
+			return;
+		}
+	}
+} // End of xint_io_uring_drain()
+#endif // XINT_HAVE_IO_URING
+
+/*----------------------------------------------------------------------------*/
+/* xdd_target_pass_io_uring_loop() - This is the io_uring equivalent of
+ * xdd_target_pass_loop(). It keeps up to td_queue_depth operations in flight
+ * from the Target Thread until all bytes have been processed.
+ *
+ * This subroutine is called by xdd_target_pass().
+ */
+void
+xdd_target_pass_io_uring_loop(xdd_plan_t* planp, target_data_t *tdp) {
+#ifdef XINT_HAVE_IO_URING
+	xint_io_uring_t		*urp;		// Pointer to the io_uring structure
+	worker_data_t		*wdp;		// The slot used for the next operation
+	int32_t				status;		// Return status from various subroutines
+	int32_t				issuing;	// Set to 0 when no more operations are to be issued this pass
+
+
+	urp = tdp->td_uringp;
+	issuing = 1;
+	while ((issuing && tdp->td_current_bytes_remaining) || (urp->ring_inflight > 0)) {
+		// Fill the ring up to the queue depth
+		while (issuing && tdp->td_current_bytes_remaining && (urp->free_count > 0)) {
+			wdp = urp->free_wdp[urp->free_count - 1];
+
+			// Things to do before an I/O is issued
+			status = xdd_target_ttd_before_io_op(tdp, wdp);
+			if (status != XDD_RC_GOOD) {
+				issuing = 0;
+				break;
+			}
+			urp->free_count--;
+
+			// Set up the task for this slot
+			xdd_target_pass_task_setup(wdp);
+
+			// Throttle and DirectIO processing
+			status = xdd_worker_thread_ttd_before_io_op(wdp);
+			if (status) {
+				fprintf(xgp->errout,"\n%s: xdd_target_pass_io_uring_loop: Target %d Worker Thread %d: ERROR: Canceling run due to previous error\n",
+					xgp->progname,
+					tdp->td_target_number,
+					wdp->wd_worker_number);
+				xgp->canceled = 1;
+			}
+			if ((xgp->canceled) || (xgp->abort) || (tdp->td_abort)) {
+				urp->free_wdp[urp->free_count++] = wdp;
+				issuing = 0;
+				break;
+			}
+			xint_io_uring_queue_op(wdp);
+		}
+
+		// Submit what was queued and wait for one completion if the ring is full or there is nothing left to issue
+		if ((urp->ring_inflight > 0) && ((urp->free_count == 0) || (!issuing) || (tdp->td_current_bytes_remaining == 0)))
+			status = xint_io_uring_submit_and_reap(tdp, 1);
+		else status = xint_io_uring_submit_and_reap(tdp, 0);
+		if (status) {
+			xgp->canceled = 1;
+			break;
+		}
+	} // End of WHILE loop that transfers data for a single pass
+
+	// Wait for anything still in flight after a failed io_uring_enter
+	xint_io_uring_drain(tdp);
+
+	// Check to see if we've been canceled - if so, we need to leave
+	if (xgp->canceled) {
+		fprintf(xgp->errout,"\n%s: xdd_target_pass_io_uring_loop: Target %d: ERROR: Canceled!\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return;
+	}
+	if (tdp->td_counters.tc_current_io_status != 0)
+		planp->target_errno[tdp->td_target_number] = XDD_RETURN_VALUE_IOERROR;
+#endif
+	return;
+} // End of xdd_target_pass_io_uring_loop()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
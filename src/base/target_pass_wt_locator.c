@@ -12,7 +12,14 @@
  */
 /*
  * This file contains the subroutine that locates an available Worker Thread for
- * a specific target.
+ * a specific target and the subroutines that hand a task to a Worker Thread.
+ *
+ * For normal (non-E2E, non-lockstep) targets the available Worker Threads are
+ * kept on a lock-free ring and tasks are handed over through a per-worker
+ * "doorbell" word. Both spin briefly and then sleep in a futex so that the
+ * per-op path does not take any mutex or barrier. E2E and lockstep targets use 
+ * the original mutex-protected list scan because they depend on the per-worker
+ * WTSYNC flags (EOF received, specific Worker Thread selection).
  */
 #include "xint.h"
 
@@ -82,6 +89,10 @@ xdd_get_any_available_worker_thread(target_data_t *tdp) {
 
     // Use a polling strategy to find available worker_threads -- this might be a good
     // candidate for asynchronous messages in the future    
+    // Use the lock-free ring if there is one
+    if (tdp->td_worker_ringp) 
+		return(xdd_worker_ring_get(tdp));
+
     wdp = 0;
     eof = 0;
     while (0 == wdp && eof != tdp->td_queue_depth) {
@@ -133,6 +144,242 @@ xdd_get_any_available_worker_thread(target_data_t *tdp) {
     return wdp;        
 } // End of xdd_get_any_available_worker_thread()
 
+/*----------------------------------------------------------------------------*/
+/* xint_worker_ring_init() - Allocate the lock-free ring of available Worker 
+ * Threads for this target. The ring is not used (and not allocated) for E2E
+ * and lockstep targets.
+ * This must be called before the Worker Threads are started because each
+ * Worker Thread puts itself on the ring at the end of its initialization.
+ *
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_worker_ring_init(target_data_t *tdp) {
+	xint_worker_ring_t	*ringp;		// Pointer to the ring
+	uint32_t			slots;		// Number of slots - a power of 2 that is >= the queue depth
+	uint32_t			i;
+
+
+	tdp->td_worker_ringp = NULL;
+	if ((tdp->td_target_options & TO_ENDTOEND) || (tdp->td_lsp))
+		return(0);
+
+	slots = 1;
+	while (slots < (uint32_t)tdp->td_queue_depth) 
+		slots <<= 1;
+
+	ringp = malloc(sizeof(xint_worker_ring_t));
+	if (ringp == NULL) {
+		fprintf(xgp->errout,"%s: xint_worker_ring_init: Target %d: ERROR: Cannot allocate %d bytes of memory for the Worker Thread ring\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(int)sizeof(xint_worker_ring_t));
+		return(-1);
+	}
+	memset(ringp, 0, sizeof(xint_worker_ring_t));
+	ringp->ring_slots = malloc(slots * sizeof(struct xint_worker_ring_slot));
+	ringp->ring_drainp = malloc(tdp->td_queue_depth * sizeof(worker_data_t *));
+	if ((ringp->ring_slots == NULL) || (ringp->ring_drainp == NULL)) {
+		fprintf(xgp->errout,"%s: xint_worker_ring_init: Target %d: ERROR: Cannot allocate memory for %d Worker Thread ring slots\n",
+			xgp->progname,
+			tdp->td_target_number,
+			slots);
+		if (ringp->ring_slots)
+			free(ringp->ring_slots);
+		if (ringp->ring_drainp)
+			free(ringp->ring_drainp);
+		free(ringp);
+		return(-1);
+	}
+	for (i = 0; i < slots; i++) {
+		ringp->ring_slots[i].slot_sequence = i;
+		ringp->ring_slots[i].slot_wdp = NULL;
+	}
+	ringp->ring_mask = slots - 1;
+	tdp->td_worker_ringp = ringp;
+	return(0);
+} // End of xint_worker_ring_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_ring_put() - Put a Worker Thread on the ring of available Worker
+ * Threads and wake up the Target Thread if it is sleeping on the ring.
+ * This is called by the Worker Thread when it finishes a task and by the 
+ * Target Thread when it returns a Worker Thread that it did not use.
+ */
+void
+xdd_worker_ring_put(target_data_t *tdp, worker_data_t *wdp) {
+	xint_worker_ring_t				*ringp;		// Pointer to the ring
+	struct xint_worker_ring_slot	*slotp;		// The slot being claimed
+	uint32_t						pos;		// Tail position being claimed
+	uint32_t						seq;		// Sequence number of the slot
+	int32_t							dif;		// Difference between the sequence and position
+
+
+	ringp = tdp->td_worker_ringp;
+	pos = __atomic_load_n(&ringp->ring_tail, __ATOMIC_RELAXED);
+	while (1) {
+		slotp = &ringp->ring_slots[pos & ringp->ring_mask];
+		seq = __atomic_load_n(&slotp->slot_sequence, __ATOMIC_ACQUIRE);
+		dif = (int32_t)(seq - pos);
+		if (dif == 0) {
+			if (__atomic_compare_exchange_n(&ringp->ring_tail, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+				break;
+		} else if (dif < 0) { 
+			// The slot has not been taken yet. The ring holds every Worker Thread so 
+			// this is only a Target Thread that is part way through taking it - try again.
+			XINT_CPU_RELAX();
+			pos = __atomic_load_n(&ringp->ring_tail, __ATOMIC_RELAXED);
+		} else {
+			pos = __atomic_load_n(&ringp->ring_tail, __ATOMIC_RELAXED);
+		}
+	}
+	slotp->slot_wdp = wdp;
+	__atomic_store_n(&slotp->slot_sequence, pos + 1, __ATOMIC_RELEASE);
+
+	// Wake up the Target Thread if it is waiting for a Worker Thread
+	__atomic_add_fetch(&ringp->ring_signal, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&ringp->ring_waiting, __ATOMIC_SEQ_CST))
+		xint_futex_wake(&ringp->ring_signal, 1);
+} // End of xdd_worker_ring_put()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_ring_get() - Take the next available Worker Thread off the ring
+ * waiting for one to become available if necessary. The Worker Thread is 
+ * marked BUSY. 
+ * This subroutine is only called by the Target Thread (single consumer).
+ */
+worker_data_t *
+xdd_worker_ring_get(target_data_t *tdp) {
+	xint_worker_ring_t				*ringp;		// Pointer to the ring
+	struct xint_worker_ring_slot	*slotp;		// The slot at the head of the ring
+	worker_data_t					*wdp;		// The Worker Thread taken off the ring
+	uint32_t						pos;		// Head position
+	uint32_t						signal;		// Snapshot of the futex word
+	int								spin;		// Number of polls before sleeping
+	int								spin_limit;	// Number of polls allowed before sleeping
+
+
+	ringp = tdp->td_worker_ringp;
+	pos = ringp->ring_head;
+	slotp = &ringp->ring_slots[pos & ringp->ring_mask];
+	spin = 0;
+	spin_limit = xint_handoff_spin_count();
+	while (__atomic_load_n(&slotp->slot_sequence, __ATOMIC_ACQUIRE) != pos + 1) {
+		if (spin < spin_limit) {
+			spin++;
+			XINT_CPU_RELAX();
+			continue;
+		}
+		// Nothing showed up while spinning so go to sleep until a Worker Thread puts itself on the ring
+		signal = __atomic_load_n(&ringp->ring_signal, __ATOMIC_SEQ_CST);
+		__atomic_store_n(&ringp->ring_waiting, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&slotp->slot_sequence, __ATOMIC_ACQUIRE) != pos + 1) {
+			tdp->td_current_state |= TARGET_CURRENT_STATE_WAITING_ANY_WORKER_THREAD_AVAILABLE;
+			xint_futex_wait(&ringp->ring_signal, signal);
+			tdp->td_current_state &= ~TARGET_CURRENT_STATE_WAITING_ANY_WORKER_THREAD_AVAILABLE;
+		}
+		__atomic_store_n(&ringp->ring_waiting, 0, __ATOMIC_SEQ_CST);
+	}
+	wdp = slotp->slot_wdp;
+	__atomic_store_n(&slotp->slot_sequence, pos + ringp->ring_mask + 1, __ATOMIC_RELEASE);
+	ringp->ring_head = pos + 1;
+
+	// Indicate that this Worker Thread is now busy
+	__atomic_or_fetch(&wdp->wd_worker_thread_target_sync, WTSYNC_BUSY, __ATOMIC_RELAXED);
+	return(wdp);
+} // End of xdd_worker_ring_get()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_ring_collect_all() - Wait for every Worker Thread of this target
+ * to finish its current task. This is done by taking all of them off the ring
+ * and then putting them back so that they are available for the next pass.
+ * This is the lock-free equivalent of calling xdd_get_specific_worker_thread()
+ * for each Worker Thread.
+ */
+void
+xdd_worker_ring_collect_all(target_data_t *tdp) {
+	xint_worker_ring_t	*ringp;		// Pointer to the ring
+	int32_t				q;			// Worker Thread counter
+
+
+	ringp = tdp->td_worker_ringp;
+	for (q = 0; q < tdp->td_queue_depth; q++) 
+		ringp->ring_drainp[q] = xdd_worker_ring_get(tdp);
+	for (q = 0; q < tdp->td_queue_depth; q++) {
+		__atomic_and_fetch(&ringp->ring_drainp[q]->wd_worker_thread_target_sync, ~WTSYNC_BUSY, __ATOMIC_RELAXED);
+		xdd_worker_ring_put(tdp, ringp->ring_drainp[q]);
+	}
+} // End of xdd_worker_ring_collect_all()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_thread_return() - Give back a Worker Thread that was obtained
+ * from xdd_get_any_available_worker_thread() but was not assigned a task.
+ */
+void
+xdd_worker_thread_return(target_data_t *tdp, worker_data_t *wdp) {
+
+	if (tdp->td_worker_ringp) {
+		__atomic_and_fetch(&wdp->wd_worker_thread_target_sync, ~WTSYNC_BUSY, __ATOMIC_RELAXED);
+		xdd_worker_ring_put(tdp, wdp);
+	} else {
+		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
+		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
+		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+	}
+} // End of xdd_worker_thread_return()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_thread_release() - Hand the task that has been set up in
+ * wdp->wd_task to the Worker Thread. This rings the doorbell of the Worker
+ * Thread and wakes it up if it is sleeping. If the target uses the shared
+ * Worker Thread pool the task is put on a pool queue instead.
+ * This subroutine is called by the Target Thread.
+ */
+void
+xdd_worker_thread_release(target_data_t *tdp, worker_data_t *wdp) {
+
+	if (tdp->td_worker_poolp) {
+		xint_worker_pool_put(tdp->td_worker_poolp, wdp);
+		return;
+	}
+	__atomic_add_fetch(&wdp->wd_task_doorbell, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&wdp->wd_task_waiting, __ATOMIC_SEQ_CST))
+		xint_futex_wake(&wdp->wd_task_doorbell, 1);
+} // End of xdd_worker_thread_release()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_thread_wait_for_task() - Wait for the Target Thread to ring the
+ * doorbell of this Worker Thread. The Worker Thread spins for a short while
+ * and then sleeps in a futex on the doorbell.
+ * This subroutine is called by the Worker Thread.
+ */
+void
+xdd_worker_thread_wait_for_task(worker_data_t *wdp) {
+	uint32_t	seen;	// The last doorbell value this Worker Thread acted on
+	int			spin;	// Number of polls before sleeping
+	int			spin_limit;	// Number of polls allowed before sleeping
+
+
+	seen = wdp->wd_task_doorbell_seen;
+	spin = 0;
+	spin_limit = xint_handoff_spin_count();
+	while (__atomic_load_n(&wdp->wd_task_doorbell, __ATOMIC_ACQUIRE) == seen) {
+		if (spin < spin_limit) {
+			spin++;
+			XINT_CPU_RELAX();
+			continue;
+		}
+		__atomic_store_n(&wdp->wd_task_waiting, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&wdp->wd_task_doorbell, __ATOMIC_SEQ_CST) == seen) {
+			wdp->wd_current_state |= WORKER_CURRENT_STATE_WAITING_FOR_TASK;
+			xint_futex_wait(&wdp->wd_task_doorbell, seen);
+			wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WAITING_FOR_TASK;
+		}
+		__atomic_store_n(&wdp->wd_task_waiting, 0, __ATOMIC_SEQ_CST);
+	}
+	wdp->wd_task_doorbell_seen = seen + 1;
+} // End of xdd_worker_thread_wait_for_task()
+
 /*
  * Local variables:
  *  indent-tabs-mode: t
@@ -26,11 +26,14 @@ int32_t
 xdd_target_ttd_after_pass(target_data_t *tdp) {
 	int32_t  status;
 	worker_data_t	*wdp;
+	int32_t			i;
 
 
 	status = 0;
 	// Issue an fdatasync() to flush all the write buffers to disk for this file if the -syncwrite option was specified
-	if (tdp->td_target_options & TO_SYNCWRITE) {
+	if ((tdp->td_target_options & TO_SYNCWRITE) && (tdp->td_target_options & TO_IO_MMAP)) {
+		status = xint_mmap_sync(tdp); // msync() the mapping when the writes were done through it
+	} else if (tdp->td_target_options & TO_SYNCWRITE) {
 #if (LINUX || AIX)
             status = fdatasync(tdp->td_file_desc);
 #else
@@ -45,6 +48,7 @@ xdd_target_ttd_after_pass(target_data_t *tdp) {
 	times(&tdp->td_counters.tc_current_cpu_times);
 
 	// Loop through all the Worker Threads to put the Earliest Start Time and Latest End Time into this Target Data Struct
+	// and to merge their op time histograms into the one for this Target
 	wdp = tdp->td_next_wdp;
 	while (wdp) {
 		if (wdp->wd_counters.tc_time_first_op_issued_this_pass <= tdp->td_counters.tc_time_first_op_issued_this_pass) 
@@ -53,8 +57,20 @@ xdd_target_ttd_after_pass(target_data_t *tdp) {
 			tdp->td_counters.tc_pass_start_time = wdp->wd_counters.tc_pass_start_time;
 		if (wdp->wd_counters.tc_pass_end_time >= tdp->td_counters.tc_pass_end_time) 
 			tdp->td_counters.tc_pass_end_time = wdp->wd_counters.tc_pass_end_time;
+		xint_lh_merge(&tdp->td_latency_hist, &wdp->wd_latency_hist);
+		if (wdp->wd_rsm_statsp) { // Add up the request size mix statistics for the whole run
+			for (i = 0; i < tdp->td_rsmp->rsm_classes; i++) {
+				tdp->td_rsmp->rsm_run_statsp[i].rs_ops += wdp->wd_rsm_statsp[i].rs_ops;
+				tdp->td_rsmp->rsm_run_statsp[i].rs_bytes += wdp->wd_rsm_statsp[i].rs_bytes;
+				tdp->td_rsmp->rsm_run_statsp[i].rs_op_time += wdp->wd_rsm_statsp[i].rs_op_time;
+				xint_lh_merge(&tdp->td_rsmp->rsm_run_statsp[i].rs_hist, &wdp->wd_rsm_statsp[i].rs_hist);
+			}
+		}
 		wdp = wdp->wd_next_wdp;
 	}
+	// Keep the op times of every pass of a replay to compare with the trace
+	if (tdp->td_replayp) 
+		xint_lh_merge(&tdp->td_replayp->replay_replayed_hist, &tdp->td_latency_hist);
 	if (tdp->td_target_options & TO_ENDTOEND) { 
 		// Average the Send/Receive Time 
 		tdp->td_e2ep->e2e_sr_time /= tdp->td_queue_depth;
@@ -136,6 +136,37 @@ if (xgp->global_options & GO_DEBUG_TIME_LIMIT) fprintf(stderr,"DEBUG_TIME_LIMIT:
 
 } // End of xdd_timelimit_before_io_op()
 
+/*----------------------------------------------------------------------------*/
+/* xdd_stream_before_io_op() - This subroutine will check to see if this 
+ * target is a background stream and all the other targets have finished 
+ * issuing I/O for this pass. If so, this stream stops so that the pass ends
+ * with the foreground streams rather than running on by itself.
+ * Return values: XDD_RC_GOOD to keep going or XDD_RC_BAD to stop this pass.
+ */
+int32_t
+xdd_stream_before_io_op(target_data_t *tdp) {
+	int32_t			i;
+
+
+	if (!(tdp->td_stream_type & XINT_STREAM_BACKGROUND) || (tdp->td_stream_foregrounds == 0))
+		return(XDD_RC_GOOD);
+
+	for (i = 0; i < tdp->td_stream_foregrounds; i++) {
+		if (__atomic_load_n(&tdp->td_stream_foregroundpp[i]->td_stream_pass_complete, __ATOMIC_ACQUIRE) < tdp->td_counters.tc_pass_number)
+			return(XDD_RC_GOOD);
+	}
+
+	if (xgp->global_options & GO_VERBOSE)
+		fprintf(xgp->output,"\n%s: xdd_stream_before_io_op: Target %d: Background stream '%s' stopped after %lld ops because the foreground streams have finished pass %d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_stream_name,
+			(long long int)tdp->td_counters.tc_current_op_number,
+			tdp->td_counters.tc_pass_number);
+	return(XDD_RC_BAD);
+
+} // End of xdd_stream_before_io_op()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_runtime_before_io_op() - This subroutine will check to see if the
  * specified time limit for this run has expired. 
@@ -170,6 +201,285 @@ xdd_runtime_before_io_op(target_data_t *tdp) {
 
 } // End of xdd_runtime_before_io_op()
 
+/*----------------------------------------------------------------------------*/
+/* xint_throttle_sleep_until() - Wait until the high-resolution clock reaches
+ * "deadline". The Target Thread sleeps with clock_nanosleep() until shortly
+ * before the deadline and then spins so that it does not lose a scheduler 
+ * tick of wakeup latency on every operation.
+ */
+static void
+xint_throttle_sleep_until(nclk_t deadline) {
+	nclk_t			now;		// What time is it *now*?
+	struct timespec	req;		// The time to sleep until or for
+
+
+	nclk_now(&now);
+	if (now >= deadline)
+		return;
+	if ((deadline - now) > XINT_THROTTLE_SPIN_NSEC) {
+#if (LINUX)
+		// Sleep on the monotonic clock so that clock adjustments cannot stretch the sleep
+		clock_gettime(CLOCK_MONOTONIC, &req);
+		req.tv_sec += (deadline - now - XINT_THROTTLE_SPIN_NSEC) / BILLION;
+		req.tv_nsec += (deadline - now - XINT_THROTTLE_SPIN_NSEC) % BILLION;
+		if (req.tv_nsec >= BILLION) {
+			req.tv_sec++;
+			req.tv_nsec -= BILLION;
+		}
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &req, NULL) == EINTR)
+			;
+#else
+		req.tv_sec = (deadline - now - XINT_THROTTLE_SPIN_NSEC) / BILLION;
+		req.tv_nsec = (deadline - now - XINT_THROTTLE_SPIN_NSEC) % BILLION;
+		nanosleep(&req, NULL);
+#endif
+	}
+	do {
+		XINT_CPU_RELAX();
+		nclk_now(&now);
+	} while (now < deadline);
+} // End of xint_throttle_sleep_until()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_throttle_before_io_op() - This subroutine implements the throttling
+ * mechanism which is essentially a delay before the next I/O operation such
+ * that the overall bandwdith or IOP rate meets the throttled value.
+ * There is one token bucket per target and it is only used by the Target
+ * Thread, so the rate applies to the target as a whole no matter how many
+ * Worker Threads are performing the operations.
+ * With a variance the rate used for each operation is drawn uniformly from
+ * the throttle value plus or minus the variance.
+ * 
+ * This subroutine is called within the context of a Target Thread.
+ *
+ */
+void
+xdd_throttle_before_io_op(target_data_t *tdp) {
+	xint_throttle_t	*throtp;	// The throttle for this target
+	nclk_t			now;		// What time is it *now*?
+	double			now_rel;	// Current time relative to the start of the bucket
+	double			rate;		// Rate to use for this operation
+	double			cost;		// Time in nanoseconds that this operation takes from the bucket
+	double			issue;		// Time relative to the start of the bucket at which this operation may be issued
+	int64_t			bytes;		// Number of bytes this operation will transfer
+
+
+	throtp = tdp->td_throtp;
+	if ((throtp == NULL) || (throtp->throttle <= 0.0)) 
+		return;
+
+	nclk_now(&now);
+	if (!throtp->throttle_started) {
+		throtp->throttle_started = 1;
+		throtp->throttle_start = now;
+		throtp->throttle_tat = 0.0;
+	}
+	now_rel = (double)(now - throtp->throttle_start);
+
+	rate = throtp->throttle;
+	if ((throtp->throttle_variance > 0.0) && !(throtp->throttle_type & XINT_THROTTLE_DELAY)) {
+		rate += throtp->throttle_variance * ((2.0 * erand48(throtp->throttle_xsubi)) - 1.0);
+		if (rate < throtp->throttle / 100.0)
+			rate = throtp->throttle / 100.0;
+	}
+	if (throtp->throttle_type & XINT_THROTTLE_DELAY) {
+		cost = throtp->throttle * BILLION;
+	} else if (throtp->throttle_type & XINT_THROTTLE_OPS) {
+		cost = BILLION / rate;
+	} else { // Bandwidth in MB/sec
+		if ((tdp->td_rsmp) || (tdp->td_replayp))
+			bytes = xdd_get_seek_entry(tdp, tdp->td_counters.tc_current_op_number)->reqsize * tdp->td_block_size;
+		else bytes = tdp->td_xfer_size;
+		if (tdp->td_current_bytes_remaining < (uint64_t)bytes)
+			bytes = tdp->td_current_bytes_remaining;
+		cost = ((double)bytes * BILLION) / (rate * MILLION);
+	}
+
+	// Take the tokens - a late operation is made up by the ones after it unless
+	// the user limited the burst, in which case the tokens beyond it are lost
+	issue = throtp->throttle_tat;
+	if ((throtp->throttle_burst_nsec >= 0.0) && (issue < now_rel - throtp->throttle_burst_nsec))
+		issue = now_rel - throtp->throttle_burst_nsec;
+	throtp->throttle_tat = issue + cost;
+if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_throttle_before_io_op: Target: %d: Worker: -: now: %f: issue: %f: cost: %f\n", (long long int)pclk_now(),tdp->td_target_number,now_rel,issue,cost);
+
+	if (issue > now_rel)
+		xint_throttle_sleep_until(throtp->throttle_start + (nclk_t)issue);
+
+} // End of xdd_throttle_before_io_op()
+
+/*----------------------------------------------------------------------------*/
+/* xint_arrival_advance() - Return the time of the next arrival on the 
+ * schedule of this target and move the schedule on to the one after it. 
+ * Times are in nanoseconds after the first operation of the pass.
+ */
+static double
+xint_arrival_advance(xint_arrival_t *arrivalp) {
+	double	this_arrival;	// Time of the arrival being returned
+	double	mean_gap;		// Average time between arrivals in nanoseconds
+
+
+	this_arrival = arrivalp->arrival_next;
+	mean_gap = BILLION / arrivalp->arrival_rate;
+	if (arrivalp->arrival_type & XINT_ARRIVAL_CONSTANT) {
+		arrivalp->arrival_next += mean_gap;
+	} else if (arrivalp->arrival_type & XINT_ARRIVAL_BURSTY) {
+		// The operations of a burst arrive together and the bursts are spaced so that the average rate is unchanged
+		if (arrivalp->arrival_burst_left > 0) {
+			arrivalp->arrival_burst_left--;
+		} else {
+			arrivalp->arrival_burst_left = arrivalp->arrival_burst - 1;
+			arrivalp->arrival_next += -log(1.0 - erand48(arrivalp->arrival_xsubi)) * mean_gap * arrivalp->arrival_burst;
+		}
+	} else { // Poisson
+		arrivalp->arrival_next += -log(1.0 - erand48(arrivalp->arrival_xsubi)) * mean_gap;
+	}
+	return(this_arrival);
+} // End of xint_arrival_advance()
+
+/*----------------------------------------------------------------------------*/
+/* xint_arrival_push() - Add an arrival to the end of the FIFO of arrivals
+ * that are due but have not been issued yet, making the FIFO bigger if needed.
+ * Returns 0 on success or -1 if the memory could not be allocated.
+ */
+static int32_t
+xint_arrival_push(target_data_t *tdp, xint_arrival_t *arrivalp, nclk_t due) {
+	nclk_t		*newp;		// The bigger FIFO
+	int64_t		new_size;	// Number of entries in the bigger FIFO
+	int64_t		i;
+
+
+	if (arrivalp->arrival_due_count == arrivalp->arrival_due_size) {
+		new_size = (arrivalp->arrival_due_size) ? 2 * arrivalp->arrival_due_size : XINT_ARRIVAL_DUE_INITIAL;
+		newp = malloc(new_size * sizeof(nclk_t));
+		if (newp == NULL) {
+			fprintf(xgp->errout,"%s: xint_arrival_push: Target %d: ERROR: Cannot allocate %lld bytes of memory for a backlog of %lld arrivals\n",
+				xgp->progname,
+				tdp->td_target_number,
+				(long long int)(new_size * sizeof(nclk_t)),
+				(long long int)arrivalp->arrival_due_count);
+			return(-1);
+		}
+		for (i = 0; i < arrivalp->arrival_due_count; i++)
+			newp[i] = arrivalp->arrival_due[(arrivalp->arrival_due_head + i) % arrivalp->arrival_due_size];
+		if (arrivalp->arrival_due)
+			free(arrivalp->arrival_due);
+		arrivalp->arrival_due = newp;
+		arrivalp->arrival_due_size = new_size;
+		arrivalp->arrival_due_head = 0;
+	}
+	arrivalp->arrival_due[(arrivalp->arrival_due_head + arrivalp->arrival_due_count) % arrivalp->arrival_due_size] = due;
+	arrivalp->arrival_due_count++;
+	return(0);
+} // End of xint_arrival_push()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_arrival_before_io_op() - This subroutine implements the open-loop
+ * arrivals. Operations arrive on a schedule that does not depend on how 
+ * long the Worker Threads take, so when they fall behind the arrivals that
+ * are due pile up in a FIFO. Each operation takes the oldest arrival and
+ * its due time is handed to the Worker Thread so that the latency of the
+ * operation includes the time it spent waiting in the backlog.
+ * When nothing is due yet the Target Thread waits for the next arrival.
+ * 
+ * This subroutine is called within the context of a Target Thread.
+ *
+ */
+int32_t
+xdd_arrival_before_io_op(target_data_t *tdp) {
+	xint_arrival_t	*arrivalp;	// The arrivals for this target
+	nclk_t			now;		// What time is it *now*?
+	nclk_t			due;		// Time at which the next arrival is due
+	nclk_t			lag;		// Time from the arrival to the issue of this operation
+	uint64_t		ops_left;	// Number of operations left in this pass
+
+
+	arrivalp = tdp->td_arrivalp;
+	if ((arrivalp == NULL) || (arrivalp->arrival_rate <= 0.0)) 
+		return(XDD_RC_GOOD);
+
+	nclk_now(&now);
+	if (!arrivalp->arrival_started) {
+		arrivalp->arrival_started = 1;
+		arrivalp->arrival_start = now;
+	}
+
+	// Queue up everything that is due by now - there can never be more arrivals than operations left in this pass
+	if ((tdp->td_rsmp) || (tdp->td_replayp))
+		ops_left = tdp->td_target_ops - tdp->td_counters.tc_current_op_number;
+	else ops_left = (tdp->td_current_bytes_remaining + tdp->td_xfer_size - 1) / tdp->td_xfer_size;
+	while ((arrivalp->arrival_due_count < (int64_t)ops_left) && 
+		   (arrivalp->arrival_start + (nclk_t)arrivalp->arrival_next <= now)) {
+		if (xint_arrival_push(tdp, arrivalp, arrivalp->arrival_start + (nclk_t)xint_arrival_advance(arrivalp)))
+			return(XDD_RC_BAD);
+	}
+
+	if (arrivalp->arrival_due_count == 0) { 
+		// Ahead of the schedule - wait for the next arrival
+		due = arrivalp->arrival_start + (nclk_t)xint_arrival_advance(arrivalp);
+		xint_throttle_sleep_until(due);
+		lag = 0;
+	} else { 
+		// Behind the schedule - take the oldest arrival
+		due = arrivalp->arrival_due[arrivalp->arrival_due_head];
+		arrivalp->arrival_due_head = (arrivalp->arrival_due_head + 1) % arrivalp->arrival_due_size;
+		arrivalp->arrival_due_count--;
+		lag = (now > due) ? now - due : 0;
+	}
+	arrivalp->arrival_intended = due;
+
+	arrivalp->arrival_ops++;
+	arrivalp->arrival_backlog_sum += (double)arrivalp->arrival_due_count;
+	if (arrivalp->arrival_due_count > arrivalp->arrival_backlog_max)
+		arrivalp->arrival_backlog_max = arrivalp->arrival_due_count;
+	if (lag > arrivalp->arrival_lag_max)
+		arrivalp->arrival_lag_max = lag;
+if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_arrival_before_io_op: Target: %d: Worker: -: due: %lld: lag: %lld: backlog: %lld\n", (long long int)pclk_now(),tdp->td_target_number,(long long int)(due - arrivalp->arrival_start),(long long int)lag,(long long int)arrivalp->arrival_due_count);
+
+	return(XDD_RC_GOOD);
+
+} // End of xdd_arrival_before_io_op()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_replay_before_io_op() - This subroutine holds each operation of a 
+ * replayed trace back until the time it was issued in the trace, scaled by
+ * the speedup factor. The times are relative to the first operation of the
+ * pass. An operation that cannot be issued on time, because the trace had more
+ * operations outstanding than there are Worker Threads or because the device
+ * is slower than the one the trace was captured on, is counted as late.
+ * This subroutine is called within the context of a Target Thread.
+ */
+void
+xdd_replay_before_io_op(target_data_t *tdp) {
+	xint_replay_t	*replayp;	// The replay for this target
+	seek_t			*seekp;		// The seek entry for this operation
+	nclk_t			now;		// What time is it *now*?
+	nclk_t			due;		// Time at which this operation is due
+
+
+	replayp = tdp->td_replayp;
+	if (replayp == NULL) 
+		return;
+
+	seekp = xdd_get_seek_entry(tdp, tdp->td_counters.tc_current_op_number);
+	nclk_now(&now);
+	if (!replayp->replay_started) {
+		replayp->replay_started = 1;
+		replayp->replay_start = now - seekp->time1;
+	}
+	due = replayp->replay_start + seekp->time1;
+	if (due > now) {
+		xint_throttle_sleep_until(due);
+	} else if (now - due > XINT_REPLAY_LATE) {
+		replayp->replay_late_ops++;
+		replayp->replay_lag_sum += (double)(now - due);
+		if (now - due > replayp->replay_lag_max)
+			replayp->replay_lag_max = now - due;
+	}
+if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_replay_before_io_op: Target: %d: Worker: -: op: %lld: due: %lld: now: %lld\n", (long long int)pclk_now(),tdp->td_target_number,(long long int)tdp->td_counters.tc_current_op_number,(long long int)(due - replayp->replay_start),(long long int)(now - replayp->replay_start));
+
+} // End of xdd_replay_before_io_op()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_target_ttd_before_io_op() - This subroutine will do all the stuff 
  * needed to be done by the Target Thread before a Worker Thread is issued with 
@@ -181,6 +491,7 @@ xdd_runtime_before_io_op(target_data_t *tdp) {
 int32_t
 xdd_target_ttd_before_io_op(target_data_t *tdp, worker_data_t *wdp) {
 	int32_t	status;	// Return status from various subroutines
+	seek_t	*seekp;	// The seek entry for this operation
 
 	// Syncio barrier - wait for all others to get here 
 	xdd_syncio_before_io_op(tdp);
@@ -198,15 +509,21 @@ xdd_target_ttd_before_io_op(target_data_t *tdp, worker_data_t *wdp) {
 	if (status != XDD_RC_GOOD) 
 		return(status);
 
+	// Check to see if this background stream should stop with the foreground streams
+	status = xdd_stream_before_io_op(tdp);
+	if (status != XDD_RC_GOOD) 
+		return(status);
+
 	/* init the error number and break flag for good luck */
 	errno = 0;
 	/* Get the location to seek to */
+	seekp = xdd_get_seek_entry(tdp, tdp->td_counters.tc_current_op_number);
 	if (tdp->td_seekhdr.seek_options & SO_SEEK_NONE) /* reseek to starting offset if noseek is set */
 		tdp->td_counters.tc_current_byte_offset = (uint64_t)((tdp->td_target_number * tdp->td_planp->target_offset) + 
-											tdp->td_seekhdr.seeks[0].block_location) * 
+											tdp->td_seekhdr.seek_first_location) * 
 											tdp->td_block_size;
 	else tdp->td_counters.tc_current_byte_offset = (uint64_t)((tdp->td_target_number * tdp->td_planp->target_offset) + 
-											tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].block_location) * 
+											seekp->block_location) * 
 											tdp->td_block_size;
 
 	if (xgp->global_options & GO_INTERACTIVE)	
@@ -230,6 +547,19 @@ xdd_target_ttd_before_io_op(target_data_t *tdp, worker_data_t *wdp) {
 		return(XDD_RC_BAD);
 	}
 
+	// Wait for the throttle to let this operation go
+	xdd_throttle_before_io_op(tdp);
+
+	// Wait for this operation to arrive if arrivals are open-loop
+	status = xdd_arrival_before_io_op(tdp);
+	if (status != XDD_RC_GOOD) {
+		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY;
+		return(status);
+	}
+
+	// Wait for the time this operation was issued in the trace being replayed
+	xdd_replay_before_io_op(tdp);
+
 	return(XDD_RC_GOOD);
 
 } // End of xdd_target_ttd_before_io_op()
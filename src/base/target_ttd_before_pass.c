@@ -177,6 +177,109 @@ xdd_e2e_before_pass(target_data_t *tdp) {
 
 } // End of xdd_e2e_before_pass()
 
+/*----------------------------------------------------------------------------*/
+/* xdd_throttle_before_pass() - Empty the token bucket of the throttle and
+ * work out how many nanoseconds of tokens it can hold. 
+ * The bucket starts when the first operation of the pass is issued.
+ */
+void
+xdd_throttle_before_pass(target_data_t *tdp) {
+	xint_throttle_t	*throtp;	// The throttle for this target
+
+
+	throtp = tdp->td_throtp;
+	if ((throtp == NULL) || (throtp->throttle <= 0.0)) 
+		return;
+
+	throtp->throttle_started = 0;
+	throtp->throttle_tat = 0.0;
+	if (throtp->throttle_type & XINT_THROTTLE_DELAY) 
+		throtp->throttle_burst_nsec = 0.0; // Every operation waits for the full delay
+	else if (throtp->throttle_burst <= 0.0)
+		throtp->throttle_burst_nsec = XINT_THROTTLE_NO_BURST_LIMIT; // Keep to the schedule
+	else throtp->throttle_burst_nsec = (throtp->throttle_burst * BILLION) / throtp->throttle; // MB over MB/sec or ops over ops/sec
+
+	// The variance of each pass is drawn from its own repeatable sequence
+	throtp->throttle_xsubi[0] = (unsigned short)(tdp->td_counters.tc_pass_number & 0xFFFF);
+	throtp->throttle_xsubi[1] = (unsigned short)(tdp->td_target_number & 0xFFFF);
+	throtp->throttle_xsubi[2] = (unsigned short)(tdp->td_seekhdr.seek_seed & 0xFFFF);
+} // End of xdd_throttle_before_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_arrival_before_pass() - Empty the backlog of the open-loop arrivals 
+ * and start a new schedule. The schedule starts when the first operation of 
+ * the pass is issued.
+ */
+void
+xdd_arrival_before_pass(target_data_t *tdp) {
+	xint_arrival_t	*arrivalp;	// The arrivals for this target
+
+
+	arrivalp = tdp->td_arrivalp;
+	if ((arrivalp == NULL) || (arrivalp->arrival_rate <= 0.0)) 
+		return;
+
+	arrivalp->arrival_started = 0;
+	arrivalp->arrival_next = 0.0;
+	arrivalp->arrival_burst_left = arrivalp->arrival_burst - 1;
+	arrivalp->arrival_due_head = 0;
+	arrivalp->arrival_due_count = 0;
+	arrivalp->arrival_ops = 0;
+	arrivalp->arrival_backlog_max = 0;
+	arrivalp->arrival_backlog_sum = 0.0;
+	arrivalp->arrival_lag_max = 0;
+
+	// The arrivals of each pass are drawn from their own repeatable sequence
+	arrivalp->arrival_xsubi[0] = (unsigned short)(tdp->td_counters.tc_pass_number & 0xFFFF);
+	arrivalp->arrival_xsubi[1] = (unsigned short)(tdp->td_target_number & 0xFFFF);
+	arrivalp->arrival_xsubi[2] = (unsigned short)((tdp->td_seekhdr.seek_seed >> 16) & 0xFFFF);
+} // End of xdd_arrival_before_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_replay_before_pass() - Start the trace that is being replayed over.
+ * The times of the pass are relative to its first operation.
+ */
+void
+xdd_replay_before_pass(target_data_t *tdp) {
+
+	if (tdp->td_replayp == NULL) 
+		return;
+	tdp->td_replayp->replay_started = 0;
+} // End of xdd_replay_before_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_stream_before_pass() - Make the list of foreground targets that a 
+ * background stream waits for so that xdd_stream_before_io_op() only has
+ * to look at those targets on each operation.
+ */
+void
+xdd_stream_before_pass(target_data_t *tdp) {
+	xdd_plan_t		*planp;		// The plan for this target
+	target_data_t	*other_tdp;	// One of the other targets
+	int32_t			i;
+
+
+	tdp->td_stream_foregrounds = 0;
+	if (!(tdp->td_stream_type & XINT_STREAM_BACKGROUND))
+		return;
+
+	planp = tdp->td_planp;
+	if (tdp->td_stream_foregroundpp == NULL) {
+		tdp->td_stream_foregroundpp = malloc(planp->number_of_targets * sizeof(target_data_t *));
+		if (tdp->td_stream_foregroundpp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_stream_before_pass: Target %d: ERROR: Cannot allocate the list of foreground streams - the background stream will run the whole pass\n",
+				xgp->progname,
+				tdp->td_target_number);
+			return;
+		}
+	}
+	for (i = 0; i < planp->number_of_targets; i++) {
+		other_tdp = planp->target_datap[i];
+		if (!(other_tdp->td_stream_type & XINT_STREAM_BACKGROUND))
+			tdp->td_stream_foregroundpp[tdp->td_stream_foregrounds++] = other_tdp;
+	}
+} // End of xdd_stream_before_pass()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_init_target_data_before_pass() - Reset variables to known state
  * 
@@ -209,6 +312,7 @@ xdd_init_target_data_before_pass(target_data_t *tdp) {
 	tdp->td_counters.tc_current_error_count = 0;		// The number of I/O errors for this Worker Thread
 	//
 	// Longest and shortest op times - RESET AT THE START OF EACH PASS
+	xint_lh_reset(&tdp->td_latency_hist);
 	if (tdp->td_esp) {
 		tdp->td_esp->my_longest_op_time = 0;			// Longest op time that occured during this pass
 		tdp->td_esp->my_longest_op_number = 0; 		// Number of the operation where the longest op time occured during this pass
@@ -246,6 +350,9 @@ xdd_init_target_data_before_pass(target_data_t *tdp) {
 		if (tdp->td_counters.tc_pass_number == 1) 
 			times(&wdp->wd_counters.tc_starting_cpu_times_this_run);
 		times(&wdp->wd_counters.tc_starting_cpu_times_this_pass);
+		xint_lh_reset(&wdp->wd_latency_hist);
+		if (wdp->wd_rsm_statsp)
+			memset(wdp->wd_rsm_statsp, 0, tdp->td_rsmp->rsm_classes * sizeof(xint_reqsize_stats_t));
 		wdp = wdp->wd_next_wdp;
 	}
 	
@@ -283,6 +390,18 @@ xdd_target_ttd_before_pass(target_data_t *tdp) {
 	// End-to-End setup
 	xdd_e2e_before_pass(tdp);
 
+	// Throttle setup
+	xdd_throttle_before_pass(tdp);
+
+	// Open-loop arrival setup
+	xdd_arrival_before_pass(tdp);
+
+	// Trace replay setup
+	xdd_replay_before_pass(tdp);
+
+	// Workload stream setup
+	xdd_stream_before_pass(tdp);
+
 	xdd_init_target_data_before_pass(tdp);
 
 	return(0);
@@ -18,11 +18,52 @@
 /*----------------------------------------------------------------------------*/
 /* xdd_verify_checksum() - Verify data checksum of the data buffer  
  * Returns the number of miscompare errors.
+ * Each whole block of the buffer is expected to end with the CRC32C of its
+ * byte offset and contents as put there by xdd_checksum_stamp() when the
+ * data was written with "-verify checksum". A block whose checksum does not
+ * match is counted as one error and reported with its byte offset.
  */
 int32_t
 xdd_verify_checksum(worker_data_t *wdp, int64_t current_op) {
-	fprintf(xgp->errout, "%s: xdd_verify_checksum: ERROR: NOT IMPLEMENTED YET\n", xgp->progname);
-	return(0);
+	target_data_t	*tdp;
+	int32_t			errors;
+	size_t			done;			// Number of bytes of the buffer checked so far
+	int64_t			block_offset;	// Byte offset of the block being checked
+	uint32_t		expected;		// Checksum worked out from the block
+	uint32_t		stored;			// Checksum found at the end of the block
+
+
+	tdp = wdp->wd_tdp;
+
+	errors = 0;
+	for (done = 0; done + tdp->td_block_size <= wdp->wd_task.task_xfer_size; done += tdp->td_block_size) {
+		block_offset = wdp->wd_task.task_byte_offset + (int64_t)done;
+		expected = xdd_checksum_block(wdp->wd_task.task_datap + done, tdp->td_block_size, block_offset);
+		stored = xdd_checksum_get(wdp->wd_task.task_datap + done, tdp->td_block_size);
+		if (expected == stored)
+			continue;
+		if ((uint64_t)errors < xgp->max_errors_to_print) {
+			fprintf(xgp->errout,"%s: xdd_verify_checksum: Target %d Worker Thread %d: ERROR: Checksum mismatch on op number %lld in block %lld at byte offset %lld, expected 0x%08x, got 0x%08x\n",
+				xgp->progname, 
+				tdp->td_target_number, 
+				wdp->wd_worker_number, 
+				(long long int)current_op,
+				(long long int)(block_offset/tdp->td_block_size), 
+				(long long int)block_offset, 
+				expected, 
+				stored);
+		}
+		errors++;
+	}
+	//print out remaining error count if exceeded max
+	if ((uint64_t)errors > xgp->max_errors_to_print) {
+		fprintf(xgp->errout,"%s: xdd_verify_checksum: Target %d Worker Thread %d: ERROR: ADDITIONAL Checksum mismatches = %lld\n",
+			xgp->progname, 
+			tdp->td_target_number, 
+			wdp->wd_worker_number, 
+			(long long int)(errors - (xgp->max_errors_to_print)));
+	}
+	return(errors);
 } // end of xdd_verify_checksum()
 
 /*----------------------------------------------------------------------------*/
@@ -54,6 +95,10 @@ xdd_verify_hex(worker_data_t *wdp, int64_t current_op) {
 		remaining = wdp->wd_task.task_xfer_size;
 	else remaining = tdp->td_dpp->data_pattern_length;
 
+	// Quick check of the whole buffer - only walk through it byte by byte if something is wrong
+	if (xdd_dp_replicate_check(wdp->wd_task.task_datap, remaining, tdp->td_dpp->data_pattern, tdp->td_dpp->data_pattern_length) == 0)
+		return(0);
+
 	offset = 0;
 	bufferp = wdp->wd_task.task_datap;
 	errors = 0;
@@ -99,14 +144,31 @@ xdd_verify_sequence(worker_data_t *wdp, int64_t current_op) {
 	uint64_t	  		errors;
 	uint64_t 		expected_data;
 	uint64_t 		*uint64p;
+	uint64_t 		orval;		// The pattern prefix if there is one
+	uint64_t 		xorval;		// All 1's for the inverse pattern
+	size_t  		words;		// Number of 8-byte words to check
+	size_t  		first;		// Index of the first word that does not match
 	unsigned char 	*ucp;        /* A temporary unsigned char pointer */
  
 
 	tdp = wdp->wd_tdp;
 
-	uint64p = (uint64_t *)wdp->wd_task.task_datap;
+	// Find the first word that does not match - if there is one then the rest of 
+	// the buffer is checked one word at a time to report all the mismatches
+	orval = 0;
+	if (tdp->td_dpp->data_pattern_options & DP_PATTERN_PREFIX) // OR-in the pattern prefix
+		orval = tdp->td_dpp->data_pattern_prefix_binary;
+	if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
+		xorval = 0xffffffffffffffffLL; // 1's compliment of the expected data 
+	else xorval = 0;
+	words = (wdp->wd_task.task_xfer_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+	first = xdd_dp_sequence_check((uint64_t *)wdp->wd_task.task_datap, words, wdp->wd_task.task_byte_offset, orval, xorval);
+	if (first == words)
+		return(0);
+
+	uint64p = (uint64_t *)wdp->wd_task.task_datap + first;
 	errors = 0;
-	for (i = 0; i < wdp->wd_task.task_xfer_size; i+=(sizeof(wdp->wd_task.task_byte_offset))) {
+	for (i = first * sizeof(uint64_t); i < wdp->wd_task.task_xfer_size; i+=(sizeof(wdp->wd_task.task_byte_offset))) {
 		expected_data = wdp->wd_task.task_byte_offset + i;
 		if (tdp->td_dpp->data_pattern_options & DP_PATTERN_PREFIX) { // OR-in the pattern prefix
 			expected_data |= tdp->td_dpp->data_pattern_prefix_binary;
@@ -167,6 +229,10 @@ xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op) {
 
 	tdp = wdp->wd_tdp;
 
+	// Quick check of the whole buffer - only walk through it byte by byte if something is wrong
+	if (xdd_dp_replicate_check(wdp->wd_task.task_datap, wdp->wd_task.task_xfer_size, tdp->td_dpp->data_pattern, 1) == 0)
+		return(0);
+
 	ucp = wdp->wd_task.task_datap;
 	errors = 0;
 	for (i = 0; i < wdp->wd_task.task_xfer_size; i++) {
@@ -189,13 +255,68 @@ xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op) {
 
 } // end of xdd_verify_singlechar() 
 
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_generated() - Verify data contents of a random or reducible data pattern
+ * Returns the number of miscompare errors. 
+ * The contents of these data patterns are worked out from the seed, the target
+ * number, the pass number and the op number, so the block that was written
+ * is made again in a scratch buffer and compared with the block that was read.
+ * The same seed and the same number of passes have to be used for a reducible
+ * data pattern to be verified in a later run.
+ */
+int32_t
+xdd_verify_generated(worker_data_t *wdp, int64_t current_op) {
+	target_data_t	*tdp;
+	unsigned char	*expectedp;		// What the buffer should look like
+	unsigned char	*ucp;
+	size_t			i;
+	int32_t			errors;
+ 
+
+	tdp = wdp->wd_tdp;
+	expectedp = malloc(wdp->wd_task.task_xfer_size);
+	if (expectedp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_verify_generated: Target %d Worker Thread %d: ERROR: Cannot allocate %lld bytes for the expected contents of op number %lld. No verification possible.\n",
+			xgp->progname, 
+			tdp->td_target_number, 
+			wdp->wd_worker_number, 
+			(long long int)wdp->wd_task.task_xfer_size,
+			(long long int)current_op);
+		return(0);
+	}
+	xdd_datapattern_generate(tdp, expectedp, wdp->wd_task.task_xfer_size, tdp->td_counters.tc_pass_number, current_op);
+
+	errors = 0;
+	if (memcmp(expectedp, wdp->wd_task.task_datap, wdp->wd_task.task_xfer_size)) {
+		ucp = wdp->wd_task.task_datap;
+		for (i = 0; i < wdp->wd_task.task_xfer_size; i++) {
+			if (ucp[i] != expectedp[i]) {
+				if ((uint64_t)errors < xgp->max_errors_to_print) 
+					fprintf(xgp->errout,"%s: xdd_verify_generated: Target %d Worker Thread %d: ERROR: Content mismatch on op number %lld at %zd bytes into block %lld, expected 0x%02x, got 0x%02x\n",
+						xgp->progname, 
+						tdp->td_target_number, 
+						wdp->wd_worker_number, 
+						(long long int)current_op,
+						i, 
+						(unsigned long long)(wdp->wd_task.task_byte_offset/tdp->td_block_size), 
+						expectedp[i], 
+						ucp[i]);
+				errors++;
+			}
+		}
+	}
+	free(expectedp);
+	return(errors);
+
+} // end of xdd_verify_generated() 
+
 /*----------------------------------------------------------------------------*/
 /* xdd_verify_contents() - Verify data contents  
  * Returns the number of miscompare errors.
  * There are various kinds of data patterns that xdd can read back for comparison. 
  * The user is responsible for using xdd to write the desired data pattern to the device 
  * and then request the proper verification / data pattern.
- * The  data patterns currently supported are: single byte data, hex digits, ascii strings, and 8-byte sequence numbers. 
+ * The  data patterns currently supported are: single byte data, hex digits, ascii strings, 8-byte sequence numbers, and the random and reducible data patterns. 
  * There is a separate subroutine in this file that handles the verification for each type of data pattern.
  * The subroutine names are obvious. If not, you should not be reading this.
  */
@@ -223,6 +344,11 @@ xdd_verify_contents(worker_data_t *wdp, int64_t current_op) {
 		return(errors);
 	}
 
+	if (tdp->td_dpp->data_pattern_options & (DP_RANDOM_PATTERN | DP_RANDOM_BY_TARGET_PATTERN | DP_REDUCIBLE_PATTERN)) { // Lets make the random data again
+		errors = xdd_verify_generated(wdp, current_op);
+		return(errors);
+	}
+
 	// If we get here then the data pattern was either not specified or the data pattern type was not recognized.
 	fprintf(xgp->errout, "%s: xdd_verify_contents: Target %d Worker Thread %d: ERROR: Data verification request not understood. No verification possible.\n",
 				xgp->progname, 
@@ -251,14 +377,14 @@ xdd_verify_location(worker_data_t *wdp, int64_t current_op) {
 
 	errors = 0;
 	current_position = *(uint64_t *)wdp->wd_task.task_datap;
-	if (current_position != tdp->td_counters.tc_current_byte_offset) {
+	if (current_position != (uint64_t)wdp->wd_task.task_byte_offset) {
 		errors++;
 		fprintf(xgp->errout,"%s: xdd_verify_location: Target %d Worker Thread %d: ERROR: op number %lld: Data Buffer Sequence mismatch - expected %lld, got %lld\n",
 			xgp->progname, 
 			tdp->td_target_number, 
 			wdp->wd_worker_number, 
-			(long long int)tdp->td_counters.tc_current_op_number, 
-			(long long int)tdp->td_counters.tc_current_byte_offset, 
+			(long long int)current_op, 
+			(long long int)wdp->wd_task.task_byte_offset, 
 			(long long int)current_position);
 
 		fflush(xgp->errout);
@@ -282,8 +408,8 @@ xdd_verify(worker_data_t *wdp, int64_t current_op) {
 	* was specified. If so, then we need to verify that what we read has the correct 
 	* sequence number(s) in it.
 	*/
-	if (!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION))) { // If we don't need to verify location or contents of the buffer, then just return.
-		fprintf(xgp->errout,"%s: xdd_verify: Target %d Worker Thread %d: ERROR: Data verification type <location or contents> not specified - No verification performed.\n",
+	if (!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM))) { // If we don't need to verify location or contents of the buffer, then just return.
+		fprintf(xgp->errout,"%s: xdd_verify: Target %d Worker Thread %d: ERROR: Data verification type <location, contents, or checksum> not specified - No verification performed.\n",
 			xgp->progname,
 			tdp->td_target_number,
 			wdp->wd_worker_number);
@@ -291,7 +417,9 @@ xdd_verify(worker_data_t *wdp, int64_t current_op) {
 	}
 
 	// Looks like we need to verify something...
-	if (tdp->td_target_options & TO_VERIFY_LOCATION) /* Assumes that the data pattern was sequenced. If not, there will be LOTS o' errors. */
+	if (tdp->td_target_options & TO_VERIFY_CHECKSUM)
+		 errors = xdd_verify_checksum(wdp, current_op);
+	else if (tdp->td_target_options & TO_VERIFY_LOCATION) /* Assumes that the data pattern was sequenced. If not, there will be LOTS o' errors. */
 		 errors = xdd_verify_location(wdp, current_op);
 	else errors = xdd_verify_contents(wdp, current_op);
 
@@ -0,0 +1,278 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that implement the "-workerpool" option.
+ * Instead of starting queue-depth Worker Threads for every target, a fixed
+ * number of Pool Threads is started once for the whole plan and the Worker
+ * Data Structs of the targets become "contexts" that are handed to whichever
+ * Pool Thread is free. Each Worker Data Struct still has its own I/O buffer,
+ * counters, time stamp entries and TOT bookkeeping so the per-target results
+ * are exactly the same as with dedicated Worker Threads.
+ *
+ * Only targets that use the lock-free ring of available Worker Threads are
+ * run by the pool. E2E and lockstep targets keep their dedicated Worker 
+ * Threads because their Worker Threads block on the network or on the other
+ * target for as long as it takes, which would tie up the pool.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xint_worker_pool_get() - Take the next task off the queue of Pool Thread
+ * "me" or, if that queue is empty, steal one from the queue of another Pool
+ * Thread. If there is nothing to do anywhere the Pool Thread spins for a
+ * short while and then sleeps in a futex until a task is put on any queue.
+ */
+static worker_data_t *
+xint_worker_pool_get(xint_worker_pool_t *poolp, int32_t me) {
+	struct xint_worker_pool_queue	*qp;		// Queue being looked at
+	worker_data_t					*wdp;		// Task taken off the queue
+	uint32_t						signal;		// Snapshot of the futex word
+	int32_t							i;
+	int								spin;		// Number of polls before sleeping
+	int								spin_limit;	// Number of polls allowed before sleeping
+
+
+	spin = 0;
+	spin_limit = xint_handoff_spin_count();
+	while (1) {
+		for (i = 0; i < poolp->pool_threads; i++) {
+			qp = &poolp->pool_queues[(me + i) % poolp->pool_threads];
+			if (__atomic_load_n(&qp->queue_count, __ATOMIC_ACQUIRE) == 0)
+				continue;
+			pthread_mutex_lock(&qp->queue_mutex);
+			wdp = qp->queue_firstp;
+			if (wdp) {
+				qp->queue_firstp = wdp->wd_pool_nextp;
+				if (qp->queue_firstp == NULL)
+					qp->queue_lastp = NULL;
+				__atomic_sub_fetch(&qp->queue_count, 1, __ATOMIC_RELEASE);
+			}
+			pthread_mutex_unlock(&qp->queue_mutex);
+			if (wdp) 
+				return(wdp);
+		}
+		if (spin < spin_limit) {
+			spin++;
+			XINT_CPU_RELAX();
+			continue;
+		}
+		// Nothing showed up while spinning so go to sleep until a task is put on a queue
+		signal = __atomic_load_n(&poolp->pool_signal, __ATOMIC_SEQ_CST);
+		__atomic_add_fetch(&poolp->pool_waiting, 1, __ATOMIC_SEQ_CST);
+		for (i = 0; i < poolp->pool_threads; i++) 
+			if (__atomic_load_n(&poolp->pool_queues[i].queue_count, __ATOMIC_SEQ_CST))
+				break;
+		if (i == poolp->pool_threads)
+			xint_futex_wait(&poolp->pool_signal, signal);
+		__atomic_sub_fetch(&poolp->pool_waiting, 1, __ATOMIC_SEQ_CST);
+		spin = 0;
+	}
+} // End of xint_worker_pool_get()
+
+/*----------------------------------------------------------------------------*/
+/* xint_worker_pool_thread() - This is the Pool Thread routine. It runs the
+ * tasks of any target that uses the pool, one at a time, forever.
+ * Like the Worker Threads, the Pool Threads are not joined; they go away 
+ * when xdd exits.
+ */
+static void *
+xint_worker_pool_thread(void *pin) {
+	struct xint_worker_pool_queue	*qp;		// The queue of this Pool Thread
+	xint_worker_pool_t				*poolp;		// The pool
+	worker_data_t					*wdp;		// The task to run
+	int32_t							me;			// Number of this Pool Thread
+	int32_t							thread_id;	// System ID of this Pool Thread for the time stamps
+
+
+	qp = (struct xint_worker_pool_queue *)pin;
+	poolp = qp->queue_poolp;
+	me = qp - poolp->pool_queues;
+#if (AIX)
+	thread_id = thread_self();
+#elif (LINUX)
+	thread_id = syscall(SYS_gettid);
+#else
+	thread_id = getpid();
+#endif
+
+	while (1) {
+		wdp = xint_worker_pool_get(poolp, me);
+		wdp->wd_thread_id = thread_id;
+		xdd_worker_thread_do_task(wdp);
+	}
+	return(0);
+} // End of xint_worker_pool_thread()
+
+/*----------------------------------------------------------------------------*/
+/* xint_worker_pool_init() - Create the shared Worker Thread pool and start
+ * its Pool Threads. This is done once per plan, before the Target Threads
+ * are started. Nothing is done unless "-workerpool" was specified.
+ *
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_worker_pool_init(xdd_plan_t *planp) {
+	xint_worker_pool_t	*poolp;		// Pointer to the pool
+	pthread_attr_t		attr;		// Pool Thread attributes
+	int32_t				i;
+	int32_t				status;
+
+
+	planp->worker_poolp = NULL;
+	if (planp->worker_pool_threads <= 0)
+		return(0);
+
+	poolp = malloc(sizeof(xint_worker_pool_t));
+	if (poolp == NULL) {
+		fprintf(xgp->errout,"%s: xint_worker_pool_init: ERROR: Cannot allocate %d bytes of memory for the Worker Thread pool\n",
+			xgp->progname,
+			(int)sizeof(xint_worker_pool_t));
+		return(-1);
+	}
+	memset(poolp, 0, sizeof(xint_worker_pool_t));
+	poolp->pool_threads = planp->worker_pool_threads;
+	poolp->pool_queues = malloc(poolp->pool_threads * sizeof(struct xint_worker_pool_queue));
+	poolp->pool_threadp = malloc(poolp->pool_threads * sizeof(pthread_t));
+	if ((poolp->pool_queues == NULL) || (poolp->pool_threadp == NULL)) {
+		fprintf(xgp->errout,"%s: xint_worker_pool_init: ERROR: Cannot allocate memory for %d Pool Threads\n",
+			xgp->progname,
+			poolp->pool_threads);
+		if (poolp->pool_queues)
+			free(poolp->pool_queues);
+		if (poolp->pool_threadp)
+			free(poolp->pool_threadp);
+		free(poolp);
+		return(-1);
+	}
+	memset(poolp->pool_queues, 0, poolp->pool_threads * sizeof(struct xint_worker_pool_queue));
+	for (i = 0; i < poolp->pool_threads; i++) {
+		pthread_mutex_init(&poolp->pool_queues[i].queue_mutex, NULL);
+		poolp->pool_queues[i].queue_poolp = poolp;
+	}
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	for (i = 0; i < poolp->pool_threads; i++) {
+		status = pthread_create(&poolp->pool_threadp[i], &attr, xint_worker_pool_thread, &poolp->pool_queues[i]);
+		if (status) {
+			fprintf(xgp->errout,"%s: xint_worker_pool_init: ERROR: Cannot create Pool Thread %d of %d - Error number %d\n",
+				xgp->progname,
+				i,
+				poolp->pool_threads,
+				status);
+			fflush(xgp->errout);
+			errno = status;
+			perror("Reason");
+			pthread_attr_destroy(&attr);
+			return(-1);
+		}
+	}
+	pthread_attr_destroy(&attr);
+	planp->worker_poolp = poolp;
+
+	if (xgp->global_options & GO_REALLYVERBOSE) 
+		fprintf(xgp->errout,"%s: xint_worker_pool_init: %d Pool Threads started\n",
+			xgp->progname,
+			poolp->pool_threads);
+	return(0);
+} // End of xint_worker_pool_init()
+
+/*----------------------------------------------------------------------------*/
+/* xint_worker_pool_attach() - Decide whether the tasks of this target are run
+ * by the shared Worker Thread pool. This must be called after the ring of
+ * available Worker Threads has been set up and before the Worker Threads are
+ * started.
+ */
+void
+xint_worker_pool_attach(target_data_t *tdp) {
+
+	tdp->td_worker_poolp = NULL;
+	if (tdp->td_worker_ringp == NULL)
+		return;
+	tdp->td_worker_poolp = tdp->td_planp->worker_poolp;
+} // End of xint_worker_pool_attach()
+
+/*----------------------------------------------------------------------------*/
+/* xint_worker_pool_add_worker() - Initialize a Worker Data Struct of a pooled
+ * target so that it is ready to be handed to the pool. This does the same 
+ * thing as the start of xdd_worker_thread() except that it runs in the Target 
+ * Thread and no thread is created.
+ * The tasks of a target with storage ordering all go to one queue so that
+ * they are started in the order they were issued, which guarantees that the
+ * operation a Pool Thread waits for is already running on another Pool Thread.
+ * The tasks of other targets are spread over all the queues.
+ *
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_worker_pool_add_worker(target_data_t *tdp, worker_data_t *wdp) {
+	xint_worker_pool_t	*poolp;		// Pointer to the pool
+	int32_t				status;
+
+
+	poolp = tdp->td_worker_poolp;
+	if (tdp->td_target_options & (TO_ORDERING_STORAGE_SERIAL | TO_ORDERING_STORAGE_LOOSE))
+		wdp->wd_pool_home = tdp->td_target_number % poolp->pool_threads;
+	else wdp->wd_pool_home = (tdp->td_target_number + wdp->wd_worker_number) % poolp->pool_threads;
+	wdp->wd_pool_nextp = NULL;
+
+	status = xdd_worker_thread_init(wdp);
+	if (status != 0) {
+		fprintf(xgp->errout,"%s: xint_worker_pool_add_worker: Aborting target due to previous initialization failure for Target number %d name '%s' WorkerThread %d.\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname,
+			wdp->wd_worker_number);
+		fflush(xgp->errout);
+		xgp->abort = 1;
+		return(-1);
+	}
+	return(0);
+} // End of xint_worker_pool_add_worker()
+
+/*----------------------------------------------------------------------------*/
+/* xint_worker_pool_put() - Hand the task that has been set up in wd_task to
+ * the pool by putting the Worker Data Struct on its home queue, and wake up
+ * a Pool Thread if they are all sleeping.
+ * This subroutine is called by the Target Thread.
+ */
+void
+xint_worker_pool_put(xint_worker_pool_t *poolp, worker_data_t *wdp) {
+	struct xint_worker_pool_queue	*qp;		// The home queue of this Worker Data Struct
+
+
+	qp = &poolp->pool_queues[wdp->wd_pool_home];
+	wdp->wd_pool_nextp = NULL;
+	pthread_mutex_lock(&qp->queue_mutex);
+	if (qp->queue_lastp)
+		qp->queue_lastp->wd_pool_nextp = wdp;
+	else qp->queue_firstp = wdp;
+	qp->queue_lastp = wdp;
+	__atomic_add_fetch(&qp->queue_count, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&qp->queue_mutex);
+
+	__atomic_add_fetch(&poolp->pool_signal, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&poolp->pool_waiting, __ATOMIC_SEQ_CST))
+		xint_futex_wake(&poolp->pool_signal, 1);
+} // End of xint_worker_pool_put()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -12,6 +12,128 @@
  */
 #include "xint.h"
 
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_thread_do_task() - Perform the task that the Target Thread handed
+ * to this WorkerThread and then make the WorkerThread available again.
+ * This is called by the WorkerThread itself or, when the target uses the 
+ * shared Worker Thread pool, by whichever Pool Thread picked up the task.
+ * Return value is 1 if this was a STOP request, otherwise 0.
+ */
+int32_t
+xdd_worker_thread_do_task(worker_data_t *wdp) {
+	int32_t  		status; 	// Status of various system calls
+	target_data_t	*tdp;		// Pointer to this WorkerThread's Target Data Struct
+	nclk_t			checktime;
+
+
+	tdp = wdp->wd_tdp;
+	status = 0;
+	// Look at Task request 
+	switch (wdp->wd_task.task_request) {
+		case TASK_REQ_IO:
+			// Perform the requested I/O operation
+			xdd_worker_thread_io(wdp);
+			break;
+		case TASK_REQ_REOPEN:
+			// Reopen the target as requested
+			xdd_target_reopen(wdp->wd_tdp);
+			break;
+		case TASK_REQ_STOP:
+			// This indicates that we should clean up and exit this subroutine
+			xdd_worker_thread_cleanup(wdp);
+			return(1);
+		case TASK_REQ_EOF:
+			// E2E Source Side only - send EOF packets to Destination 
+			status = xdd_e2e_eof_source_side(wdp);
+			if (status) // Only set the status in the Target Data Struct if it is non-zero
+				tdp->td_counters.tc_current_io_status = status;
+			break;
+		default:
+			// Technically, we should never see this....
+			fprintf(xgp->errout,"%s: xdd_worker_thread_do_task: WARNING: Target number %d name '%s' WorkerThread %d - unknown work request: 0x%x.\n",
+				xgp->progname,
+				tdp->td_target_number,
+				tdp->td_target_full_pathname,
+				wdp->wd_worker_number,
+				wdp->wd_task.task_request);
+			break;
+	} // End of SWITCH stmnt that determines the TASK
+	
+	
+// Time stamp if requested
+//		if (p->tsp->ts_options & (TS_ON | TS_TRIGGERED)) {
+//			// Record the amount of system and user time used so far...
+//			status = getrusage(RUSAGE_THREAD, &usage);
+//			errno_save = errno;
+//			if (status) {
+//				fprintf(xgp->errout,"%s: xdd_worker_thread_do_task: WARNING: Target number %d name '%s' WorkerThread %d - calle to getrusage failed\n",
+//					xgp->progname,
+//					wdp->my_target_number,
+//					wdp->target_full_pathname,
+//					wdp->my_worker_thread_number);
+//				errno = errno_save;
+//				perror("Reason");
+//			}
+//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_utime.tv_sec  = usage.ru_utime.tv_sec;
+//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_utime.tv_usec = usage.ru_utime.tv_usec;
+//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_stime.tv_sec  = usage.ru_stime.tv_sec;
+//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_stime.tv_usec = usage.ru_stime.tv_usec;
+//			p->ttp->tte[wdp->tsp->ts_current_entry].nvcsw = usage.ru_nvcsw;
+//			p->ttp->tte[wdp->tsp->ts_current_entry].nivcsw = usage.ru_nivcsw;
+//		}
+
+	// Hand the time stamp entry for this task to the flusher if streaming
+	xdd_ts_commit_entry(wdp);
+
+	// Mark this WorkerThread Available
+	if (tdp->td_worker_ringp) {
+		// Put this WorkerThread back on the ring of available WorkerThreads
+		__atomic_and_fetch(&wdp->wd_worker_thread_target_sync, ~WTSYNC_BUSY, __ATOMIC_RELAXED);
+		xdd_worker_ring_put(tdp, wdp);
+		return(0);
+	}
+	pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
+	nclk_now(&checktime);
+	wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this WorkerThread NOT Busy
+	if (wdp->wd_worker_thread_target_sync & WTSYNC_TARGET_WAITING) {
+	    // Release the target that is waiting on this WorkerThread
+	    //status = sem_post(&wdp->this_worker_thread_is_available_sem);
+	    status = pthread_cond_broadcast(&wdp->wd_this_worker_thread_is_available_condition);
+	    if (status) {
+		fprintf(xgp->errout,"%s: xdd_worker_thread_do_task: Target %d WorkerThread %d: WARNING: Bad status from sem_post on this_worker_thread_is_available semaphore: status=%d, errno=%d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			status,
+			errno);
+	    }
+		// Turn off the TARGET_WAITING Flag
+		wdp->wd_worker_thread_target_sync &= ~WTSYNC_TARGET_WAITING; 
+	}
+
+	nclk_now(&checktime);
+	
+	// Unlock the worker_thread-target synchronization mutex
+	pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+
+	// Release the WorkerThread Locator which might be waiting for ANY available WorkerThread
+	pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
+	tdp->td_any_worker_thread_available++;
+	status = pthread_cond_broadcast(&tdp->td_any_worker_thread_available_condition);
+	pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_worker_thread_do_task: Target %d WorkerThread %d: WARNING: Bad status from sem_post on sem_any_worker_thread_available semaphore: status=%d, errno=%d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			status,
+			errno);
+	}
+
+	return(0);
+
+} // End of xdd_worker_thread_do_task()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_worker_thread() - This is the WorkerThread routine that actually performs I/O
  * on behalf of a Target thread.
@@ -56,104 +178,14 @@ xdd_worker_thread(void *pin) {
 	// The subroutine that is called for any particular task will set the "xgp->canceled" flag to
 	// indicate that there was a condition that warrants canceling the entire run
 	while (1) {
-		status = 0;
-		// Enter the WorkerThread_TargetPass_Wait barrier until we are assigned something to do by targetpass()
+		// Wait until we are assigned something to do by targetpass()
 		nclk_now(&checktime);
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&wdp->wd_occupant,1);
-
-		// Look at Task request 
-		switch (wdp->wd_task.task_request) {
-			case TASK_REQ_IO:
-				// Perform the requested I/O operation
-				xdd_worker_thread_io(wdp);
-				break;
-			case TASK_REQ_REOPEN:
-				// Reopen the target as requested
-				xdd_target_reopen(wdp->wd_tdp);
-				break;
-			case TASK_REQ_STOP:
-				// This indicates that we should clean up and exit this subroutine
-				xdd_worker_thread_cleanup(wdp);
-				return(0);
-			case TASK_REQ_EOF:
-				// E2E Source Side only - send EOF packets to Destination 
-				status = xdd_e2e_eof_source_side(wdp);
-				if (status) // Only set the status in the Target Data Struct if it is non-zero
-					tdp->td_counters.tc_current_io_status = status;
-				break;
-			default:
-				// Technically, we should never see this....
-				fprintf(xgp->errout,"%s: xdd_worker_thread: WARNING: Target number %d name '%s' WorkerThread %d - unknown work request: 0x%x.\n",
-					xgp->progname,
-					tdp->td_target_number,
-					tdp->td_target_full_pathname,
-					wdp->wd_worker_number,
-					wdp->wd_task.task_request);
-				break;
-		} // End of SWITCH stmnt that determines the TASK
-		
-		
-// Time stamp if requested
-//		if (p->tsp->ts_options & (TS_ON | TS_TRIGGERED)) {
-//			// Record the amount of system and user time used so far...
-//			status = getrusage(RUSAGE_THREAD, &usage);
-//			errno_save = errno;
-//			if (status) {
-//				fprintf(xgp->errout,"%s: xdd_worker_thread: WARNING: Target number %d name '%s' WorkerThread %d - calle to getrusage failed\n",
-//					xgp->progname,
-//					wdp->my_target_number,
-//					wdp->target_full_pathname,
-//					wdp->my_worker_thread_number);
-//				errno = errno_save;
-//				perror("Reason");
-//			}
-//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_utime.tv_sec  = usage.ru_utime.tv_sec;
-//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_utime.tv_usec = usage.ru_utime.tv_usec;
-//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_stime.tv_sec  = usage.ru_stime.tv_sec;
-//			p->ttp->tte[wdp->tsp->ts_current_entry].usage_stime.tv_usec = usage.ru_stime.tv_usec;
-//			p->ttp->tte[wdp->tsp->ts_current_entry].nvcsw = usage.ru_nvcsw;
-//			p->ttp->tte[wdp->tsp->ts_current_entry].nivcsw = usage.ru_nivcsw;
-//		}
-
-		// Mark this WorkerThread Available
-		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-		nclk_now(&checktime);
-		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this WorkerThread NOT Busy
-		if (wdp->wd_worker_thread_target_sync & WTSYNC_TARGET_WAITING) {
-		    // Release the target that is waiting on this WorkerThread
-		    //status = sem_post(&wdp->this_worker_thread_is_available_sem);
-		    status = pthread_cond_broadcast(&wdp->wd_this_worker_thread_is_available_condition);
-		    if (status) {
-			fprintf(xgp->errout,"%s: xdd_worker_thread: Target %d WorkerThread %d: WARNING: Bad status from sem_post on this_worker_thread_is_available semaphore: status=%d, errno=%d\n",
-				xgp->progname,
-				tdp->td_target_number,
-				wdp->wd_worker_number,
-				status,
-				errno);
-		    }
-			// Turn off the TARGET_WAITING Flag
-			wdp->wd_worker_thread_target_sync &= ~WTSYNC_TARGET_WAITING; 
-		}
-
-		nclk_now(&checktime);
-		
-		// Unlock the worker_thread-target synchronization mutex
-		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
-
-		// Release the WorkerThread Locator which might be waiting for ANY available WorkerThread
-		pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
-		tdp->td_any_worker_thread_available++;
-		status = pthread_cond_broadcast(&tdp->td_any_worker_thread_available_condition);
-		pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
-		if (status) {
-			fprintf(xgp->errout,"%s: xdd_worker_thread: Target %d WorkerThread %d: WARNING: Bad status from sem_post on sem_any_worker_thread_available semaphore: status=%d, errno=%d\n",
-				xgp->progname,
-				tdp->td_target_number,
-				wdp->wd_worker_number,
-				status,
-				errno);
-		}
+		xdd_worker_thread_wait_for_task(wdp);
 
+		// Perform the task - a STOP request means that this WorkerThread is done
+		status = xdd_worker_thread_do_task(wdp);
+		if (status)
+			return(0);
 	} // end of WHILE loop 
 
 } /* end of xdd_worker_thread() */
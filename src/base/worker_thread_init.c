@@ -26,7 +26,6 @@ int32_t
 xdd_worker_thread_init(worker_data_t *wdp) {
     int32_t  		status;
     target_data_t	*tdp;			// Pointer to this worker_thread's target Data Struct
-    char			tmpname[XDD_BARRIER_MAX_NAME_LENGTH];	// Used to create unique names for the barriers
 	unsigned char	*bufp;		// Generic Buffer pointer
 
 #if defined(HAVE_CPUSET_T) && defined(HAVE_PTHREAD_ATTR_SETAFFINITY_NP)
@@ -91,18 +90,17 @@ xdd_worker_thread_init(worker_data_t *wdp) {
 		return(-1);
 	}
 	
-	// Initialize the tot_wait structure 
-	status = pthread_cond_init(&wdp->wd_tot_wait.totw_condition, 0);
-	if (0 != status) {
-		fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: ERROR: Failed to initialize tot condition variable\n",
-			xgp->progname,
-			tdp->td_target_number,
-			wdp->wd_worker_number);
-		return(-1);
+	// Per-size statistics for the request size mix
+	if (tdp->td_rsmp) {
+		wdp->wd_rsm_statsp = calloc(tdp->td_rsmp->rsm_classes, sizeof(xint_reqsize_stats_t));
+		if (wdp->wd_rsm_statsp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: ERROR: Cannot allocate the request size mix statistics\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number);
+			return(-1);
+		}
 	}
-	wdp->wd_tot_wait.totw_wdp = wdp;
-	wdp->wd_tot_wait.totw_is_released = 0;
-	wdp->wd_tot_wait.totw_nextp = 0;
 
 	// Get the I/O buffer
 	// The xdd_init_io_buffers() routine will set wd_bufp and wd_buf_size to appropriate values.
@@ -168,17 +166,10 @@ xdd_worker_thread_init(worker_data_t *wdp) {
 	// Set proper data pattern in Data buffer
 	xdd_datapattern_buffer_init(wdp);
 
-	// Init the WorkerThread-TargetPass WAIT Barrier for this WorkerThread
-	sprintf(tmpname,"T%04d:W%04d>worker_thread_targetpass_wait_barrier",tdp->td_target_number,wdp->wd_worker_number);
-	status = xdd_init_barrier(tdp->td_planp, &wdp->wd_thread_targetpass_wait_for_task_barrier, 2, tmpname);
-	if (status) {
-		fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: ERROR: Cannot initialize WorkerThread TargetPass WAIT barrier.\n",
-			xgp->progname, 
-			tdp->td_target_number,
-			wdp->wd_worker_number);
-		fflush(xgp->errout);
-		return(-1);
-	}
+	// Init the doorbell that targetpass() uses to hand a task to this WorkerThread
+	wdp->wd_task_doorbell = 0;
+	wdp->wd_task_doorbell_seen = 0;
+	wdp->wd_task_waiting = 0;
 
 	// Initialize the worker_thread ordering 
 	status = pthread_cond_init(&wdp->wd_this_worker_thread_is_available_condition, 0);
@@ -192,17 +183,21 @@ xdd_worker_thread_init(worker_data_t *wdp) {
 	}
 
 	// Indicate to the Target Thread that this WorkerThread is available
-	pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
-	tdp->td_any_worker_thread_available++;
-	status = pthread_cond_broadcast(&tdp->td_any_worker_thread_available_condition);
-	pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
-	if (status) {
-		fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: WARNING: Bad status from sem_post on any_worker_thread_available semaphore: status=%d, errno=%d\n",
-			xgp->progname,
-			tdp->td_target_number,
-			wdp->wd_worker_number,
-			status,
-			errno);
+	if (tdp->td_worker_ringp) 
+		xdd_worker_ring_put(tdp, wdp);
+	else {
+		pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
+		tdp->td_any_worker_thread_available++;
+		status = pthread_cond_broadcast(&tdp->td_any_worker_thread_available_condition);
+		pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
+		if (status) {
+			fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: WARNING: Bad status from sem_post on any_worker_thread_available semaphore: status=%d, errno=%d\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				status,
+				errno);
+		}
 	}
 
 	// Set up for an End-to-End operation (if requested)
@@ -127,6 +127,10 @@ xdd_worker_thread_io(worker_data_t *wdp) {
 /*----------------------------------------------------------------------------*/
 /* xdd_worker_thread_wait_for_previous_io() - This subroutine will wait for
  * the previous Worker Thread I/O to complete.
+ * The previous op is complete when the sequence number in its TOT entry
+ * reaches its op number plus 1. The comparison is done on the signed 
+ * difference so that it keeps working when the 32-bit sequence wraps. This Worker Thread spins on the sequence
+ * number for a short while and then sleeps in a futex on it.
  * Return value of 0 is good, -1 indicates there was an error
  */
 int32_t
@@ -134,7 +138,10 @@ xdd_worker_thread_wait_for_previous_io(worker_data_t *wdp) {
 	target_data_t		*tdp;				// Pointer to the Target Data for this Worker Thread
 	int32_t		tot_offset;		// Offset into the TOT
 	tot_entry_t	*tep;			// Pointer to the TOT entry to use
-	tot_wait_t	*totwp,*tmpwp;	// A TOT Wait struct pointer
+	uint32_t	expected;		// The sequence number that the previous op will post
+	uint32_t	current;		// The sequence number currently in the TOT entry
+	int			spin;			// Number of polls before sleeping
+	int			spin_limit;		// Number of polls allowed before sleeping
 
 
 	tdp = wdp->wd_tdp;
@@ -144,107 +151,86 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worke
 	if (tot_offset < 0) 
 		tot_offset = tdp->td_totp->tot_entries - 1; // The last TOT_ENTRY
 	
-//	if (tdp->td_target_options & TO_E2E_DESTINATION) {
-//		if (tdp->td_counters.tc_current_op_number == 0)
-		if (wdp->wd_task.task_op_number == 0)
+	if (wdp->wd_task.task_op_number == 0)
 		return(0);	// Dont need to wait for op minus 1 ;)
-//	} else {
-//		if (tdp->td_counters.tc_current_op_number == 0)
-//			return(0);	// Dont need to wait for op minus 1 ;)
-//	}
-
 
 	tep = &tdp->td_totp->tot_entry[tot_offset];
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS;
-	pthread_mutex_lock(&tep->tot_mutex);
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS;
-	nclk_now(&tep->tot_wait_ts);
+	expected = (uint32_t)wdp->wd_task.task_op_number; // (op number - 1) + 1
+	current = __atomic_load_n(&tep->tot_sequence, __ATOMIC_ACQUIRE);
+	if ((int32_t)(current - expected) >= 0)
+		return(0);
 
+	nclk_now(&tep->tot_wait_ts);
+	tep->tot_wait_worker_thread_number = wdp->wd_worker_number;
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: tot_offset: %d: I AM WAITING FOR PREVIOUS IO starting at %lld\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,(long long int)tep->tot_wait_ts);
 if (xgp->global_options & GO_DEBUG_TOT) xdd_show_tot_entry(tdp->td_totp,tot_offset);
 	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO;
-
-	totwp = &wdp->wd_tot_wait;
-	if (TOT_ENTRY_UNAVAILABLE == tep->tot_status) {
-		if (tep->tot_waitp == 0) 
-			tep->tot_waitp = totwp;
-		else { // Put this worker thread at the end of the chain
-			tmpwp = tep->tot_waitp;
-			while (tmpwp->totw_nextp != 0) 
-				tmpwp = tmpwp->totw_nextp;
-			tmpwp->totw_nextp = totwp;
-		}
-		// Wait for this tot_entry to become available
-		while (1 != totwp->totw_is_released) {
-	    	pthread_cond_wait(&totwp->totw_condition, &tep->tot_mutex);
+	spin = 0;
+	spin_limit = xint_handoff_spin_count();
+	while ((int32_t)(current - expected) < 0) {
+		if (spin < spin_limit) {
+			spin++;
+			XINT_CPU_RELAX();
+		} else {
+			__atomic_add_fetch(&tep->tot_waiters, 1, __ATOMIC_SEQ_CST);
+			current = __atomic_load_n(&tep->tot_sequence, __ATOMIC_SEQ_CST);
+			if ((int32_t)(current - expected) < 0) 
+				xint_futex_wait(&tep->tot_sequence, current);
+			__atomic_sub_fetch(&tep->tot_waiters, 1, __ATOMIC_SEQ_CST);
 		}
-		totwp->totw_is_released = 0; 
+		current = __atomic_load_n(&tep->tot_sequence, __ATOMIC_ACQUIRE);
 	}
 	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO;
-	tep->tot_status = TOT_ENTRY_UNAVAILABLE;
-	pthread_mutex_unlock(&tep->tot_mutex);
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: tot_offset: %d: I AM DONE WAITING FOR PREVIOUS IO - released by worker %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,tep->tot_post_worker_thread_number);
 
 	return(0);
 } // End of xdd_worker_thread_wait_for_previous_io()
 
 /*----------------------------------------------------------------------------*/
-/* xdd_worker_thread_release_next_io() - This subroutine will check to
- * see if we need to release the next Worker Thread that might be waiting for
- * this Worker Thread to complete. 
+/* xdd_worker_thread_release_next_io() - This subroutine will release the
+ * Worker Thread doing the next op by posting this op's sequence number
+ * to its TOT entry. The next Worker Thread is only woken up through the 
+ * kernel if it has gone to sleep waiting for us.
  * 
  * Return value of 0 is good, -1 indicates there was an error
  */
 int32_t
 xdd_worker_thread_release_next_io(worker_data_t *wdp) {
-	int32_t 	status;
 	target_data_t		*tdp;				// Pointer to the Target Data for this Worker Thread
 	int32_t		tot_offset;		// Offset into the TOT
 	tot_entry_t	*tep;			// Pointer to the TOT entry to use
-	tot_wait_t	*totwp;			// A TOT Wait struct pointer
+	uint32_t	sequence;		// The sequence number to post for this op
+	uint32_t	current;		// The sequence number currently in the TOT entry
 
 
 	tdp = wdp->wd_tdp;
 	tot_offset = (wdp->wd_task.task_op_number % tdp->td_totp->tot_entries);
 
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: task_op_number: %lld: tot_offset: %d: ENTER\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)wdp->wd_task.task_op_number,tot_offset);
-	// Wait for the I/O operation ahead of this one to complete (if necessary)
 
 	tep = &tdp->td_totp->tot_entry[tot_offset];
-	totwp = &wdp->wd_tot_wait;
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE;
-	pthread_mutex_lock(&tep->tot_mutex);
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE;
+	// Update the TOT Entry record of this op - these are published by the store of the sequence number below
 	tep->tot_post_worker_thread_number = wdp->wd_worker_number;
 	nclk_now(&tep->tot_post_ts);
-
-if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: task_op_number: %lld: tot_offset: %d: RELEASING worker number %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)wdp->wd_task.task_op_number,tot_offset,tep->tot_wait_worker_thread_number);
-	// Update the TOT Entry counters
-	nclk_now(&tep->tot_update_ts);
+	tep->tot_update_ts = tep->tot_post_ts;
 	tep->tot_update_worker_thread_number = wdp->wd_worker_number;
 	tep->tot_op_number = wdp->wd_task.task_op_number;
 	tep->tot_byte_offset = wdp->wd_task.task_byte_offset;
 	tep->tot_io_size = wdp->wd_task.task_xfer_size;
-	tep->tot_status = TOT_ENTRY_AVAILABLE;
-	pthread_mutex_unlock(&tep->tot_mutex); //TMR
-	if (tep->tot_waitp) { // Check to see if another Worker is waiting for this tot entry
-		totwp = tep->tot_waitp;
-		tep->tot_waitp = totwp->totw_nextp;
-		totwp->totw_is_released = 1;
-		totwp->totw_nextp = 0;
-		status = pthread_cond_signal(&totwp->totw_condition);
-		if (status) {
-			fprintf(xgp->errout,"%s: xdd_worker_thread_release_next_io: Target %d Worker Thread %d: ERROR: Bad status from pthread_cond_signal: status=%d, errno=%d, task_op_number=%lld, tot_offset=%d\n",
-				xgp->progname,
-				tdp->td_target_number,
-				wdp->wd_worker_number,
-				status,
-				errno,
-				(long long int)wdp->wd_task.task_op_number,
-				tot_offset);
-			return(-1);
-		}
+
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: task_op_number: %lld: tot_offset: %d: RELEASING worker number %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)wdp->wd_task.task_op_number,tot_offset,tep->tot_wait_worker_thread_number);
+	// The sequence number only ever moves forward. Under Loose Ordering an op releases
+	// the next one twice and the second release must not undo a later op that has 
+	// already been posted to this entry.
+	sequence = (uint32_t)(wdp->wd_task.task_op_number + 1);
+	current = __atomic_load_n(&tep->tot_sequence, __ATOMIC_RELAXED);
+	while ((int32_t)(sequence - current) > 0) {
+		if (__atomic_compare_exchange_n(&tep->tot_sequence, &current, sequence, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+			break;
 	}
+	if (__atomic_load_n(&tep->tot_waiters, __ATOMIC_SEQ_CST))
+		xint_futex_wake(&tep->tot_sequence, INT32_MAX);
+
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: tot_offset: %d: worker %d has been RELEASED\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,tep->tot_wait_worker_thread_number);
 if (xgp->global_options & GO_DEBUG_TOT) xdd_show_tot_entry(tdp->td_totp,tot_offset);
 	return(0);
@@ -0,0 +1,294 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that implement the local copy engine
+ * selected with "-copyfrom". Each write operation of the target copies the
+ * same range of the source file into the target with FICLONERANGE or
+ * copy_file_range() so the data does not cross into user space, or with
+ * pread()/pwrite() through the I/O buffer when neither one works.
+ * The kernel calls are made with syscall() and ioctl() directly so that they
+ * do not depend on the C library version.
+ */
+#include "xint.h"
+
+#if (LINUX)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#if defined(FICLONERANGE)
+#define XINT_HAVE_FICLONERANGE 1
+#endif
+#if defined(__NR_copy_file_range)
+#define XINT_HAVE_COPY_FILE_RANGE 1
+#endif
+#endif
+
+static char	*xint_copy_method_names[XINT_COPY_METHODS] = {"clone", "copy_file_range", "read/write"};
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_fallback() - Return 1 if errno says that a copy method cannot be
+ * used for these files at all, rather than that something went wrong.
+ */
+static int
+xint_copy_fallback(int err) {
+	return((err == EOPNOTSUPP) || (err == ENOTTY) || (err == EXDEV) || 
+		(err == EINVAL) || (err == ENOSYS) || (err == EBADF) || (err == ETXTBSY));
+} // End of xint_copy_fallback()
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_clone_unsupported() - Return 1 if errno from FICLONERANGE says 
+ * that these files can never be cloned. Other errors such as EINVAL for a 
+ * range that is not block aligned only mean that this range cannot be.
+ */
+static int
+xint_copy_clone_unsupported(int err) {
+	return((err == EOPNOTSUPP) || (err == EXDEV));
+} // End of xint_copy_clone_unsupported()
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_source_left() - Return the number of bytes of the source file 
+ * from "offset" up to "length" - FICLONERANGE stops at the end of the source
+ * file without saying so. The size is only looked up again if the range 
+ * goes past the size that was last seen, since the source may be growing.
+ */
+static size_t
+xint_copy_source_left(xint_copy_t *copyp, int64_t offset, size_t length) {
+	struct stat		statbuf;
+	int64_t			size;
+
+
+	size = __atomic_load_n(&copyp->copy_source_size, __ATOMIC_RELAXED);
+	if (offset + (int64_t)length > size) {
+		if (fstat(copyp->copy_fd, &statbuf) == 0) {
+			size = statbuf.st_size;
+			__atomic_store_n(&copyp->copy_source_size, size, __ATOMIC_RELAXED);
+		}
+		if (offset >= size)
+			return(0);
+		if (offset + (int64_t)length > size)
+			return(size - offset);
+	}
+	return(length);
+} // End of xint_copy_source_left()
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_drop_method() - Stop using a copy method for this target and 
+ * say so once. Another Worker Thread may have dropped it already.
+ */
+static void
+xint_copy_drop_method(target_data_t *tdp, int32_t method, int err) {
+	xint_copy_t		*copyp;
+
+
+	copyp = tdp->td_copyp;
+	if (__atomic_compare_exchange_n(&copyp->copy_method, &method, method + 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+		if (xgp->global_options & GO_VERBOSE)
+			fprintf(xgp->output,"%s: xint_copy_drop_method: Target %d: INFO: %s cannot be used from %s (%s) - using %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				xint_copy_method_names[method],
+				copyp->copy_source,
+				strerror(err),
+				xint_copy_method_names[method + 1]);
+	}
+} // End of xint_copy_drop_method()
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_init() - Open the source file of a local copy.
+ * This is called within the context of a Target Thread.
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_copy_init(target_data_t *tdp) {
+	xint_copy_t		*copyp;
+
+
+	if (!(tdp->td_target_options & TO_IO_COPY))
+		return(0);
+	copyp = tdp->td_copyp;
+	if ((copyp == NULL) || (copyp->copy_source == NULL)) {
+		fprintf(xgp->errout,"%s: xint_copy_init: Target %d: ERROR: The copy engine needs the source file to be specified with -copyfrom\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+	if ((tdp->td_rwratio != 0.0) || (tdp->td_target_options & (TO_ENDTOEND | TO_SGIO | TO_NULL_TARGET))) {
+		fprintf(xgp->errout,"%s: xint_copy_init: Target %d: ERROR: The target of -copyfrom has to be a file or device that is only written\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+
+	copyp->copy_fd = open(copyp->copy_source, O_RDONLY);
+	if (copyp->copy_fd < 0) {
+		fprintf(xgp->errout,"%s: xint_copy_init: Target %d: ERROR: Cannot open the source file %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			copyp->copy_source);
+		perror("Reason");
+		return(-1);
+	}
+	copyp->copy_source_size = 0;
+	copyp->copy_method = (copyp->copy_options & XINT_COPY_NOCLONE) ? XINT_COPY_OFFLOAD : XINT_COPY_CLONE;
+#if !defined(XINT_HAVE_FICLONERANGE)
+	if (copyp->copy_method == XINT_COPY_CLONE)
+		copyp->copy_method = XINT_COPY_OFFLOAD;
+#endif
+#if !defined(XINT_HAVE_COPY_FILE_RANGE)
+	if (copyp->copy_method == XINT_COPY_OFFLOAD)
+		copyp->copy_method = XINT_COPY_READWRITE;
+#endif
+	return(0);
+} // End of xint_copy_init()
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_io() - Copy the range of the source file for this operation into
+ * the target at the same offset with the best method that works.
+ * This subroutine is called within the context of a Worker Thread.
+ * Return value is the number of bytes copied or -1 if there was a failure,
+ * in which case errno says why.
+ */
+ssize_t
+xint_copy_io(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	xint_copy_t		*copyp;
+	int32_t			method;
+	int32_t			op_method;	// First method this op may use - a range that cannot be cloned is copied
+	size_t			length;		// Number of bytes to copy
+#if defined(XINT_HAVE_FICLONERANGE)
+	size_t			cloned;		// Number of bytes the clone covered
+#endif
+	size_t			done;		// Number of bytes copied so far
+	ssize_t			status;
+	int				err;
+#if defined(XINT_HAVE_FICLONERANGE)
+	struct file_clone_range	fcr;
+#endif
+#if defined(XINT_HAVE_COPY_FILE_RANGE)
+	loff_t			off_in, off_out;
+#endif
+
+
+	tdp = wdp->wd_tdp;
+	copyp = tdp->td_copyp;
+	length = wdp->wd_task.task_xfer_size;
+	done = 0;
+	op_method = XINT_COPY_CLONE;
+	while (done < length) {
+		method = __atomic_load_n(&copyp->copy_method, __ATOMIC_RELAXED);
+		if (method < op_method)
+			method = op_method;
+		switch (method) {
+#if defined(XINT_HAVE_FICLONERANGE)
+		case XINT_COPY_CLONE:
+			fcr.src_fd = copyp->copy_fd;
+			fcr.src_offset = wdp->wd_task.task_byte_offset + done;
+			fcr.src_length = length - done;
+			fcr.dest_offset = wdp->wd_task.task_byte_offset + done;
+			if (ioctl(wdp->wd_task.task_file_desc, FICLONERANGE, &fcr) == 0) {
+				cloned = xint_copy_source_left(copyp, fcr.src_offset, length - done);
+				__atomic_add_fetch(&copyp->copy_bytes[XINT_COPY_CLONE], cloned, __ATOMIC_RELAXED);
+				done += cloned;
+				if (cloned < fcr.src_length) // End of the source file
+					return(done);
+				continue;
+			}
+			err = errno;
+			if (!xint_copy_fallback(err))
+				return(-1);
+			if (xint_copy_clone_unsupported(err))
+				xint_copy_drop_method(tdp, method, err);
+			else op_method = XINT_COPY_OFFLOAD; // Copy this range and clone the next one
+			break;
+#endif
+#if defined(XINT_HAVE_COPY_FILE_RANGE)
+		case XINT_COPY_OFFLOAD:
+			off_in = wdp->wd_task.task_byte_offset + done;
+			off_out = off_in;
+			status = syscall(__NR_copy_file_range, copyp->copy_fd, &off_in, wdp->wd_task.task_file_desc, &off_out, length - done, 0);
+			if (status > 0) {
+				__atomic_add_fetch(&copyp->copy_bytes[XINT_COPY_OFFLOAD], status, __ATOMIC_RELAXED);
+				done += status;
+				continue;
+			}
+			if (status == 0) // End of the source file
+				return(done);
+			err = errno;
+			if ((done > 0) || !xint_copy_fallback(err))
+				return(-1);
+			xint_copy_drop_method(tdp, method, err);
+			break;
+#endif
+		default:
+			status = pread(copyp->copy_fd, wdp->wd_task.task_datap + done, length - done, (off_t)(wdp->wd_task.task_byte_offset + done));
+			if (status <= 0) 
+				return((status == 0) ? (ssize_t)done : -1);
+			status = pwrite(wdp->wd_task.task_file_desc, wdp->wd_task.task_datap + done, status, (off_t)(wdp->wd_task.task_byte_offset + done));
+			if (status <= 0) 
+				return(-1);
+			__atomic_add_fetch(&copyp->copy_bytes[XINT_COPY_READWRITE], status, __ATOMIC_RELAXED);
+			done += status;
+			break;
+		}
+	}
+	return(done);
+} // End of xint_copy_io()
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_display() - Display how many bytes were copied with each method
+ * and how much CPU time the run took for each GB copied. The CPU time comes
+ * from the combined results of the run in "rp".
+ */
+void
+xint_copy_display(target_data_t *tdp, results_t *rp, FILE *out) {
+	xint_copy_t		*copyp;
+	int32_t			i;
+
+
+	copyp = tdp->td_copyp;
+	fprintf(out,"Copy of '%s' to Target %d, %s",
+		copyp->copy_source,
+		tdp->td_target_number,
+		tdp->td_target_full_pathname);
+	for (i = 0; i < XINT_COPY_METHODS; i++)
+		fprintf(out,", %s, %lld, bytes", xint_copy_method_names[i], (long long int)copyp->copy_bytes[i]);
+	fprintf(out,"\n");
+	if (rp->bytes_xfered > 0)
+		fprintf(out,"Copy CPU time, %.3f, seconds per GB, user, %.3f, system, %.3f\n",
+			rp->us_time / ((double)rp->bytes_xfered / FLOAT_BILLION),
+			rp->user_time / ((double)rp->bytes_xfered / FLOAT_BILLION),
+			rp->system_time / ((double)rp->bytes_xfered / FLOAT_BILLION));
+} // End of xint_copy_display()
+
+/*----------------------------------------------------------------------------*/
+/* xint_copy_cleanup() - Close the source file of a local copy */
+void
+xint_copy_cleanup(target_data_t *tdp) {
+
+
+	if ((tdp->td_copyp == NULL) || (tdp->td_copyp->copy_fd < 0))
+		return;
+	close(tdp->td_copyp->copy_fd);
+	tdp->td_copyp->copy_fd = -1;
+} // End of xint_copy_cleanup()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -35,7 +35,7 @@ xdd_io_for_os(worker_data_t *wdp) {
 	nclk_now(&wdp->wd_counters.tc_current_op_start_time);
 	// Time stamp if requested
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_disk_start = wdp->wd_counters.tc_current_op_start_time;
 		ttep->tte_disk_processor_start = xdd_get_processor();
 	}
@@ -52,6 +52,10 @@ xdd_io_for_os(worker_data_t *wdp) {
 		} else { // Issue the actual operation
 			if ((tdp->td_target_options & TO_SGIO)) 
 			 	wdp->wd_task.task_io_status = xdd_sg_io(wdp,'w'); // Issue the SGIO operation 
+			else if (tdp->td_target_options & TO_IO_MMAP) 
+				wdp->wd_task.task_io_status = xint_mmap_io(wdp); // Copy the buffer to the mapping
+			else if (tdp->td_target_options & TO_IO_COPY) 
+				wdp->wd_task.task_io_status = xint_copy_io(wdp); // Copy this range of the source file in the kernel
 			else if (!(tdp->td_target_options & TO_NULL_TARGET)) {
 
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_io_for_os: Target: %d: Worker: %d: WRITE: file_desc: %d: datap: %p: xfer_size: %d: byte_offset: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset);
@@ -74,6 +78,8 @@ if (xgp->global_options & GO_DEBUG_IO) xdd_show_task(&wdp->wd_task);
 		} else { // Issue the actual operation
 			if ((tdp->td_target_options & TO_SGIO)) 
 			 	wdp->wd_task.task_io_status = xdd_sg_io(wdp,'r'); // Issue the SGIO operation 
+			else if (tdp->td_target_options & TO_IO_MMAP) 
+				wdp->wd_task.task_io_status = xint_mmap_io(wdp); // Copy the mapping to the buffer
 			else if (!(tdp->td_target_options & TO_NULL_TARGET)) {
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_io_for_os: Target: %d: Worker: %d: READ: file_desc: %d: datap: %p: xfer_size: %d: byte_offset: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset);
                             wdp->wd_task.task_io_status = pread(wdp->wd_task.task_file_desc,
@@ -84,11 +90,11 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_io_fo
                                                               wdp->wd_task.task_datap,
                                                               wdp->wd_task.task_xfer_size);// Issue a normal read() operation
 		}
-	
-// FIXME _ NEED TO FIX THIS 
-//		if (p->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION)) {
-//			wdp->dpp->data_pattern_compare_errors += xdd_verify(wdp, wdp->wdrget_op_number);
-//		}
+
+		// Check the data that was just read if requested
+		if ((tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM)) && 
+			(wdp->wd_task.task_io_status == (ssize_t)wdp->wd_task.task_xfer_size)) 
+			__atomic_add_fetch(&tdp->td_dpp->data_pattern_compare_errors, xdd_verify(wdp, wdp->wd_task.task_op_number), __ATOMIC_RELAXED);
 	
 	} else {  // Must be a NOOP
 		// The NOOP is used to test the overhead usage of XDD when no actual I/O is done
@@ -128,7 +134,7 @@ xdd_io_for_os(worker_data_t *wdp) {
 	// Record the starting time for this write op
 	nclk_now(&wdp->wd_counters.tc_current_op_start_time);
 	// Time stamp if requested
-	ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+	ttep = wdp->wd_ts_ttep;
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
 		ttep->tte_disk_start = wdp->wd_counters.tc_current_op_start_time;
 		ttep->tte_disk_processor_start = xdd_get_processor();
@@ -167,11 +173,11 @@ xdd_io_for_os(worker_data_t *wdp) {
                                                               wdp->wd_task.task_datap,
                                                               wdp->wd_task.task_xfer_size);// Issue a normal read() operation
 		}
-/* FIXME	
-		if (tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION)) {
-			wdp->wd_tdp->data_pattern_compare_errors += xdd_verify(wdp, wdp->wdrget_op_number);
-		}
-*/	
+		// Check the data that was just read if requested
+		if ((tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM)) && 
+			(wdp->wd_task.task_io_status == (ssize_t)wdp->wd_task.task_xfer_size)) 
+			__atomic_add_fetch(&tdp->td_dpp->data_pattern_compare_errors, xdd_verify(wdp, wdp->wd_task.task_op_number), __ATOMIC_RELAXED);
+
 	} else {  // Must be a NOOP
 		// The NOOP is used to test the overhead usage of XDD when no actual I/O is done
 		wdp->wd_task.task_op_string = "NOOP";
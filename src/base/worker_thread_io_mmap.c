@@ -0,0 +1,296 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that implement the mmap I/O engine
+ * selected with "-ioengine mmap". The Worker Threads issue the operations
+ * just like they do for the sync engine except that each read or write is a
+ * memcpy() from or to a mapping of the target file instead of a pread() or
+ * pwrite().
+ */
+#include "xint.h"
+#include <sys/mman.h>
+
+/*----------------------------------------------------------------------------*/
+/* xint_mmap_extend() - Map the file up to at least "length" bytes into the
+ * reserved address space. The mapping may go past the end of the file but
+ * only the part inside the file is ever copied to or from. The new part of
+ * the mapping gets the MAP_POPULATE and MAP_SYNC flags and the madvise()
+ * hint if they were requested.
+ * This is called with the mmap lock held or before any I/O is issued.
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+static int32_t
+xint_mmap_extend(target_data_t *tdp, uint64_t length) {
+	xint_mmap_t		*mmapp;
+	size_t			page_size;
+	size_t			new_mapped;	// Number of bytes that will be mapped
+	void			*addr;
+	int				prot;
+	int				flags;
+
+
+	mmapp = tdp->td_mmapp;
+	page_size = getpagesize();
+	new_mapped = (size_t)((length + page_size - 1) & ~((uint64_t)page_size - 1));
+	if (new_mapped <= mmapp->mmap_mapped)
+		return(0);
+	if (new_mapped > mmapp->mmap_reserved) {
+		errno = EFBIG;
+		return(-1);
+	}
+	// Grow by a good amount at a time. The part past the end of the file is never touched.
+	if (new_mapped - mmapp->mmap_mapped < XINT_MMAP_GROW) {
+		new_mapped = mmapp->mmap_mapped + XINT_MMAP_GROW;
+		if (new_mapped > mmapp->mmap_reserved)
+			new_mapped = mmapp->mmap_reserved;
+	}
+
+	prot = PROT_READ;
+	if ((fcntl(tdp->td_file_desc, F_GETFL) & O_ACCMODE) != O_RDONLY)
+		prot |= PROT_WRITE;
+	flags = MAP_SHARED | MAP_FIXED;
+#ifdef MAP_POPULATE
+	if (mmapp->mmap_options & XINT_MMAP_POPULATE)
+		flags |= MAP_POPULATE;
+#endif
+#if defined(MAP_SYNC) && defined(MAP_SHARED_VALIDATE)
+	if (mmapp->mmap_options & XINT_MMAP_SYNC)
+		flags = (flags & ~MAP_SHARED) | MAP_SHARED_VALIDATE | MAP_SYNC;
+#endif
+	addr = mmap(mmapp->mmap_addr + mmapp->mmap_mapped, new_mapped - mmapp->mmap_mapped, prot, flags, tdp->td_file_desc, (off_t)mmapp->mmap_mapped);
+	if (addr == MAP_FAILED) {
+		if (mmapp->mmap_options & XINT_MMAP_SYNC)
+			fprintf(xgp->errout,"%s: xint_mmap_extend: Target %d: ERROR: Cannot map the target with MAP_SYNC - the target has to be on a DAX file system\n",
+				xgp->progname,
+				tdp->td_target_number);
+		return(-1);
+	}
+	if (mmapp->mmap_advice >= 0)
+		madvise(addr, new_mapped - mmapp->mmap_mapped, mmapp->mmap_advice);
+	__atomic_store_n(&mmapp->mmap_mapped, new_mapped, __ATOMIC_RELEASE);
+	return(0);
+} // End of xint_mmap_extend()
+
+/*----------------------------------------------------------------------------*/
+/* xint_mmap_map() - Reserve the address space for this target and map the
+ * part of the file that is already there.
+ * This is called when the target is opened and again when it is reopened.
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_mmap_map(target_data_t *tdp) {
+	xint_mmap_t		*mmapp;
+	struct stat		statbuf;
+	off_t			file_size;
+	size_t			page_size;
+
+
+	mmapp = tdp->td_mmapp;
+	if ((mmapp == NULL) || !(tdp->td_target_options & TO_IO_MMAP) || (tdp->td_target_options & TO_NULL_TARGET))
+		return(0);
+
+	// Block devices have a size of 0 in the stat buffer so ask for the end of the device instead
+	file_size = 0;
+	if ((fstat(tdp->td_file_desc, &statbuf) == 0) && S_ISREG(statbuf.st_mode))
+		file_size = statbuf.st_size;
+	else file_size = lseek(tdp->td_file_desc, 0, SEEK_END);
+	if (file_size < 0)
+		file_size = 0;
+
+	page_size = getpagesize();
+	mmapp->mmap_reserved = XINT_MMAP_RESERVE;
+	if ((uint64_t)file_size > mmapp->mmap_reserved)
+		mmapp->mmap_reserved = (size_t)(((uint64_t)file_size + page_size - 1) & ~((uint64_t)page_size - 1));
+	mmapp->mmap_addr = mmap(NULL, mmapp->mmap_reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (mmapp->mmap_addr == MAP_FAILED) {
+		fprintf(xgp->errout,"%s: xint_mmap_map: Target %d: ERROR: Cannot reserve %lld bytes of address space for the mapping of target %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(long long int)mmapp->mmap_reserved,
+			tdp->td_target_full_pathname);
+		perror("Reason");
+		mmapp->mmap_addr = NULL;
+		return(-1);
+	}
+	mmapp->mmap_mapped = 0;
+	mmapp->mmap_file_size = file_size;
+	if (xint_mmap_extend(tdp, mmapp->mmap_file_size)) {
+		fprintf(xgp->errout,"%s: xint_mmap_map: Target %d: ERROR: Cannot map %lld bytes of target %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(long long int)mmapp->mmap_file_size,
+			tdp->td_target_full_pathname);
+		perror("Reason");
+		xint_mmap_unmap(tdp);
+		return(-1);
+	}
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xint_mmap_map: Target: %d: Worker: -: file_desc: %d: addr: %p: reserved: %lld: mapped: %lld: file_size: %lld\n", (long long int)pclk_now(),tdp->td_target_number,tdp->td_file_desc,mmapp->mmap_addr,(long long int)mmapp->mmap_reserved,(long long int)mmapp->mmap_mapped,(long long int)mmapp->mmap_file_size);
+	return(0);
+} // End of xint_mmap_map()
+
+/*----------------------------------------------------------------------------*/
+/* xint_mmap_unmap() - Unmap the target and give back the reserved address space */
+void
+xint_mmap_unmap(target_data_t *tdp) {
+	xint_mmap_t		*mmapp;
+
+
+	mmapp = tdp->td_mmapp;
+	if ((mmapp == NULL) || (mmapp->mmap_addr == NULL))
+		return;
+	munmap(mmapp->mmap_addr, mmapp->mmap_reserved);
+	mmapp->mmap_addr = NULL;
+	mmapp->mmap_mapped = 0;
+} // End of xint_mmap_unmap()
+
+/*----------------------------------------------------------------------------*/
+/* xint_mmap_init() - Get the mmap engine ready for this target.
+ * This is called within the context of a Target Thread after the target
+ * has been opened.
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_mmap_init(target_data_t *tdp) {
+
+
+	if (!(tdp->td_target_options & TO_IO_MMAP))
+		return(0);
+
+#if defined(LINUX)
+	// The Worker Threads copy to and from the mapping themselves.
+	// Anything that does its I/O some other way falls back to the normal path.
+	if (tdp->td_target_options & (TO_ENDTOEND | TO_SGIO)) {
+		fprintf(xgp->errout,"%s: xint_mmap_init: Target %d: WARNING: The mmap engine cannot be used with e2e or sgio - using the sync engine\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_target_options &= ~TO_IO_MMAP;
+		return(0);
+	}
+	if (xdd_get_mmapp(tdp) == NULL)
+		return(-1);
+#if !defined(MAP_SYNC) || !defined(MAP_SHARED_VALIDATE)
+	if (tdp->td_mmapp->mmap_options & XINT_MMAP_SYNC) {
+		fprintf(xgp->errout,"%s: xint_mmap_init: Target %d: WARNING: MAP_SYNC is not supported on this system - mapping without it\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_mmapp->mmap_options &= ~XINT_MMAP_SYNC;
+	}
+#endif
+	return(xint_mmap_map(tdp));
+#else
+	fprintf(xgp->errout,"%s: xint_mmap_init: Target %d: WARNING: The mmap engine is not supported on this system - using the sync engine\n",
+		xgp->progname,
+		tdp->td_target_number);
+	tdp->td_target_options &= ~TO_IO_MMAP;
+	return(0);
+#endif
+} // End of xint_mmap_init()
+
+/*----------------------------------------------------------------------------*/
+/* xint_mmap_io() - Do one read or write operation by copying the data
+ * between the I/O buffer and the mapping. A write that goes past the end
+ * of the file makes the file longer first. A read that goes past the end of
+ * the file is cut short the way pread() would be.
+ * This subroutine is called within the context of a Worker Thread.
+ * Return value is the number of bytes transferred or -1 if there was a
+ * failure, in which case errno says why.
+ */
+ssize_t
+xint_mmap_io(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	xint_mmap_t		*mmapp;
+	uint64_t		offset;		// Location of this operation in the file
+	uint64_t		length;		// Number of bytes to copy
+	uint64_t		file_size;
+	int32_t			status;
+
+
+	tdp = wdp->wd_tdp;
+	mmapp = tdp->td_mmapp;
+	offset = (uint64_t)wdp->wd_task.task_byte_offset;
+	length = wdp->wd_task.task_xfer_size;
+	if (offset + length > mmapp->mmap_reserved) {
+		errno = EFBIG;
+		return(-1);
+	}
+
+	// Make the file and the mapping longer if this operation goes past the end of either one
+	file_size = __atomic_load_n(&mmapp->mmap_file_size, __ATOMIC_ACQUIRE);
+	if ((offset + length > file_size) || (offset + length > __atomic_load_n(&mmapp->mmap_mapped, __ATOMIC_ACQUIRE))) {
+		pthread_mutex_lock(&mmapp->mmap_lock);
+		status = 0;
+		if ((wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) && (offset + length > mmapp->mmap_file_size)) {
+			status = ftruncate(tdp->td_file_desc, (off_t)(offset + length));
+			if (status == 0)
+				__atomic_store_n(&mmapp->mmap_file_size, offset + length, __ATOMIC_RELEASE);
+		}
+		if (status == 0)
+			status = xint_mmap_extend(tdp, offset + length);
+		file_size = mmapp->mmap_file_size;
+		pthread_mutex_unlock(&mmapp->mmap_lock);
+		if (status)
+			return(-1);
+	}
+
+	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {
+		memcpy(mmapp->mmap_addr + offset, wdp->wd_task.task_datap, length);
+	} else {
+		if (offset >= file_size)
+			return(0);
+		if (offset + length > file_size)
+			length = file_size - offset;
+		memcpy(wdp->wd_task.task_datap, mmapp->mmap_addr + offset, length);
+	}
+	return((ssize_t)length);
+} // End of xint_mmap_io()
+
+/*----------------------------------------------------------------------------*/
+/* xint_mmap_sync() - Write all the changed pages of the mapping back to the
+ * target for the -syncwrite option.
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xint_mmap_sync(target_data_t *tdp) {
+	xint_mmap_t		*mmapp;
+
+
+	mmapp = tdp->td_mmapp;
+	if ((mmapp == NULL) || (mmapp->mmap_addr == NULL) || (mmapp->mmap_mapped == 0))
+		return(0);
+	return(msync(mmapp->mmap_addr, mmapp->mmap_mapped, MS_SYNC));
+} // End of xint_mmap_sync()
+
+/*----------------------------------------------------------------------------*/
+/* xint_mmap_cleanup() - Unmap the target and free the mmap engine structure */
+void
+xint_mmap_cleanup(target_data_t *tdp) {
+
+
+	if (tdp->td_mmapp == NULL)
+		return;
+	xint_mmap_unmap(tdp);
+	pthread_mutex_destroy(&tdp->td_mmapp->mmap_lock);
+	free(tdp->td_mmapp);
+	tdp->td_mmapp = NULL;
+} // End of xint_mmap_cleanup()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -271,12 +271,12 @@ xdd_extended_stats(worker_data_t *wdp) {
 	if (tdp->td_counters.tc_current_op_elapsed_time > esp->my_longest_op_time) {
 		esp->my_longest_op_time = tdp->td_counters.tc_current_op_elapsed_time;
 		esp->my_longest_op_number = tdp->td_counters.tc_current_op_number;
-		if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) {  		// Write Operation
+		if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  		// Write Operation
 			if (tdp->td_counters.tc_current_op_elapsed_time > esp->my_longest_write_op_time) {
 				esp->my_longest_write_op_time = tdp->td_counters.tc_current_op_elapsed_time;
 				esp->my_longest_write_op_number = tdp->td_counters.tc_current_op_number;
 			}
-		} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) {  // READ Operation
+		} else if (wdp->wd_task.task_op_type == TASK_OP_TYPE_READ) {  // READ Operation
 			if (tdp->td_counters.tc_current_op_elapsed_time > esp->my_longest_read_op_time) {
 				esp->my_longest_read_op_time = tdp->td_counters.tc_current_op_elapsed_time;
 				esp->my_longest_read_op_number = tdp->td_counters.tc_current_op_number;
@@ -292,12 +292,12 @@ xdd_extended_stats(worker_data_t *wdp) {
 	if (tdp->td_counters.tc_current_op_elapsed_time < esp->my_shortest_op_time) {
 		esp->my_shortest_op_time = tdp->td_counters.tc_current_op_elapsed_time;
 		esp->my_shortest_op_number = tdp->td_counters.tc_current_op_number;
-		if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) {  		// Write Operation
+		if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  		// Write Operation
 			if (tdp->td_counters.tc_current_op_elapsed_time < esp->my_shortest_write_op_time) {
 				esp->my_shortest_write_op_time = tdp->td_counters.tc_current_op_elapsed_time;
 				esp->my_shortest_write_op_number = tdp->td_counters.tc_current_op_number;
 			}
-		} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) {  // READ Operation
+		} else if (wdp->wd_task.task_op_type == TASK_OP_TYPE_READ) {  // READ Operation
 			if (tdp->td_counters.tc_current_op_elapsed_time < esp->my_shortest_read_op_time) {
 				esp->my_shortest_read_op_time = tdp->td_counters.tc_current_op_elapsed_time;
 				esp->my_shortest_read_op_number = tdp->td_counters.tc_current_op_number;
@@ -322,6 +322,8 @@ xdd_extended_stats(worker_data_t *wdp) {
 void
 xdd_worker_thread_ttd_after_io_op(worker_data_t *wdp) {
 	target_data_t	*tdp;
+	nclk_t			op_time;	// Op time that goes into the latency histograms
+	int32_t			i, j;
 
 
 	tdp = wdp->wd_tdp;
@@ -346,6 +348,33 @@ xdd_worker_thread_ttd_after_io_op(worker_data_t *wdp) {
 	// Extended Statistics 
 	xdd_extended_stats(wdp);
 
+	// Latency Histogram - only successful ops are counted so the percentiles match the op counts
+	// With open-loop arrivals the latency runs from the time the operation was due, not when it was issued
+	if (wdp->wd_counters.tc_current_error_count == 0) {
+		if ((wdp->wd_task.task_time_to_issue) && (wdp->wd_counters.tc_current_op_end_time > wdp->wd_task.task_time_to_issue))
+			op_time = wdp->wd_counters.tc_current_op_end_time - wdp->wd_task.task_time_to_issue;
+		else op_time = wdp->wd_counters.tc_current_op_elapsed_time;
+		xint_lh_record(&wdp->wd_latency_hist, op_time);
+
+		// Request size mix - the last op of a pass may be cut short so it goes with the next larger size
+		if ((tdp->td_rsmp) && (wdp->wd_rsm_statsp)) {
+			j = -1;
+			for (i = 0; i < tdp->td_rsmp->rsm_classes; i++) {
+				if (tdp->td_rsmp->rsm_bytes[i] < (int64_t)wdp->wd_task.task_xfer_size)
+					continue;
+				if ((j < 0) || (tdp->td_rsmp->rsm_bytes[i] < tdp->td_rsmp->rsm_bytes[j]))
+					j = i;
+			}
+			if (j >= 0) {
+				i = j;
+				wdp->wd_rsm_statsp[i].rs_ops++;
+				wdp->wd_rsm_statsp[i].rs_bytes += wdp->wd_task.task_xfer_size;
+				wdp->wd_rsm_statsp[i].rs_op_time += op_time;
+				xint_lh_record(&wdp->wd_rsm_statsp[i].rs_hist, op_time);
+			}
+		}
+	}
+
 } // End of xdd_worker_thread_ttd_after_io_op()
 
 /*
@@ -237,63 +237,14 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	// Record the amount of data received 
 	wdp->wd_e2ep->e2e_data_recvd = wdp->wd_e2ep->e2e_hdrp->e2eh_data_length;
 
+	// Check the block checksums of the data that was just received before it is written
+	if ((tdp->td_target_options & TO_VERIFY_CHECKSUM) && (wdp->wd_task.task_xfer_size > 0))
+		__atomic_add_fetch(&tdp->td_dpp->data_pattern_compare_errors, xdd_verify_checksum(wdp, wdp->wd_task.task_op_number), __ATOMIC_RELAXED);
+
 	return(0);
 
 } // xdd_e2e_before_io_op()
 
-/*----------------------------------------------------------------------------*/
-/* xdd_throttle_before_io_op() - This subroutine implements the throttling
- * mechanism which is essentially a delay before the next I/O operation such
- * that the overall bandwdith or IOP rate meets the throttled value.
- * This subroutine is called in the context of a Worker Thread
- */
-void	
-xdd_throttle_before_io_op(worker_data_t *wdp) {
-	nclk_t   sleep_time;         /* This is the number of nano seconds to sleep between I/O ops */
-	int32_t  sleep_time_dw;     /* This is the amount of time to sleep in milliseconds */
-	nclk_t	now;
-	target_data_t	*tdp;
-
-
-	tdp = wdp->wd_tdp;
-if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_throttle_before_io_op: Target: %d: Worker: %d: ENTER: td_throtp: %p: throttle: %f:\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tdp->td_throtp,(tdp->td_throtp != NULL)?tdp->td_throtp->throttle:-69.69);
-	if ((tdp->td_throtp == NULL) || (tdp->td_throtp->throttle <= 0.0)) 
-		return;
-
-	/* If this is a 'throttled' operation, check to see what time it is relative to the start
-	 * of this pass, compare that to the time that this operation was supposed to begin, and
-	 * go to sleep for how ever many milliseconds is necessary until the next I/O needs to be
-	 * issued. If we are past the issue time for this operation, just issue the operation.
-	 */
-	if (tdp->td_throtp->throttle > 0.0) {
-		nclk_now(&now);
-		if (tdp->td_throtp->throttle_type & XINT_THROTTLE_DELAY) {
-			sleep_time = tdp->td_throtp->throttle*1000000;
-		} else { // Process the throttle for IOPS or BW
-			now -= wdp->wd_counters.tc_pass_start_time;
-			if (now < tdp->td_seekhdr.seeks[wdp->wd_task.task_op_number].time1) { /* Then we may need to sleep */
-				sleep_time = (tdp->td_seekhdr.seeks[wdp->wd_task.task_op_number].time1 - now); /* sleep time in microseconds */
-if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_throttle_before_io_op: Target: %d: Worker: %d: OPS/BW: time1: %lld: now: %lld: sleep_time: %lld\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)tdp->td_seekhdr.seeks[wdp->wd_task.task_op_number].time1,(long long int)now,(long long int)sleep_time);
-				if (sleep_time > 0) {
-					sleep_time_dw = sleep_time;
-#ifdef WIN32
-					Sleep(sleep_time_dw/1000);
-#elif (LINUX || IRIX || AIX || DARWIN || FREEBSD) /* Change this line to use usleep */
-					if ((sleep_time_dw*CLK_TCK) > 1000) /* only sleep if it will be 1 or more ticks */
-#if (IRIX )
-						sginap((sleep_time_dw*CLK_TCK)/fixme);
-#elif (LINUX || AIX || DARWIN || FREEBSD) /* Change this line to use usleep */
-						// The sleep_time_dw is in units of nanoseconds so we 
-						// divide be 1000 to get the number of microseconds to sleep
-						usleep(sleep_time_dw/1000);
-#endif
-#endif
-				}
-			}
-		}
-	}
-} // xdd_throttle_before_io_op()
-
 /*----------------------------------------------------------------------------*/
 /* xdd_worker_thread_ttd_before_io_op() - This subroutine will do all the stuff 
  * needed to be done before an I/O operation is issued.
@@ -325,9 +276,6 @@ xdd_worker_thread_ttd_before_io_op(worker_data_t *wdp) {
 	// DirectIO Handling
 	xdd_dio_before_io_op(wdp);
 
-	// Throttle Processing
-	xdd_throttle_before_io_op(wdp);
-
 	return(0);
 
 } // End of xdd_worker_thread_ttd_before_io_op()
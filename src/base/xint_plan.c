@@ -57,6 +57,8 @@ xdd_plan_t* xint_plan_data_initialization() {
 	planp->number_of_iothreads = 0;    /* number of threads spawned for all targets */
 	planp->estimated_end_time = 0;     /* The time at which this run (all passes) should end */
 	planp->number_of_processors = 0;   /* Number of processors */ 
+	planp->worker_pool_threads = 0;    /* No shared Worker Thread pool */
+	planp->worker_poolp = NULL;
 	planp->e2e_TCP_Win = DEFAULT_E2E_TCP_WINDOW_SIZE;	 /* e2e TCP Window Size */
 	planp->ActualLocalStartTime = 0;   /* The time to start operations */
 	planp->XDDMain_Thread = pthread_self();
@@ -70,7 +72,15 @@ xdd_plan_t* xint_plan_data_initialization() {
 /* This is called after the target substructures have been created */
 int xint_plan_start(xdd_plan_t* planp, xdd_occupant_t* barrier_occupant) {
 	int rc;
+	int target_number;
+	int64_t threads;
 	
+	/* Only let the handoff waits spin if every thread can have its own processor */
+	threads = 1 + planp->worker_pool_threads; /* The main thread and the Pool Threads */
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) 
+		threads += 1 + planp->target_datap[target_number]->td_queue_depth; /* The Target Thread and its Worker Threads */
+	xint_handoff_spin_init(threads);
+
 	/* Initialize subsystems */
 	if (PLAN_ENABLE_XNI & planp->plan_options) {
 		xni_initialize();
@@ -93,6 +103,13 @@ int xint_plan_start(xdd_plan_t* planp, xdd_occupant_t* barrier_occupant) {
         return -1;
     }
 
+	/* Start the shared Worker Thread pool before the targets that use it */
+	rc = xint_worker_pool_init(planp);
+	if (rc < 0) {
+		xdd_destroy_all_barriers(planp);
+		return -1;
+	}
+
 	/* Add a barrier occupant for tracking barrier participants */
 	xdd_init_barrier_occupant(barrier_occupant, "XDD_MAIN", XDD_OCCUPANT_TYPE_MAIN, NULL);
 
@@ -61,7 +61,7 @@ int
 bufqueue_init(struct bx_buffer_queue *bq, char *bq_name) {
 	int	status;
 
-fprintf(stderr,"bufqueue_init: Initializing buffer queue %s...",bq_name);
+if (Debug_Level) fprintf(stderr,"bufqueue_init: Initializing buffer queue %s...",bq_name);
 	bq->bq_name = bq_name;
 	bq->bq_counter = 0;
 	bq->bq_flags = 0;
@@ -77,7 +77,7 @@ fprintf(stderr,"bufqueue_init: Initializing buffer queue %s...",bq_name);
 		perror("Error initializing queue barrier");
 		return(-1);
 	}
-fprintf(stderr,"Done.\n");
+if (Debug_Level) fprintf(stderr,"Done.\n");
 	return(0);
 } // End of bufqueue_init()
 
@@ -88,7 +88,7 @@ bufhdr_init(struct bx_buffer_header *bp, int bh_size) {
 	int	status;
 
 
-fprintf(stderr,"bufhdr_init: Initializing buffer header %p size %d ...",bp,bh_size);
+if (Debug_Level) fprintf(stderr,"bufhdr_init: Initializing buffer header %p size %d ...",bp,bh_size);
 	bp->bh_next = 0;
 	bp->bh_prev = 0;
 	status = pthread_mutex_init(&bp->bh_mutex, 0);
@@ -96,8 +96,10 @@ fprintf(stderr,"bufhdr_init: Initializing buffer header %p size %d ...",bp,bh_si
 		perror("Error initializing buffer header mutex");
 		return(-1);
 	}
-	bp->bh_startp = (unsigned char *)valloc(bh_size);
-	if (bp->bh_startp == NULL) {
+	// The buffers are aligned so they can be used with O_DIRECT
+	status = posix_memalign((void **)&bp->bh_startp, BX_DIO_ALIGNMENT, bh_size);
+	if (status) {
+		errno = status;
 		perror("Error allocating buffer");
 		return(-1);
 	}
@@ -111,9 +113,9 @@ fprintf(stderr,"bufhdr_init: Initializing buffer header %p size %d ...",bp,bh_si
 	bp->bh_target = 0;
 	bp->bh_time = 0;
 	bp->bh_flags = BX_BUFHDR_INITIALIZED;
-fprintf(stderr,"Done.\n");
+if (Debug_Level) fprintf(stderr,"Done.\n");
 	return(0);
-}
+} // End of bufhdr_init()
 //
 // Buffers always go at the end of the linked list
 int
@@ -151,7 +153,6 @@ bh_enqueue(struct bx_buffer_header *bp, struct bx_buffer_queue *bq) {
 			perror("Reason");
 		}
 	}
-	bp->bh_time = 0xDEAD0000;
 	// Release the lock for this buffer queue
 	pthread_mutex_unlock(&bq->bq_mutex);
 	return(0);
@@ -192,9 +193,12 @@ bh_dequeue(struct bx_buffer_queue *bq) {
 // queue *anchors* in the INPUT and OUTPUT Target Data Structure.
 // Once the buffer queues are initialized, then each buffer header is 
 // initialized and stuffed onto the INPUT target Buffer Header Queue.
+// The number of buffers is the depth of the pipeline between the INPUT
+// and OUTPUT targets. If --buffers was not specified then there is one 
+// buffer for each Worker Thread so every Worker Thread can be busy at once.
 //
 int
-qb_init() {
+qb_init(void) {
 	struct	bx_td	*p;
 	struct	bx_buffer_header	*bp;
 	int 	i;
@@ -213,12 +217,21 @@ qb_init() {
 	}
 	first_target = Sequence[0];
 
+	if (Number_Of_Buffers == 0) {
+		for (i = 0; i < MAX_TARGETS; i++) {
+			p = &bx_td[i];
+			if (p->bx_td_flags & BX_TD_TARGET_DEFINED) 
+				Number_Of_Buffers += p->bx_td_number_of_worker_threads;
+		}
+		if (Number_Of_Buffers > MAX_NUMBER_OF_BUFFERS)
+			Number_Of_Buffers = MAX_NUMBER_OF_BUFFERS;
+	}
+
 	// Allocate buffers and stuff them on the available queue
-// TBD - calculate the number of buffers based on the number of targets and number of worker_threads...etc
+	// The buffer size is the largest transfer size of all the targets
 	for (i = 0; i < Number_Of_Buffers; i++) {
 		// Init the buffer header
 		bp = &Buf_Hdrs[i];
-// TBD - the "buffer size" needs to be calculated as the maximum transfer size of all targets
 		status = bufhdr_init(bp,Buffer_Size);
 		if (status < 0) {
 			fprintf(stderr,"qb_init: buffer header initialization failed for buffer %d\n",i);
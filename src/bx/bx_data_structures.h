@@ -17,6 +17,7 @@
 #define MAX_TARGETS				128
 #define MAX_WORKER_THREADS		128
 #define MAX_SEQUENCE_ENTRIES	MAX_TARGETS
+#define BX_DIO_ALIGNMENT		4096		// Buffer, offset, and length alignment for targets opened with O_DIRECT
 
 #define THOUSAND 1000
 #define MILLION 1000000
@@ -45,6 +46,7 @@ struct bx_buffer_header	{
 typedef struct bx_buffer_header bx_buffer_header_t;
 #define BX_BUFHDR_INITIALIZED 0x0000000000000001
 #define BX_BUFHDR_END_OF_FILE 0x0000000000000002
+#define BX_BUFHDR_ERROR       0x0000000000000004	// The data in this buffer is not valid because an I/O operation failed
 
 
 // The queue anchor
@@ -123,6 +125,7 @@ struct bx_td {
 		int					bx_td_my_target_number; 		// The number of the target that owns this Target Data Structure
 		char				*bx_td_file_name;			// The name of the file for this target
 		int					bx_td_fd;					// The file descriptor for this target
+		int					bx_td_tail_fd;				// Buffered file descriptor for the unaligned tail of a "dio" target
 		int					bx_td_number_of_worker_threads;	// Number of Worker Threads for this target
 		long long int		bx_td_file_size;				// Size of a file to create (in bytes)
 		int					bx_td_transfer_size;			// Data Transfer size for I/O
@@ -136,6 +139,12 @@ struct bx_td {
 		struct bx_buffer_queue 	bx_td_buffer_queue;				// The Buffer Queue anchor for this target
 		int				 	bx_td_next_buffer_queue;		// Target number of the next target to queue this buffer to
 		struct bx_wd_queue 	bx_td_bx_wd_queue;			// The Worker Thread Data Structure Queue anchor for this target
+		int					bx_td_status;					// Zero if this target completed without errors
+		long long int		bx_td_bytes_transferred;		// Number of bytes read or written by the Worker Threads
+		long long int		bx_td_ops;					// Number of read or write operations performed
+		long long int		bx_td_errors;				// Number of read or write operations that failed
+		nclk_t				bx_td_start_time;			// Time this target started moving data
+		nclk_t				bx_td_end_time;				// Time the last of the data went through this target
 };
 #define BX_TD_INPUT 				0x00000001
 #define BX_TD_OUTPUT 				0x00000002
@@ -165,6 +174,7 @@ int bufqueue_init(struct bx_buffer_queue *bq, char *bq_name);
 int bufhdr_init(struct bx_buffer_header *bp, int bh_size);
 int bh_enqueue(struct bx_buffer_header *bp, struct bx_buffer_queue *bq);
 struct bx_buffer_header *bh_dequeue(struct bx_buffer_queue *bq);
+int qb_init(void);
 void nclk_now(nclk_t *nclkp);
 int ui(int argc, char *argv[]);
 int get_target_file_options(int target_number, int index, int argc, char *argv[]);
@@ -172,6 +182,7 @@ int get_target_network_options(int target_number, int index, int argc, char *arg
 int get_target_sg_options(int target_number, int index, int argc, char *argv[]);
 int get_target_options(int index, int argc, char *argv[]);
 int get_sequence(int index, int current_argc, int argc, char *argv[]);
+int check_targets(void);
 void usage(char *progname);
 void *worker_thread_main(void *pin);
 int target_init(struct bx_td *p);
@@ -194,4 +205,6 @@ EXTERNAL 	int					Number_Of_Targets;
 EXTERNAL 	int					Number_Of_Buffers;
 EXTERNAL 	int 				Buffer_Size;
 EXTERNAL 	int					Debug_Level;
+EXTERNAL 	int					Abort;
 EXTERNAL 	int					Sequence[MAX_SEQUENCE_ENTRIES+1];
+EXTERNAL 	int					Sequence_Length;
@@ -37,6 +37,10 @@
 // Thread Data Structure  Queue for its target. THe Worker Thread Data 
 // Structure Queue anchor is located in the Target Data Structure of 
 // the target.
+// A "dio" target is opened with O_DIRECT. It is also opened a second time 
+// without O_DIRECT for the last part of the file that is not a multiple
+// of the alignment.
+// If the file size of an INPUT target is 0 then the whole file is copied.
 //
 // If all goes well then 0 is returned to the caller.
 //
@@ -44,32 +48,73 @@ int
 target_init(struct bx_td *p) {
     int 			status;
 	int				i;
+	int				flags;
 	unsigned int	qflags;
 	struct bx_wd		*bx_wdp;
+	struct stat		statbuf;
 
-fprintf(stderr,"\n %s Target Thread %d: Initializing\n",
+if (Debug_Level) fprintf(stderr,"\n %s Target Thread %d: Initializing\n",
 			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
 			p->bx_td_my_target_number);
 	qflags = 0;
+	p->bx_td_fd = -1;
+	p->bx_td_tail_fd = -1;
+	if (!(p->bx_td_flags & BX_TD_TYPE_FILE)) {
+		fprintf(stderr,"target_init: Target %d: Only targets of type 'file' are supported\n", p->bx_td_my_target_number);
+		return(-1);
+	}
+	status = bx_wd_queue_init(&p->bx_td_bx_wd_queue, "WDQ");
+	if (status) 
+		return(-1);
+
 	// Open the file
-	if (p->bx_td_flags & BX_TD_INPUT) {
-		p->bx_td_fd = open(p->bx_td_file_name, O_RDONLY);
+	if (p->bx_td_flags & BX_TD_TYPE_FILE_NULL) {
+		// Nothing to open
+	} else if (p->bx_td_flags & BX_TD_INPUT) {
+		flags = O_RDONLY;
+#ifdef O_DIRECT
+		if (p->bx_td_flags & BX_TD_TYPE_FILE_DIO)
+			flags |= O_DIRECT;
+#endif
+		p->bx_td_fd = open(p->bx_td_file_name, flags);
 		if (p->bx_td_fd < 0) {
-			perror("target_init: Cannot open input file");
+			fprintf(stderr,"target_init: Target %d: Cannot open input file '%s'\n", p->bx_td_my_target_number, p->bx_td_file_name);
+			perror("Reason");
 			return(-1);
 		}
+		if (p->bx_td_file_size == 0) {
+			status = fstat(p->bx_td_fd, &statbuf);
+			if (status < 0) {
+				perror("target_init: Cannot get the size of the input file");
+				return(-1);
+			}
+			p->bx_td_file_size = statbuf.st_size;
+		}
 	} else	{ 
-		p->bx_td_fd = creat(p->bx_td_file_name, S_IRWXU|S_IRWXG|S_IRWXO);
-		if (p->bx_td_fd < 0) {
-			perror("target_init: Cannot open/create output file");
+		flags = O_WRONLY|O_CREAT|O_TRUNC;
+		p->bx_td_tail_fd = open(p->bx_td_file_name, flags, 0666);
+		if (p->bx_td_tail_fd < 0) {
+			fprintf(stderr,"target_init: Target %d: Cannot open/create output file '%s'\n", p->bx_td_my_target_number, p->bx_td_file_name);
+			perror("Reason");
 			return(-1);
 		}
+		p->bx_td_fd = p->bx_td_tail_fd;
+#ifdef O_DIRECT
+		if (p->bx_td_flags & BX_TD_TYPE_FILE_DIO) {
+			p->bx_td_fd = open(p->bx_td_file_name, O_WRONLY|O_DIRECT);
+			if (p->bx_td_fd < 0) {
+				fprintf(stderr,"target_init: Target %d: Cannot open output file '%s' with O_DIRECT\n", p->bx_td_my_target_number, p->bx_td_file_name);
+				perror("Reason");
+				return(-1);
+			}
+		}
+#endif
 	}
 
 	// Create the Worker Threads
 	for (i = 0; i < p->bx_td_number_of_worker_threads; i++) {
 		bx_wdp = &p->bx_td_bx_wd[i];
-		fprintf(stderr,"target_init: %s target %d creating Worker Threads %d of %d, fd=%d, bx_wdp=%p...\n",
+if (Debug_Level) fprintf(stderr,"target_init: %s target %d creating Worker Threads %d of %d, fd=%d, bx_wdp=%p...\n",
 				(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
 				p->bx_td_my_target_number, 
 				i+1, 
@@ -78,16 +123,24 @@ fprintf(stderr,"\n %s Target Thread %d: Initializing\n",
 				bx_wdp);
 		bx_wdp->bx_wd_my_worker_thread_number = i;
 		bx_wdp->bx_wd_flags = qflags;
+		bx_wdp->bx_wd_released = 0;
 		bx_wdp->bx_wd_fd = p->bx_td_fd;
 		bx_wdp->bx_wd_my_queue = &p->bx_td_bx_wd_queue;
 		bx_wdp->bx_wd_my_bx_tdp = p;
+		status = pthread_mutex_init(&bx_wdp->bx_wd_mutex, 0);
+		if (status == 0)
+			status = pthread_cond_init(&bx_wdp->bx_wd_conditional, 0);
+		if (status) {
+			perror("target_init: Cannot initialize Worker Thread mutex");
+			return(-1);
+		}
 		status = pthread_create(&p->bx_td_worker_threads[i], NULL, worker_thread_main, bx_wdp);
 		if (status) {
 			perror("target_init: Cannot create Worker Threads");
 			return(-1);
 		}
 	}
-fprintf(stderr,"\n %s Target Thread %d: Initialization Complete\n",
+if (Debug_Level) fprintf(stderr,"\n %s Target Thread %d: Initialization Complete\n",
 			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
 			p->bx_td_my_target_number);
 
@@ -95,6 +148,42 @@ fprintf(stderr,"\n %s Target Thread %d: Initialization Complete\n",
 
 } // End of target_init()
 
+/**************************************************************************
+*   Worker Thread Release
+**************************************************************************/
+// Give a Worker Thread a buffer (or the TERMINATE flag) and wake it up.
+// The Worker Thread Data Structure mutex is held so the wake up cannot
+// slip in between the Worker Thread checking bx_wd_released and waiting.
+static void
+target_release_worker_thread(struct bx_wd *bx_wdp, struct bx_buffer_header *bufhdrp, int next_buffer_queue, unsigned int flags) {
+	pthread_mutex_lock(&bx_wdp->bx_wd_mutex);
+	bx_wdp->bx_wd_bufhdrp = bufhdrp;
+	bx_wdp->bx_wd_next_buffer_queue = next_buffer_queue;
+	bx_wdp->bx_wd_flags |= flags;
+	bx_wdp->bx_wd_released = 1;
+	pthread_cond_broadcast(&bx_wdp->bx_wd_conditional);
+	pthread_mutex_unlock(&bx_wdp->bx_wd_mutex);
+} // End of target_release_worker_thread()
+
+/**************************************************************************
+*   Worker Thread Termination
+**************************************************************************/
+// Wait for each of the Worker Threads of a target to finish its last
+// operation, tell it to terminate, and wait for it to exit.
+static void
+target_terminate_worker_threads(struct bx_td *p) {
+	struct bx_wd		*bx_wdp;
+	int				i;
+
+	for (i = 0; i < p->bx_td_number_of_worker_threads; i++) {
+if (Debug_Level) fprintf(stderr,"target_terminate_worker_threads: - Waiting for WORKER THREAD %d of %d\n",i+1,p->bx_td_number_of_worker_threads);
+		bx_wdp = bx_wd_dequeue(&p->bx_td_bx_wd_queue);
+		target_release_worker_thread(bx_wdp, 0, 0, BX_WD_TERMINATE);
+	}
+	for (i = 0; i < p->bx_td_number_of_worker_threads; i++) 
+		pthread_join(p->bx_td_worker_threads[i], NULL);
+} // End of target_terminate_worker_threads()
+
 /**************************************************************************
 *   The Input Target Thread
 **************************************************************************/
@@ -118,7 +207,8 @@ fprintf(stderr,"\n %s Target Thread %d: Initialization Complete\n",
 //
 // Once all the input Worker Threads have terminated, it is safe to assume that
 // all of the data from the input file has been given to the OUTPUT target.
-// Therefore, this thread can 
+// Then all the buffers are collected as they come back around the sequence
+// and the last one is sent down the sequence as the END_OF_FILE marker.
 int
 target_input(struct bx_td *p) {
 	long long int	bytes_remaining;
@@ -130,62 +220,42 @@ target_input(struct bx_td *p) {
 	off_t			current_file_offset;
 
 
-fprintf(stderr,"target_input: - ENTER\n");
+if (Debug_Level) fprintf(stderr,"target_input: - ENTER\n");
 	// Now copy the data from the input file to the output file 
 	bytes_remaining = p->bx_td_file_size;
 	current_file_offset = 0;
-	while(bytes_remaining > 0) {
-fprintf(stderr,"target_input: - bytes_remaining=%lld\n",(long long int)bytes_remaining);
-		// Get the next available input qrhread
+	while ((bytes_remaining > 0) && (!Abort)) {
+		// Get the next available input Worker Thread
 		bx_wdp = bx_wd_dequeue(&p->bx_td_bx_wd_queue);
-fprintf(stderr,"target_input: - got a Worker Thread Data Structure: %p\n",bx_wdp);
-bufqueue_show(&p->bx_td_buffer_queue);	
 		// Get the next available buffer from the available buffer queue
 		bufhdrp = bh_dequeue(&p->bx_td_buffer_queue);
 	
-fprintf(stderr,"target_input: - got a BUFFER: %p\n",bufhdrp);
 		if (bytes_remaining < p->bx_td_transfer_size)
 			transfer_size = bytes_remaining;
 		else transfer_size = p->bx_td_transfer_size;
 		bufhdrp->bh_transfer_size = transfer_size;
 		bufhdrp->bh_file_offset = current_file_offset;
+		bufhdrp->bh_sequence = current_file_offset / p->bx_td_transfer_size;
 		// Point this buffer to the Worker Thread Data Structure/Worker Threads 
 		// and release the Worker Threads.
-		bx_wdp->bx_wd_bufhdrp = bufhdrp;
-		bx_wdp->bx_wd_released = 1;
-		bx_wdp->bx_wd_next_buffer_queue = p->bx_td_next_buffer_queue;
-
-		pthread_cond_broadcast(&bx_wdp->bx_wd_conditional);
+		target_release_worker_thread(bx_wdp, bufhdrp, p->bx_td_next_buffer_queue, 0);
 		bytes_remaining -= transfer_size;
 		current_file_offset += transfer_size;
-fprintf(stderr,"target_input: - WORKER THREAD RELEASED\n");
 	}
 
 	// At this point all the input operations have been scheduled and 
 	// this target needs to wait for the last Worker Threads to transfer its
 	// data and complete. 
-	// This target thread will wait on the Worker Threads until all the
-	// Worker Threads have checked in as complete. After that, this subroutine
-	// thread will exit.
-	
-	for (i = 0; i < p->bx_td_number_of_worker_threads; i++) {
-		// Get the next available input qrhread
-fprintf(stderr,"target_input: - Waiting for WORKER THREAD %d of %d\n",i+1,p->bx_td_number_of_worker_threads);
-		bx_wdp = bx_wd_dequeue(&p->bx_td_bx_wd_queue);
-		bx_wdp->bx_wd_flags |= BX_WD_TERMINATE;
-		pthread_cond_broadcast(&bx_wdp->bx_wd_conditional);
-fprintf(stderr,"target_input: - WORKER THREAD %d of %d has completed\n",i+1,p->bx_td_number_of_worker_threads);
-	}
+	target_terminate_worker_threads(p);
 
 	// Now we wait for all the buffers to come back from the OUTPUT target
 	// at which point we know that all the data has been written to the
 	// output device. 
 	for (i = 0; i < Number_Of_Buffers; i++) {
-fprintf(stderr,"target_input: - Waiting for BUFFER %d of %d\n",i+1,Number_Of_Buffers);
 		// Get a buffer from the buffer queue
 		bufhdrp = bh_dequeue(&p->bx_td_buffer_queue);
-fprintf(stderr,"target_input: - BUFFER %d of %d completed\n",i+1,Number_Of_Buffers);
 	}
+	nclk_now(&p->bx_td_end_time);
 	
 	// Now that all the buffers have returned from the OUTPUT target,
 	// we take the last buffer header, set the "END_OF_FILE" flag,
@@ -195,10 +265,12 @@ fprintf(stderr,"target_input: - BUFFER %d of %d completed\n",i+1,Number_Of_Buffe
 	//
 	// Set the End Of File flag in the buf header and wake up the output target
 	bufhdrp->bh_flags |= BX_BUFHDR_END_OF_FILE;
-	qp = &bx_td[bx_wdp->bx_wd_next_buffer_queue].bx_td_buffer_queue;
-	bh_enqueue(bx_wdp->bx_wd_bufhdrp, qp);
+	qp = &bx_td[p->bx_td_next_buffer_queue].bx_td_buffer_queue;
+	bh_enqueue(bufhdrp, qp);
 
-fprintf(stderr,"\n Target Input  %d: DONE\n",p->bx_td_my_target_number);
+if (Debug_Level) fprintf(stderr,"\n Target Input  %d: DONE\n",p->bx_td_my_target_number);
+	if (p->bx_td_errors || Abort)
+		return(-1);
     return 0;
 } // End of target_input()
 
@@ -206,51 +278,50 @@ fprintf(stderr,"\n Target Input  %d: DONE\n",p->bx_td_my_target_number);
 *   The Output Target Thread
 **************************************************************************/
 // Just like the INPUT target thread only backwards.
+// When the END_OF_FILE buffer shows up it is passed on to the next target
+// in the sequence if that is another OUTPUT target.
 int
 target_output(struct bx_td *p) {
 	struct bx_wd	*bx_wdp = 0;
 	struct bx_buffer_header	*bufhdrp = 0;
-	int				buffers_written;
-	int				i;
+	int				next;
 
 
-	buffers_written = 0;
-fprintf(stderr,"target_output: - ENTER\n");
+if (Debug_Level) fprintf(stderr,"target_output: - ENTER\n");
 	// Now copy the data from the input file to the output file 
 	while(1) {
 		// Get the next available buffer from the available buffer queue
 		bufhdrp = bh_dequeue(&p->bx_td_buffer_queue);
-fprintf(stderr,"target_output: - got a BUFHDR: %p\n",bx_wdp);
 		if (bufhdrp->bh_flags & BX_BUFHDR_END_OF_FILE) {
-fprintf(stderr,"target_output: - got an EOF: %p\n",bx_wdp);
+if (Debug_Level) fprintf(stderr,"target_output: - got an EOF: %p\n",bufhdrp);
 			break;
 		}
 	
-		// Get the next available output qrhread
+		// Get the next available output Worker Thread
 		bx_wdp = bx_wd_dequeue(&p->bx_td_bx_wd_queue);
-fprintf(stderr,"target_output: - got a Worker Thread Data Structure: %p\n",bx_wdp);
 	
 		// Point the Worker Threads to the buffer and release the Worker Threads
-		bx_wdp->bx_wd_bufhdrp = bufhdrp;
-		bx_wdp->bx_wd_released = 1;
-		bx_wdp->bx_wd_next_buffer_queue = p->bx_td_next_buffer_queue;
-
-		pthread_cond_broadcast(&bx_wdp->bx_wd_conditional);
-		buffers_written++;
-fprintf(stderr,"target_output: - WORKER THREAD RELEASED\n");
+		target_release_worker_thread(bx_wdp, bufhdrp, p->bx_td_next_buffer_queue, 0);
 	}
 
 	// Terminate all Worker Threads
-	for (i = 0; i < p->bx_td_number_of_worker_threads; i++) {
-		// Get the next available output qrhread
-fprintf(stderr,"target_output: - Waiting for WORKER THREAD %d of %d\n",i+1,p->bx_td_number_of_worker_threads);
-		bx_wdp = bx_wd_dequeue(&p->bx_td_bx_wd_queue);
-		bx_wdp->bx_wd_flags |= BX_WD_TERMINATE;
-		pthread_cond_broadcast(&bx_wdp->bx_wd_conditional);
-fprintf(stderr,"target_output: - WORKER THREAD %d of %d has completed\n",i+1,p->bx_td_number_of_worker_threads);
+	target_terminate_worker_threads(p);
+	nclk_now(&p->bx_td_end_time);
+
+	// Pass the END_OF_FILE along
+	next = p->bx_td_next_buffer_queue;
+	if (bx_td[next].bx_td_flags & BX_TD_OUTPUT) 
+		bh_enqueue(bufhdrp, &bx_td[next].bx_td_buffer_queue);
+
+	// Make sure the data is on the storage before saying it is done
+	if ((p->bx_td_fd >= 0) && (fsync(p->bx_td_fd) < 0)) {
+		perror("target_output: fsync failed");
+		p->bx_td_errors++;
 	}
-	fprintf(stderr,"\n Target Output  %d: %d buffers written - DONE\n",p->bx_td_my_target_number, buffers_written);
+if (Debug_Level) fprintf(stderr,"\n Target Output  %d: %lld buffers written - DONE\n",p->bx_td_my_target_number, p->bx_td_ops);
 
+	if (p->bx_td_errors)
+		return(-1);
     return 0;
 } // End of target_output()
 
@@ -262,6 +333,8 @@ fprintf(stderr,"target_output: - WORKER THREAD %d of %d has completed\n",i+1,p->
 // on which target it is. Up returning from target_input/target_output
 // the target thread will enter the "main" barrier where "main" is 
 // waiting for all targets to complete. 
+// If any target fails to initialize then all of them skip the copy so that
+// none of them is left waiting for buffers that never come.
 void *
 target_main(void *pin) {
     int status;
@@ -270,47 +343,42 @@ target_main(void *pin) {
 
 	p = (struct bx_td *)pin;
 
-fprintf(stderr,"\n %s Target Thread %d: Starting\n",
+if (Debug_Level) fprintf(stderr,"\n %s Target Thread %d: Starting\n",
 			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
 			p->bx_td_my_target_number);
 	status = target_init(p);
 	if (status != 0) {
-		fprintf(stderr,"Target Thread %d: Error during initialization - exiting\n",p->bx_td_my_target_number);
-		return NULL;
+		fprintf(stderr,"Target Thread %d: Error during initialization\n",p->bx_td_my_target_number);
+		Abort = 1;
 	}
 
 	// Wait here for all other Targets to initialize
 	pthread_barrier_wait(&Target_Barrier);
 	
 	// At this point all Targets have initialized 
-	if (p->bx_td_flags & BX_TD_INPUT)
-		status = target_input(p);
-	else status = target_output(p);
+	if (Abort) {
+		status = -1;
+	} else {
+		nclk_now(&p->bx_td_start_time);
+		if (p->bx_td_flags & BX_TD_INPUT)
+			status = target_input(p);
+		else status = target_output(p);
+	}
+	p->bx_td_status = status;
 
-fprintf(stderr,"\n %s Target Thread %d: COMPLETED - status=%d\n",
-			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
-			p->bx_td_my_target_number,
-			status);
 	if (status != 0) {
 		fprintf(stderr,"%s Target %d: failed\n",
 			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
 			p->bx_td_my_target_number);
 	}
 
-	fprintf(stderr,"\n %s Target Thread %d: DONE\n",
-			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
-			p->bx_td_my_target_number);
-
 	// At this point this target is done so it will enter the "main barrier"
 	// where "main" is waiting. When all targets arrive then the barrier
 	// collapses and this target thread will exit.
-fprintf(stderr,"\n %s Target Thread %d: Entering MAIN_BARRIER\n",
+if (Debug_Level) fprintf(stderr,"\n %s Target Thread %d: Entering MAIN_BARRIER\n",
 			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
 			p->bx_td_my_target_number);
 	pthread_barrier_wait(&Main_Barrier);
-fprintf(stderr,"\n %s Target Thread %d: Leaving\n",
-			(p->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", 
-			p->bx_td_my_target_number);
 
     return NULL;
 } // End of target_main()
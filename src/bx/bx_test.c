@@ -24,7 +24,6 @@
 // NOTE: Global variables are defined in bx_data_structures.h and live here
 #undef THIS_IS_A_SUBROUTINE
 #include "bx_data_structures.h"
-int qb_init();
 
 /**************************************************************************
 *   MAIN
@@ -33,6 +32,9 @@ int qb_init();
 int main(int argc, char *argv[]) {
 	int i;
     int status;
+	struct bx_td	*p;
+	double			elapsed;
+	double			bandwidth;
 
 
 	Buffer_Size = 0;
@@ -47,10 +49,17 @@ int main(int argc, char *argv[]) {
 	}
 	
 	// Process the Command Line
+	if (argc < 2) {
+		usage(argv[0]);
+		return(1);
+	}
 	status = ui(argc, argv);
 	if (status < 0) 
-		return(-1);
-fprintf(stderr,"main: Buffer_Size=%d, number of targets=%d\n",Buffer_Size,Number_Of_Targets);
+		return(1);
+	status = check_targets();
+	if (status < 0) 
+		return(1);
+if (Debug_Level) fprintf(stderr,"main: Buffer_Size=%d, number of targets=%d\n",Buffer_Size,Number_Of_Targets);
 	// Initialize the main barrier where all targets meet before starting
 	status = pthread_barrier_init(&Main_Barrier,0,Number_Of_Targets+1);
 	if (status) {
@@ -69,12 +78,12 @@ fprintf(stderr,"main: Buffer_Size=%d, number of targets=%d\n",Buffer_Size,Number
 		fprintf(stderr,"MAIN: Error initializing buffers - leaving now\n");
 		return(1);
 	}
-	bufqueue_show(&bx_td[0].bx_td_buffer_queue);
+if (Debug_Level) bufqueue_show(&bx_td[Sequence[0]].bx_td_buffer_queue);
 
 	// Create the target_threads
 	for (i = 0; i < MAX_TARGETS; i++) {
 		if (bx_td[i].bx_td_flags & BX_TD_TARGET_DEFINED) {
-			fprintf(stderr,"main: Creating target thread %d \n",i);
+if (Debug_Level) fprintf(stderr,"main: Creating target thread %d \n",i);
 			status = pthread_create(&Targets[i], NULL, target_main, &bx_td[i]);
 			if (status) {
 				perror("Cannot create target thread");
@@ -82,14 +91,34 @@ fprintf(stderr,"main: Buffer_Size=%d, number of targets=%d\n",Buffer_Size,Number
 			}
 		}
 	}
-	fprintf(stderr,"main: %d targets started\n",Number_Of_Targets);
+if (Debug_Level) fprintf(stderr,"main: %d targets started\n",Number_Of_Targets);
 
 	// Wait here for both target threads to complete then exit, stage left
-	fprintf(stderr,"main: WATING FOR %d targets to complete\n",Number_Of_Targets);
 	pthread_barrier_wait(&Main_Barrier);
-	fprintf(stderr,"main: %d targets have completed! \n",Number_Of_Targets);
+if (Debug_Level) fprintf(stderr,"main: %d targets have completed! \n",Number_Of_Targets);
+
+	// Show what each target moved. The elapsed time of every target ends 
+	// when the last buffer has gone all the way through the sequence.
+	status = 0;
+	fprintf(stdout,"Target, Direction, File, Bytes, Ops, Errors, Elapsed seconds, MB/sec\n");
+	for (i = 0; i < Sequence_Length; i++) {
+		p = &bx_td[Sequence[i]];
+		elapsed = (double)(bx_td[Sequence[0]].bx_td_end_time - p->bx_td_start_time) / BILLION;
+		bandwidth = (elapsed > 0.0) ? ((double)p->bx_td_bytes_transferred / elapsed / MILLION) : 0.0;
+		fprintf(stdout,"%d, %s, %s, %lld, %lld, %lld, %.3f, %.3f\n",
+			p->bx_td_my_target_number,
+			(p->bx_td_flags & BX_TD_INPUT)?"in":"out",
+			p->bx_td_file_name,
+			p->bx_td_bytes_transferred,
+			p->bx_td_ops,
+			p->bx_td_errors,
+			elapsed,
+			bandwidth);
+		if (p->bx_td_status)
+			status = 1;
+	}
 
 	// That's all folks
 
-    return 0;
+    return(status);
 } // End of main()
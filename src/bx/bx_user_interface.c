@@ -73,9 +73,9 @@
 int
 get_target_file_options(int target_number, int index, int argc, char *argv[]) {
 
-fprintf(stderr,"get_target_file_options: target_number=%d, index=%d, argc=%d\n",target_number,index,argc);
+if (Debug_Level) fprintf(stderr,"get_target_file_options: target_number=%d, index=%d, argc=%d\n",target_number,index,argc);
 	// Sanity check the number of remaining arguments
-	if (index+TARGET_FILE_LASTARG >= argc-1) {
+	if (index+TARGET_FILE_LASTARG > argc-1) {
 		fprintf(stderr, "get_target_file_options: Not enough remaining arguments\n");
 		return(-1);
 	}
@@ -84,31 +84,43 @@ fprintf(stderr,"get_target_file_options: target_number=%d, index=%d, argc=%d\n",
 
 	// FILENAME
 	bx_td[target_number].bx_td_file_name = argv[index+TARGET_FILE_NAME];
-fprintf(stderr,"get_target_file_options: target_number=%d,file name=%s\n",target_number, bx_td[target_number].bx_td_file_name);
+if (Debug_Level) fprintf(stderr,"get_target_file_options: target_number=%d,file name=%s\n",target_number, bx_td[target_number].bx_td_file_name);
 
-	// FILE SIZE
+	// FILE SIZE - 0 means the size of the input file
 	bx_td[target_number].bx_td_file_size = atoll(argv[index+TARGET_FILE_SIZE]);
-fprintf(stderr,"get_target_file_options: target_number=%d,file size=%lld\n",target_number, bx_td[target_number].bx_td_file_size);
+	if (bx_td[target_number].bx_td_file_size < 0) {
+		fprintf(stderr, "get_target_file_options: Invalid file size '%s'\n", argv[index+TARGET_FILE_SIZE]);
+		return(-1);
+	}
+if (Debug_Level) fprintf(stderr,"get_target_file_options: target_number=%d,file size=%lld\n",target_number, bx_td[target_number].bx_td_file_size);
 
 	// TRANSFER SIZE
 	bx_td[target_number].bx_td_transfer_size = atoi(argv[index+TARGET_FILE_XFER_SIZE]);
+	if ((bx_td[target_number].bx_td_transfer_size <= 0) || (bx_td[target_number].bx_td_transfer_size > MAX_BUFFER_SIZE)) {
+		fprintf(stderr, "get_target_file_options: Invalid transfer size '%s' - must be greater than 0 and no more than %d\n", argv[index+TARGET_FILE_XFER_SIZE], MAX_BUFFER_SIZE);
+		return(-1);
+	}
 	if (Buffer_Size <  bx_td[target_number].bx_td_transfer_size)
 		Buffer_Size =  bx_td[target_number].bx_td_transfer_size;
-fprintf(stderr,"get_target_file_options: target_number=%d,transfer size=%d\n",target_number, bx_td[target_number].bx_td_transfer_size);
+if (Debug_Level) fprintf(stderr,"get_target_file_options: target_number=%d,transfer size=%d\n",target_number, bx_td[target_number].bx_td_transfer_size);
 	
 	// OPTIONS
 	if (0 == strcmp(argv[index+TARGET_FILE_OPTIONS],"bio")) 
 		bx_td[target_number].bx_td_flags |= BX_TD_TYPE_FILE_BIO;
 	else if (0 == strcmp(argv[index+TARGET_FILE_OPTIONS],"dio")) 
 		bx_td[target_number].bx_td_flags |= BX_TD_TYPE_FILE_DIO;
-	else if (0 == strcmp(argv[index+TARGET_FILE_OPTIONS],"NULL")) 
+	else if (0 == strcasecmp(argv[index+TARGET_FILE_OPTIONS],"null")) 
 		bx_td[target_number].bx_td_flags |= BX_TD_TYPE_FILE_NULL;
 	else {
-		fprintf(stderr, "get_target_network_options: Invalid file option '%s' - must be 'bio', 'dio', or 'null'\n", argv[index+TARGET_FILE_OPTIONS]);
+		fprintf(stderr, "get_target_file_options: Invalid file option '%s' - must be 'bio', 'dio', or 'null'\n", argv[index+TARGET_FILE_OPTIONS]);
+		return(-1);
+	}
+	if ((bx_td[target_number].bx_td_flags & BX_TD_TYPE_FILE_DIO) && (bx_td[target_number].bx_td_transfer_size % BX_DIO_ALIGNMENT)) {
+		fprintf(stderr, "get_target_file_options: The transfer size of a 'dio' target must be a multiple of %d\n", BX_DIO_ALIGNMENT);
 		return(-1);
 	}
 
-fprintf(stderr,"get_target_file_options: return=%d\n",TARGET_FILE_LASTARG+1);
+if (Debug_Level) fprintf(stderr,"get_target_file_options: return=%d\n",TARGET_FILE_LASTARG+1);
 	return(TARGET_FILE_LASTARG+1);
 } // End of get_target_file_options()
 
@@ -124,7 +136,7 @@ get_target_network_options(int target_number, int index, int argc, char *argv[])
 	char	*cp;
 
 	// Sanity check the number of remaining arguments
-	if (index+TARGET_NETWORK_LASTARG >= argc-1) {
+	if (index+TARGET_NETWORK_LASTARG > argc-1) {
 		fprintf(stderr, "get_target_net_options: Not enough remaining arguments\n");
 		return(-1);
 	}
@@ -195,7 +207,7 @@ int
 get_target_sg_options(int target_number, int index, int argc, char *argv[]) {
 
 	// Sanity check the number of remaining arguments
-	if (index+TARGET_SG_LASTARG >= argc-1) {
+	if (index+TARGET_SG_LASTARG > argc-1) {
 		fprintf(stderr, "get_target_sg_options: Not enough remaining arguments\n");
 		return(-1);
 	}
@@ -225,7 +237,7 @@ get_target_options(int index, int argc, char *argv[]) {
 
 	// Target Number
 	// Sanity check the number of remaining arguments
-fprintf(stderr,"get_target_options: index=%d, argc=%d\n",index,argc);
+if (Debug_Level) fprintf(stderr,"get_target_options: index=%d, argc=%d\n",index,argc);
 	current_arg_index = index;
 	if (current_arg_index >= argc-1) {
 		fprintf(stderr, "get_target_options: Not enough remaining arguments\n");
@@ -294,7 +306,7 @@ fprintf(stderr,"get_target_options: index=%d, argc=%d\n",index,argc);
 
 	// At this point the status could be the number of arguments processed 
 	// or -1 if something went wrong
-fprintf(stderr,"get_target_options: return=%d\n",status);
+if (Debug_Level) fprintf(stderr,"get_target_options: return=%d\n",status);
 	return(status);
 
 } // End of get_target_options()
@@ -319,52 +331,98 @@ int
 get_sequence(int index, int current_argc, int argc, char *argv[]) {
 	int 	i;
 	int		new_index;
-	int		sequence_index;
 	int		target_number;
-	int		args_remaining;
-	char	*cp;
 
-fprintf(stderr,"get_sequence: index=%d, argc=%d\n",index,argc);
-	args_remaining = argc-index-1;
-	if (args_remaining == 0)
-		return(0);
+if (Debug_Level) fprintf(stderr,"get_sequence: index=%d, argc=%d\n",index,argc);
+	Sequence_Length = 0;
 	new_index = index+1;
-	args_remaining = argc-new_index-1;
-	if (args_remaining == 0)
-		return(0);
-	cp = argv[new_index];
-
-	sequence_index = 0;
-	while (*cp != '-') {
-		if (sequence_index > MAX_SEQUENCE_ENTRIES-1) {
+	while ((new_index < argc) && (argv[new_index][0] != '-')) {
+		if (Sequence_Length > MAX_SEQUENCE_ENTRIES-1) {
 			fprintf(stderr, "get_sequence: Too many targets specified in this sequence - must be less than %d\n", MAX_SEQUENCE_ENTRIES);
 			return(-1);
 		}
-		Sequence[sequence_index] = atoi(argv[new_index]);
-		if ((Sequence[sequence_index] < 0) || (Sequence[sequence_index] > MAX_TARGETS)) {
-			fprintf(stderr, "get_sequence: Invalid sequence number '%d' - must be between 0 and %d\n", Sequence[sequence_index],MAX_TARGETS);
+		target_number = atoi(argv[new_index]);
+		if ((target_number < 0) || (target_number >= MAX_TARGETS)) {
+			fprintf(stderr, "get_sequence: Invalid sequence number '%d' - must be between 0 and %d\n", target_number,MAX_TARGETS-1);
 			return(-1);
 		}
-fprintf(stderr,"get_sequence: sequence_index %d, Sequence is %d, argc=%d, new_index=%d\n",sequence_index, Sequence[sequence_index],argc,new_index);
-		Sequence[sequence_index+1] = Sequence[0]; // Points to the first target in the sequence
+		Sequence[Sequence_Length++] = target_number;
 		new_index++;
-		args_remaining = argc-new_index;
-		if (args_remaining == 0)
-			break;
-		cp = argv[new_index];
-		sequence_index++;
 	}
-	// At this point the "sequence_index" is the number of targets in the sequence
+	if (Sequence_Length == 0) {
+		fprintf(stderr, "get_sequence: No targets specified in the sequence\n");
+		return(-1);
+	}
+	Sequence[Sequence_Length] = Sequence[0]; // Points to the first target in the sequence
+
 	// We need to point the bx_td of each target to the subsequent target
-	for (i = 0; i < sequence_index; i++) {
+	for (i = 0; i < Sequence_Length; i++) {
 		target_number = Sequence[i];
 		bx_td[target_number].bx_td_next_buffer_queue = Sequence[i+1];
 	}
-fprintf(stderr,"get_sequence: return=%d\n",sequence_index);
-	return(sequence_index+2);
+if (Debug_Level) fprintf(stderr,"get_sequence: return=%d\n",Sequence_Length+1);
+	return(Sequence_Length+1);
 
 } // End of get_sequence()
 
+//---------------------------------------------------------------------------//
+// check_targets() makes sure the targets and the sequence describe a copy 
+// that can be done. 
+// If no --sequence was specified then the targets are used in the order of
+// their target numbers.
+// The first target in the sequence is the INPUT target and all of the 
+// others are OUTPUT targets that each get a copy of the data.
+// Upon success this subroutine will return 0.
+//
+int
+check_targets(void) {
+	int		i;
+	int		target_number;
+
+
+	if (Sequence_Length == 0) {
+		for (i = 0; i < MAX_TARGETS; i++) {
+			if (bx_td[i].bx_td_flags & BX_TD_TARGET_DEFINED) {
+				Sequence[Sequence_Length++] = i;
+			}
+		}
+		Sequence[Sequence_Length] = Sequence[0];
+		for (i = 0; i < Sequence_Length; i++) 
+			bx_td[Sequence[i]].bx_td_next_buffer_queue = Sequence[i+1];
+	}
+	if (Sequence_Length < 2) {
+		fprintf(stderr, "check_targets: At least one input and one output target are needed\n");
+		return(-1);
+	}
+	if (Sequence_Length != Number_Of_Targets) {
+		fprintf(stderr, "check_targets: The sequence has %d targets but %d targets were specified\n", Sequence_Length, Number_Of_Targets);
+		return(-1);
+	}
+	for (i = 0; i < Sequence_Length; i++) {
+		target_number = Sequence[i];
+		if (!(bx_td[target_number].bx_td_flags & BX_TD_TARGET_DEFINED)) {
+			fprintf(stderr, "check_targets: Target %d is in the sequence but was not specified\n", target_number);
+			return(-1);
+		}
+		if ((i == 0) && !(bx_td[target_number].bx_td_flags & BX_TD_INPUT)) {
+			fprintf(stderr, "check_targets: The first target in the sequence, target %d, must be an 'in' target\n", target_number);
+			return(-1);
+		}
+		if ((i > 0) && !(bx_td[target_number].bx_td_flags & BX_TD_OUTPUT)) {
+			fprintf(stderr, "check_targets: Target %d must be an 'out' target\n", target_number);
+			return(-1);
+		}
+		// Every target moves the buffers of the INPUT target
+		bx_td[target_number].bx_td_transfer_size = bx_td[Sequence[0]].bx_td_transfer_size;
+	}
+	if (Number_Of_Buffers > MAX_NUMBER_OF_BUFFERS) {
+		fprintf(stderr, "check_targets: Too many buffers - must be no more than %d\n", MAX_NUMBER_OF_BUFFERS);
+		return(-1);
+	}
+	return(0);
+
+} // End of check_targets()
+
 int
 ui(int argc, char *argv[]) {
 	int		i;
@@ -377,43 +435,51 @@ ui(int argc, char *argv[]) {
 	current_argc = argc;
 	i = 1;
 	while (current_argc > 1) {
-fprintf(stderr,"ui: current_argc=%d\n",current_argc);
+if (Debug_Level) fprintf(stderr,"ui: current_argc=%d\n",current_argc);
 		if (0 == strcmp(argv[i],"--target")) {
-fprintf(stderr,"ui: getting target options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
+if (Debug_Level) fprintf(stderr,"ui: getting target options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
 			status = get_target_options(i, argc, argv);
 			if (status < 0)
 				break;
 			current_argc -= status;
 			i += status;
 		} else if (0 == strcmp(argv[i],"--buffers")) {
-fprintf(stderr,"ui: getting buffer options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
+if (Debug_Level) fprintf(stderr,"ui: getting buffer options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
+			if (i+1 >= argc) {
+				fprintf(stderr,"ui: The number of buffers must be specified\n");
+				return(-1);
+			}
 			Number_Of_Buffers = atoi(argv[i+1]);
-			if (Number_Of_Buffers < 1)
-				break;
+			if (Number_Of_Buffers < 1) {
+				fprintf(stderr,"ui: Invalid number of buffers '%s'\n",argv[i+1]);
+				return(-1);
+			}
 			current_argc -= 2;
 			i += 2;
-fprintf(stderr,"ui: got buffer options - current_argc=%d, i=%d\n",current_argc,i);
+if (Debug_Level) fprintf(stderr,"ui: got buffer options - current_argc=%d, i=%d\n",current_argc,i);
 		} else if (0 == strcmp(argv[i],"--debug")) {
-fprintf(stderr,"ui: getting debug options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
+if (Debug_Level) fprintf(stderr,"ui: getting debug options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
+			if (i+1 >= argc) {
+				fprintf(stderr,"ui: The debug level must be specified\n");
+				return(-1);
+			}
 			Debug_Level = atoi(argv[i+1]);
-			if (Number_Of_Buffers < 1)
-				break;
 			current_argc -= 2;
 			i += 2;
 		} else if (0 == strcmp(argv[i],"--sequence")) {
-fprintf(stderr,"ui: getting sequence options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
+if (Debug_Level) fprintf(stderr,"ui: getting sequence options - current_argc=%d, i=%d, argv[i]='%s'\n",current_argc,i,argv[i]);
 			status = get_sequence(i, current_argc, argc, argv);
 			if (status < 0)
 				break;
 			current_argc -= status;
 			i += status;
-fprintf(stderr,"ui: got sequence options - current_argc=%d, status=%d, i=%d\n",current_argc,status,i);
+if (Debug_Level) fprintf(stderr,"ui: got sequence options - current_argc=%d, status=%d, i=%d\n",current_argc,status,i);
 		} else { 
 			fprintf(stderr,"ui: Invalid argument: '%s'\n",argv[i]);
 			usage(argv[0]);
 			return(-1);
 		}
-fprintf(stderr,"ui: end of WHILE - current_argc=%d, status=%d, argc=%d\n",current_argc,status,argc);
+if (Debug_Level) fprintf(stderr,"ui: end of WHILE - current_argc=%d, status=%d, argc=%d\n",current_argc,status,argc);
 
 	} 
 
@@ -426,11 +492,16 @@ fprintf(stderr,"ui: end of WHILE - current_argc=%d, status=%d, argc=%d\n",curren
 void
 usage(char *progname) {
 
-	fprintf(stderr,"Usage: %s --target <options> --buffers # --sequence <# # #...#> --debug\n",progname);
+	fprintf(stderr,"Usage: %s --target <options> [--buffers #] [--sequence <# # #...#>] [--debug #]\n",progname);
 	fprintf(stderr,"The following is the format of the --target option\n");
 	fprintf(stderr,"   0     1 2            3             4             5               6                    7                8\n");
 	fprintf(stderr,"--target # <in|out|int> #WorkerThreads     <file|net|sg> <options>\n");
-	fprintf(stderr,"--target # <in|out|int> #WorkerThreads     file          <filename>      <file_size>          <transfer_size>  <dio,null,sync>\n");
+	fprintf(stderr,"--target # <in|out|int> #WorkerThreads     file          <filename>      <file_size>          <transfer_size>  <bio,dio,null>\n");
 	fprintf(stderr,"--target # <in|out|int> #WorkerThreads     network       <client|server> <user@hostname:port> <TCP|UDP|UDT>\n");
 	fprintf(stderr,"--target # <in|out|int> #WorkerThreads     sg            /dev/sg#\n");
+	fprintf(stderr,"Only file targets are supported. A file size of 0 for the 'in' target copies the whole file.\n");
+	fprintf(stderr,"'dio' opens the file with O_DIRECT and needs a transfer size that is a multiple of %d.\n", BX_DIO_ALIGNMENT);
+	fprintf(stderr,"--buffers is the number of buffers in flight between the targets [Default: one per Worker Thread]\n");
+	fprintf(stderr,"--sequence is the order the buffers go through the targets, starting with the 'in' target\n");
+	fprintf(stderr,"    [Default: the targets in target number order]\n");
 }
@@ -62,13 +62,22 @@
 // At some point the Worker Thread will wake up and find the "TERMINATE" 
 // flag set in its Worker Thread Data Structure . At this point the Worker 
 // Thread will break the loop and terminate. 
+//
+// Since the INPUT and OUTPUT targets each have their own Worker Threads 
+// and the buffers are passed between them on queues, reads of one part of
+// the file overlap writes of another part. No Worker Thread ever does both.
+// An operation that fails marks the target as failed. A buffer that could 
+// not be read is still passed along so the pipeline drains, but nothing 
+// is written from it.
 void *
 worker_thread_main(void *pin) {   
-    int 	status;
+	ssize_t					status;
 	struct bx_td 			*bx_tdp;
 	struct bx_wd 			*bx_wdp;
 	struct bx_buffer_queue 	*qp;
 	struct bx_buffer_header	*bufhdrp;
+	size_t					length;
+	int						fd;
 	nclk_t					nclk;
 
 
@@ -76,10 +85,6 @@ worker_thread_main(void *pin) {
 	bx_tdp = bx_wdp->bx_wd_my_bx_tdp;
 nclk_now(&nclk);
 if (DEBUG) fprintf(stderr,"%llu: worker_thread_main: ENTER: bx_wdp=%p, bx_tdp=%p\n", (unsigned long long int)nclk,bx_wdp, bx_tdp);
-	status = 0;
-	
-nclk_now(&nclk);
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s - ENTER %d\n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number);
 
 	while (1) {
 		// Set flag to indicate that this worker_thread is WAITING
@@ -88,55 +93,73 @@ if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s -
 		bx_wd_enqueue(bx_wdp, bx_wdp->bx_wd_my_queue);
 		// Wait for the target thread to release me
 		pthread_mutex_lock(&bx_wdp->bx_wd_mutex);
-nclk_now(&nclk);
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s - got the bx_wd_mutex lock - waiting for something to do - time %d\n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number);
-		bx_wdp->bx_wd_flags |= BX_WD_WAITING;
 		while (1 != bx_wdp->bx_wd_released) {
          	pthread_cond_wait(&bx_wdp->bx_wd_conditional, &bx_wdp->bx_wd_mutex);
 		}
 		bx_wdp->bx_wd_flags &= ~BX_WD_WAITING;
 		bx_wdp->bx_wd_released = 0;
-		if (bx_wdp->bx_wd_flags & BX_WD_TERMINATE)
+		if (bx_wdp->bx_wd_flags & BX_WD_TERMINATE) {
+			pthread_mutex_unlock(&bx_wdp->bx_wd_mutex);
 			break;
+		}
 
-nclk_now(&nclk);
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s - got the bx_wd_mutex lock - GOT something to do - time %d\n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number);
-
-bx_wd_show(bx_wdp);
 		bufhdrp = bx_wdp->bx_wd_bufhdrp;
 		if (bx_tdp->bx_td_flags & BX_TD_INPUT) { // Read the input file
-			status = pread(bx_wdp->bx_wd_fd, bufhdrp->bh_startp, bufhdrp->bh_transfer_size, bufhdrp->bh_file_offset);
+			// A "dio" read has to be a multiple of the alignment. The read 
+			// stops at the end of the file so the length is rounded up.
+			length = bufhdrp->bh_transfer_size;
+			if (bx_tdp->bx_td_flags & BX_TD_TYPE_FILE_DIO)
+				length = (length + BX_DIO_ALIGNMENT - 1) & ~((size_t)BX_DIO_ALIGNMENT - 1);
+			if (bx_tdp->bx_td_flags & BX_TD_TYPE_FILE_NULL)
+				status = bufhdrp->bh_transfer_size;
+			else status = pread(bx_wdp->bx_wd_fd, bufhdrp->bh_startp, length, bufhdrp->bh_file_offset);
 			if (status < 0) {
-				perror("Read error");
+				perror("worker_thread_main: Read error");
 				bufhdrp->bh_valid_size = 0;
+				bufhdrp->bh_flags |= BX_BUFHDR_ERROR;
+				__atomic_add_fetch(&bx_tdp->bx_td_errors, 1, __ATOMIC_RELAXED);
 			} else {
+				if (status > bufhdrp->bh_transfer_size)
+					status = bufhdrp->bh_transfer_size;
 				bufhdrp->bh_valid_size = status;
+				bufhdrp->bh_flags &= ~BX_BUFHDR_ERROR;
+				__atomic_add_fetch(&bx_tdp->bx_td_bytes_transferred, status, __ATOMIC_RELAXED);
 			}
+			bufhdrp->bh_valid_startp = bufhdrp->bh_startp;
+			bufhdrp->bh_target = bx_tdp->bx_td_my_target_number;
 nclk_now(&nclk);
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s - read %d of %d bytes starting at offset %d - time %zd\n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number,status,bufhdrp->bh_transfer_size,bufhdrp->bh_file_offset);
-			// Put this buffer on the output target queue
-			qp = &bx_td[bx_wdp->bx_wd_next_buffer_queue].bx_td_buffer_queue;
-			bh_enqueue(bx_wdp->bx_wd_bufhdrp, qp);
+if (DEBUG) fprintf(stderr,"%llu worker_thread_main: INPUT %d - read %zd of %d bytes starting at offset %lld\n", (unsigned long long int)nclk,bx_wdp->bx_wd_my_worker_thread_number,status,bufhdrp->bh_transfer_size,(long long int)bufhdrp->bh_file_offset);
 		} else { // Must be output
-			status = pwrite(bx_wdp->bx_wd_fd, bufhdrp->bh_startp, bufhdrp->bh_transfer_size, bufhdrp->bh_file_offset);
-			if (status < 0) {
-				perror("Write error");
-				bufhdrp->bh_valid_size = 0;
-			} else {
-				bufhdrp->bh_valid_size = status;
+			// Nothing is written from a buffer that could not be read
+			status = 0;
+			if (!(bufhdrp->bh_flags & BX_BUFHDR_ERROR) && (bufhdrp->bh_valid_size > 0)) {
+				// The unaligned tail of a "dio" target is written through the buffered file descriptor
+				fd = bx_wdp->bx_wd_fd;
+				if ((bx_tdp->bx_td_flags & BX_TD_TYPE_FILE_DIO) && 
+					((bufhdrp->bh_valid_size % BX_DIO_ALIGNMENT) || (bufhdrp->bh_file_offset % BX_DIO_ALIGNMENT)))
+					fd = bx_tdp->bx_td_tail_fd;
+				if (bx_tdp->bx_td_flags & BX_TD_TYPE_FILE_NULL)
+					status = bufhdrp->bh_valid_size;
+				else status = pwrite(fd, bufhdrp->bh_valid_startp, bufhdrp->bh_valid_size, bufhdrp->bh_file_offset);
+				if (status < 0) {
+					perror("worker_thread_main: Write error");
+					__atomic_add_fetch(&bx_tdp->bx_td_errors, 1, __ATOMIC_RELAXED);
+				} else if (status < bufhdrp->bh_valid_size) {
+					fprintf(stderr,"worker_thread_main: Short write of %zd of %d bytes at offset %lld\n", status, bufhdrp->bh_valid_size, (long long int)bufhdrp->bh_file_offset);
+					__atomic_add_fetch(&bx_tdp->bx_td_errors, 1, __ATOMIC_RELAXED);
+				}
+				if (status > 0)
+					__atomic_add_fetch(&bx_tdp->bx_td_bytes_transferred, status, __ATOMIC_RELAXED);
 			}
 nclk_now(&nclk);
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s - wrote %d of %d bytes starting at offset %d - requeuing buffer %zd - time %p\n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number,status,bufhdrp->bh_transfer_size,bufhdrp->bh_file_offset, bufhdrp);
-			// Put this buffer on the input target queue
-			qp = &bx_td[bx_wdp->bx_wd_next_buffer_queue].bx_td_buffer_queue;
-			bh_enqueue(bufhdrp, qp);
-			bufqueue_show(qp);
+if (DEBUG) fprintf(stderr,"%llu worker_thread_main: OUTPUT %d - wrote %zd of %d bytes starting at offset %lld - requeuing buffer %p\n", (unsigned long long int)nclk,bx_wdp->bx_wd_my_worker_thread_number,status,bufhdrp->bh_valid_size,(long long int)bufhdrp->bh_file_offset, bufhdrp);
 		}
-nclk_now(&nclk);
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s - transferred %d bytes - time %d\n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number,status);
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s - releasing the bx_wd_mutex lock %d\n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number);
+		__atomic_add_fetch(&bx_tdp->bx_td_ops, 1, __ATOMIC_RELAXED);
+		// Put this buffer on the queue of the next target in the sequence
+		qp = &bx_td[bx_wdp->bx_wd_next_buffer_queue].bx_td_buffer_queue;
+		bh_enqueue(bufhdrp, qp);
 		pthread_mutex_unlock(&bx_wdp->bx_wd_mutex);
 	}
-if (DEBUG) fprintf(stderr,"%llu worker_thread_main: my_worker_thread_number=%s %d - Exit \n", (unsigned long long int)nclk,(bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number);
+if (DEBUG) fprintf(stderr,"worker_thread_main: %s %d - Exit \n", (bx_tdp->bx_td_flags & BX_TD_INPUT)?"INPUT":"OUTPUT", bx_wdp->bx_wd_my_worker_thread_number);
    	return 0;
 } // End of worker_thread_main()
@@ -1,5 +1,5 @@
 #
-# Module makefile for the lite client
+# Module makefile for the bx buffer exchange copy pipeline
 #
 DIR := src/bx
 
@@ -11,13 +11,15 @@
  *
  */
 # --target # <in|out|int> #WorkerThreads     <file|net|sg> <options>
-# --target # <in|out|int> #WorkerThreads     file          <filename>      <file_size>          <transfer_size>  <dio,null,sync>
+# --target # <in|out|int> #WorkerThreads     file          <filename>      <file_size>          <transfer_size>  <bio,dio,null>
 # --target # <in|out|int> #WorkerThreads     network       <client|server> <user@hostname:port> <TCP|UDP|UDT>
 # --target # <in|out|int> #WorkerThreads     sg            /dev/sg#
-./bxt --target 0 in  3 file /tmp/test_input_file  12345678 1048576 bio \
-      --target 1 out 1 file /tmp/test_output_file 12345678 1048576 bio \
-      --target 2 out 2 file /tmp/test_output_file2 1234567  1048576 bio \
-	  --buffers 3 \
+# Target 0 is read with 3 Worker Threads while targets 1 and 2 are written,
+# so the reads overlap the writes. A file size of 0 copies the whole input.
+./bxt --target 0 in  3 file /tmp/test_input_file  0 1048576 dio \
+      --target 1 out 1 file /tmp/test_output_file 0 1048576 dio \
+      --target 2 out 2 file /tmp/test_output_file2 0 1048576 bio \
+	  --buffers 6 \
 	  --sequence 0 1 2
 
   
@@ -117,6 +117,7 @@ xdd_system_info(xdd_plan_t* planp, FILE *out) {
 	fprintf(out, "Number of physical pages, %d\n", physical_pages);
 	fprintf(out, "Megabytes of physical memory, %d\n", memory_size);
 	fprintf(out, "Clock Ticks per second, %d\n", xgp->clock_tick);
+	fprintf(out, "Nanosecond clock source, %s\n", nclk_source());
 #elif (WIN32)
 	SYSTEM_INFO system_info; /* Structure to receive system information */
 	OSVERSIONINFOEXA osversion_info;
@@ -187,6 +188,9 @@ xdd_options_info(xdd_plan_t* planp, FILE *out) {
 	fprintf(out, "Maximum Error Threshold, %lld\n", (long long)xgp->max_errors);
 	fprintf(out, "Target Offset, %lld\n",(long long)planp->target_offset);
 	fprintf(out, "I/O Synchronization, %d\n", planp->syncio);
+	if (planp->worker_pool_threads > 0)
+		fprintf(out, "Shared Worker Thread pool, %d threads\n", planp->worker_pool_threads);
+	else fprintf(out, "Shared Worker Thread pool, disabled\n");
 	fprintf(out, "Total run-time limit in seconds, %f\n", planp->run_time);
 
 	fprintf(out, "Output file name, %s\n",xgp->output_filename);
@@ -229,6 +233,13 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
     if (tdp->td_processor == -1) 
 		    fprintf(out,"\t\tProcessor, all/any\n");
 	else fprintf(out,"\t\tProcessor, %d\n",tdp->td_processor);
+	if (tdp->td_numa_node == XINT_NUMA_OFF) 
+		fprintf(out,"\t\tNUMA node, off\n");
+	else if (tdp->td_numa_node == XINT_NUMA_AUTO) 
+		fprintf(out,"\t\tNUMA node, auto\n");
+	else fprintf(out,"\t\tNUMA node, %d\n",tdp->td_numa_node);
+	if (tdp->td_stream_name)
+		fprintf(out,"\t\tWorkload stream, %s, %s\n",tdp->td_stream_name,(tdp->td_stream_type & XINT_STREAM_BACKGROUND)?"background":"foreground");
 	fprintf(out,"\t\tRead/write ratio, %5.2f READ, %5.2f WRITE\n",tdp->td_rwratio*100.0,(1.0-tdp->td_rwratio)*100.0);
 	fprintf(out,"\t\tNetwork Operation Ordering is,");
 	if (tdp->td_target_options & TO_ORDERING_NETWORK_SERIAL) 
@@ -245,14 +256,31 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 	if (tdp->td_throtp) {
 		fprintf(out,"\t\tThrottle in %s is, %6.2f\n",
 			(tdp->td_throtp->throttle_type & XINT_THROTTLE_OPS)?"ops/sec":((tdp->td_throtp->throttle_type & XINT_THROTTLE_BW)?"MB/sec":"Delay"), tdp->td_throtp->throttle);
+		if (tdp->td_throtp->throttle_burst > 0.0)
+			fprintf(out,"\t\tThrottle burst in %s, %6.2f\n",
+				(tdp->td_throtp->throttle_type & XINT_THROTTLE_OPS)?"ops":"MB", tdp->td_throtp->throttle_burst);
 	} else {
 		fprintf(out,"\t\tThrottle is unrestricted\n");
 	}
+	if ((tdp->td_arrivalp) && (tdp->td_arrivalp->arrival_rate > 0.0)) {
+		fprintf(out,"\t\tOpen-loop arrivals in ops/sec, %s, %6.2f\n",
+			(tdp->td_arrivalp->arrival_type & XINT_ARRIVAL_CONSTANT)?"constant":((tdp->td_arrivalp->arrival_type & XINT_ARRIVAL_BURSTY)?"bursty":"poisson"), tdp->td_arrivalp->arrival_rate);
+		if (tdp->td_arrivalp->arrival_type & XINT_ARRIVAL_BURSTY)
+			fprintf(out,"\t\tOpen-loop arrival burst in ops, %d\n",tdp->td_arrivalp->arrival_burst);
+	}
 	fprintf(out,"\t\tPer-pass time limit in seconds, %f\n",tdp->td_time_limit);
 	fprintf(out,"\t\tPass seek randomization, %s", (tdp->td_target_options & TO_PASS_RANDOMIZE)?"enabled\n":"disabled\n");
 	fprintf(out,"\t\tFile write synchronization, %s", (tdp->td_target_options & TO_SYNCWRITE)?"enabled\n":"disabled\n");
 	fprintf(out,"\t\tBlocksize in bytes, %d\n", tdp->td_block_size);
 	fprintf(out,"\t\tRequest size, %d, %d-byte blocks, %d, bytes\n",tdp->td_reqsize,tdp->td_block_size,tdp->td_reqsize*tdp->td_block_size);
+	if (tdp->td_replayp) 
+		fprintf(out,"\t\tReplay of trace file, %s, %lld, ops, speedup, %.2f\n",tdp->td_replayp->replay_filename,(long long int)tdp->td_replayp->replay_ops,tdp->td_replayp->replay_speedup);
+	if (tdp->td_rsmp) {
+		fprintf(out,"\t\tRequest size mix, ");
+		for (i = 0; i < (size_t)tdp->td_rsmp->rsm_classes; i++)
+			fprintf(out,"%s%lld:%d", (i)?",":"", (long long int)tdp->td_rsmp->rsm_bytes[i], tdp->td_rsmp->rsm_weight[i]);
+		fprintf(out,", bytes:weight\n");
+	}
 	fprintf(out,"\t\tNumber of Operations, %lld\n", (long long int)tdp->td_target_ops);
 
 	// Total Data Transfer for this TARGET
@@ -279,10 +307,19 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 	fprintf(out,"\t\tI/O memory buffer is %s\n", 
 		(tdp->td_target_options & TO_SHARED_MEMORY)?"a shared memory segment":"a normal memory buffer");
 	fprintf(out,"\t\tI/O memory buffer alignment in bytes, %d\n", tdp->td_mem_align);
+	if (tdp->td_buffer_poolp) 
+		fprintf(out,"\t\tI/O memory buffer huge pages, %lld bytes, %s, pool size %lld bytes\n",
+			(long long int)tdp->td_hugepage_size,
+			(tdp->td_buffer_pool_hugetlb) ? "hugetlb" : "transparent",
+			(long long int)tdp->td_buffer_pool_size);
+	else fprintf(out,"\t\tI/O memory buffer huge pages, off\n");
 	if (tdp->td_dpp) {
 		dpp = tdp->td_dpp;
 		fprintf(out,"\t\tData pattern in buffer");
-                if (dpp->data_pattern_options & (DP_RANDOM_PATTERN | DP_RANDOM_BY_TARGET_PATTERN | DP_SEQUENCED_PATTERN | DP_INVERSE_PATTERN | DP_ASCII_PATTERN | DP_HEX_PATTERN | DP_PATTERN_PREFIX)) {
+		if (dpp->data_pattern_options & DP_REDUCIBLE_PATTERN) {
+			fprintf(out,",reducible, compression ratio %.2f, dedupe ratio %.2f, %d-byte blocks\n",
+				dpp->data_pattern_compress_ratio, dpp->data_pattern_dedupe_ratio, tdp->td_block_size);
+		} else if (dpp->data_pattern_options & (DP_RANDOM_PATTERN | DP_RANDOM_BY_TARGET_PATTERN | DP_SEQUENCED_PATTERN | DP_INVERSE_PATTERN | DP_ASCII_PATTERN | DP_HEX_PATTERN | DP_PATTERN_PREFIX)) {
 			if (dpp->data_pattern_options & DP_RANDOM_PATTERN) fprintf(out,",random ");
                         if (dpp->data_pattern_options & DP_RANDOM_BY_TARGET_PATTERN) fprintf(out,",random by target number ");
 			if (dpp->data_pattern_options & DP_SEQUENCED_PATTERN) fprintf(out,",sequenced ");
@@ -309,22 +346,40 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 			fprintf(out," From file: %s\n",dpp->data_pattern_filename);
 	}
 	fprintf(out,"\t\tData buffer verification is");
-	if ((tdp->td_target_options & (TO_VERIFY_LOCATION | TO_VERIFY_CONTENTS)))
+	if (tdp->td_target_options & TO_VERIFY_CHECKSUM)
+		fprintf(out," enabled for CRC32C Checksum verification of each %d-byte block.\n", tdp->td_block_size);
+	else if ((tdp->td_target_options & (TO_VERIFY_LOCATION | TO_VERIFY_CONTENTS)))
 		fprintf(out," enabled for %s verification.\n", (tdp->td_target_options & TO_VERIFY_LOCATION)?"Location":"Content");
 	else fprintf(out," disabled.\n");
 	fprintf(out,"\t\tDirect I/O, %s", (tdp->td_target_options & TO_DIO)?"enabled\n":"disabled\n");
 	fprintf(out, "\t\tPreallocation, %lld\n",(long long int)tdp->td_preallocate);
 	fprintf(out, "\t\tPretruncation, %lld\n",(long long int)tdp->td_pretruncate);
 	fprintf(out, "\t\tQueue Depth, %d\n",tdp->td_queue_depth);
+	fprintf(out, "\t\tWorker Threads, %s\n",(tdp->td_worker_poolp) ? "shared pool" : "dedicated");
+	if (tdp->td_target_options & TO_IO_MMAP) {
+		fprintf(out, "\t\tI/O Engine, mmap");
+		if (tdp->td_mmapp) 
+			fprintf(out, "%s%s%s%s",
+				(tdp->td_mmapp->mmap_options & XINT_MMAP_POPULATE)?", populate":"",
+				(tdp->td_mmapp->mmap_options & XINT_MMAP_SYNC)?", sync":"",
+				(tdp->td_mmapp->mmap_advice >= 0)?", advise ":"",
+				(tdp->td_mmapp->mmap_advice >= 0)?tdp->td_mmapp->mmap_advice_name:"");
+		fprintf(out, "\n");
+	} else if ((tdp->td_target_options & TO_IO_COPY) && (tdp->td_copyp)) {
+		fprintf(out, "\t\tI/O Engine, copy from '%s'%s\n", 
+			tdp->td_copyp->copy_source,
+			(tdp->td_copyp->copy_options & XINT_COPY_NOCLONE)?", noclone":"");
+	} else fprintf(out, "\t\tI/O Engine, %s\n", (tdp->td_target_options & TO_IO_URING)?"uring":"sync");
 	/* Timestamp options */
 	if (tdp->td_ts_table.ts_options & TS_ON) {
-                fprintf(out, "\t\tTimestamping, enabled with options, %s %s %s %s %s %s\n",
+                fprintf(out, "\t\tTimestamping, enabled with options, %s %s %s %s %s %s %s\n",
                    ( tdp->td_ts_table.ts_options & TS_DETAILED   )?"DETAILED":"", 
                    ( tdp->td_ts_table.ts_options & TS_SUMMARY    )?"SUMMARY":"",
                    ( tdp->td_ts_table.ts_options & TS_NORMALIZE  )?"NORMALIZE":"",
                    ( tdp->td_ts_table.ts_options & TS_APPEND     )?"APPEND":"",
                    ( tdp->td_ts_table.ts_options & TS_WRAP       )?"WRAP":"",
-                   ( tdp->td_ts_table.ts_options & TS_ONESHOT    )?"ONESHOT":"");
+                   ( tdp->td_ts_table.ts_options & TS_ONESHOT    )?"ONESHOT":"",
+                   ( tdp->td_ts_table.ts_options & TS_STREAM     )?"STREAM":"");
                 if ( tdp->td_ts_table.ts_options & TS_TRIGTIME   ) fprintf(out,"TRIGTIME %llu",tdp->td_ts_table.ts_trigtime);
                 if ( tdp->td_ts_table.ts_options & TS_TRIGOP     ) fprintf(out,":TRIGOP %"PRId64,tdp->td_ts_table.ts_trigop);
 		if ( tdp->td_ts_table.ts_output_filename != NULL ) fprintf(out, "\t\tTimestamp ASCII output file name, %s\n",tdp->td_ts_table.ts_output_filename);
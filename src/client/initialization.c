@@ -40,7 +40,9 @@ xdd_initialization(int32_t argc,char *argv[], xdd_plan_t *planp) {
 
 	// Init output format header
 	if (planp->plan_options & PLAN_ENDTOEND) 
-		xdd_results_format_id_add("+E2ESRTIME+E2EIOTIME+E2EPERCENTSRTIME ", planp->format_string);
+		planp->format_string = xdd_results_format_id_add("+E2ESRTIME+E2EIOTIME+E2EPERCENTSRTIME ", planp->format_string);
+	if (planp->plan_options & PLAN_ARRIVALS) 
+		planp->format_string = xdd_results_format_id_add("+BACKLOGMAX+BACKLOGAVG+ISSUELAGMAX ", planp->format_string);
 
 	// Optimize runtime priorities and all that 
 	// See schedule.c
@@ -499,11 +499,115 @@ xdd_get_throtp(target_data_t *tdp) {
 		tdp->td_throtp->throttle = XINT_DEFAULT_THROTTLE;
 		tdp->td_throtp->throttle_variance = XINT_DEFAULT_THROTTLE_VARIANCE;
 		tdp->td_throtp->throttle_type = XINT_DEFAULT_THROTTLE_TYPE;
+		tdp->td_throtp->throttle_burst = 0.0;
+		tdp->td_throtp->throttle_started = 0;
 	}
 	return(tdp->td_throtp);
 
 } /* End of xdd_get_throtp() */
 
+/*----------------------------------------------------------------------------*/
+/* xdd_get_arrivalp() - return a pointer to the XDD Arrival Data Structure 
+ */
+xint_arrival_t *
+xdd_get_arrivalp(target_data_t *tdp) {
+
+	if (tdp->td_arrivalp == 0) { // If there is no existing Arrival structure, allocate a new one 
+		tdp->td_arrivalp = malloc(sizeof(xint_arrival_t));
+		if (tdp->td_arrivalp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for ARRIVAL variables for target %d\n",
+			xgp->progname, (int)sizeof(xint_arrival_t), tdp->td_target_number);
+			return(NULL);
+		}
+		// Set default Arrival values in the newly allocated arrival structure
+		memset(tdp->td_arrivalp, 0, sizeof(xint_arrival_t));
+		tdp->td_arrivalp->arrival_type = XINT_ARRIVAL_POISSON;
+		tdp->td_arrivalp->arrival_burst = XINT_DEFAULT_ARRIVAL_BURST;
+	}
+	return(tdp->td_arrivalp);
+
+} /* End of xdd_get_arrivalp() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_rsmp() - return a pointer to the XDD Request Size Mix Structure 
+ */
+xint_reqsize_mix_t *
+xdd_get_rsmp(target_data_t *tdp) {
+
+	if (tdp->td_rsmp == 0) { // If there is no existing Request Size Mix structure, allocate a new one 
+		tdp->td_rsmp = malloc(sizeof(xint_reqsize_mix_t));
+		if (tdp->td_rsmp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for REQUEST SIZE MIX variables for target %d\n",
+			xgp->progname, (int)sizeof(xint_reqsize_mix_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_rsmp, 0, sizeof(xint_reqsize_mix_t));
+	}
+	return(tdp->td_rsmp);
+
+} /* End of xdd_get_rsmp() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_replayp() - return a pointer to the XDD Replay Structure 
+ */
+xint_replay_t *
+xdd_get_replayp(target_data_t *tdp) {
+
+	if (tdp->td_replayp == 0) { // If there is no existing Replay structure, allocate a new one 
+		tdp->td_replayp = malloc(sizeof(xint_replay_t));
+		if (tdp->td_replayp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for REPLAY variables for target %d\n",
+			xgp->progname, (int)sizeof(xint_replay_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_replayp, 0, sizeof(xint_replay_t));
+		tdp->td_replayp->replay_speedup = 1.0;
+	}
+	return(tdp->td_replayp);
+
+} /* End of xdd_get_replayp() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_mmapp() - return a pointer to the XDD mmap Engine Structure 
+ */
+xint_mmap_t *
+xdd_get_mmapp(target_data_t *tdp) {
+
+	if (tdp->td_mmapp == 0) { // If there is no existing mmap structure, allocate a new one 
+		tdp->td_mmapp = malloc(sizeof(xint_mmap_t));
+		if (tdp->td_mmapp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for MMAP variables for target %d\n",
+			xgp->progname, (int)sizeof(xint_mmap_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_mmapp, 0, sizeof(xint_mmap_t));
+		tdp->td_mmapp->mmap_advice = -1;
+		pthread_mutex_init(&tdp->td_mmapp->mmap_lock, 0);
+	}
+	return(tdp->td_mmapp);
+
+} /* End of xdd_get_mmapp() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_copyp() - return a pointer to the XDD Local Copy Structure 
+ */
+xint_copy_t *
+xdd_get_copyp(target_data_t *tdp) {
+
+	if (tdp->td_copyp == 0) { // If there is no existing copy structure, allocate a new one 
+		tdp->td_copyp = malloc(sizeof(xint_copy_t));
+		if (tdp->td_copyp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for COPY variables for target %d\n",
+			xgp->progname, (int)sizeof(xint_copy_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_copyp, 0, sizeof(xint_copy_t));
+		tdp->td_copyp->copy_fd = -1;
+	}
+	return(tdp->td_copyp);
+
+} /* End of xdd_get_copyp() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_get_tsp() - return a pointer to the Time Stamp Variables
  * for the specified target
@@ -69,6 +69,83 @@ xdd_parse_arg_count_check(int32_t args, int32_t argc, char *option) {
 } // End of xdd_parse_arg_count_check()
 /*----------------------------------------------------------------------------*/
 int
+xddfunc_arrivals(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, i; 
+    int target_number;
+    char *what;
+    double rate;
+    int32_t burst;
+    uint32_t type;
+    target_data_t *tdp;
+    int retval;
+	xint_arrival_t	*arrivalp;
+
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+	if (argc < args+3) {
+		fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-arrivals'\n",xgp->progname);
+		return(0);
+	}
+	what = argv[args+1];
+	rate = atof(argv[args+2]);
+	retval = args+3;
+	burst = XINT_DEFAULT_ARRIVAL_BURST;
+
+    if (strcmp(what, "constant") == 0) 
+		type = XINT_ARRIVAL_CONSTANT;
+    else if (strcmp(what, "poisson") == 0) 
+		type = XINT_ARRIVAL_POISSON;
+    else if (strcmp(what, "bursty") == 0) {
+		type = XINT_ARRIVAL_BURSTY;
+		if (argc < args+4) {
+			fprintf(xgp->errout,"%s: ERROR: the number of operations in a burst must be specified for '-arrivals bursty'\n",xgp->progname);
+			return(0);
+		}
+		burst = atoi(argv[args+3]);
+		if (burst <= 0) {
+			fprintf(xgp->errout,"%s: burst of %d operations is not valid. The burst must be a number greater than 0\n",xgp->progname,burst);
+			return(0);
+		}
+		retval++;
+	} else {
+		fprintf(xgp->errout,"%s: ERROR: arrival type '%s' is not valid. It must be one of constant, poisson, or bursty\n",xgp->progname,what);
+		return(0);
+	}
+	if (rate <= 0.0) {
+		fprintf(xgp->errout,"%s: arrival rate of %5.2f is not valid. The rate must be a number of ops/sec greater than 0.00\n",xgp->progname,rate);
+		return(0);
+	}
+
+	if (flags & XDD_PARSE_PHASE2) {
+		planp->plan_options |= PLAN_ARRIVALS;
+		if (target_number >= 0) { /* Set this option value for a specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			arrivalp = xdd_get_arrivalp(tdp);
+			if (arrivalp == NULL) return(-1);
+			arrivalp->arrival_type = type;
+			arrivalp->arrival_rate = rate;
+			arrivalp->arrival_burst = burst;
+		} else { /* Set option for all targets */
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				arrivalp = xdd_get_arrivalp(tdp);
+				if (arrivalp == NULL) return(-1);
+				arrivalp->arrival_type = type;
+				arrivalp->arrival_rate = rate;
+				arrivalp->arrival_burst = burst;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return(retval);
+} // End of xddfunc_arrivals()
+/*----------------------------------------------------------------------------*/
+int
 xddfunc_blocksize(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
     int args,i; 
@@ -279,6 +356,63 @@ int xddfunc_cookie(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
 	}
 } // End of xddfunc_cookie()
 /*----------------------------------------------------------------------------*/
+// Copy a local file into a target inside the kernel
+// Arguments: -copyfrom [target #] <source file> [noclone]
+// Each write operation copies the same range of the source file into the 
+// target with FICLONERANGE or copy_file_range() and falls back to reading the
+// range into the I/O buffer and writing it. "noclone" skips FICLONERANGE so 
+// the blocks are really copied rather than shared.
+int
+xddfunc_copyfrom(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int				args, i; 
+    int				target_number;
+    target_data_t	*tdp;
+	xint_copy_t		*copyp;
+	uint32_t		copy_option;
+	int				retval;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	copy_option = 0;
+	retval = args+2;
+	if ((argc > args+2) && (strcmp(argv[args+2], "noclone") == 0)) {
+		copy_option = XINT_COPY_NOCLONE;
+		retval = args+3;
+	}
+
+	if (flags & XDD_PARSE_PHASE2) {
+		if (target_number >= 0) { /* Set this option value for a specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			copyp = xdd_get_copyp(tdp);
+			if (copyp == NULL) return(-1);
+			copyp->copy_source = argv[args+1];
+			copyp->copy_options |= copy_option;
+			tdp->td_target_options &= ~TO_IO_ENGINE_MASK;
+			tdp->td_target_options |= TO_IO_COPY;
+		} else { /* Set option for all targets */
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				copyp = xdd_get_copyp(tdp);
+				if (copyp == NULL) return(-1);
+				copyp->copy_source = argv[args+1];
+				copyp->copy_options |= copy_option;
+				tdp->td_target_options &= ~TO_IO_ENGINE_MASK;
+				tdp->td_target_options |= TO_IO_COPY;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return(retval);
+} // End of xddfunc_copyfrom()
+/*----------------------------------------------------------------------------*/
 // Create new target files for each pass.
 int
 xddfunc_createnewfiles(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
@@ -394,6 +528,39 @@ xddfunc_datapattern(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
 				}
 			}
 		}
+	} else if (strcmp(pattern_type, "reducible") == 0) {  /* unique blocks with a compression ratio and a dedupe ratio */
+		double	compress_ratio;
+		double	dedupe_ratio;
+
+		retval += 2;
+		if (argc <= args+3) {
+			fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-datapattern reducible'\n",xgp->progname);
+			return(0);
+		}
+		compress_ratio = atof(argv[args+2]);
+		dedupe_ratio = atof(argv[args+3]);
+		if ((compress_ratio < 1.0) || (dedupe_ratio < 1.0)) {
+			fprintf(xgp->errout,"%s: ERROR: The compression ratio <%s> and dedupe ratio <%s> for '-datapattern reducible' must be 1.0 or more\n",
+				xgp->progname, argv[args+2], argv[args+3]);
+			return(0);
+		}
+		if (tdp) { /* set option for the specific target */
+            tdp->td_dpp->data_pattern_options |= DP_REDUCIBLE_PATTERN;
+			tdp->td_dpp->data_pattern_compress_ratio = compress_ratio;
+			tdp->td_dpp->data_pattern_dedupe_ratio = dedupe_ratio;
+		} else { // Put this option into all Targets 
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) { 
+					tdp->td_dpp->data_pattern_options |= DP_REDUCIBLE_PATTERN;
+					tdp->td_dpp->data_pattern_compress_ratio = compress_ratio;
+					tdp->td_dpp->data_pattern_dedupe_ratio = dedupe_ratio;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
 	} else if (strcmp(pattern_type, "ascii") == 0) {
 		retval++;
 		if (argc <= args+2) {
@@ -1627,6 +1794,57 @@ xddfunc_help(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     return(-1);
 }
 /*----------------------------------------------------------------------------*/
+// Specify the size of the huge pages for the I/O buffer pool
+// Arguments: -hugepages [target #] 2m|1g|off
+// This will set tdp->td_hugepage_size to the page size in bytes or 0 for off
+// 
+int
+xddfunc_hugepages(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int			args, i; 
+    int			target_number;
+    target_data_t	*tdp;
+	int64_t		hugepage_size;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	if ((strcasecmp(argv[args+1], "2m") == 0) || (strcmp(argv[args+1], "on") == 0)) {
+		hugepage_size = 2LL*1024*1024;
+	} else if (strcasecmp(argv[args+1], "1g") == 0) {
+		hugepage_size = 1024LL*1024*1024;
+	} else if (strcmp(argv[args+1], "off") == 0) {
+		hugepage_size = 0;
+	} else {
+		fprintf(xgp->errout,"%s: xddfunc_hugepages: ERROR: Unknown huge page size '%s'. This should be '2m', '1g' or 'off'.\n",
+			xgp->progname,
+			argv[args+1]);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+
+		tdp->td_hugepage_size = hugepage_size;
+        return(args+2);
+	} else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				tdp->td_hugepage_size = hugepage_size;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+		return(2);
+	}
+}
+/*----------------------------------------------------------------------------*/
 // Specify an identification string for this run
 // Arguments: -id commandline|"string"
 int
@@ -1664,6 +1882,67 @@ xddfunc_interactive(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
     return(1);
 }
 /*----------------------------------------------------------------------------*/
+// Specify the I/O engine used to issue the I/O operations for a target
+// Arguments: -ioengine [target #] sync | uring | mmap | copy
+// The "sync" engine is the default where each Worker Thread issues one blocking
+// pread()/pwrite() at a time. The "uring" engine has the Target Thread keep
+// up to queue depth operations in flight through an io_uring (Linux only).
+// The "mmap" engine has each Worker Thread copy to or from a mapping of the
+// target file (Linux only) - see the -mmap option. The "copy" engine copies 
+// the file named with -copyfrom into the target.
+int
+xddfunc_ioengine(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int			args, i; 
+    int			target_number;
+    target_data_t	*tdp;
+	char		*engine;
+	uint64_t	engine_option;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	engine = (char *)argv[args+1];
+	if (strcmp(engine, "sync") == 0) {
+		engine_option = 0;
+	} else if ((strcmp(engine, "uring") == 0) || (strcmp(engine, "io_uring") == 0)) {
+		engine_option = TO_IO_URING;
+	} else if (strcmp(engine, "mmap") == 0) {
+		engine_option = TO_IO_MMAP;
+	} else if (strcmp(engine, "copy") == 0) {
+		engine_option = TO_IO_COPY;
+	} else {
+		fprintf(xgp->errout,"%s: xddfunc_ioengine: ERROR: Unknown I/O engine '%s'. This should be 'sync', 'uring', 'mmap', or 'copy'.\n",
+			xgp->progname,
+			engine);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+
+		tdp->td_target_options &= ~TO_IO_ENGINE_MASK;
+		tdp->td_target_options |= engine_option;
+        return(args+2);
+	} else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				tdp->td_target_options &= ~TO_IO_ENGINE_MASK;
+				tdp->td_target_options |= engine_option;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+		return(2);
+	}
+}
+/*----------------------------------------------------------------------------*/
 // Specify the number of KBytes to transfer per pass (1K=1024 bytes)
 // Arguments: -kbytes [target #] #
 // This will set tdp->td_bytes to the calculated value (kbytes * 1024)
@@ -2167,6 +2446,106 @@ xddfunc_minall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	return(1);
 }
 /*----------------------------------------------------------------------------*/
+// Set the options of the mmap I/O engine and select it for a target
+// Arguments: -mmap [target #] populate | sync | advise normal|random|sequential|willneed|dontneed|hugepage
+// "populate" maps the target with MAP_POPULATE so the pages are faulted in
+// when the target is mapped rather than by the operations. "sync" maps it with
+// MAP_SYNC, which needs a file on a DAX file system. "advise" passes the hint
+// to madvise() for the whole mapping.
+int
+xddfunc_mmap(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int				args, i; 
+    int				target_number;
+    target_data_t	*tdp;
+	xint_mmap_t		*mmapp;
+	uint32_t		mmap_option;
+	int32_t			advice;
+	char			*advice_name;
+	int				retval;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	mmap_option = 0;
+	advice = -1;
+	advice_name = NULL;
+	retval = args+2;
+	if (strcmp(argv[args+1], "populate") == 0) {
+		mmap_option = XINT_MMAP_POPULATE;
+	} else if (strcmp(argv[args+1], "sync") == 0) {
+		mmap_option = XINT_MMAP_SYNC;
+	} else if (strcmp(argv[args+1], "advise") == 0) {
+		if (argc < args+3) {
+			fprintf(xgp->errout,"%s: xddfunc_mmap: ERROR: the hint must be specified for '-mmap advise'\n",xgp->progname);
+			return(0);
+		}
+		advice_name = argv[args+2];
+		if (strcmp(advice_name, "normal") == 0)
+			advice = MADV_NORMAL;
+		else if (strcmp(advice_name, "random") == 0)
+			advice = MADV_RANDOM;
+		else if (strcmp(advice_name, "sequential") == 0)
+			advice = MADV_SEQUENTIAL;
+		else if (strcmp(advice_name, "willneed") == 0)
+			advice = MADV_WILLNEED;
+		else if (strcmp(advice_name, "dontneed") == 0)
+			advice = MADV_DONTNEED;
+#ifdef MADV_HUGEPAGE
+		else if (strcmp(advice_name, "hugepage") == 0)
+			advice = MADV_HUGEPAGE;
+#endif
+		else {
+			fprintf(xgp->errout,"%s: xddfunc_mmap: ERROR: Unknown madvise hint '%s'. This should be 'normal', 'random', 'sequential', 'willneed', 'dontneed', or 'hugepage'.\n",
+				xgp->progname,
+				advice_name);
+			return(0);
+		}
+		retval = args+3;
+	} else {
+		fprintf(xgp->errout,"%s: xddfunc_mmap: ERROR: Unknown mmap option '%s'. This should be 'populate', 'sync', or 'advise'.\n",
+			xgp->progname,
+			argv[args+1]);
+		return(0);
+	}
+
+	if (flags & XDD_PARSE_PHASE2) {
+		if (target_number >= 0) { /* Set this option value for a specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			mmapp = xdd_get_mmapp(tdp);
+			if (mmapp == NULL) return(-1);
+			mmapp->mmap_options |= mmap_option;
+			if (advice >= 0) {
+				mmapp->mmap_advice = advice;
+				mmapp->mmap_advice_name = advice_name;
+			}
+			tdp->td_target_options &= ~TO_IO_ENGINE_MASK;
+			tdp->td_target_options |= TO_IO_MMAP;
+		} else { /* Set option for all targets */
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				mmapp = xdd_get_mmapp(tdp);
+				if (mmapp == NULL) return(-1);
+				mmapp->mmap_options |= mmap_option;
+				if (advice >= 0) {
+					mmapp->mmap_advice = advice;
+					mmapp->mmap_advice_name = advice_name;
+				}
+				tdp->td_target_options &= ~TO_IO_ENGINE_MASK;
+				tdp->td_target_options |= TO_IO_MMAP;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return(retval);
+} // End of xddfunc_mmap()
+/*----------------------------------------------------------------------------*/
 // Set up a queue thread for the specified target to act as an alternate
 // path to the main target device
 int
@@ -2240,6 +2619,57 @@ xddfunc_noproclock(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
     return(1);
 }
 /*----------------------------------------------------------------------------*/
+// Specify the NUMA placement of the WorkerThreads and their I/O buffers
+// Arguments: -numa [target #] auto|off|#
+// This will set tdp->td_numa_node to XINT_NUMA_AUTO, XINT_NUMA_OFF or the node number
+// 
+int
+xddfunc_numa(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int			args, i; 
+    int			target_number;
+    target_data_t	*tdp;
+	int32_t		numa_node;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	if (strcmp(argv[args+1], "auto") == 0) {
+		numa_node = XINT_NUMA_AUTO;
+	} else if (strcmp(argv[args+1], "off") == 0) {
+		numa_node = XINT_NUMA_OFF;
+	} else if (isdigit((unsigned char)argv[args+1][0])) {
+		numa_node = atoi(argv[args+1]);
+	} else {
+		fprintf(xgp->errout,"%s: xddfunc_numa: ERROR: Unknown NUMA placement '%s'. This should be 'auto', 'off' or a node number.\n",
+			xgp->progname,
+			argv[args+1]);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+
+		tdp->td_numa_node = numa_node;
+        return(args+2);
+	} else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				tdp->td_numa_node = numa_node;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+		return(2);
+	}
+}
+/*----------------------------------------------------------------------------*/
 // Specify the number of requests to run 
 // Arguments: -numreqs [target #] #
 // This will set tdp->td_numreqs to the specified value 
@@ -2540,7 +2970,7 @@ xddfunc_output_format(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fl
 				fprintf(stderr,"%s: Error: No format string specified for '-outputformat add' option\n", xgp->progname);
 				return(-1);
 			}
-			xdd_results_format_id_add(argv[2], planp->format_string);
+			planp->format_string = xdd_results_format_id_add(argv[2], planp->format_string);
 			return(3);
 		}
 		if (strcmp(argv[1], "new") == 0) {
@@ -3125,6 +3555,108 @@ xddfunc_reqsize(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 } // End of xddfunc_reqsize()
 /*----------------------------------------------------------------------------*/
+// Specify a mix of request sizes with a weight for each one
+// Arguments: -reqsizemix [target #] size:weight,size:weight,...
+int
+xddfunc_reqsizemix(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+	xint_reqsize_mix_t	mix;
+	xint_reqsize_mix_t	*rsmp;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	if (xint_reqsize_mix_parse(&mix, argv[args+1]) < 0)
+		return(0);
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		rsmp = xdd_get_rsmp(tdp);
+		if (rsmp == NULL) return(-1);
+		*rsmp = mix;
+        return(args+2);
+	} else { // Put this option into all Targets 
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				rsmp = xdd_get_rsmp(tdp);
+				if (rsmp == NULL) return(-1);
+				*rsmp = mix;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+        return(2);
+	}
+} // End of xddfunc_reqsizemix()
+/*----------------------------------------------------------------------------*/
+// Replay a blkparse trace or an xdd timestamp dump
+// Arguments: -replay [target #] <filename> [speedup #]
+int
+xddfunc_replay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+	char *filename;
+	double speedup;
+	int retval;
+	xint_replay_t *replayp;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	filename = argv[args+1];
+	speedup = 1.0;
+	retval = args+2;
+	if ((argc > args+2) && (strcmp(argv[args+2], "speedup") == 0)) {
+		if (argc < args+4) {
+			fprintf(xgp->errout,"%s: ERROR: the speedup factor must be specified for '-replay ... speedup'\n",xgp->progname);
+			return(0);
+		}
+		speedup = atof(argv[args+3]);
+		if (speedup <= 0.0) {
+			fprintf(xgp->errout,"%s: replay speedup of %5.2f is not valid. The speedup must be a number greater than 0.00\n",xgp->progname,speedup);
+			return(0);
+		}
+		retval += 2;
+	}
+
+	if (flags & XDD_PARSE_PHASE2) {
+		if (target_number >= 0) { /* Set this option value for a specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			replayp = xdd_get_replayp(tdp);
+			if (replayp == NULL) return(-1);
+			replayp->replay_filename = filename;
+			replayp->replay_speedup = speedup;
+		} else { /* Set option for all targets */
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				replayp = xdd_get_replayp(tdp);
+				if (replayp == NULL) return(-1);
+				replayp->replay_filename = filename;
+				replayp->replay_speedup = speedup;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return(retval);
+} // End of xddfunc_replay()
+/*----------------------------------------------------------------------------*/
 // Control restart operation options
 int
 xddfunc_restart(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
@@ -3411,6 +3943,17 @@ xddfunc_rwratio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 }
 /*----------------------------------------------------------------------------*/
+// Set a random seek distribution for one target
+static void
+xdd_parse_seek_distribution(target_data_t *tdp, char *pattern, uint32_t distribution, double param1, double param2)
+{
+	tdp->td_seekhdr.seek_options |= SO_SEEK_RANDOM;
+	tdp->td_seekhdr.seek_pattern = pattern;
+	tdp->td_seekhdr.seek_distribution = distribution;
+	tdp->td_seekhdr.seek_dist_param1 = param1;
+	tdp->td_seekhdr.seek_dist_param2 = param2;
+}
+/*----------------------------------------------------------------------------*/
 // Specify the starting offset into the device in blocks between passes
 // Arguments: -seek [target #] option_name value
 // 
@@ -3421,6 +3964,9 @@ xddfunc_seek(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     int     args, args_index; 
     int     target_number;
     target_data_t  *tdp;
+	uint32_t distribution;
+	int		dist_args;
+	double	param1, param2;
 
 	args_index = 1;
     args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
@@ -3534,21 +4080,71 @@ xddfunc_seek(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		if (target_number >= 0) {  /* set option for specific target */
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
 			if (tdp == NULL) return(-1);
-			tdp->td_seekhdr.seek_options |= SO_SEEK_RANDOM;
-			tdp->td_seekhdr.seek_pattern = "random";
+			xdd_parse_seek_distribution(tdp, "random", SO_DIST_UNIFORM, 0.0, 0.0);
 		} else {  /* set option for all targets */
 			if (flags & XDD_PARSE_PHASE2) {
 				tdp = planp->target_datap[0];
 				i = 0;
 				while (tdp) {
-					tdp->td_seekhdr.seek_options |= SO_SEEK_RANDOM;
-					tdp->td_seekhdr.seek_pattern = "random";
+					xdd_parse_seek_distribution(tdp, "random", SO_DIST_UNIFORM, 0.0, 0.0);
 					i++;
 					tdp = planp->target_datap[i];
 				}
 			}
 		} 
 		return(args_index+1);
+	} else if ((strcmp(argv[args_index], "zipf") == 0) || (strcmp(argv[args_index], "pareto") == 0) ||
+			   (strcmp(argv[args_index], "hotspot") == 0) || (strcmp(argv[args_index], "gaussian") == 0)) { /* Skewed random seek locations */
+		if ((strcmp(argv[args_index], "zipf") == 0) || (strcmp(argv[args_index], "pareto") == 0))
+			dist_args = 1;
+		else dist_args = 2;
+		if (argc <= args_index+dist_args) {
+			fprintf(stderr,"%s: Not enough arguments specified for seek option %s\n",xgp->progname, argv[args_index]);
+			return(0);
+		}
+		param1 = atof(argv[args_index+1]);
+		param2 = (dist_args > 1) ? atof(argv[args_index+2]) : 0.0;
+		if (strcmp(argv[args_index], "zipf") == 0) {
+			distribution = SO_DIST_ZIPF;
+			if (param1 <= 0.0) {
+				fprintf(stderr,"%s: zipf theta of %f is not valid. It must be greater than 0.0\n",xgp->progname, param1);
+				return(0);
+			}
+		} else if (strcmp(argv[args_index], "pareto") == 0) {
+			distribution = SO_DIST_PARETO;
+			if ((param1 <= 0.0) || (param1 >= 1.0)) {
+				fprintf(stderr,"%s: pareto h of %f is not valid. It must be between 0.0 and 1.0\n",xgp->progname, param1);
+				return(0);
+			}
+		} else if (strcmp(argv[args_index], "hotspot") == 0) {
+			distribution = SO_DIST_HOTSPOT;
+			if ((param1 <= 0.0) || (param1 >= 100.0) || (param2 < 0.0) || (param2 > 100.0)) {
+				fprintf(stderr,"%s: hotspot of %f percent of the range getting %f percent of the ops is not valid\n",xgp->progname, param1, param2);
+				return(0);
+			}
+		} else {
+			distribution = SO_DIST_GAUSSIAN;
+			if ((param1 < 0.0) || (param2 <= 0.0)) {
+				fprintf(stderr,"%s: gaussian center of %f blocks with a standard deviation of %f blocks is not valid\n",xgp->progname, param1, param2);
+				return(0);
+			}
+		}
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			xdd_parse_seek_distribution(tdp, argv[args_index], distribution, param1, param2);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					xdd_parse_seek_distribution(tdp, argv[args_index], distribution, param1, param2);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		} 
+		return(args_index+1+dist_args);
 	} else if (strcmp(argv[args_index], "stagger") == 0) { /*  Staggered seek list option */
 		if (target_number >= 0) {  /* set option for specific target */
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
@@ -4099,6 +4695,59 @@ xddfunc_stoptrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
 	}
 }
 /*----------------------------------------------------------------------------*/
+// Name the workload stream that a target runs
+// Several targets can name the same file so that each one is an independent
+// stream of I/O with its own access pattern, rate and queue depth. A background
+// stream stops issuing I/O as soon as all the other targets have finished their pass.
+// Arguments: -stream [target #] <name> [foreground|background]
+int
+xddfunc_stream(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+	char *name;
+	int32_t type;
+	int retval;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	name = argv[args+1];
+	type = XINT_STREAM_FOREGROUND;
+	retval = args+2;
+	if (argc > args+2) {
+		if (strcmp(argv[args+2], "background") == 0) {
+			type = XINT_STREAM_BACKGROUND;
+			retval++;
+		} else if (strcmp(argv[args+2], "foreground") == 0) 
+			retval++;
+	}
+
+	if (flags & XDD_PARSE_PHASE2) {
+		planp->plan_options |= PLAN_STREAMS;
+		if (target_number >= 0) { /* Set this option value for a specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_stream_name = name;
+			tdp->td_stream_type = type;
+		} else { /* Set option for all targets */
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				tdp->td_stream_name = name;
+				tdp->td_stream_type = type;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return(retval);
+} // End of xddfunc_stream()
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_syncio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -4469,6 +5118,27 @@ xddfunc_throttle(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	    	}
 		}
 		return(retval);
+    } else if (strcmp(what, "burst") == 0) { /* Size of the token bucket in MB or ops */
+        if (value <= 0.0) {
+			fprintf(xgp->errout,"%s: throttle burst of %5.2f is not valid. throttle burst must be a number greater than 0.00\n",xgp->progname,value);
+            return(0);
+        }
+        if (tdp) {
+			throtp = xdd_get_throtp(tdp);
+            throtp->throttle_burst = value;
+        } else { /* Set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					throtp = xdd_get_throtp(tdp);
+					throtp->throttle_burst = value;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		return(retval);
     } else if (strcmp(what, "var") == 0) { /* Throttle Variance */
 	if (NULL != tdp && value <= 0.0) {
 		throtp = xdd_get_throtp(tdp);
@@ -4494,7 +5164,7 @@ xddfunc_throttle(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		}
 		return(retval);
     } else {
-		fprintf(xgp->errout,"%s: throttle type of of %s is not valid. throttle type must be \"ops\", \"bw\", or \"var\"\n",xgp->progname,what);
+		fprintf(xgp->errout,"%s: throttle type of of %s is not valid. throttle type must be \"ops\", \"bw\", \"delay\", \"burst\" or \"var\"\n",xgp->progname,what);
 		return(0);
 	}
 } // End of xddfunc_throttle()
@@ -4823,6 +5493,25 @@ xddfunc_timestamp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		}
 		planp->ts_binary_filename_prefix = argv[args_index];
 		return(args_index+1);
+	} else if (strcmp(argv[args_index], "stream") == 0) { /* stream a binary timestamp file to "filename" during the run */
+        args_index++;
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_DUMP | TS_STREAM);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_DUMP | TS_STREAM);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		planp->ts_binary_filename_prefix = argv[args_index];
+		return(args_index+1);
 	} else if (strcmp(argv[args_index], "summary") == 0) { /* set the time stamp SUMMARY reporting option */
 		if (target_number >= 0) {
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
@@ -4921,6 +5610,23 @@ xddfunc_verify(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 			}
 		}
 		return(args_index+1);
+	} else if (strcmp(argv[args_index], "checksum") == 0) { /*  Stamp each block with a checksum on write and verify it on read */
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		return(args_index+1);
 	} else {
 		fprintf(stderr,"%s: Invalid verify suboption %s\n",xgp->progname, argv[args_index]);
         return(0);
@@ -4948,6 +5654,27 @@ xddfunc_version(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     exit(XDD_RETURN_VALUE_SUCCESS);
 }
 
+/*----------------------------------------------------------------------------*/
+// Run the Worker Threads of all targets on a shared pool of threads
+// Arguments: -workerpool <#threads> | cpus
+int
+xddfunc_workerpool(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	if (argc < 2) { // Not enough arguments in this line
+		fprintf(xgp->errout,"%s: ERROR: Not enough arguments to fully qualify this option: %s\n",
+			   	xgp->progname, argv[0]);
+		return(-1);
+	}
+	if (strcmp(argv[1], "cpus") == 0) 
+		planp->worker_pool_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	else planp->worker_pool_threads = atoi(argv[1]);
+	if (planp->worker_pool_threads <= 0) {
+		fprintf(xgp->errout,"%s: xddfunc_workerpool: ERROR: Invalid number of Worker Pool threads '%s'. This should be a positive number or 'cpus'.\n",
+			xgp->progname, argv[1]);
+		return(-1);
+	}
+    return(2);
+}
 /*----------------------------------------------------------------------------*/
 int
 xddfunc_invalid_option(int32_t argc, char *argv[], uint32_t flags)
@@ -5035,6 +5762,7 @@ xddfunc_xni(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	int target_number;
 	char* xni_mode_str = 0;
 	xni_protocol_t* xni_proto = 0;
+	int xni_tcp_flags = XNI_TCP_DEFAULT_FLAGS;
 
 	args = xdd_parse_target_number(planp, argc, &argv[0],
 								   flags, &target_number);
@@ -5048,7 +5776,10 @@ xddfunc_xni(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	xni_mode_str = argv[args + 1];
 	if (0 == strcmp(xni_mode_str, "tcp"))
 		xni_proto = &xni_protocol_tcp;
-	else if (0 == strcmp(xni_mode_str, "ib"))
+	else if (0 == strcmp(xni_mode_str, "tcp-zerocopy")) {
+		xni_proto = &xni_protocol_tcp;
+		xni_tcp_flags |= XNI_TCP_ZEROCOPY;
+	} else if (0 == strcmp(xni_mode_str, "ib"))
 		xni_proto = &xni_protocol_ib;
 	else {
 		fprintf(stderr, "Invalid XNI mode: %s\n", xni_mode_str);
@@ -5065,6 +5796,7 @@ xddfunc_xni(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		if (tdp == NULL)
 			return(-1);
 		tdp->xni_pcl = *xni_proto;
+		tdp->xni_tcp_flags = xni_tcp_flags;
 		return(args+2);
 	} else {
         /* Put this option into all Targets */ 
@@ -5073,6 +5805,7 @@ xddfunc_xni(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 			int i = 0;
 			while (tdp) {
 				tdp->xni_pcl = *xni_proto;
+				tdp->xni_tcp_flags = xni_tcp_flags;
 				i++;
 				tdp = planp->target_datap[i];
 			}
@@ -29,6 +29,18 @@
 //                char    *ext_help[5];   /* Extented help strings */
 //            };
 xdd_func_t  xdd_func[] = {
+    {"arrivals", "arr",
+            xddfunc_arrivals,  
+            1,  
+            "  -arrivals [target <target#>] <constant|poisson|bursty> <#.#ops/sec> [#ops/burst]\n",  
+            {"    Issues operations open-loop at the average rate of #.# ops/sec no matter how long the previous operations take.\n", 
+             "    'constant' spaces the operations evenly, 'poisson' uses exponentially distributed times between operations and\n\
+    'bursty' issues bursts of #ops/burst operations at once with a Poisson distribution of the bursts.\n",
+             "    The latency percentiles are measured from the time each operation was due rather than the time it was issued\n\
+    and the BacklgMax, BacklgAvg and IssLagMax columns show how far behind the schedule the Worker Threads fell.\n",
+             "    See also: -throttle\n",
+             0},
+			0},
     {"blocksize", "bs",
             xddfunc_blocksize,  
             1,  
@@ -64,6 +76,16 @@ xdd_func_t  xdd_func[] = {
             {"    Will set the magic cookie for network connections\n",
             0,0,0,0},
             0},
+    {"copyfrom", "cpf",
+            xddfunc_copyfrom,
+            1,
+            "  -copyfrom [target <target#>] <source file> [noclone]\n",
+            {"    Selects the copy I/O engine for a target. Each write operation copies the same range of the source file\n\
+    into the target inside the kernel with FICLONERANGE (a reflink) or copy_file_range(). If the file systems\n\
+    cannot do either the range is read into the I/O buffer and written. Use with -op write <linux only>\n",
+            "    'noclone' does not try FICLONERANGE so the blocks are copied rather than shared\n",
+            0,0,0},
+			0},
     {"createnewfiles",  "cnf",
             xddfunc_createnewfiles,  
             1,  
@@ -81,7 +103,7 @@ xdd_func_t  xdd_func[] = {
     {"datapattern", "dp",
             xddfunc_datapattern,    
             1,  
-            "  -datapattern [target <target#>] <c> | random | sequenced | prefix <hexdigits> | inverse | ascii <asciistring> | hex <hexdigits> | replicate | lfpat | ltpat | cjtpat | crpat | cspat\n",  
+            "  -datapattern [target <target#>] <c> | random | sequenced | prefix <hexdigits> | inverse | ascii <asciistring> | hex <hexdigits> | replicate | reducible <compress ratio> <dedupe ratio> | lfpat | ltpat | cjtpat | crpat | cspat\n",  
             {"    -datapattern 'c' will use the character c as the data pattern to write\n\
        If the word 'random' is specified for the pattern then a random pattern will be generated\n\
        If the word 'sequenced' is specified for the pattern then a sequenced number pattern will be generated\n\
@@ -92,7 +114,9 @@ xdd_func_t  xdd_func[] = {
        If the word 'replicate' is specified then whatever pattern was specified is replicated throughout the buffer\n",
       "If any of the words 'lfpat, ltpat, cjtpat, crpat, or cspat' is specified then the 8B/10B stress patterns are used.\n\
 	        Default data pattern is all binary 0's\n",
-             0,0},
+             "    -datapattern 'reducible' writes new blocks on every write that compress by about the compression ratio\n\
+       and of which one in 'dedupe ratio' is unique - the dedupe block size is the -blocksize\n",
+             0},
 			0},
     {"debug", "debug",
             xddfunc_debug,
@@ -195,6 +219,15 @@ xdd_func_t  xdd_func[] = {
             {"    Will print out extended help for a specific option \n", 
             0,0,0,0},
 			0},
+    {"hugepages", "hp",
+            xddfunc_hugepages, 
+            1,  
+            "  -hugepages [target <target#>] 2m | 1g | off\n",  
+            {"    Allocates the I/O buffers of all WorkerThreads of a target from one pool of 2 MiB or 1 GiB huge pages.\n\
+    If there are no free huge pages of that size, transparent huge pages are used instead. This option\n\
+    takes the place of -sharedmemory for the target. Default is 'off' <linux only>\n", 
+            0,0,0,0},
+			0},
     {"identifier",   "id",
             xddfunc_id, 
             1,  
@@ -209,6 +242,18 @@ xdd_func_t  xdd_func[] = {
             {"    Indicates that XDD should start up in Interactive Mode - targets will not start until the 'run' command is given.\n", 
             0,0,0,0},
 			0},
+    {"ioengine",   "ioe",
+            xddfunc_ioengine, 
+            1,  
+            "  -ioengine [target <target#>] sync | uring | mmap | copy\n",  
+            {"    Specifies how I/O operations are issued for a target. 'sync' is the default where each Worker Thread\n\
+    issues one blocking read or write at a time. 'uring' uses a single io_uring per target that is driven\n\
+    by the Target Thread and keeps up to -queuedepth operations in flight <linux only>\n", 
+            "    'mmap' maps the target file and each Worker Thread copies to or from the mapping, so the op times\n\
+    include the page faults. See -mmap for the mapping options <linux only>\n",
+            "    'copy' copies the file named with -copyfrom into the target inside the kernel <linux only>\n",
+            0,0},
+			0},
     {"kbytes",  "kb",
             xddfunc_kbytes,     
             1,  
@@ -312,6 +357,16 @@ xdd_func_t  xdd_func[] = {
             {"    Will set not lock memory, process, or reset process priority\n", 
             0,0,0,0},
 			0},
+    {"mmap", "mmap",
+            xddfunc_mmap,
+            1,
+            "  -mmap [target <target#>] populate | sync | advise normal|random|sequential|willneed|dontneed|hugepage\n",
+            {"    Selects the mmap I/O engine for a target and sets how the target is mapped. May be given more than once.\n\
+    'populate' faults in the pages when the target is mapped with MAP_POPULATE. 'sync' maps the target with\n\
+    MAP_SYNC, which needs a file on a DAX file system. 'advise' passes the hint to madvise() for the mapping.\n",
+            "    With -syncwrite the mapping is written back with msync() at the end of each pass <linux only>\n",
+            0,0,0},
+			0},
     {"multipath", "mp",
             xddfunc_multipath,     
             1,  
@@ -349,6 +404,15 @@ xdd_func_t  xdd_func[] = {
             {"    Will set not lock process into memory\n", 
             0,0,0,0},
 			0},
+    {"numa", "numa",
+            xddfunc_numa, 
+            1,  
+            "  -numa [target <target#>] auto | off | <node#>\n",  
+            {"    Places the WorkerThreads and their I/O buffers on a NUMA node. 'auto' uses the node that the\n\
+    target device is attached to, or for End-to-End operations the node of the network interface.\n\
+    Each WorkerThread is pinned to one CPU of the node, round-robin. Default is 'off' <linux only>\n", 
+            0,0,0,0},
+			0},
     {"numreqs", "nr",
             xddfunc_numreqs, 
             1,  
@@ -514,6 +578,26 @@ xdd_func_t  xdd_func[] = {
              "    then the speficied target is assigned the specified request size\n",
              0,0},
 			0},
+    {"reqsizemix", "rsm",
+            xddfunc_reqsizemix,    
+            1,  
+            "  -reqsizemix [target <target#>] <size:weight>[,<size:weight>...]\n",  
+            {"    Gives each operation one of several request sizes. Each size is in bytes and may end in k, m or g\n",
+             "    and must be a multiple of the block size. The weights say how often each size is used, so\n",
+             "    '4k:50,64k:30,1m:20' makes half of the operations 4KiB. The I/O buffers are sized for the largest request\n",
+             "    and the operations, bytes and op times of each size are displayed at the end of the run\n",
+             0},
+			0},
+    {"replay", "replay",
+            xddfunc_replay,    
+            1,  
+            "  -replay [target <target#>] <filename> [speedup #]\n",  
+            {"    Replays the reads and writes in a blkparse text trace or an xdd binary timestamp dump (-ts dump).\n",
+             "    Each operation is issued at its original time divided by the speedup factor with its original\n",
+             "    location, size and type. The queue depth is raised to the concurrency of the trace if needed\n",
+             "    and the op times of the trace and the replay are compared at the end of the run\n",
+             0},
+			0},
     {"restart", "rst",
             xddfunc_restart,    
             1,  
@@ -560,7 +644,7 @@ xdd_func_t  xdd_func[] = {
     {"seek",  "s",
             xddfunc_seek,       
             1,  
-            "  -seek [target <target#>] save <filename> | load <filename> | disthist #buckets | seekhist #buckets | sequential | random | range #blocks | stagger #blocks | interleave #blocks | seed # | none\n",  
+            "  -seek [target <target#>] save <filename> | load <filename> | disthist #buckets | seekhist #buckets | sequential | random | zipf #theta | pareto #h | hotspot #%range #%ops | gaussian #center #stddev | range #blocks | stagger #blocks | interleave #blocks | seed # | none\n",  
             {"    -seek 'save <filename>' will save the seek list in the file specified\n\
     -seek 'load <filename>' will load the seek list from the file specified\n\
     -seek 'disthist #buckets' will display a 'seek distance' histogram using the specified number of 'buckets'\n\
@@ -572,7 +656,12 @@ xdd_func_t  xdd_func[] = {
     -seek 'interleave #' specifies the number of blocksized blocks to interleave into the access pattern\n\
     -seek 'seed #' specifies a seed to use when generating random numbers\n\
     -seek 'none' do not seek - retransfer the same block each time \n",
-                0,0,0},
+             "    -seek 'zipf #theta' will generate random seeks with a Zipf distribution of exponent theta, e.g. 0.99\n\
+    -seek 'pareto #h' will send a fraction 1-h of the random seeks to the first fraction h of the range, e.g. 0.2 for 80/20\n\
+    -seek 'hotspot #%range #%ops' will send #%ops of the random seeks to the first #%range of the range\n\
+    -seek 'gaussian #center #stddev' will generate random seeks with a normal distribution around block #center\n\
+    The hottest locations of zipf and pareto are at the start of the range. All use the seed from -seek seed.\n",
+                0,0},
 			0},
     {"serialordering", "so",
             xddfunc_serialordering,     
@@ -652,6 +741,16 @@ xdd_func_t  xdd_func[] = {
             "  -stoptrigger <target#> <target#> <<time|op|percent|mbytes|kbytes> #>\n",   
             {" ", 0,0,0,0},
 			0},
+    {"stream", "stream",
+            xddfunc_stream,     
+            1,  
+            "  -stream [target <target#>] <name> [foreground|background]\n",   
+            {"    Names the workload stream that a target runs. Give several targets the same file name, for example\n",
+             "    with '-targets -2 <file>', to run independent streams with their own options against one file.\n",
+             "    The results of each stream are displayed for every pass under its name along with the COMBINED results.\n",
+             "    A background stream stops as soon as all the other targets have finished the pass\n",
+             0},
+			0},
     {"syncio", "sio",
             xddfunc_syncio,     
             1,  
@@ -744,11 +843,12 @@ xdd_func_t  xdd_func[] = {
     {"throttle", "throt",
             xddfunc_throttle,   
             1,  
-            "  -throttle [target <target#>] <ops|bw|var> <#.#ops | #.#MB/sec | #.#var>\n",   
+            "  -throttle [target <target#>] <ops|bw|delay|burst|var> <#.#ops | #.#MB/sec | #.#seconds | #.#MB or ops | #.#var>\n",   
             {"    -throttle <ops|bw|var> #.# will cause each target to run at the IOPS or bandwidth specified as #.#\n",
              "    -throttle target N ops #.# will cause the target number N to run at the number of ops per second specified as #.#\n",
              "    -throttle target N bw #.#  will cause the target number N to run at the bandwidth specified as #.#\n",
-             "    -throttle target N delay #.#  specifies that there should be # seconds of delay between each operation.\n    -throttle target N var #.#  specifies that the BW or IOPS rate should vary by the amount specified.\n",
+             "    -throttle target N delay #.#  specifies that there should be # seconds of delay between each operation.\n    -throttle target N var #.#  specifies that the BW or IOPS rate should vary by the amount specified.\n\
+    -throttle target N burst #.#  lets up to #.# MB (bw) or ops (ops) be issued at once after an idle period. Default is no limit: ops that fall behind are made up.\n",
              0},
 			0},
     {"timelimit", "tl",
@@ -777,7 +877,7 @@ xdd_func_t  xdd_func[] = {
     {"timestamps", "ts",
             xddfunc_timestamp,  
             1,  
-            "  -ts [target <target#>] summary|detailed|wrap|oneshot|size #|append|output <filename>|dump <filename>|triggertime <seconds>|triggerop <op#>\n",   
+            "  -ts [target <target#>] summary|detailed|wrap|oneshot|size #|append|output <filename>|dump <filename>|stream <filename>|triggertime <seconds>|triggerop <op#>\n",   
             {"    -ts  'summary' will turn on time stamping with summary reporting option\n\
     -ts  'detailed'  will turn on time stamping with detailed reporting option\n\
     -ts  'wrap'  will cause the timestamp buffer to wrap after N timestamp entries are used. Should be used in conjunction with -ts size.\n\
@@ -788,6 +888,7 @@ xdd_func_t  xdd_func[] = {
     -ts  'append'  will append output to existing output file.\n\
     -ts  'output filename' will print the output to file 'filename'. Default output is stdout\n\
     -ts  'dump filename'  will turn on time stamping and dump a binary time stamp file to 'filename'\n\
+    -ts  'stream filename'  is like 'dump' but writes the entries to 'filename' during the run using bounded memory\n\
     Default is no time stamping.\n",
               0,0,0},
 			0},
@@ -808,10 +909,11 @@ xdd_func_t  xdd_func[] = {
     {"verify", "verify",
             xddfunc_verify,     
             1,  
-            "  -verify [target <target#>] location|contents\n",   
+            "  -verify [target <target#>] location|contents|checksum\n",   
             {"    -verify  'location'  will verify the block location is correct\n",
              "    -verify  'contents' will verify the contents of the data buffer read is the same as the specified data pattern\n",
-             0,0,0},
+             "    -verify  'checksum' will end each block written with a CRC32C of its location and contents and check it on read\n",
+             0,0},
 			XDD_FUNC_INVISIBLE},
     {"version", "ver",
             xddfunc_version,     
@@ -820,6 +922,14 @@ xdd_func_t  xdd_func[] = {
             {"    Will print out the version number of this program\n",
              0,0,0,0},
 			0},
+    {"workerpool", "wp",
+            xddfunc_workerpool,
+            1,
+            "  -workerpool <#threads> | cpus\n",   
+            {"    Runs the Worker Threads of all targets on a shared pool of #threads threads instead of starting queuedepth threads per target\n",
+             "    'cpus' uses one thread per online CPU. E2E and lockstep targets always use their own Worker Threads\n",
+             0,0,0},
+			0},
     {"writeafterread", "war",
             xddfunc_endtoend,
             1,
@@ -830,9 +940,10 @@ xdd_func_t  xdd_func[] = {
     {"xni", "xni",
             xddfunc_xni,
             1,
-            "  -xni tcp|ib\n",   
+            "  -xni tcp|tcp-zerocopy|ib\n",   
             {" Enable XNI networking package rather than SWH sockets\n",
-            0,0,0,0},
+            " tcp-zerocopy sends with MSG_ZEROCOPY where the kernel supports it\n",
+            0,0,0},
 			XDD_FUNC_INVISIBLE},
     {"ibdevice", "ibdevice",
             xddfunc_ibdevice,
@@ -222,6 +222,114 @@ xdd_results_fmt_latency(results_t *rp) {
 		fprintf(rp->output,"%9.3f",rp->latency);
 	}
 
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_latency_p50(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","   LatP50");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," microsec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->latency_p50);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_latency_p90(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","   LatP90");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," microsec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->latency_p90);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_latency_p99(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","   LatP99");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," microsec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->latency_p99);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_latency_p999(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","  LatP999");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," microsec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->latency_p999);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_latency_p9999(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s"," LatP9999");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," microsec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->latency_p9999);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_latency_max(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","   LatMax");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," microsec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->latency_max);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_backlog_max(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","BacklgMax");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s","      ops");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.0f",rp->backlog_max);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_backlog_avg(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","BacklgAvg");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s","      ops");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->backlog_avg);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_issue_lag_max(results_t *rp) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s","IssLagMax");
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," microsec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%9.1f",rp->issue_lag_max);
+	}
+
 }
 /*----------------------------------------------------------------------------*/
 void 
@@ -547,6 +655,15 @@ static	xdd_results_fmt_t	xdd_results_fmt_table[] = {
 	{"+READIOPS", 			xdd_results_fmt_read_iops},
 	{"+WRITEIOPS", 			xdd_results_fmt_write_iops},
 	{"+LATENCY", 			xdd_results_fmt_latency},
+	{"+LATP9999", 			xdd_results_fmt_latency_p9999},
+	{"+LATP999", 			xdd_results_fmt_latency_p999},
+	{"+LATP99", 			xdd_results_fmt_latency_p99},
+	{"+LATP90", 			xdd_results_fmt_latency_p90},
+	{"+LATP50", 			xdd_results_fmt_latency_p50},
+	{"+LATMAX", 			xdd_results_fmt_latency_max},
+	{"+BACKLOGMAX", 		xdd_results_fmt_backlog_max},
+	{"+BACKLOGAVG", 		xdd_results_fmt_backlog_avg},
+	{"+ISSUELAGMAX", 		xdd_results_fmt_issue_lag_max},
 	{"+ELAPSEDTIME1STOP", 	xdd_results_fmt_elapsed_time_from_1st_op},
 	{"+ELAPSEDTIMEPASS", 	xdd_results_fmt_elapsed_time_from_pass_start},
 	{"+OVERHEADTIME", 		xdd_results_fmt_elapsed_over_head_time},
@@ -693,7 +810,8 @@ xdd_results_display(results_t *rp) {
 /*----------------------------------------------------------------------------*/
 // This routine will add a string of format IDs or other text to the end
 // of the existing format ID string.
-void 
+// Returns a pointer to the new format string or the old one if there is no memory.
+char *
 xdd_results_format_id_add( char *sp , char *format_stringp) {
 
 	char	*tmpp;
@@ -713,9 +831,9 @@ xdd_results_format_id_add( char *sp , char *format_stringp) {
 			new_length,
 			sp,
 			format_stringp);
+		return(format_stringp);
 	}
 	sprintf(tmpp, "%s%s ",format_stringp, sp);
-	format_stringp = tmpp;
 	
-	return;
+	return(tmpp);
 }
@@ -197,6 +197,7 @@ xdd_process_pass_results(xdd_plan_t *planp) {
     results_t	*tarp;	// Pointer to the Target Average results structure
     results_t	*trp;	// Pointer to the Temporary Target Pass results
     results_t	targetpass_results; // Temporary for target pass results
+	char		stream_what[16];	// Name of the workload stream in the "What" column
 
 	
 	// Initialize temporary to 0
@@ -244,7 +245,12 @@ xdd_process_pass_results(xdd_plan_t *planp) {
 			planp->heartbeat_flags |= HEARTBEAT_HOLDOFF;
 			fprintf(trp->output,"\r");
 		}
-        if (xgp->global_options & GO_VERBOSE) {
+		// The pass results of each workload stream are always displayed under the name of the stream
+		if (tdp->td_stream_name) {
+			sprintf(stream_what,"%-14.14s",tdp->td_stream_name);
+			trp->what = stream_what;
+		}
+        if ((xgp->global_options & GO_VERBOSE) || (tdp->td_stream_name)) {
             xdd_results_display(trp);
             if (xgp->csvoutput) { // Display to CSV file if requested
                 trp->output = xgp->csvoutput;
@@ -305,7 +311,8 @@ xdd_process_run_results(xdd_plan_t *planp) {
 		tarp->what = "TARGET_AVERAGE";
 		tarp->output = xgp->output;
 		tarp->delimiter = ' ';
-		if (xgp->global_options & GO_VERBOSE) {
+		// The averages of workload streams are displayed when there is more than one pass
+		if ((xgp->global_options & GO_VERBOSE) || ((tdp->td_stream_name) && (planp->passes > 1))) {
 			// Display the Target AVERAGE results if -verbose was specified
 			xdd_results_display(tarp);
 			if (xgp->csvoutput) { // Display to CSV file if requested
@@ -335,9 +342,22 @@ xdd_process_run_results(xdd_plan_t *planp) {
 		xdd_results_display(crp);
 	}
 
+	// Display the results of each request size for the -reqsizemix option, of each -replay, and of each -copyfrom
+	for (target_number=0; target_number<planp->number_of_targets; target_number++) { 
+		tdp = planp->target_datap[target_number]; /* Get the target_datap for this target */
+		if (tdp->td_rsmp)
+			xint_reqsize_mix_display(tdp, xgp->output);
+		if (tdp->td_replayp)
+			xint_replay_display(tdp, xgp->output);
+		if ((tdp->td_copyp) && (tdp->td_target_options & TO_IO_COPY))
+			xint_copy_display(tdp, crp, xgp->output);
+	}
+
 	// Process TimeStamp reports for the -ts option
 	for (target_number=0; target_number<planp->number_of_targets; target_number++) { 
 		tdp = planp->target_datap[target_number]; /* Get the target_datap for this target */
+		/* Get the rest of the streamed entries into the binary file */
+		xdd_ts_stream_stop(tdp);
 		/* Display and write the time stamping information if requested */
 		if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
 			if (tdp->td_ts_table.ts_current_entry > tdp->td_ts_table.ts_size) 
@@ -403,6 +423,20 @@ xdd_combine_results(results_t *to, results_t *from, xdd_plan_t *planp) {
 	to->elapsed_pass_time_from_first_op += from->elapsed_pass_time_from_first_op; // Total time from start of first op in pass to the end of the last operation 
 	to->pass_start_lag_time += from->pass_start_lag_time;		// Lag time from start of pass to the start of the first operation 
 
+	// Op time histogram - the percentiles are recalculated over everything merged so far
+	xint_lh_merge(&to->latency_hist, &from->latency_hist);
+	xdd_results_latency_percentiles(to);
+
+	// Open-loop arrival backlog
+	to->arrival_ops += from->arrival_ops;
+	to->backlog_sum += from->backlog_sum;
+	if (to->arrival_ops > 0)
+		to->backlog_avg = to->backlog_sum / (double)to->arrival_ops;
+	if (to->backlog_max < from->backlog_max)
+		to->backlog_max = from->backlog_max;
+	if (to->issue_lag_max < from->issue_lag_max)
+		to->issue_lag_max = from->issue_lag_max;
+
 	if (to->flags & RESULTS_TARGET_PASS) {
 		if (to->earliest_start_time_this_pass >= from->earliest_start_time_this_pass)
 			to->earliest_start_time_this_pass = from->earliest_start_time_this_pass;
@@ -748,6 +782,20 @@ xdd_extract_pass_results(results_t *rp, target_data_t *tdp, xdd_plan_t *planp) {
 		rp->latency = 0.0;
 	else rp->latency = (double)((1.0/rp->iops) * 1000.0);  // milliseconds
 
+	// Latency percentiles from the op time histogram of this Target
+	memcpy(&rp->latency_hist, &tdp->td_latency_hist, sizeof(rp->latency_hist));
+	xdd_results_latency_percentiles(rp);
+
+	// Backlog of the open-loop arrivals
+	if (tdp->td_arrivalp) {
+		rp->arrival_ops = tdp->td_arrivalp->arrival_ops;
+		rp->backlog_sum = tdp->td_arrivalp->arrival_backlog_sum;
+		if (rp->arrival_ops > 0)
+			rp->backlog_avg = rp->backlog_sum / (double)rp->arrival_ops;
+		rp->backlog_max = (double)tdp->td_arrivalp->arrival_backlog_max;
+		rp->issue_lag_max = (double)tdp->td_arrivalp->arrival_lag_max / FLOAT_THOUSAND;
+	}
+
 	// Times
 	rp->user_time =   (double)(tdp->td_counters.tc_current_cpu_times.tms_utime  - tdp->td_counters.tc_starting_cpu_times_this_pass.tms_utime)/(double)(xgp->clock_tick); // Seconds
 	rp->system_time = (double)(tdp->td_counters.tc_current_cpu_times.tms_stime  - tdp->td_counters.tc_starting_cpu_times_this_pass.tms_stime)/(double)(xgp->clock_tick); // Seconds
@@ -823,6 +871,26 @@ xdd_extract_pass_results(results_t *rp, target_data_t *tdp, xdd_plan_t *planp) {
 	return(0);
 } // End of xdd_extract_pass_results() 
 
+/*----------------------------------------------------------------------------*/
+// xdd_results_latency_percentiles() 
+// Fill in the latency percentiles of the specified results structure from
+// its op time histogram. The histogram is in nanoseconds and the percentiles 
+// are reported in microseconds.
+//
+void
+xdd_results_latency_percentiles(results_t *rp) {
+	xint_latency_histogram_t	*lhp;
+
+
+	lhp = &rp->latency_hist;
+	rp->latency_p50 = (double)xint_lh_percentile(lhp, 50.0) / FLOAT_THOUSAND;
+	rp->latency_p90 = (double)xint_lh_percentile(lhp, 90.0) / FLOAT_THOUSAND;
+	rp->latency_p99 = (double)xint_lh_percentile(lhp, 99.0) / FLOAT_THOUSAND;
+	rp->latency_p999 = (double)xint_lh_percentile(lhp, 99.9) / FLOAT_THOUSAND;
+	rp->latency_p9999 = (double)xint_lh_percentile(lhp, 99.99) / FLOAT_THOUSAND;
+	rp->latency_max = (double)lhp->lh_max / FLOAT_THOUSAND;
+} // End of xdd_results_latency_percentiles() 
+
 /*
  * Local variables:
  *  indent-tabs-mode: t
@@ -11,22 +11,157 @@
  *
  */
 /*
- * This file contains the subroutines necessary to generate the seeklist 
- * which has the implied access pattern.
+ * This file contains the subroutines necessary to generate the seek 
+ * locations which have the implied access pattern.
  */
 #include "xint.h"
+
+#define XINT_SEEK_TWO_PI	6.283185307179586476925286766559
+
+/*----------------------------------------------------------------------------*/
+/* The Zipf locations are drawn with the rejection-inversion method of 
+ * Hormann and Derflinger, "Rejection-inversion to generate variates from
+ * monotone discrete distributions" (1996). It needs no table, takes O(1) time
+ * to set up for any range and accepts more than 9 in 10 candidates, so each
+ * location costs about one random number. The helpers below are the integral
+ * of the Zipf "hat" function and its inverse for exponent s, written so that
+ * they stay accurate when s is at or near 1.
+ */
+static double
+xint_zipf_helper1(double x) { // log(1+x)/x
+	if (fabs(x) > 1e-8)
+		return(log1p(x) / x);
+	return(1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x)));
+}
+static double
+xint_zipf_helper2(double x) { // (exp(x)-1)/x
+	if (fabs(x) > 1e-8)
+		return(expm1(x) / x);
+	return(1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x)));
+}
+static double
+xint_zipf_h(double x, double s) {
+	return(exp(-s * log(x)));
+}
+static double
+xint_zipf_h_integral(double x, double s) {
+	double	log_x = log(x);
+	return(xint_zipf_helper2((1.0 - s) * log_x) * log_x);
+}
+static double
+xint_zipf_h_integral_inverse(double x, double s) {
+	double	t = x * (1.0 - s);
+	if (t < -1.0)
+		t = -1.0;
+	return(exp(xint_zipf_helper1(t) * x));
+}
+
+/*----------------------------------------------------------------------------*/
+/* xdd_init_seek_distribution() - Work out the range of the random seek 
+ * locations and the constants that the chosen distribution needs so that
+ * each location can then be drawn in constant time.
+ */
+static void
+xdd_init_seek_distribution(target_data_t *tdp) {
+	seekhdr_t	*sp;	/* pointer to the seek header */
+	double		n;		/* Number of locations in the range */
+	double		s;		/* Zipf exponent */
+
+
+	sp = &tdp->td_seekhdr;
+	sp->seek_dist_range = (sp->seek_range * 1024) / tdp->td_block_size;
+	n = (sp->seek_dist_range > 1) ? (double)sp->seek_dist_range : 1.0;
+	switch (sp->seek_distribution) {
+		case SO_DIST_ZIPF:
+			s = sp->seek_dist_param1;
+			sp->seek_dist_c1 = xint_zipf_h_integral(1.5, s) - 1.0;
+			sp->seek_dist_c2 = xint_zipf_h_integral(n + 0.5, s);
+			sp->seek_dist_c3 = 2.0 - xint_zipf_h_integral_inverse(xint_zipf_h_integral(2.5, s) - xint_zipf_h(2.0, s), s);
+			break;
+		case SO_DIST_PARETO:
+			// The power of a uniform number that sends a fraction 1-h of the ops to the first fraction h of the range 
+			sp->seek_dist_c1 = log(sp->seek_dist_param1) / log(1.0 - sp->seek_dist_param1);
+			break;
+		case SO_DIST_HOTSPOT:
+			// Number of blocks in the hot band and the fraction of the ops that go there
+			sp->seek_dist_c1 = floor(n * sp->seek_dist_param1 / 100.0);
+			sp->seek_dist_c2 = sp->seek_dist_param2 / 100.0;
+			break;
+		default:
+			break;
+	}
+} /* end of xdd_init_seek_distribution() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_random_seek_location() - Draw one random block location from the 
+ * distribution of this target using the random numbers of the operation.
+ * The skewed distributions put their hottest blocks at the start of the 
+ * range except for gaussian, whose hottest block is the center.
+ */
+static uint64_t
+xdd_random_seek_location(seekhdr_t *sp, int64_t range) {
+	double		n;		/* Number of locations in the range */
+	double		u;		/* Uniform random number for the Zipf candidate */
+	double		x;		/* Continuous location */
+	int64_t		k;		/* Zipf rank from 1 to n */
+
+
+	if ((range <= 1) && (sp->seek_distribution != SO_DIST_UNIFORM))
+		return(0);
+	n = (double)range;
+	switch (sp->seek_distribution) {
+		case SO_DIST_ZIPF:
+			for (;;) {
+				u = sp->seek_dist_c2 + xint_rng_double(&sp->seek_rng) * (sp->seek_dist_c1 - sp->seek_dist_c2);
+				x = xint_zipf_h_integral_inverse(u, sp->seek_dist_param1);
+				k = (int64_t)(x + 0.5);
+				if (k < 1)
+					k = 1;
+				else if (k > range)
+					k = range;
+				if (((double)k - x <= sp->seek_dist_c3) || 
+					(u >= xint_zipf_h_integral((double)k + 0.5, sp->seek_dist_param1) - xint_zipf_h((double)k, sp->seek_dist_param1)))
+					return((uint64_t)(k - 1));
+			}
+		case SO_DIST_PARETO:
+			x = n * pow(xint_rng_double(&sp->seek_rng), sp->seek_dist_c1);
+			break;
+		case SO_DIST_HOTSPOT:
+			if (xint_rng_double(&sp->seek_rng) < sp->seek_dist_c2)
+				x = sp->seek_dist_c1 * xint_rng_double(&sp->seek_rng);
+			else x = sp->seek_dist_c1 + (n - sp->seek_dist_c1) * xint_rng_double(&sp->seek_rng);
+			break;
+		case SO_DIST_GAUSSIAN:
+			// Box-Muller - locations that fall off either end wrap around to the other end
+			x = sqrt(-2.0 * log(1.0 - xint_rng_double(&sp->seek_rng))) * cos(XINT_SEEK_TWO_PI * xint_rng_double(&sp->seek_rng));
+			x = fmod(sp->seek_dist_param1 + (x * sp->seek_dist_param2), n);
+			if (x < 0.0)
+				x += n;
+			break;
+		default: // Uniform
+			x = n * xint_rng_double(&sp->seek_rng);
+			break;
+	}
+	if (x > n - 1.0)
+		x = n - 1.0;
+	if (x < 0.0)
+		x = 0.0;
+	return((uint64_t)x);
+} /* end of xdd_random_seek_location() */
+
 /*----------------------------------------------------------------------------*/
-/* xdd_init_seek_list() - Generate the list of seek operations to perform
- * This routine will generate a list of locations to access within the
- * specified range for random seeks or within the implied range for 
+/* xdd_init_seek_list() - Set up the seek locations for a target
+ * This routine will set up the generator for the locations to access within 
+ * the specified range for random seeks or within the implied range for 
  * purely sequential operations. 
- * The seek list is either loaded from a specified file or is generated
- * by this routine. 
- * Each entry in the seek list contains the seek location, the size of the
- * data transfer (currently reqsize), and the operation to perform.
- * The seek entries are first loaded with their locations and a second
- * pass assigns operations (read or write) to the locations as
- * necessary. 
+ * Each seek entry contains the seek location, the size of the
+ * data transfer (currently reqsize), the operation to perform, and the
+ * time the operation should be issued when throttled.
+ * Seek entries are normally generated on demand, one operation at a time,
+ * by xdd_get_seek_entry() so that no memory is needed for the seek list.
+ * A full seek list is only built when it is loaded from a file or when it 
+ * needs to be saved to a file or used to print the seek histograms. In that 
+ * case the list is filled in by the same generator.
  * Example A - A normal 100% write seek list
  *
  * Operation# Location Op 
@@ -36,19 +171,11 @@
  *    3     3072  W 
  *    n     n*1024 W
  *
+ * Return value is 0 if everything is good or -1 if there was a problem.
  */
-void
+int32_t
 xdd_init_seek_list(target_data_t *tdp) {
-	int32_t  j;
-	int32_t  rw_op_index;  /* relative rw index from 0 to the number of rw ops minus 1  */
-	int32_t  rw_index;   /* absolute index into seek list for the current rw op*/
-	int32_t  rw_index_incr;  /* read/write index increment value (1 or 2) */
 	int32_t  op_index;   /* Current operation number  (from 0 to sp->seek_total_ops-1 ) */
-	int64_t  gap;    /* The gap in blocks between staggered locations */
-	int64_t  interleave_threadoffset;
-	int64_t  range_in_bytes;
-	int64_t  range_in_1kblocks;
-	int64_t  range_in_blocksize_blocks;
 	double  bytes_per_sec;  /* The tranfer rate requested by the -throttle option */
 	double  seconds_per_op; /* a floating point representation of the time per operation */
 	double  variance_seconds_per_op; /* a floating point representation of the time variance per operation */
@@ -58,10 +185,6 @@ xdd_init_seek_list(target_data_t *tdp) {
 	double  bytes_per_request; /* self explanatory */
 	nclk_t  nano_seconds_per_op = 0; /* self explanatory */
     nclk_t  nano_second_throttle_variance = 0; /* Max variance per operation */
-	nclk_t  relative_time; /* Time in nanosecond relative to the first operation */
-	int32_t  previous_percent_op; /* used to determine read/write operation */
-	int32_t  percent_op;  /* used to determine read/write operation */
-	int32_t  current_op;  /* Current operation - SO_OP_READ or SO_OP_WRITE or SO_OP_NOOP */
 	seekhdr_t *sp;   /* pointer to the seek header */
         
 	/* If a throttle value has been specified, calculate the time that each operation should take */
@@ -99,108 +222,193 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
 		}
 	} else nano_seconds_per_op = 0;
 	sp = &tdp->td_seekhdr;
-        /* Initialize the random number generator */
-	sp->oldstate = initstate(sp->seek_seed, sp->state, sizeof(sp->state));
+	sp->seek_nsec_per_op = nano_seconds_per_op;
+	sp->seek_nsec_variance = nano_second_throttle_variance;
+	sp->seek_sec_per_op_low = seconds_per_op_low;
+	sp->seek_sec_per_op_high = seconds_per_op_high;
+	sp->seek_num_rw_ops = sp->seek_total_ops;
+	sp->seek_current_op = -1;
+	sp->seek_next_op = 0;
+	sp->seeks = NULL;
+	xdd_init_seek_distribution(tdp);
+
+	/* Only build the full seek list if it is loaded from or saved to a file */
+	if (!(sp->seek_options & (SO_SEEK_LOAD | SO_SEEK_SAVE | SO_SEEK_SEEKHIST | SO_SEEK_DISTHIST))) 
+		return(0);
+
+	sp->seeks = (seek_t *)calloc((int32_t)sp->seek_total_ops,sizeof(seek_t));
+	if (sp->seeks == NULL) {
+		fprintf(xgp->errout,"%s: xdd_init_seek_list: ERROR: Cannot allocate memory for access list for Target %d name '%s' - terminating\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname);
+		return(-1);
+	}
 
 	/* Check to see if we need to load the seeks from a specified file */
 	if (sp->seek_options & SO_SEEK_LOAD) { /* Load pre-defined seek list */
 		xdd_load_seek_list(tdp);
 		sp->seek_options &= ~SO_SEEK_LOAD; /* only want to load seek list once */
+		sp->seek_first_location = sp->seeks[0].block_location;
 	} else { /* Generate a new seek list */ 
-		relative_time = nano_seconds_per_op + tdp->td_start_delay;
-		rw_op_index = 0;
-		rw_index = 0;
-		rw_index_incr = 1;
-		sp->seek_num_rw_ops = sp->seek_total_ops;
-		if (tdp->td_rwratio >= 0.5) /* This has to be set correctly or the first op may not be correct */
-			previous_percent_op = -1.0;
-		else previous_percent_op = 0.0;
-		for (op_index = 0; op_index < sp->seek_total_ops; op_index++) {   
-			/* Fill in the seek location */
-			if (sp->seek_options & SO_SEEK_RANDOM) { /* generate a random seek location */
-				range_in_1kblocks = sp->seek_range;
-				range_in_bytes = range_in_1kblocks * 1024;
-				range_in_blocksize_blocks = range_in_bytes / tdp->td_block_size;
-				if (rw_op_index == 0) { /* This is the first location for this thread */
-// FIXME ????					for (j = 0; j < tdp->td_my_qthread_number; j++) /* skip over the first N locations */
-// FIXME ????						sp->seeks[rw_index].block_location = (uint64_t)(range_in_blocksize_blocks * xdd_random_float());
-					/* Assign this location as the first seek */
-					sp->seeks[rw_index].block_location = (uint64_t)(range_in_blocksize_blocks * xdd_random_float());
-				} else { /* This section if for seek locations 2 thru N */
-					/* This is done to support interleaved I/O operations and/or command queuing */
-					for (j = 0; j < sp->seek_interleave; j++)
-						sp->seeks[rw_index].block_location = (uint64_t)(range_in_blocksize_blocks * xdd_random_float());
-				}
-			} else {/* generate a sequential seek */
-				if (sp->seek_options & SO_SEEK_STAGGER) {
-					gap = ((sp->seek_range-tdp->td_reqsize) - (sp->seek_num_rw_ops*tdp->td_reqsize)) / (sp->seek_num_rw_ops-1);
-				        if (sp->seek_stride > tdp->td_reqsize) gap = sp->seek_stride - tdp->td_reqsize;
-                                }
-				else gap = 0; 
-				if (sp->seek_interleave > 1)
-// FIXME ????		interleave_threadoffset = (tdp->td_my_qthread_number%sp->seek_interleave)*tdp->td_reqsize;
-					interleave_threadoffset = sp->seek_interleave*tdp->td_reqsize;
-				else interleave_threadoffset = 0;
-				sp->seeks[rw_index].block_location = tdp->td_start_offset + interleave_threadoffset + 
-						(rw_op_index * ((tdp->td_reqsize*sp->seek_interleave)+gap));
-			} /* end of generating a sequential seek */
-			/* Now lets fill in the request sizes to transfer */
-			sp->seeks[rw_index].reqsize = tdp->td_reqsize;
-			/* Now lets fill in the appropriate operation */
-			/* The operation is specified either as "read" or "write" in which case
-			 * all operations for this target will be either read or write accordingly.
-			 * The way this is actually done is that when the command line arguments are
-			 * parsed, if the -op read or -op write options are specified then the
-			 * rwratio is set to 100 or 0 accordingly. This way, the operation is
-			 * determined soley by the rwratio parameter. 
-			 * If the "rwratio" was specified, then the appropriate number
-			 * of read and write operations are used. 
-			 * The -rwratio option takes precedence over the -op option.
-			 */
-			if (tdp->td_rwratio == -1.0) { // No-op
-				sp->seeks[rw_index].operation = SO_OP_NOOP;
-			} else { // Normal read/write operations
-				percent_op = tdp->td_rwratio * rw_op_index;
-				if (percent_op > previous_percent_op) 
-					current_op = SO_OP_READ;
-				else current_op = SO_OP_WRITE;
-				previous_percent_op = percent_op;
-            	/* Fill in the operation */
-				if (current_op == SO_OP_WRITE) { /* This is a WRITE operation */
-					sp->seeks[rw_index].operation = SO_OP_WRITE;
-				} else { /* This is a READ operation */
-					sp->seeks[rw_index].operation = SO_OP_READ;
-				}
-			}
-
-			/* fill in the time that this operation is supposed to take place */
-            //  -----------------L=========^=========H------------>
-            //   Time--->        |         |         |Relative time plus the variance
-            //                   |         |Relative time Average
-            //                   |Relative time minus the variance
-            // The actual time that an I/O operation should take place is somewhere between
-            // the relative time plus or minus the variance. In Theory. Maybe.
-            if ((tdp->td_throtp) && (tdp->td_throtp->throttle_variance > 0.0)) {
-                variance_seconds_per_op = ((seconds_per_op_high-seconds_per_op_low) * xdd_random_float()) * BILLION;
-                sp->seeks[rw_index].time1 = (relative_time - nano_second_throttle_variance) + variance_seconds_per_op;
-
-            } else {
-			    sp->seeks[rw_index].time1 = relative_time;
-
-            }
-if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_init_seek_list: Target: %d: Worker: %d: SET SEEK TIME: nano_seconds_per_op: %lld: relative_time: %lld:\n", (long long int)pclk_now(),tdp->td_target_number,-1,(long long int)nano_seconds_per_op,(long long int)relative_time);
-			relative_time += nano_seconds_per_op;
-
-			/* Increment to the next entry in the seek list */
-			rw_index += rw_index_incr;
-			rw_op_index++;
-		} /* end of FOR loop */
+		for (op_index = 0; op_index < sp->seek_total_ops; op_index++) 
+			xdd_generate_seek_entry(tdp, op_index, &sp->seeks[op_index]);
 	} /* done generating a new seek list */
 	/* Save this seek list to a file if requested to do so */
 	if (sp->seek_options & (SO_SEEK_SAVE | SO_SEEK_SEEKHIST | SO_SEEK_DISTHIST)) 
 		xdd_save_seek_list(tdp);
+	return(0);
 } /* end of xdd_init_seek_list() */
 /*----------------------------------------------------------------------------*/
+/* xdd_generate_seek_entry() - Generate the seek entry for a single operation
+ * The random locations and throttle variances of an operation are drawn from
+ * a counter-based random number stream keyed by the seed, the target number,
+ * and the operation number, so entries can be generated in any order and by
+ * any thread. Only sequential locations with a request size mix have to be
+ * generated in order because they depend on the sizes of all the operations
+ * before them.
+ * The result is placed in the seek entry pointed to by "sep".
+ */
+void
+xdd_generate_seek_entry(target_data_t *tdp, int64_t op_index, seek_t *sep) {
+	int32_t  j;
+	int64_t  gap;    /* The gap in blocks between staggered locations */
+	int64_t  interleave_threadoffset;
+	double  variance_seconds_per_op; /* a floating point representation of the time variance per operation */
+	nclk_t  relative_time; /* Time in nanosecond relative to the first operation */
+	int32_t  previous_percent_op; /* used to determine read/write operation */
+	int32_t  percent_op;  /* used to determine read/write operation */
+	seekhdr_t *sp;   /* pointer to the seek header */
+	xint_replay_entry_t *rep; /* The trace entry of a replayed operation */
+
+
+	sp = &tdp->td_seekhdr;
+	xint_rng_init(&sp->seek_rng, (uint64_t)sp->seek_seed, tdp->td_target_number, XINT_RNG_SEEK, op_index);
+	/* A replayed operation is the same as it was in the trace */
+	if (tdp->td_replayp) {
+		rep = &tdp->td_replayp->replay_entries[op_index];
+		sep->block_location = rep->re_offset / tdp->td_block_size;
+		sep->reqsize = rep->re_size / tdp->td_block_size;
+		sep->operation = rep->re_operation;
+		sep->time1 = (nclk_t)(rep->re_issue_time / tdp->td_replayp->replay_speedup);
+		sep->time2 = rep->re_latency;
+		if (op_index == 0) 
+			sp->seek_first_location = sep->block_location;
+		sp->seek_next_op = op_index + 1;
+		return;
+	}
+	sep->block_location = 0;
+	/* Each operation of a request size mix has its own request size */
+	if (tdp->td_rsmp)
+		sep->reqsize = tdp->td_rsmp->rsm_reqsize[xint_reqsize_mix_class(tdp, op_index)];
+	else sep->reqsize = tdp->td_reqsize;
+	/* Fill in the seek location */
+	if (sp->seek_options & SO_SEEK_RANDOM) { /* generate a random seek location */
+		if (op_index == 0) { /* This is the first location for this thread */
+			/* Assign this location as the first seek */
+			sep->block_location = xdd_random_seek_location(sp, sp->seek_dist_range);
+		} else { /* This section if for seek locations 2 thru N */
+			/* This is done to support interleaved I/O operations and/or command queuing */
+			for (j = 0; j < sp->seek_interleave; j++)
+				sep->block_location = xdd_random_seek_location(sp, sp->seek_dist_range);
+		}
+	} else {/* generate a sequential seek */
+		if ((sp->seek_options & SO_SEEK_STAGGER) && (sp->seek_num_rw_ops > 1)) {
+			gap = ((sp->seek_range-tdp->td_reqsize) - (sp->seek_num_rw_ops*tdp->td_reqsize)) / (sp->seek_num_rw_ops-1);
+			if (sp->seek_stride > tdp->td_reqsize) gap = sp->seek_stride - tdp->td_reqsize;
+		}
+		else gap = 0; 
+		if (sp->seek_interleave > 1)
+			interleave_threadoffset = sp->seek_interleave*tdp->td_reqsize;
+		else interleave_threadoffset = 0;
+		if (tdp->td_rsmp) { /* The operations are different sizes so add them up */
+			if (op_index == 0)
+				sp->seek_mix_location = 0;
+			sep->block_location = tdp->td_start_offset + interleave_threadoffset + sp->seek_mix_location;
+			sp->seek_mix_location += (sep->reqsize*sp->seek_interleave)+gap;
+		} else sep->block_location = tdp->td_start_offset + interleave_threadoffset + 
+				(op_index * ((tdp->td_reqsize*sp->seek_interleave)+gap));
+	} /* end of generating a sequential seek */
+	if (op_index == 0) 
+		sp->seek_first_location = sep->block_location;
+	/* Now lets fill in the appropriate operation */
+	/* The operation is specified either as "read" or "write" in which case
+	 * all operations for this target will be either read or write accordingly.
+	 * The way this is actually done is that when the command line arguments are
+	 * parsed, if the -op read or -op write options are specified then the
+	 * rwratio is set to 100 or 0 accordingly. This way, the operation is
+	 * determined soley by the rwratio parameter. 
+	 * If the "rwratio" was specified, then the appropriate number
+	 * of read and write operations are used. 
+	 * The -rwratio option takes precedence over the -op option.
+	 */
+	if (tdp->td_rwratio == -1.0) { // No-op
+		sep->operation = SO_OP_NOOP;
+	} else { // Normal read/write operations
+		if (op_index == 0) { /* This has to be set correctly or the first op may not be correct */
+			if (tdp->td_rwratio >= 0.5) 
+				previous_percent_op = -1.0;
+			else previous_percent_op = 0.0;
+		} else previous_percent_op = tdp->td_rwratio * (op_index - 1);
+		percent_op = tdp->td_rwratio * op_index;
+		if (percent_op > previous_percent_op) 
+			sep->operation = SO_OP_READ;
+		else sep->operation = SO_OP_WRITE;
+	}
+
+	/* fill in the time that this operation is supposed to take place */
+    //  -----------------L=========^=========H------------>
+    //   Time--->        |         |         |Relative time plus the variance
+    //                   |         |Relative time Average
+    //                   |Relative time minus the variance
+    // The actual time that an I/O operation should take place is somewhere between
+    // the relative time plus or minus the variance. In Theory. Maybe.
+	relative_time = (sp->seek_nsec_per_op * (op_index + 1)) + tdp->td_start_delay;
+    if ((tdp->td_throtp) && (tdp->td_throtp->throttle_variance > 0.0)) {
+        variance_seconds_per_op = ((sp->seek_sec_per_op_high-sp->seek_sec_per_op_low) * xint_rng_double(&sp->seek_rng)) * BILLION;
+        sep->time1 = (relative_time - sp->seek_nsec_variance) + variance_seconds_per_op;
+    } else {
+	    sep->time1 = relative_time;
+    }
+	sep->time2 = 0;
+if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_generate_seek_entry: Target: %d: Worker: %d: SET SEEK TIME: nano_seconds_per_op: %lld: relative_time: %lld:\n", (long long int)pclk_now(),tdp->td_target_number,-1,(long long int)sp->seek_nsec_per_op,(long long int)relative_time);
+	sp->seek_next_op = op_index + 1;
+} /* end of xdd_generate_seek_entry() */
+/*----------------------------------------------------------------------------*/
+/* xdd_get_seek_entry() - Return a pointer to the seek entry for the 
+ * specified operation number. 
+ * If there is a full seek list then the entry comes from the list. 
+ * Otherwise the entry is generated on demand into sp->seek_current. 
+ * Operations are normally requested in order so each entry is generated
+ * exactly once. An operation requested out of order (e.g. a restart that 
+ * resumes in the middle of a pass) is generated directly, except for 
+ * sequential locations with a request size mix where the operations before
+ * it are generated again to add up their sizes.
+ * This is only called by the Target Thread. 
+ */
+seek_t *
+xdd_get_seek_entry(target_data_t *tdp, int64_t op_index) {
+	seekhdr_t	*sp;		/* pointer to the seek header */
+	int64_t		i;
+
+
+	sp = &tdp->td_seekhdr;
+	if (sp->seeks)
+		return(&sp->seeks[op_index]);
+	if (op_index == sp->seek_current_op)
+		return(&sp->seek_current);
+	if ((op_index != 0) && (op_index != sp->seek_next_op)) {
+		if ((tdp->td_rsmp) && !(tdp->td_replayp) && !(sp->seek_options & SO_SEEK_RANDOM)) {
+			for (i = 0; i < op_index; i++)
+				xdd_generate_seek_entry(tdp, i, &sp->seek_current);
+		} else if (sp->seek_next_op == 0) /* Operation 0 sets the first location */
+			xdd_generate_seek_entry(tdp, 0, &sp->seek_current);
+	}
+	xdd_generate_seek_entry(tdp, op_index, &sp->seek_current);
+	sp->seek_current_op = op_index;
+	return(&sp->seek_current);
+} /* end of xdd_get_seek_entry() */
+/*----------------------------------------------------------------------------*/
 /* xdd_save_seek_list() - save the specified seek list in a file    
  */
 void
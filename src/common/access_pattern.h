@@ -36,6 +36,13 @@ typedef struct seek_entries seek_t;
 #define SO_SEEK_DISTHIST  0x00000020 /**< Print the seek distance histogram */
 #define SO_SEEK_SEEKHIST  0x00000040 /**< Print the seek location histogram */
 
+/** Distributions of the random seek locations */
+#define SO_DIST_UNIFORM   0 /**< Every location in the range is equally likely */
+#define SO_DIST_ZIPF      1 /**< Zipf distribution with exponent theta - location 0 is the hottest */
+#define SO_DIST_PARETO    2 /**< Pareto "h/1-h" rule - a fraction 1-h of the ops go to the first fraction h of the range, and so on within it */
+#define SO_DIST_HOTSPOT   3 /**< A percentage of the ops go to a hot band at the start of the range */
+#define SO_DIST_GAUSSIAN  4 /**< Normal distribution around a center location, wrapped around the range */
+
 /** The seek header contains all the information regarding seek locations */
 struct seekhdr {
 	uint64_t seek_options; /**< various seek option flags */
@@ -51,9 +58,24 @@ struct seekhdr {
 	char  *seek_savefile; /**< file to save seek locations into */
 	char  *seek_loadfile; /**< file from which to load seek locations from */
 	char  *seek_pattern; /**< The seek pattern used for this target */
-	seek_t  *seeks;  /**< the seek list */
-	char state[256];
-	char *oldstate;
+	seek_t  *seeks;  /**< the seek list - only allocated for -seek load/save/seekhist/disthist */
+	seek_t  seek_current; /**< The seek entry generated on demand for seek_current_op */
+	int64_t  seek_current_op; /**< The operation number of seek_current or -1 */
+	int64_t  seek_next_op; /**< The next operation number the generator will produce */
+	uint64_t seek_first_location; /**< The location of operation 0 - used by -seek none */
+	int64_t  seek_mix_location; /**< Blocks taken up by the sequential operations so far when there is a request size mix */
+	xint_rng_t seek_rng; /**< Random numbers of the operation being generated - keyed by seed, target and operation number */
+	uint32_t seek_distribution; /**< Distribution of random seek locations - one of the SO_DIST_ values */
+	double  seek_dist_param1; /**< zipf theta, pareto h, hotspot hot band percent, or gaussian center in blocks */
+	double  seek_dist_param2; /**< hotspot percent of ops that go to the hot band, or gaussian standard deviation in blocks */
+	int64_t  seek_dist_range; /**< Number of blocks the random locations are drawn from */
+	double  seek_dist_c1; /**< Constants worked out once by xdd_init_seek_distribution() */
+	double  seek_dist_c2;
+	double  seek_dist_c3;
+	nclk_t  seek_nsec_per_op; /**< Nanoseconds between operations when throttled */
+	nclk_t  seek_nsec_variance; /**< Max variance in nanoseconds per operation when throttled */
+	double  seek_sec_per_op_low; /**< Shortest time per operation when throttled with a variance */
+	double  seek_sec_per_op_high; /**< Longest time per operation when throttled with a variance */
 };
 typedef struct seekhdr seekhdr_t;
 
@@ -107,6 +107,7 @@
 // in the barrier at any given time. 
 // The "threads" member of the barrier structure indicates the number of occupants 
 // that must enter the barrier before all the occupants are released.
+// The occupant chain is only kept when XDD_BARRIER_TRACKING() is true.
 //
 
 #include "xint.h"
@@ -159,9 +160,9 @@ xdd_destroy_all_barriers(xdd_plan_t* planp) {
 } /* end of xdd_destroy_all_barriers() */
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
-// This section uses POSIX pthread_barriers to implement barriers
+// This section implements barriers with atomics and futexes
 /*----------------------------------------------------------------------------*/
-/* xdd_init_barrier() - Will initialize the specified pthread_barrier
+/* xdd_init_barrier() - Will initialize the specified barrier
  */
 int32_t
 xdd_init_barrier(xdd_plan_t* planp, struct xdd_barrier *bp, int32_t threads, char *barrier_name) {
@@ -176,23 +177,17 @@ xdd_init_barrier(xdd_plan_t* planp, struct xdd_barrier *bp, int32_t threads, cha
 	bp->name[XDD_BARRIER_MAX_NAME_LENGTH-1] = '\0';
 	bp->first_occupant = NULL;
 	bp->last_occupant = NULL;
+	bp->arrived = 0;
+	bp->sense = 0;
+	bp->waiting = 0;
+	// Do not spin if the participants cannot all be running at the same time
+	if (threads <= sysconf(_SC_NPROCESSORS_ONLN))
+		bp->spin = XDD_BARRIER_SPIN_COUNT;
+	else bp->spin = 0;
 
 	status = pthread_mutex_init(&bp->mutex, 0);
 	if (status) {
-		fprintf(xgp->errout,"%s: xdd_init_barrier<pthread_barriers>: ERROR initializing mutex for barrier '%s', status=%d",
-			xgp->progname, barrier_name, status);
-		perror("Reason");
-		bp->flags &= ~XDD_BARRIER_FLAG_INITIALIZED; // NOT initialized!!!
-		return(-1);
-	}
-	// Init barrier
-#ifdef HAVE_PTHREAD_BARRIER_T
-	status = pthread_barrier_init(&bp->pbar, 0, threads);
-#else
-	status = xint_barrier_init(&bp->pbar, threads);
-#endif
-	if (status) {
-		fprintf(xgp->errout,"%s: xdd_init_barrier<pthread_barriers>: ERROR in pthread_barrier_init for barrier '%s', status=%d",
+		fprintf(xgp->errout,"%s: xdd_init_barrier: ERROR initializing mutex for barrier '%s', status=%d",
 			xgp->progname, barrier_name, status);
 		perror("Reason");
 		bp->flags &= ~XDD_BARRIER_FLAG_INITIALIZED; // NOT initialized!!!
@@ -216,7 +211,7 @@ xdd_init_barrier(xdd_plan_t* planp, struct xdd_barrier *bp, int32_t threads, cha
 	planp->barrier_count++;
 	pthread_mutex_unlock(&planp->barrier_chain_mutex);
 	return(0);
-} // End of xdd_init_barrier() POSIX
+} // End of xdd_init_barrier()
 
 /*----------------------------------------------------------------------------*/
 /* xdd_destroy_barrier() - Will destroy all the barriers and mutex locks.
@@ -238,22 +233,11 @@ xdd_destroy_barrier(xdd_plan_t* planp, struct xdd_barrier *bp) {
 		return;
 	status = pthread_mutex_destroy(&bp->mutex);
 	if (status && !(xgp->global_options & GO_INTERACTIVE_EXIT)) { // If this is an exit requested by the interactive debugger then do not display error messages...
-		fprintf(xgp->errout,"%s: xdd_destroy_barrier<pthread_barriers>: ERROR: pthread_mutex_destroy: errno %d destroying mutex for barrier '%s'\n",
+		fprintf(xgp->errout,"%s: xdd_destroy_barrier: ERROR: pthread_mutex_destroy: errno %d destroying mutex for barrier '%s'\n",
 			xgp->progname, status, bp->name);
 		errno = status; // Set the errno
 		perror("Reason");
 	}
-#ifdef HAVE_PTHREAD_BARRIER_T
-	status = pthread_barrier_destroy(&bp->pbar);
-#else
-	status = xint_barrier_destroy(&bp->pbar);
-#endif
-	if (status && !(xgp->global_options & GO_INTERACTIVE_EXIT)) { // If this is an exit requested by the interactive debugger then do not display error messages...
-		fprintf(xgp->errout,"%s: xdd_destroy_barrier<pthread_barriers>: ERROR: pthread_barrier_destroy: errno %d destroying barrier '%s'\n",
-			xgp->progname,status,bp->name);
-		errno = status; // Set the errno
-		perror("Reason");
-	}
 	bp->counter = -1;
 	strcpy(bp->name,"DESTROYED");
 	// Remove this barrier from the chain and relink the barrier before this one to the barrier after this one
@@ -276,37 +260,14 @@ xdd_destroy_barrier(xdd_plan_t* planp, struct xdd_barrier *bp) {
 	planp->barrier_count--;
 	pthread_mutex_unlock(&planp->barrier_chain_mutex);
 	// There, I think we're done...
-} // End of xdd_destroy_barrier() POSIX
-// 							PTHREAD BARRIERS 
+} // End of xdd_destroy_barrier()
 /*----------------------------------------------------------------------------*/
-/* xdd_barrier() - This is the actual barrier subroutine. 
- * The caller will block in this subroutine until all required threads enter
- * this subroutine <barrier> at which time they will all be released.
- * 
- * The "owner" parameter indicates whether or not the calling thread is the
- * owner of this barrier. 0==NOT owner, 1==owner. If this thread owns this
- * barrier then it will be responsible for removing the "occupant" chain 
- * upon being released from this barrier.
- *
- * Before entering the barrier, the occupant structure is added to the end
- * of the occupant chain. This allows the debug routine to see which threads
- * are in a barrier at any given time as well as when they entered the barrier.
- * 
- * If the barrier is a Target Thread or a Worker Thread then the Target_Data pointer is
- * valid and the "current_barrier" member of that Target_Data is set to the barrier
- * pointer of the barrier that this thread is about to enter. Upon leaving the
- * barrier, this pointer is cleared.
- *
- * THIS SUBROUTINE IMPLEMENTS BARRIERS USING PTHREAD_BARRIERS 
+/* xdd_barrier_enter() - Put an occupant on the occupant chain of a barrier
+ * and mark its Target or Worker Thread as being in this barrier.
+ * This is only done when barrier tracking is on.
  */
-int32_t
-xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner) {
-	int32_t 	status;  			// Status of the pthread_barrier call 
-
-
-	/* "threads" is the number of participating threads */
-	if (bp->threads == 1) return(0); /* If there is only one thread then why bother sleeping */
-
+static void
+xdd_barrier_enter(struct xdd_barrier *bp, xdd_occupant_t *occupantp) {
 	// Put this Target_Data on the Barrier Target_Data Chain so that we can track it later if we need to 
 	/////// this is to keep track of which Target_Data are in a particular barrier at any given time...
 	pthread_mutex_lock(&bp->mutex);
@@ -335,29 +296,16 @@ xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner) {
 	bp->counter++;
 	pthread_mutex_unlock(&bp->mutex);
 
-	// Now we wait here at this barrier until all the other threads arrive...
 	nclk_now(&occupantp->entry_time);
+} // End of xdd_barrier_enter()
 
-#ifdef HAVE_PTHREAD_BARRIER_T
-	status = pthread_barrier_wait(&bp->pbar);
-	nclk_now(&occupantp->exit_time);
-	if ((status != 0) && (status != PTHREAD_BARRIER_SERIAL_THREAD)) {
-		fprintf(xgp->errout,"%s: xdd_barrier<pthread_barriers>: ERROR: pthread_barrier_wait failed: Barrier %s, status is %d, errno is %d\n", 
-			xgp->progname, bp->name, status, errno);
-		perror("Reason");
-		status = -1;
-	}
-#else
-	status = xint_barrier_wait(&bp->pbar);
+/*----------------------------------------------------------------------------*/
+/* xdd_barrier_leave() - Undo xdd_barrier_enter() after the barrier opens.
+ * The owner of the barrier also clears the occupant chain.
+ */
+static void
+xdd_barrier_leave(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner) {
 	nclk_now(&occupantp->exit_time);
-	if (status != 0) {
-		fprintf(xgp->errout,"%s: xdd_barrier<pthread_barriers>: ERROR: xint_barrier_wait failed: Barrier %s, status is %d, errno is %d\n", 
-			xgp->progname, bp->name, status, errno);
-		perror("Reason");
-		status = -1;
-	}
-#endif
-
 	if (occupantp->occupant_type & XDD_OCCUPANT_TYPE_TARGET ) {
 		// Clear this thread's Target_Data->current_barrier
 		((target_data_t *)(occupantp->occupant_data))->td_current_barrier = NULL;
@@ -376,9 +324,70 @@ xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner) {
 		bp->counter = 0;
 		pthread_mutex_unlock(&bp->mutex);
 	}
-	return(status);
-} // End of xdd_barrier() POSIX
-// End of POSIX pthread_barrier code
+} // End of xdd_barrier_leave()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_barrier() - This is the actual barrier subroutine. 
+ * The caller will block in this subroutine until all required threads enter
+ * this subroutine <barrier> at which time they will all be released.
+ * 
+ * The "owner" parameter indicates whether or not the calling thread is the
+ * owner of this barrier. 0==NOT owner, 1==owner. If this thread owns this
+ * barrier then it will be responsible for removing the "occupant" chain 
+ * upon being released from this barrier.
+ *
+ * When barrier tracking is on, the occupant structure is added to the end
+ * of the occupant chain before entering the barrier. This allows the debug 
+ * routine to see which threads are in a barrier at any given time as well 
+ * as when they entered the barrier.
+ * 
+ * If the barrier is a Target Thread or a Worker Thread then the Target_Data pointer is
+ * valid and the "current_barrier" member of that Target_Data is set to the barrier
+ * pointer of the barrier that this thread is about to enter. Upon leaving the
+ * barrier, this pointer is cleared.
+ *
+ * See barrier.h for how the sense-reversing barrier works.
+ */
+int32_t
+xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner) {
+	uint32_t	sense;		// Value of bp->sense for this round
+	int32_t		tracking;	// Set when the occupant chain is being kept
+	int32_t		spin;		// Number of polls left before sleeping
+
+
+	/* "threads" is the number of participating threads */
+	if (bp->threads == 1) return(0); /* If there is only one thread then why bother sleeping */
+
+	tracking = XDD_BARRIER_TRACKING();
+	if (tracking)
+		xdd_barrier_enter(bp, occupantp);
+
+	// Now we wait here at this barrier until all the other threads arrive...
+	sense = __atomic_load_n(&bp->sense, __ATOMIC_ACQUIRE);
+	if (__atomic_add_fetch(&bp->arrived, 1, __ATOMIC_ACQ_REL) == (uint32_t)bp->threads) {
+		// Last one in - reset for the next round and open the barrier
+		__atomic_store_n(&bp->arrived, 0, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&bp->sense, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&bp->waiting, __ATOMIC_SEQ_CST))
+			xint_futex_wake(&bp->sense, INT32_MAX);
+	} else {
+		for (spin = bp->spin; spin > 0; spin--) {
+			if (__atomic_load_n(&bp->sense, __ATOMIC_ACQUIRE) != sense)
+				break;
+			XINT_CPU_RELAX();
+		}
+		if (spin == 0) {
+			__atomic_add_fetch(&bp->waiting, 1, __ATOMIC_SEQ_CST);
+			while (__atomic_load_n(&bp->sense, __ATOMIC_SEQ_CST) == sense)
+				xint_futex_wait(&bp->sense, sense);
+			__atomic_sub_fetch(&bp->waiting, 1, __ATOMIC_RELAXED);
+		}
+	}
+
+	if (tracking)
+		xdd_barrier_leave(bp, occupantp, owner);
+	return(0);
+} // End of xdd_barrier()
 
 /*
  * Local variables:
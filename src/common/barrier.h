@@ -113,6 +113,21 @@
 // The "threads" member of the barrier structure indicates the number of occupants 
 // that must enter the barrier before all the occupants are released.
 //
+// Keeping the occupant chain costs a mutex and two clock reads every time a thread
+// passes through a barrier, so the chain is only kept when Interactive Mode or
+// one of the debug options is on (see XDD_BARRIER_TRACKING()). Otherwise "counter"
+// stays at zero and the occupant chain stays empty.
+//
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The barrier itself is a sense-reversing barrier. Each thread that enters
+// increments "arrived". The last one to arrive resets "arrived" and increments
+// "sense", which releases everyone that entered while "sense" had its old value.
+// Waiting threads spin on "sense" for a short while and then sleep in a futex 
+// on it. The "waiting" member counts the sleepers so that the last thread only 
+// makes the wake-up system call when somebody is actually asleep. 
+// Spinning only makes sense when every participant can have a CPU, so barriers
+// with more threads than there are processors go straight to the futex.
+//
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // The occupant structure
 // When the occupant type is either TARGET or Worker THREAD then the occupant_data member
@@ -147,6 +162,8 @@ typedef struct xdd_occupant xdd_occupant_t;
 //
 #define XDD_BARRIER_MAX_NAME_LENGTH		64	// not to exceed this many characters in length
 #define	XDD_BARRIER_FLAG_INITIALIZED	0x00000001ULL	// Indicates that this barrier has been initialized
+#define XDD_BARRIER_SPIN_COUNT			4000	// Number of times to poll "sense" before sleeping
+#define XDD_BARRIER_TRACKING()			(xgp->global_options & (GO_INTERACTIVE|GO_DEBUG_ALL))
 struct xdd_barrier {
 	struct 	xdd_barrier 	*prev_barrier; 	// Previous barrier in the chain 
 	struct 	xdd_barrier 	*next_barrier; 	// Next barrier in chain 
@@ -156,12 +173,12 @@ struct xdd_barrier {
 	char					name[XDD_BARRIER_MAX_NAME_LENGTH]; 	// This is the ASCII name of the barrier
 	int32_t					counter; 		// Couter used to keep track of how many threads have entered the barrier
 	int32_t					threads; 		/// The number of threads that need to enter this barrier before occupants are released
+	uint32_t				arrived;		// Number of threads that have arrived in the current round
+	uint32_t				sense;			// Futex word incremented each time the barrier opens
+	uint32_t				waiting;		// Number of threads sleeping on "sense"
+	int32_t					spin;			// Number of times to poll "sense" before sleeping
 #ifdef WIN32
     HANDLE				sem;  			// The semaphore Object
-#elif (defined HAVE_PTHREAD_BARRIER_T)
-    pthread_barrier_t	pbar;			// The PThreads Barrier 
-#else
-    xint_barrier_t pbar;
 #endif
 	pthread_mutex_t 	mutex;  		// Locking Mutex for access to the semaphore chain
 };
@@ -0,0 +1,209 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the block checksums used by "-verify checksum".
+ * Every block of a write buffer gets the CRC32C (Castagnoli) of its byte
+ * offset and its contents in its last XDD_CHECKSUM_SIZE bytes. Because the
+ * offset is part of the checksum a block that landed in the wrong place is
+ * caught as well as a block whose contents changed.
+ * On x86 processors with SSE4.2 the crc32 instruction is used. Everywhere
+ * else a slicing-by-8 table is used.
+ */
+#include "xint.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define XDD_CRC_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#define XDD_CRC32C_POLY		0x82f63b78	// Reversed Castagnoli polynomial
+
+static pthread_once_t	xdd_crc32c_once = PTHREAD_ONCE_INIT;
+static int				xdd_crc32c_hw;				// Set if the crc32 instruction can be used
+static uint32_t			xdd_crc32c_table[8][256];	// Tables for the slicing-by-8 kernel
+
+/*----------------------------------------------------------------------------*/
+/* xdd_crc32c_init() - Build the tables for the software kernel and see if
+ * the processor has the crc32 instruction. Called once through pthread_once().
+ */
+static void
+xdd_crc32c_init(void) {
+	uint32_t	crc;
+	int			i, j;
+
+
+	for (i = 0; i < 256; i++) {
+		crc = (uint32_t)i;
+		for (j = 0; j < 8; j++)
+			crc = (crc & 1) ? ((crc >> 1) ^ XDD_CRC32C_POLY) : (crc >> 1);
+		xdd_crc32c_table[0][i] = crc;
+	}
+	for (i = 0; i < 256; i++) {
+		crc = xdd_crc32c_table[0][i];
+		for (j = 1; j < 8; j++) {
+			crc = xdd_crc32c_table[0][crc & 0xff] ^ (crc >> 8);
+			xdd_crc32c_table[j][i] = crc;
+		}
+	}
+	xdd_crc32c_hw = 0;
+#if defined(XDD_CRC_X86_KERNELS)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sse4.2"))
+		xdd_crc32c_hw = 1;
+#endif
+} // End of xdd_crc32c_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_crc32c_sw() - Slicing-by-8 CRC32C kernel */
+static uint32_t
+xdd_crc32c_sw(uint32_t crc, const unsigned char *bufp, size_t length) {
+	uint32_t	lo, hi;
+
+
+	while (length && ((uintptr_t)bufp & 7)) {
+		crc = xdd_crc32c_table[0][(crc ^ *bufp++) & 0xff] ^ (crc >> 8);
+		length--;
+	}
+	while (length >= 8) {
+		lo = crc ^ ((uint32_t)bufp[0] | ((uint32_t)bufp[1] << 8) | ((uint32_t)bufp[2] << 16) | ((uint32_t)bufp[3] << 24));
+		hi = (uint32_t)bufp[4] | ((uint32_t)bufp[5] << 8) | ((uint32_t)bufp[6] << 16) | ((uint32_t)bufp[7] << 24);
+		crc = xdd_crc32c_table[7][lo & 0xff] ^
+			xdd_crc32c_table[6][(lo >> 8) & 0xff] ^
+			xdd_crc32c_table[5][(lo >> 16) & 0xff] ^
+			xdd_crc32c_table[4][lo >> 24] ^
+			xdd_crc32c_table[3][hi & 0xff] ^
+			xdd_crc32c_table[2][(hi >> 8) & 0xff] ^
+			xdd_crc32c_table[1][(hi >> 16) & 0xff] ^
+			xdd_crc32c_table[0][hi >> 24];
+		bufp += 8;
+		length -= 8;
+	}
+	while (length--)
+		crc = xdd_crc32c_table[0][(crc ^ *bufp++) & 0xff] ^ (crc >> 8);
+	return(crc);
+} // End of xdd_crc32c_sw()
+
+#if defined(XDD_CRC_X86_KERNELS)
+/*----------------------------------------------------------------------------*/
+/* xdd_crc32c_sse42() - CRC32C kernel that uses the SSE4.2 crc32 instruction */
+__attribute__((target("sse4.2")))
+static uint32_t
+xdd_crc32c_sse42(uint32_t crc, const unsigned char *bufp, size_t length) {
+	while (length && ((uintptr_t)bufp & 7)) {
+		crc = _mm_crc32_u8(crc, *bufp++);
+		length--;
+	}
+#if defined(__x86_64__)
+	{
+		uint64_t	crc64;
+		uint64_t	word;
+
+		crc64 = crc;
+		while (length >= 8) {
+			memcpy(&word, bufp, sizeof(word));
+			crc64 = _mm_crc32_u64(crc64, word);
+			bufp += 8;
+			length -= 8;
+		}
+		crc = (uint32_t)crc64;
+	}
+#endif
+	while (length >= 4) {
+		uint32_t	word;
+
+		memcpy(&word, bufp, sizeof(word));
+		crc = _mm_crc32_u32(crc, word);
+		bufp += 4;
+		length -= 4;
+	}
+	while (length--)
+		crc = _mm_crc32_u8(crc, *bufp++);
+	return(crc);
+} // End of xdd_crc32c_sse42()
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* xdd_crc32c() - Continue the CRC32C "crc" over "length" bytes of the buffer.
+ * Start with 0xffffffff and invert the result to get the standard CRC32C.
+ */
+uint32_t
+xdd_crc32c(uint32_t crc, const unsigned char *bufp, size_t length) {
+	pthread_once(&xdd_crc32c_once, xdd_crc32c_init);
+#if defined(XDD_CRC_X86_KERNELS)
+	if (xdd_crc32c_hw)
+		return(xdd_crc32c_sse42(crc, bufp, length));
+#endif
+	return(xdd_crc32c_sw(crc, bufp, length));
+} // End of xdd_crc32c()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_block() - Return the checksum of one block that belongs at
+ * "byte_offset". The checksum covers the offset (as 8 little-endian bytes)
+ * and the first block_size - XDD_CHECKSUM_SIZE bytes of the block.
+ */
+uint32_t
+xdd_checksum_block(const unsigned char *blockp, int32_t block_size, int64_t byte_offset) {
+	unsigned char	offset[sizeof(uint64_t)];
+	uint32_t		crc;
+	size_t			i;
+
+
+	for (i = 0; i < sizeof(offset); i++)
+		offset[i] = (unsigned char)((uint64_t)byte_offset >> (8 * i));
+	crc = xdd_crc32c(0xffffffff, offset, sizeof(offset));
+	crc = xdd_crc32c(crc, blockp, (size_t)block_size - XDD_CHECKSUM_SIZE);
+	return(~crc);
+} // End of xdd_checksum_block()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_get() - Return the checksum stored at the end of a block */
+uint32_t
+xdd_checksum_get(const unsigned char *blockp, int32_t block_size) {
+	const unsigned char	*cp;
+
+
+	cp = blockp + block_size - XDD_CHECKSUM_SIZE;
+	return((uint32_t)cp[0] | ((uint32_t)cp[1] << 8) | ((uint32_t)cp[2] << 16) | ((uint32_t)cp[3] << 24));
+} // End of xdd_checksum_get()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_stamp() - Put the checksum of each whole block of the buffer
+ * in the last XDD_CHECKSUM_SIZE bytes of the block. The buffer belongs at
+ * "byte_offset". A partial block at the end of the buffer is left alone.
+ */
+void
+xdd_checksum_stamp(unsigned char *bufp, size_t length, int64_t byte_offset, int32_t block_size) {
+	unsigned char	*cp;
+	uint32_t		crc;
+	size_t			done;
+
+
+	for (done = 0; done + block_size <= length; done += block_size) {
+		crc = xdd_checksum_block(bufp + done, block_size, byte_offset + (int64_t)done);
+		cp = bufp + done + block_size - XDD_CHECKSUM_SIZE;
+		cp[0] = (unsigned char)crc;
+		cp[1] = (unsigned char)(crc >> 8);
+		cp[2] = (unsigned char)(crc >> 16);
+		cp[3] = (unsigned char)(crc >> 24);
+	}
+} // End of xdd_checksum_stamp()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
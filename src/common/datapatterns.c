@@ -33,50 +33,21 @@ int xdd_data_pattern_init(xint_data_pattern_t* xdp)
 void
 xdd_datapattern_buffer_init(worker_data_t *wdp) {
 	target_data_t	*tdp;
-    int32_t i;
     int32_t pattern_length; // Length of the pattern
-    size_t remaining_length; // Length of the space in the pattern buffer
-    unsigned char    *ucp;          // Pointer to an unsigned char type, duhhhh
-    uint32_t *lp;			// pointer to a pattern
     xint_data_pattern_t	*dpp;
 
 
 	tdp = wdp->wd_tdp;
     dpp = tdp->td_dpp;
-    if (dpp->data_pattern_options & DP_RANDOM_PATTERN) { // A nice random pattern
-		lp = (uint32_t *)wdp->wd_task.task_datap;
-		xgp->random_initialized = 0;
-		xgp->random_init_seed = 72058; // Backward compatibility with older xdd versions
-		/* Set each four-byte field in the I/O buffer to a random integer */
-		for(i = 0; i < (int32_t)(tdp->td_xfer_size / sizeof(int32_t)); i++ ) {
-	    	*lp=xdd_random_int();
-	    	lp++;
-		}
-    } else if (dpp->data_pattern_options & DP_RANDOM_BY_TARGET_PATTERN) { // A nice random pattern, unique by target number
-		lp = (uint32_t *)wdp->wd_task.task_datap;
-		xgp->random_initialized = 0;
-		xgp->random_init_seed = (tdp->td_target_number+1); 
-		/* Set each four-byte field in the I/O buffer to a random integer */
-		for(i = 0; i < (int32_t)(tdp->td_xfer_size / sizeof(int32_t)); i++ ) {
-	    	*lp=xdd_random_int();
-	    	lp++;
-		}
+    if (dpp->data_pattern_options & (DP_RANDOM_PATTERN | DP_RANDOM_BY_TARGET_PATTERN)) { // A nice random pattern
+		/* Each block of the I/O buffer gets random data made from its own key */
+		xdd_datapattern_generate(tdp, wdp->wd_task.task_datap, tdp->td_xfer_size, 0, 0);
     } else if ((dpp->data_pattern_options & DP_ASCII_PATTERN) ||
 	     (dpp->data_pattern_options & DP_HEX_PATTERN)) { // put the pattern that is in the pattern buffer into the io buffer
 		// Clear out the buffer before putting in the string so there are no strange characters in it.
 		memset(wdp->wd_task.task_datap,'\0',tdp->td_xfer_size);
 		if (dpp->data_pattern_options & DP_REPLICATE_PATTERN) { // Replicate the pattern throughout the buffer
-	    	ucp = (unsigned char *)wdp->wd_task.task_datap;
-	    	remaining_length = tdp->td_xfer_size;
-	    	while (remaining_length) { 
-				if (dpp->data_pattern_length < remaining_length) 
-		    		pattern_length = dpp->data_pattern_length;
-				else pattern_length = remaining_length;
-		
-				memcpy(ucp,dpp->data_pattern,pattern_length);
-				remaining_length -= pattern_length;
-				ucp += pattern_length;
-	    	}
+	    	xdd_dp_replicate_fill(wdp->wd_task.task_datap, tdp->td_xfer_size, dpp->data_pattern, dpp->data_pattern_length);
 		} else { // Just put the pattern at the beginning of the buffer once 
 	    	if (dpp->data_pattern_length < (size_t)tdp->td_xfer_size) 
 				pattern_length = dpp->data_pattern_length;
@@ -87,83 +58,186 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(lfpat);
 		fprintf(stderr,"LFPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,lfpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_dp_replicate_fill(wdp->wd_task.task_datap, tdp->td_xfer_size, lfpat, dpp->data_pattern_length);
     } else if (dpp->data_pattern_options & DP_LTPAT_PATTERN) {
 		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(ltpat);
 		fprintf(stderr,"LTPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,ltpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_dp_replicate_fill(wdp->wd_task.task_datap, tdp->td_xfer_size, ltpat, dpp->data_pattern_length);
     } else if (dpp->data_pattern_options & DP_CJTPAT_PATTERN) {
 		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(cjtpat);
 		fprintf(stderr,"CJTPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,cjtpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_dp_replicate_fill(wdp->wd_task.task_datap, tdp->td_xfer_size, cjtpat, dpp->data_pattern_length);
     } else if (dpp->data_pattern_options & DP_CRPAT_PATTERN) {
 		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(crpat);
 		fprintf(stderr,"CRPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,crpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_dp_replicate_fill(wdp->wd_task.task_datap, tdp->td_xfer_size, crpat, dpp->data_pattern_length);
     } else if (dpp->data_pattern_options & DP_CSPAT_PATTERN) {
 		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(cspat);
 		fprintf(stderr,"CSPAT length is %d\n", (int)dpp->data_pattern_length);
+		xdd_dp_replicate_fill(wdp->wd_task.task_datap, tdp->td_xfer_size, cspat, dpp->data_pattern_length);
+    } else if (dpp->data_pattern_options & DP_REDUCIBLE_PATTERN) { // Filled in by xdd_datapattern_fill() on every write
 		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,cspat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
     } else { // Otherwise set the entire buffer to the character in "dpp->data_pattern"
 		memset(wdp->wd_task.task_datap,*(dpp->data_pattern),tdp->td_xfer_size);
    	}
 		
     return;
 } // end of xdd_datapattern_buffer_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_random_block() - Fill one block with random data made from the key.
+ * The whole 8-byte words come from the vector kernel and any bytes left over
+ * at the end come from the next value of the key's stream.
+ */
+static void
+xdd_dp_random_block(unsigned char *blockp, int32_t length, uint64_t key) {
+	uint64_t	value;
+	int32_t		words;
+
+
+	words = length / sizeof(uint64_t);
+	if (words > 0)
+		xdd_dp_random_fill((uint64_t *)blockp, words, key);
+	if (length > words * (int32_t)sizeof(uint64_t)) {
+		value = xint_rng_at(key, words);
+		memcpy(blockp + words * sizeof(uint64_t), &value, length - words * sizeof(uint64_t));
+	}
+} // End of xdd_dp_random_block()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_reducible_block() - Make one block of the reducible pattern.
+ * The first "random_length" bytes are random data made from the key and
+ * the rest of the block is 0's, so a compressor gets roughly
+ * length/random_length out of it and two different keys never give the
+ * same block.
+ */
+static void
+xdd_dp_reducible_block(unsigned char *blockp, int32_t length, int32_t random_length, uint64_t key) {
+	int32_t	random_bytes;
+
+
+	random_bytes = (random_length < length) ? random_length : length;
+	random_bytes &= ~7;
+	if (random_bytes > 0)
+		xdd_dp_random_fill((uint64_t *)blockp, random_bytes / sizeof(uint64_t), key);
+	memset(blockp + random_bytes, 0, length - random_bytes);
+} // End of xdd_dp_reducible_block()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_datapattern_library_init() - Get a target ready for the reducible
+ * data pattern. This works out how much of each block is random data and
+ * what fraction of the blocks are unique, and builds the library of blocks
+ * that the rest of the blocks are copies of.
+ * The library blocks count as unique blocks too, so with a dedupe ratio of D
+ * and N blocks to write in the whole run there are N/D different blocks when
+ * N/D - (library size) of the blocks are unique and the rest are copies of
+ * library blocks. The library is kept to at most half of the N/D.
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_datapattern_library_init(target_data_t *tdp) {
+	xint_data_pattern_t	*dpp;
+	int32_t				block_size;
+	int32_t				k;
+	uint64_t			key;
+	double				blocks;		// Number of blocks written in the whole run
+	double				unique;		// Fraction of the blocks written that are unique
+
+
+	dpp = tdp->td_dpp;
+	if ((dpp == NULL) || !(dpp->data_pattern_options & DP_REDUCIBLE_PATTERN))
+		return(0);
+	block_size = tdp->td_block_size;
+	dpp->data_pattern_random_length = ((int32_t)(block_size / dpp->data_pattern_compress_ratio)) & ~7;
+	if ((dpp->data_pattern_random_length < (int32_t)sizeof(uint64_t)) && (block_size >= (int32_t)sizeof(uint64_t)))
+		dpp->data_pattern_random_length = sizeof(uint64_t);
+	if (dpp->data_pattern_dedupe_ratio <= 1.0) {
+		dpp->data_pattern_unique_limit = UINT64_MAX;
+		dpp->data_pattern_library_blocks = 0;
+		return(0);
+	}
+	blocks = ((double)tdp->td_target_bytes_to_xfer_per_pass / block_size) * tdp->td_planp->passes;
+	dpp->data_pattern_library_blocks = XDD_DP_LIBRARY_BLOCKS;
+	if ((int64_t)dpp->data_pattern_library_blocks * block_size > XDD_DP_LIBRARY_BYTES) 
+		dpp->data_pattern_library_blocks = XDD_DP_LIBRARY_BYTES / block_size;
+	if (dpp->data_pattern_library_blocks > (blocks / dpp->data_pattern_dedupe_ratio) / 2)
+		dpp->data_pattern_library_blocks = (int32_t)((blocks / dpp->data_pattern_dedupe_ratio) / 2);
+	if (dpp->data_pattern_library_blocks < 1)
+		dpp->data_pattern_library_blocks = 1;
+	unique = (1.0 / dpp->data_pattern_dedupe_ratio);
+	if (blocks > 0)
+		unique -= dpp->data_pattern_library_blocks / blocks;
+	if (unique < 0.0)
+		unique = 0.0;
+	dpp->data_pattern_unique_limit = (uint64_t)(ldexp(1.0, 64) * unique);
+	dpp->data_pattern_library = malloc((size_t)dpp->data_pattern_library_blocks * block_size);
+	if (dpp->data_pattern_library == NULL) {
+		fprintf(xgp->errout,"%s: xdd_datapattern_library_init: Target %d: ERROR: Cannot allocate %lld bytes for the data pattern block library\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(long long int)dpp->data_pattern_library_blocks * block_size);
+		return(-1);
+	}
+	key = xint_rng_key((uint64_t)tdp->td_seekhdr.seek_seed, tdp->td_target_number, XINT_RNG_LIBRARY, 0);
+	for (k = 0; k < dpp->data_pattern_library_blocks; k++)
+		xdd_dp_reducible_block(dpp->data_pattern_library + ((size_t)k * block_size), block_size, dpp->data_pattern_random_length, xint_rng_at(key, k));
+	return(0);
+} // End of xdd_datapattern_library_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_datapattern_generate() - Fill a buffer with the random or reducible 
+ * data pattern of operation "op_number" of pass "pass_number".
+ * Every block of the buffer is made from its own key, which comes from the
+ * seed, the target number, and where the block is in the buffer - and for
+ * the reducible pattern also the pass number and the op number. Nothing is
+ * carried over from one block or one operation to the next, so any thread
+ * can make the contents of any operation at any time, which is how the
+ * verify code gets the contents it expects to read back.
+ * For the reducible pattern the key also decides whether the block is 
+ * unique, in which case it is made from the key, or a copy of one of the
+ * library blocks.
+ * Return values: 0 is good, -1 if the data pattern is not one of these.
+ */
+int32_t
+xdd_datapattern_generate(target_data_t *tdp, unsigned char *bufp, size_t length, int32_t pass_number, int64_t op_number) {
+	xint_data_pattern_t	*dpp;
+	unsigned char		*blockp;
+	int32_t				block_size;
+	int32_t				block_length;	// Length of this block - the last one can be short
+	size_t				done;			// Number of bytes of the buffer filled so far
+	uint64_t			key;			// Key of the stream of block keys
+	uint64_t			block_key;		// Key of this block
+
+
+	dpp = tdp->td_dpp;
+	block_size = tdp->td_block_size;
+	if (dpp->data_pattern_options & DP_RANDOM_PATTERN) // Same data for every target
+		key = xint_rng_key(XDD_DP_RANDOM_SEED, 0, XINT_RNG_DATA, 0);
+	else if (dpp->data_pattern_options & DP_RANDOM_BY_TARGET_PATTERN) 
+		key = xint_rng_key(XDD_DP_RANDOM_SEED, tdp->td_target_number, XINT_RNG_DATA, 0);
+	else if (dpp->data_pattern_options & DP_REDUCIBLE_PATTERN) // The pass number goes in with the use so each pass writes new blocks
+		key = xint_rng_key((uint64_t)tdp->td_seekhdr.seek_seed, tdp->td_target_number, XINT_RNG_REDUCIBLE | ((uint64_t)pass_number << 32), op_number);
+	else return(-1);
+
+	for (done = 0; done < length; done += block_length) {
+		blockp = bufp + done;
+		block_length = block_size;
+		if (done + block_length > length)
+			block_length = length - done;
+		block_key = xint_rng_at(key, done / block_size);
+		if (!(dpp->data_pattern_options & DP_REDUCIBLE_PATTERN))
+			xdd_dp_random_block(blockp, block_length, block_key);
+		else if ((block_key < dpp->data_pattern_unique_limit) || (dpp->data_pattern_library == NULL))
+			xdd_dp_reducible_block(blockp, block_length, dpp->data_pattern_random_length, block_key);
+		else memcpy(blockp, dpp->data_pattern_library + ((block_key % dpp->data_pattern_library_blocks) * block_size), block_length);
+	}
+	return(0);
+} // End of xdd_datapattern_generate()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_datapattern_fill() - This subroutine will fill the buffer with a 
  * specific pattern. 
@@ -173,8 +247,7 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 void
 xdd_datapattern_fill(worker_data_t *wdp) {
 	target_data_t	*tdp;
-	size_t  		j;					// random variables 
-	uint64_t 		*posp;             	// Position Pointer 
+	uint64_t 		xorval;            	// All 1's for the inverse pattern
 	nclk_t			start_time;			// Used for calculating elapsed times of ops
 	nclk_t			end_time;			// Used for calculating elapsed times of ops
 
@@ -183,17 +256,26 @@ xdd_datapattern_fill(worker_data_t *wdp) {
 	/* Sequenced Data Pattern */
 	if (tdp->td_dpp->data_pattern_options & DP_SEQUENCED_PATTERN) {
 		nclk_now(&start_time);
-		posp = (uint64_t *)wdp->wd_task.task_datap;
-		for (j=0; j<(tdp->td_xfer_size/sizeof(wdp->wd_task.task_byte_offset)); j++) {
-			*posp = wdp->wd_task.task_byte_offset + (j * sizeof(wdp->wd_task.task_byte_offset));
-			*posp |= tdp->td_dpp->data_pattern_prefix_binary;
-			if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
-				*posp ^= 0xffffffffffffffffLL; // 1's compliment of the pattern
-			posp++;
-		}
+		if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
+			xorval = 0xffffffffffffffffLL; // 1's compliment of the pattern
+		else xorval = 0;
+		xdd_dp_sequence_fill((uint64_t *)wdp->wd_task.task_datap, 
+			tdp->td_xfer_size/sizeof(wdp->wd_task.task_byte_offset),
+			wdp->wd_task.task_byte_offset,
+			tdp->td_dpp->data_pattern_prefix_binary,
+			xorval);
 		nclk_now(&end_time);
 // FIXME ????		wdp->wd_accumulated_pattern_fill_time = (end_time - start_time);
 	}
+	/* Reducible Data Pattern - new blocks on every write */
+	if (tdp->td_dpp->data_pattern_options & DP_REDUCIBLE_PATTERN)
+		xdd_datapattern_generate(tdp, wdp->wd_task.task_datap, wdp->wd_task.task_xfer_size, tdp->td_counters.tc_pass_number, wdp->wd_task.task_op_number);
+	/* Block checksums go in last so that they cover the pattern - the E2E Destination writes the stamped data it received */
+	if ((tdp->td_target_options & TO_VERIFY_CHECKSUM) && !(tdp->td_target_options & TO_E2E_DESTINATION))
+		xdd_checksum_stamp(wdp->wd_task.task_datap, 
+			wdp->wd_task.task_xfer_size,
+			wdp->wd_task.task_byte_offset,
+			tdp->td_block_size);
 } // End of xdd_datapattern_fill() 
 
  
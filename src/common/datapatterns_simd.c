@@ -0,0 +1,399 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the low-level kernels that generate and check the
+ * data patterns in the I/O buffers. On x86 processors the 8-byte sequenced
+ * pattern kernels come in SSE2, AVX2, and AVX-512 flavors and the best one
+ * that the processor supports is picked the first time a kernel is called.
+ * The random fill used by the reducible data pattern runs four xorshift128+
+ * generators side by side so that it vectorizes the same way.
+ * The replicated and single-character kernels are built on memcpy()/memcmp()
+ * which the C library already vectorizes.
+ */
+#include "xint.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define XDD_DP_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// The kernel levels - in order of preference
+#define XDD_DP_KERNEL_UNKNOWN	0	// Not picked yet
+#define XDD_DP_KERNEL_SCALAR	1	// Plain C
+#define XDD_DP_KERNEL_SSE2		2	// 128-bit
+#define XDD_DP_KERNEL_AVX2		3	// 256-bit
+#define XDD_DP_KERNEL_AVX512	4	// 512-bit
+
+static int	xdd_dp_kernel_level = XDD_DP_KERNEL_UNKNOWN;
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_kernel_select() - Pick the widest kernel this processor can run.
+ * Every thread that races through here picks the same answer so no lock
+ * is needed.
+ */
+static int
+xdd_dp_kernel_select(void) {
+	int	level;
+
+
+	level = __atomic_load_n(&xdd_dp_kernel_level, __ATOMIC_RELAXED);
+	if (level != XDD_DP_KERNEL_UNKNOWN)
+		return(level);
+	level = XDD_DP_KERNEL_SCALAR;
+#if defined(XDD_DP_X86_KERNELS)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		level = XDD_DP_KERNEL_AVX512;
+	else if (__builtin_cpu_supports("avx2"))
+		level = XDD_DP_KERNEL_AVX2;
+	else if (__builtin_cpu_supports("sse2"))
+		level = XDD_DP_KERNEL_SSE2;
+#endif
+	__atomic_store_n(&xdd_dp_kernel_level, level, __ATOMIC_RELAXED);
+	return(level);
+} // End of xdd_dp_kernel_select()
+
+#if defined(XDD_DP_X86_KERNELS)
+/*----------------------------------------------------------------------------*/
+// Sequenced pattern kernels
+// Word j of the buffer is ((start + 8*j) | orval) ^ xorval
+__attribute__((target("sse2")))
+static size_t
+xdd_dp_sequence_fill_sse2(uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	__m128i	seq, incr, orv, xorv;
+	size_t	j;
+
+
+	seq = _mm_set_epi64x((long long)(start + 8), (long long)start);
+	incr = _mm_set1_epi64x(16);
+	orv = _mm_set1_epi64x((long long)orval);
+	xorv = _mm_set1_epi64x((long long)xorval);
+	for (j = 0; j + 2 <= count; j += 2) {
+		_mm_storeu_si128((__m128i *)(bufp + j), _mm_xor_si128(_mm_or_si128(seq, orv), xorv));
+		seq = _mm_add_epi64(seq, incr);
+	}
+	return(j);
+}
+__attribute__((target("sse2")))
+static size_t
+xdd_dp_sequence_check_sse2(const uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	__m128i	seq, incr, orv, xorv, got, eq;
+	size_t	j;
+
+
+	seq = _mm_set_epi64x((long long)(start + 8), (long long)start);
+	incr = _mm_set1_epi64x(16);
+	orv = _mm_set1_epi64x((long long)orval);
+	xorv = _mm_set1_epi64x((long long)xorval);
+	for (j = 0; j + 2 <= count; j += 2) {
+		got = _mm_loadu_si128((const __m128i *)(bufp + j));
+		eq = _mm_cmpeq_epi32(got, _mm_xor_si128(_mm_or_si128(seq, orv), xorv));
+		if (_mm_movemask_epi8(eq) != 0xFFFF)
+			return(j);
+		seq = _mm_add_epi64(seq, incr);
+	}
+	return(j);
+}
+__attribute__((target("avx2")))
+static size_t
+xdd_dp_sequence_fill_avx2(uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	__m256i	seq, incr, orv, xorv;
+	size_t	j;
+
+
+	seq = _mm256_set_epi64x((long long)(start + 24), (long long)(start + 16), (long long)(start + 8), (long long)start);
+	incr = _mm256_set1_epi64x(32);
+	orv = _mm256_set1_epi64x((long long)orval);
+	xorv = _mm256_set1_epi64x((long long)xorval);
+	for (j = 0; j + 4 <= count; j += 4) {
+		_mm256_storeu_si256((__m256i *)(bufp + j), _mm256_xor_si256(_mm256_or_si256(seq, orv), xorv));
+		seq = _mm256_add_epi64(seq, incr);
+	}
+	return(j);
+}
+__attribute__((target("avx2")))
+static size_t
+xdd_dp_sequence_check_avx2(const uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	__m256i	seq, incr, orv, xorv, got, eq;
+	size_t	j;
+
+
+	seq = _mm256_set_epi64x((long long)(start + 24), (long long)(start + 16), (long long)(start + 8), (long long)start);
+	incr = _mm256_set1_epi64x(32);
+	orv = _mm256_set1_epi64x((long long)orval);
+	xorv = _mm256_set1_epi64x((long long)xorval);
+	for (j = 0; j + 4 <= count; j += 4) {
+		got = _mm256_loadu_si256((const __m256i *)(bufp + j));
+		eq = _mm256_cmpeq_epi64(got, _mm256_xor_si256(_mm256_or_si256(seq, orv), xorv));
+		if (_mm256_movemask_epi8(eq) != -1)
+			return(j);
+		seq = _mm256_add_epi64(seq, incr);
+	}
+	return(j);
+}
+__attribute__((target("avx512f")))
+static size_t
+xdd_dp_sequence_fill_avx512(uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	__m512i	seq, incr, orv, xorv;
+	size_t	j;
+
+
+	seq = _mm512_add_epi64(_mm512_set1_epi64((long long)start), _mm512_set_epi64(56, 48, 40, 32, 24, 16, 8, 0));
+	incr = _mm512_set1_epi64(64);
+	orv = _mm512_set1_epi64((long long)orval);
+	xorv = _mm512_set1_epi64((long long)xorval);
+	for (j = 0; j + 8 <= count; j += 8) {
+		_mm512_storeu_si512((void *)(bufp + j), _mm512_xor_si512(_mm512_or_si512(seq, orv), xorv));
+		seq = _mm512_add_epi64(seq, incr);
+	}
+	return(j);
+}
+__attribute__((target("avx512f")))
+static size_t
+xdd_dp_sequence_check_avx512(const uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	__m512i	seq, incr, orv, xorv, got;
+	size_t	j;
+
+
+	seq = _mm512_add_epi64(_mm512_set1_epi64((long long)start), _mm512_set_epi64(56, 48, 40, 32, 24, 16, 8, 0));
+	incr = _mm512_set1_epi64(64);
+	orv = _mm512_set1_epi64((long long)orval);
+	xorv = _mm512_set1_epi64((long long)xorval);
+	for (j = 0; j + 8 <= count; j += 8) {
+		got = _mm512_loadu_si512((const void *)(bufp + j));
+		if (_mm512_cmpneq_epi64_mask(got, _mm512_xor_si512(_mm512_or_si512(seq, orv), xorv)))
+			return(j);
+		seq = _mm512_add_epi64(seq, incr);
+	}
+	return(j);
+}
+/*----------------------------------------------------------------------------*/
+// Random fill kernels
+// Word j of the buffer is the next output of generator (j % 4)
+// The state is s[0..3] (first halves) and s[4..7] (second halves) of the four generators
+__attribute__((target("sse2")))
+static size_t
+xdd_dp_random_fill_sse2(uint64_t *bufp, size_t count, uint64_t *s) {
+	__m128i	a0, a1, b0, b1, x, y;
+	size_t	j;
+
+
+	a0 = _mm_loadu_si128((const __m128i *)(s + 0));
+	a1 = _mm_loadu_si128((const __m128i *)(s + 2));
+	b0 = _mm_loadu_si128((const __m128i *)(s + 4));
+	b1 = _mm_loadu_si128((const __m128i *)(s + 6));
+	for (j = 0; j + 4 <= count; j += 4) {
+		x = a0; y = b0; a0 = y;
+		x = _mm_xor_si128(x, _mm_slli_epi64(x, 23));
+		b0 = _mm_xor_si128(_mm_xor_si128(x, y), _mm_xor_si128(_mm_srli_epi64(x, 17), _mm_srli_epi64(y, 26)));
+		_mm_storeu_si128((__m128i *)(bufp + j), _mm_add_epi64(b0, y));
+		x = a1; y = b1; a1 = y;
+		x = _mm_xor_si128(x, _mm_slli_epi64(x, 23));
+		b1 = _mm_xor_si128(_mm_xor_si128(x, y), _mm_xor_si128(_mm_srli_epi64(x, 17), _mm_srli_epi64(y, 26)));
+		_mm_storeu_si128((__m128i *)(bufp + j + 2), _mm_add_epi64(b1, y));
+	}
+	_mm_storeu_si128((__m128i *)(s + 0), a0);
+	_mm_storeu_si128((__m128i *)(s + 2), a1);
+	_mm_storeu_si128((__m128i *)(s + 4), b0);
+	_mm_storeu_si128((__m128i *)(s + 6), b1);
+	return(j);
+}
+__attribute__((target("avx2")))
+static size_t
+xdd_dp_random_fill_avx2(uint64_t *bufp, size_t count, uint64_t *s) {
+	__m256i	a, b, x, y;
+	size_t	j;
+
+
+	a = _mm256_loadu_si256((const __m256i *)(s + 0));
+	b = _mm256_loadu_si256((const __m256i *)(s + 4));
+	for (j = 0; j + 4 <= count; j += 4) {
+		x = a; y = b; a = y;
+		x = _mm256_xor_si256(x, _mm256_slli_epi64(x, 23));
+		b = _mm256_xor_si256(_mm256_xor_si256(x, y), _mm256_xor_si256(_mm256_srli_epi64(x, 17), _mm256_srli_epi64(y, 26)));
+		_mm256_storeu_si256((__m256i *)(bufp + j), _mm256_add_epi64(b, y));
+	}
+	_mm256_storeu_si256((__m256i *)(s + 0), a);
+	_mm256_storeu_si256((__m256i *)(s + 4), b);
+	return(j);
+}
+#endif // XDD_DP_X86_KERNELS
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_sequence_fill() - Fill "count" 8-byte words of the buffer with the
+ * sequenced data pattern. Word j is set to ((start + 8*j) | orval) ^ xorval.
+ * Passing an xorval of all 1's gives the inverse pattern.
+ */
+void
+xdd_dp_sequence_fill(uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	size_t	j;
+
+
+	switch (xdd_dp_kernel_select()) {
+#if defined(XDD_DP_X86_KERNELS)
+		case XDD_DP_KERNEL_AVX512:
+			j = xdd_dp_sequence_fill_avx512(bufp, count, start, orval, xorval);
+			break;
+		case XDD_DP_KERNEL_AVX2:
+			j = xdd_dp_sequence_fill_avx2(bufp, count, start, orval, xorval);
+			break;
+		case XDD_DP_KERNEL_SSE2:
+			j = xdd_dp_sequence_fill_sse2(bufp, count, start, orval, xorval);
+			break;
+#endif
+		default:
+			j = 0;
+			break;
+	}
+	// Whatever is left over (or everything for the scalar kernel)
+	for (; j < count; j++)
+		bufp[j] = ((start + (j * sizeof(uint64_t))) | orval) ^ xorval;
+} // End of xdd_dp_sequence_fill()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_sequence_check() - Check "count" 8-byte words of the buffer against
+ * the sequenced data pattern described in xdd_dp_sequence_fill().
+ * Returns the index of the first word that does not match or "count" if
+ * all of them match.
+ */
+size_t
+xdd_dp_sequence_check(const uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval) {
+	size_t	j;
+
+
+	switch (xdd_dp_kernel_select()) {
+#if defined(XDD_DP_X86_KERNELS)
+		case XDD_DP_KERNEL_AVX512:
+			j = xdd_dp_sequence_check_avx512(bufp, count, start, orval, xorval);
+			break;
+		case XDD_DP_KERNEL_AVX2:
+			j = xdd_dp_sequence_check_avx2(bufp, count, start, orval, xorval);
+			break;
+		case XDD_DP_KERNEL_SSE2:
+			j = xdd_dp_sequence_check_sse2(bufp, count, start, orval, xorval);
+			break;
+#endif
+		default:
+			j = 0;
+			break;
+	}
+	// Pin down the exact word in the vector that missed or check the left overs
+	for (; j < count; j++)
+		if (bufp[j] != (((start + (j * sizeof(uint64_t))) | orval) ^ xorval))
+			return(j);
+	return(count);
+} // End of xdd_dp_sequence_check()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_random_fill() - Fill "count" 8-byte words of the buffer with
+ * random data. The same seed always gives the same data no matter which
+ * kernel is used. The four generators are seeded from the seed with
+ * splitmix64 so that nearby seeds give unrelated data.
+ */
+void
+xdd_dp_random_fill(uint64_t *bufp, size_t count, uint64_t seed) {
+	uint64_t	s[8];		// State of the four generators
+	uint64_t	x, y;
+	size_t		j;
+	int			l;
+
+
+	for (l = 0; l < 8; l++) {
+		seed += 0x9e3779b97f4a7c15ULL;
+		x = seed;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		s[l] = (x ^ (x >> 31)) | 1;
+	}
+	switch (xdd_dp_kernel_select()) {
+#if defined(XDD_DP_X86_KERNELS)
+		case XDD_DP_KERNEL_AVX512:
+		case XDD_DP_KERNEL_AVX2:
+			j = xdd_dp_random_fill_avx2(bufp, count, s);
+			break;
+		case XDD_DP_KERNEL_SSE2:
+			j = xdd_dp_random_fill_sse2(bufp, count, s);
+			break;
+#endif
+		default:
+			j = 0;
+			break;
+	}
+	// Whatever is left over (or everything for the scalar kernel)
+	for (l = 0; j < count; j++, l = (l + 1) & 3) {
+		x = s[l];
+		y = s[l + 4];
+		s[l] = y;
+		x ^= x << 23;
+		s[l + 4] = x ^ y ^ (x >> 17) ^ (y >> 26);
+		bufp[j] = s[l + 4] + y;
+	}
+} // End of xdd_dp_random_fill()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_replicate_fill() - Fill "length" bytes of the buffer with copies
+ * of the "pattern_length" byte pattern. The pattern is copied in once and
+ * then the filled part of the buffer is doubled until the buffer is full
+ * so that there are only log2(length/pattern_length) calls to memcpy().
+ * The last copy of the pattern is truncated if it does not fit.
+ */
+void
+xdd_dp_replicate_fill(unsigned char *bufp, size_t length, const unsigned char *patternp, size_t pattern_length) {
+	size_t	filled;		// Number of bytes filled so far
+	size_t	chunk;		// Number of bytes to copy this time
+
+
+	if ((length == 0) || (pattern_length == 0))
+		return;
+	filled = (pattern_length < length) ? pattern_length : length;
+	memcpy(bufp, patternp, filled);
+	while (filled < length) {
+		chunk = (filled < (length - filled)) ? filled : (length - filled);
+		memcpy(bufp + filled, bufp, chunk);
+		filled += chunk;
+	}
+} // End of xdd_dp_replicate_fill()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_dp_replicate_check() - Check that "length" bytes of the buffer are
+ * copies of the "pattern_length" byte pattern.
+ * The first copy is compared against the pattern. After that every byte has
+ * to be equal to the byte "pattern_length" bytes before it, so the rest of the
+ * buffer is compared against itself shifted by one pattern length.
+ * Returns 0 if the buffer matches and 1 if there is a mismatch somewhere.
+ * The caller is expected to rescan the buffer to report the mismatches.
+ */
+int32_t
+xdd_dp_replicate_check(const unsigned char *bufp, size_t length, const unsigned char *patternp, size_t pattern_length) {
+	size_t	first;		// Length of the first copy of the pattern
+
+
+	if ((length == 0) || (pattern_length == 0))
+		return(0);
+	first = (pattern_length < length) ? pattern_length : length;
+	if (memcmp(bufp, patternp, first))
+		return(1);
+	if ((length > first) && memcmp(bufp + first, bufp, length - first))
+		return(1);
+	return(0);
+} // End of xdd_dp_replicate_check()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
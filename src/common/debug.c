@@ -75,6 +75,7 @@ xdd_show_plan_data(xdd_plan_t* planp) {
     fprintf(stderr,"xdd_show_plan_data: estimated_end_time        %lld - The time at which this run (all passes) should end \n",(long long int)planp->estimated_end_time);
     fprintf(stderr,"xdd_show_plan_data: number_of_processors      %d - Number of processors \n",planp->number_of_processors);
     fprintf(stderr,"xdd_show_plan_data: clock_tick                %d - Number of clock ticks per second \n",planp->clock_tick);
+    fprintf(stderr,"xdd_show_plan_data: worker_pool_threads       %d - Number of threads in the shared Worker Thread pool \n",planp->worker_pool_threads);
     fprintf(stderr,"xdd_show_plan_data: barrier_count             %d Number of barriers on the chain \n",planp->barrier_count);                         
     fprintf(stderr,"xdd_show_plan_data: format_string             '%s'\n",(planp->format_string != NULL)?planp->format_string:"NA");
     fprintf(stderr,"xdd_show_plan_data: results_header_displayed   %d\n",planp->results_header_displayed);
@@ -161,6 +162,7 @@ xdd_show_target_data(target_data_t *tdp) {
     fprintf(stderr,"xdd_show_target_data: char                    *td_target_full_pathname=%s\n",tdp->td_target_full_pathname);    // Fully qualified path name to the target device/file
     fprintf(stderr,"xdd_show_target_data: char                    td_target_extension[32]=%s\n",tdp->td_target_extension);     // The target extension number 
     fprintf(stderr,"xdd_show_target_data: int32_t                 td_processor=%d\n",tdp->td_processor);                  // Processor/target assignments 
+    fprintf(stderr,"xdd_show_target_data: int32_t                 td_numa_node=%d\n",tdp->td_numa_node);                  // NUMA node for WorkerThreads and their buffers
     fprintf(stderr,"xdd_show_target_data: double                  td_start_delay=%f\n",tdp->td_start_delay);             // number of seconds to delay the start  of this operation 
     fprintf(stderr,"xdd_show_target_data: nclk_t                  td_start_delay_psec=%lld\n",(unsigned long long int)tdp->td_start_delay_psec);        // number of nanoseconds to delay the start  of this operation 
     fprintf(stderr,"xdd_show_target_data: char                    td_random_init_state[256]\n");     // Random number generator state initalizer array 
@@ -168,6 +170,8 @@ xdd_show_target_data(target_data_t *tdp) {
     fprintf(stderr,"xdd_show_target_data: int32_t                 td_queue_depth=%d\n",tdp->td_queue_depth);             // Command queue depth for each target 
     fprintf(stderr,"xdd_show_target_data: int64_t                 td_preallocate=%lld\n",(long long int)tdp->td_preallocate);             // File preallocation value 
     fprintf(stderr,"xdd_show_target_data: int32_t                 td_mem_align=%d\n",tdp->td_mem_align);               // Memory read/write buffer alignment value in bytes 
+    fprintf(stderr,"xdd_show_target_data: int64_t                 td_hugepage_size=%lld\n",(long long int)tdp->td_hugepage_size);               // Size of the huge pages for the I/O buffer pool or 0 for none
+    fprintf(stderr,"xdd_show_target_data: unsigned char           *td_buffer_poolp=%p\n",tdp->td_buffer_poolp);               // Huge page pool holding the I/O buffers of all WorkerThreads
     fprintf(stderr,"xdd_show_target_data: struct heartbeat        td_hb=%p\n",tdp->td_planp);                    // Heartbeat data
     fprintf(stderr,"xdd_show_target_data: uint64_t                td_target_bytes_to_xfer_per_pass=%lld\n",(long long int)tdp->td_target_bytes_to_xfer_per_pass);     // Number of bytes to xfer per pass for the entire target (all qthreads)
     fprintf(stderr,"xdd_show_target_data: int64_t                 td_last_committed_op=%lld\n",(long long int)tdp->td_last_committed_op);        // Operation number of last r/w operation relative to zero
@@ -182,6 +186,11 @@ xdd_show_target_data(target_data_t *tdp) {
     fprintf(stderr,"xdd_show_target_data: pthread_mutex_t         td_counters_mutex\n");             // Mutex for locking when updating td_counters
     fprintf(stderr,"xdd_show_target_data: struct xint_target_counters td_counters\n");        // Pointer to the target counters
     fprintf(stderr,"xdd_show_target_data: struct xint_throttle    *td_throtp=%p\n",tdp->td_throtp);            // Pointer to the throttle sturcture
+    fprintf(stderr,"xdd_show_target_data: struct xint_arrival     *td_arrivalp=%p\n",tdp->td_arrivalp);        // Pointer to the open-loop arrival structure
+    fprintf(stderr,"xdd_show_target_data: struct xint_reqsize_mix *td_rsmp=%p\n",tdp->td_rsmp);        // Pointer to the request size mix structure
+    fprintf(stderr,"xdd_show_target_data: struct xint_replay      *td_replayp=%p\n",tdp->td_replayp);        // Pointer to the trace replay structure
+    fprintf(stderr,"xdd_show_target_data: char                    *td_stream_name=%s\n",(tdp->td_stream_name)?tdp->td_stream_name:"NA");        // Name of the workload stream
+    fprintf(stderr,"xdd_show_target_data: int32_t                 td_stream_type=0x%x\n",tdp->td_stream_type);        // Type of workload stream
     fprintf(stderr,"xdd_show_target_data: struct xint_e2e         *td_e2ep=%p\n",tdp->td_e2ep);            // Pointer to the e2e struct when needed
     fprintf(stderr,"xdd_show_target_data: struct xint_extended_stats *td_esp=%p\n",tdp->td_esp);            // Extended Stats Structure Pointer
     fprintf(stderr,"xdd_show_target_data: struct xint_triggers     *td_trigp=%p\n",tdp->td_trigp);            // Triggers Structure Pointer
@@ -209,6 +218,8 @@ xdd_show_worker_data(worker_data_t *wdp) {
     fprintf(stderr,"xdd_show_worker_data: int32_t                 wd_worker_number=%d\n",wdp->wd_worker_number);    // My worker number within this target relative to 0
     fprintf(stderr,"xdd_show_worker_data: int32_t                 wd_thread_id=%d\n",wdp->wd_thread_id);          // My system thread ID (like a process ID) 
     fprintf(stderr,"xdd_show_worker_data: int32_t                 wd_pid=%d\n",wdp->wd_pid);               // My process ID 
+    fprintf(stderr,"xdd_show_worker_data: int32_t                 wd_numa_node=%d\n",wdp->wd_numa_node);         // NUMA node for this Worker_Thread and its I/O buffer
+    fprintf(stderr,"xdd_show_worker_data: int32_t                 wd_pool_home=%d\n",wdp->wd_pool_home);         // Worker Thread pool queue for this Worker_Thread
     fprintf(stderr,"xdd_show_worker_data: unsigned char           *wd_bufp=%p\n",wdp->wd_bufp);            // Pointer to the generic I/O buffer
     fprintf(stderr,"xdd_show_worker_data: int                     wd_buf_size=%d\n",wdp->wd_buf_size);        // Size in bytes of the generic I/O buffer
     fprintf(stderr,"xdd_show_worker_data: int64_t                 wd_ts_entry=%lld\n",(long long int)wdp->wd_next_wdp);        // The TimeStamp entry to use when time-stamping an operation
@@ -233,7 +244,8 @@ xdd_show_worker_data(worker_data_t *wdp) {
     fprintf(stderr,"xdd_show_worker_data: int32_t                 wd_worker_thread_target_sync=0x%08x:%s\n",wdp->wd_worker_thread_target_sync,option_string);        // Flags used to synchronize a Worker_Thread with its Target
     fprintf(stderr,"xdd_show_worker_data: pthread_cond_t          wd_this_worker_thread_is_available_condition\n");
     fprintf(stderr,"xdd_show_worker_data: xdd_barrier_t           *wd_current_barrier:%p: '%s'\n",wdp->wd_current_barrier, wdp->wd_current_barrier?wdp->wd_current_barrier->name:"NA");    // The barrier where the Worker_Thread waits for targetpass() to release it with a task to perform
-    fprintf(stderr,"xdd_show_worker_data: xdd_barrier_t           wd_thread_targetpass_wait_for_task_barrier:\n");    // The barrier where the Worker_Thread waits for targetpass() to release it with a task to perform
+    fprintf(stderr,"xdd_show_worker_data: uint32_t                wd_task_doorbell=%u\n",wdp->wd_task_doorbell);    // Incremented by the Target Thread each time it hands a task to this Worker_Thread
+    fprintf(stderr,"xdd_show_worker_data: uint32_t                wd_task_doorbell_seen=%u\n",wdp->wd_task_doorbell_seen);    // The last doorbell value this Worker_Thread has acted on
     fprintf(stderr,"xdd_show_worker_data: xdd_occupant_t          wd_occupant:\n");        // Used by the barriers to keep track of what is in a barrier at any given time
     xdd_show_occupant(&wdp->wd_occupant);
     fprintf(stderr,"xdd_show_worker_data: char                    wd_occupant_name[XDD_BARRIER_MAX_NAME_LENGTH]='%s'\n",wdp->wd_occupant_name);    // For a Target thread this is "TARGET####", for a Worker_Thread it is "TARGET####WORKER####"
@@ -259,6 +271,8 @@ xdd_show_worker_data(worker_data_t *wdp) {
 		strcat(option_string,"WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS ");
 	if(wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO)
 		strcat(option_string,"WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO ");
+	if(wdp->wd_current_state & WORKER_CURRENT_STATE_WAITING_FOR_TASK)
+		strcat(option_string,"WORKER_CURRENT_STATE_WAITING_FOR_TASK ");
     fprintf(stderr,"xdd_show_worker_data: uint32_t                 wd_current_state=0x%08x: '%s'\n",wdp->wd_current_state,option_string);            // State of this thread at any given time (see Current State definitions below)
 
     fprintf(stderr,"xdd_show_worker_data:********* End of Worker Data **********\n");
@@ -300,7 +314,7 @@ xdd_show_task(xint_task_t *taskp) {
     fprintf(stderr,"\txdd_show_task: size_t        task_xfer_size=%d\n",(int)taskp->task_xfer_size);                // Number of bytes to transfer
     fprintf(stderr,"\txdd_show_task: off_t         task_byte_offset=%lld\n",(long long int)taskp->task_byte_offset);            // Offset into the file where this transfer starts
     fprintf(stderr,"\txdd_show_task: uint64_t      task_e2e_sequence_number=%lld\n",(long long int)taskp->task_e2e_sequence_number);    // Sequence number of this task when part of an End-to-End operation
-    fprintf(stderr,"\txdd_show_task: nclk_t        task_time_to_issue=%lld\n",(unsigned long long int)taskp->task_time_to_issue);            // Time to issue the I/O operation or 0 if not used
+    fprintf(stderr,"\txdd_show_task: nclk_t        task_time_to_issue=%lld\n",(unsigned long long int)taskp->task_time_to_issue);            // Time the I/O operation was due with open-loop arrivals or 0 if not used
     fprintf(stderr,"\txdd_show_task: ssize_t       task_io_status=%d\n",(int)taskp->task_io_status);                // Returned status of this I/O associated with this task
     fprintf(stderr,"\txdd_show_task: int32_t       task_errno=%d\n",taskp->task_errno);                    // Returned errno of this I/O associated with this task
     fprintf(stderr,"xdd_show_task:********* End of TASK Data at 0x%p **********\n",taskp);
@@ -450,12 +464,11 @@ xdd_show_e2e_header(xdd_e2e_header_t *e2ehp) {
  */
 void
 xdd_show_tot_entry(tot_t *totp, int i) {
-	tot_wait_t	*totwp;
-
 
   	fprintf(stderr,"\txdd_show_tot_entry:---------- TOT %p entry %d ----------\n",totp,i);
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> pthread_mutex_t tot_mutex\n",i);		// Mutex that is locked when updating items in this entry
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> pthread_cond_t tot_condition\n",i);
+   	fprintf(stderr,"\txdd_show_tot_entry: <%d> pthread_mutex_t tot_mutex\n",i);		// Mutex that is locked by tot_update() when updating items in this entry
+   	fprintf(stderr,"\txdd_show_tot_entry: <%d> uint32_t tot_sequence=%u\n",i,totp->tot_entry[i].tot_sequence);		// (Op number + 1) of the last op released through this entry
+   	fprintf(stderr,"\txdd_show_tot_entry: <%d> uint32_t tot_waiters=%u\n",i,totp->tot_entry[i].tot_waiters);		// Number of Worker Threads sleeping on tot_sequence
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> nclk_t tot_wait_ts=%lld\n",i,(long long int)totp->tot_entry[i].tot_wait_ts);			// Time that another Worker Thread starts to wait on this
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> nclk_t tot_post_ts=%lld\n",i,(long long int)totp->tot_entry[i].tot_post_ts);			// Time that the responsible Worker Thread posts this semaphore
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> nclk_t tot_update_ts=%lld\n",i,(long long int)totp->tot_entry[i].tot_update_ts);		// Time that the responsible Worker Thread updates the byte_location and io_size
@@ -465,23 +478,6 @@ xdd_show_tot_entry(tot_t *totp, int i) {
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t tot_wait_worker_thread_number=%d\n",i,totp->tot_entry[i].tot_wait_worker_thread_number);	// Number of the Worker Thread that is waiting for this TOT entry to be posted
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t tot_post_worker_thread_number=%d\n",i,totp->tot_entry[i].tot_post_worker_thread_number);	// Number of the Worker Thread that posted this TOT entry 
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t tot_update_worker_thread_number=%d\n",i,totp->tot_entry[i].tot_update_worker_thread_number);	// Number of the Worker Thread that last updated this TOT Entry
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t status=%d\n",i,totp->tot_entry[i].tot_status);
-
-	if (totp->tot_entry[i].tot_waitp) {
-		fprintf(stderr,"\t\txdd_show_tot_entry: <%d> TOT WAIT Chain\n",i);
-		totwp = totp->tot_entry[i].tot_waitp;
-		while (totwp) {
-			fprintf(stderr,"\t\txdd_show_tot_entry: ----------------------------------\n");
-   			fprintf(stderr,"\t\txdd_show_tot_entry: <%d> struct tot_wait *tot_waitp=%p\n",i,totp->tot_entry[i].tot_waitp);
-   			fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> tot_wait_t *totw_nextp=%p\n",i,totwp->totw_nextp);
-			fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> struct xint_worker_data	*totw_wdp=%p\n",i,totwp->totw_wdp);		// Pointer to the Worker that owns this tot_wait
-    		fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> pthread_cond_t totw_condition\n",i);; 
-    		fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> int totw_is_released=%d\n",i,totwp->totw_is_released);
-			totwp = totwp->totw_nextp;
-		}
-	}
-
-
 
 } // End of xdd_show_tot_entry()
 
@@ -525,6 +521,7 @@ xdd_show_ts_table(xint_timestamp_t *ts_tablep, int target_number) {
 #define TS_TRIGOP             0x00000800 /**< Time stamp trigger operation number */
 #define TS_TRIGGERED          0x00001000 /**< Time stamping has been triggered */
 #define TS_SUPPRESS_OUTPUT    0x00002000 /**< Suppress timestamp output */
+#define TS_STREAM             0x00004000 /**< Stream entries to the binary file during the run */
 #define DEFAULT_TS_OPTIONS 0x00000000
 	option_string[0]='\0';
 	if (ts_tablep->ts_options & TS_NORMALIZE)
@@ -555,6 +552,8 @@ xdd_show_ts_table(xint_timestamp_t *ts_tablep, int target_number) {
 		strcat(option_string,"TS_TRIGGERED ");
 	if (ts_tablep->ts_options & TS_SUPPRESS_OUTPUT)
 		strcat(option_string,"TS_SUPPRESS_OUTPUT ");
+	if (ts_tablep->ts_options & TS_STREAM)
+		strcat(option_string,"TS_STREAM ");
 	fprintf(stderr,"xdd_show_ts_table: uint64_t        ts_options=0x%016llx: '%s'\n",(unsigned long long int)ts_tablep->ts_options,option_string); // Time Stamping Options 
 	fprintf(stderr,"xdd_show_ts_table: int64_t         ts_current_entry=%lld\n",(long long int)ts_tablep->ts_current_entry); 		// Index into the Timestamp Table of the current entry
 	fprintf(stderr,"xdd_show_ts_table: int64_t         ts_size=%lld\n",(long long int)ts_tablep->ts_size);  						// Time Stamping Size in number of entries 
@@ -657,6 +656,12 @@ xdd_show_results_data(results_t *rp, char *dumptype, xdd_plan_t *planp) {
 	fprintf(stderr,"	read_iops = %8.3f\n",rp->read_iops);				// Measured read I/O Operations per second from start of first op to end of last op 
 	fprintf(stderr,"	write_iops = %8.3f\n",rp->write_iops);				// Measured write I/O Operations per second from start of first op to end of last op 
 	fprintf(stderr,"	latency = %8.3f\n",rp->latency); 				// Latency in milliseconds 
+	fprintf(stderr,"	latency_p50 = %8.3f\n",rp->latency_p50); 			// Median op time in microseconds
+	fprintf(stderr,"	latency_p90 = %8.3f\n",rp->latency_p90); 			// 90th percentile op time in microseconds
+	fprintf(stderr,"	latency_p99 = %8.3f\n",rp->latency_p99); 			// 99th percentile op time in microseconds
+	fprintf(stderr,"	latency_p999 = %8.3f\n",rp->latency_p999); 			// 99.9th percentile op time in microseconds
+	fprintf(stderr,"	latency_p9999 = %8.3f\n",rp->latency_p9999); 			// 99.99th percentile op time in microseconds
+	fprintf(stderr,"	latency_max = %8.3f\n",rp->latency_max); 			// Longest op time in microseconds
 
 	// CPU Utilization Information >> see user_time, system_time, and us_time below
 	fprintf(stderr,"	user_time = %8.3f\n",rp->user_time); 				// Amount of CPU time used by the application for this pass 
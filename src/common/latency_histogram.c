@@ -0,0 +1,102 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that maintain the per-worker and
+ * per-target latency histograms and turn them into percentiles for the
+ * results display. Recording a value is done by the inline xint_lh_record()
+ * in xint_latency_histogram.h.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xint_lh_reset() - Clear a histogram
+ */
+void
+xint_lh_reset(xint_latency_histogram_t *lhp) {
+	memset(lhp, 0, sizeof(*lhp));
+} // End of xint_lh_reset()
+
+/*----------------------------------------------------------------------------*/
+/* xint_lh_merge() - Add all the values recorded in the "from" histogram to
+ * the "to" histogram.
+ */
+void
+xint_lh_merge(xint_latency_histogram_t *to, xint_latency_histogram_t *from) {
+	int		i;
+
+
+	if (from->lh_total == 0)
+		return;
+	for (i = 0; i < XINT_LH_BUCKETS; i++)
+		to->lh_counts[i] += from->lh_counts[i];
+	if ((to->lh_total == 0) || (from->lh_min < to->lh_min))
+		to->lh_min = from->lh_min;
+	if (from->lh_max > to->lh_max)
+		to->lh_max = from->lh_max;
+	to->lh_total += from->lh_total;
+} // End of xint_lh_merge()
+
+/*----------------------------------------------------------------------------*/
+/* xint_lh_percentile() - Return the value in nanoseconds at or below which
+ * "percentile" percent of the recorded values fall.
+ * The value returned is the upper edge of the bucket that contains the
+ * requested rank, clipped to the range of values actually recorded.
+ * Returns 0 for an empty histogram.
+ */
+uint64_t
+xint_lh_percentile(xint_latency_histogram_t *lhp, double percentile) {
+	uint64_t	rank;		// Number of values that must be at or below the answer
+	uint64_t	seen;		// Number of values in the buckets looked at so far
+	uint64_t	value;		// Upper edge of the bucket that holds the rank
+	int			shift;		// Number of low-order bits dropped for this bucket
+	int			i;
+
+
+	if (lhp->lh_total == 0)
+		return(0);
+	if (percentile >= 100.0)
+		return(lhp->lh_max);
+	rank = (uint64_t)((percentile / 100.0) * (double)lhp->lh_total + 0.5);
+	if (rank == 0)
+		rank = 1;
+
+	seen = 0;
+	for (i = 0; i < XINT_LH_BUCKETS; i++) {
+		seen += lhp->lh_counts[i];
+		if (seen >= rank)
+			break;
+	}
+	if (i == XINT_LH_BUCKETS)
+		return(lhp->lh_max);
+
+	shift = 0;
+	if (i >= (2 * XINT_LH_SUB_COUNT))
+		shift = (i >> XINT_LH_SUB_BITS) - 1;
+	value = (((uint64_t)(i - (shift << XINT_LH_SUB_BITS)) + 1) << shift) - 1;
+	if (value > lhp->lh_max)
+		value = lhp->lh_max;
+	if (value < lhp->lh_min)
+		value = lhp->lh_min;
+	return(value);
+} // End of xint_lh_percentile()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -5,11 +5,18 @@ DIR := src/common
 
 COMMON_SRC := $(DIR)/access_pattern.c \
 	$(DIR)/barrier.c \
+	$(DIR)/checksum.c \
 	$(DIR)/datapatterns.c \
+	$(DIR)/datapatterns_simd.c \
 	$(DIR)/debug.c \
+	$(DIR)/latency_histogram.c \
 	$(DIR)/memory.c \
 	$(DIR)/processor.c \
+	$(DIR)/replay.c \
+	$(DIR)/reqsize_mix.c \
 	$(DIR)/target_data.c \
 	$(DIR)/timestamp.c \
+	$(DIR)/xint_futex.c \
 	$(DIR)/xint_global_data.c \
-	$(DIR)/xint_nclk.c
+	$(DIR)/xint_nclk.c \
+	$(DIR)/xint_numa.c
@@ -38,11 +38,13 @@ typedef struct xdd_func xdd_func_t;
 #define	XDD_FUNC_INVISIBLE	0x00000001	// When this flag is present then this command will not be displayed with "usage"
 
 // Prototypes required by the parse_table() compilation
+int xddfunc_arrivals(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_blocksize(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_bytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_combinedout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_congestion(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_cookie(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_copyfrom(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_createnewfiles(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_csvout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_datapattern(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -58,8 +60,10 @@ int xddfunc_flushwrite(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t f
 int xddfunc_fullhelp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_help(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_hugepages(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_id(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_interactive(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_ioengine(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_kbytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_lockstep(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_looseordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -71,11 +75,13 @@ int xddfunc_mbytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
 int xddfunc_memalign(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_memory_usage(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_minall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_mmap(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_multipath(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_nobarrier(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_nomemlock(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_noordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_noproclock(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_numa(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_numreqs(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_operationdelay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_operation(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -98,6 +104,8 @@ int xddfunc_recreatefiles(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_
 int xddfunc_reopen(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_report_threshold(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_reqsize(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_reqsizemix(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_replay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_restart(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_retry(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_roundrobin(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -115,6 +123,7 @@ int xddfunc_starttrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t
 int xddfunc_stoponerror(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_stoptrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_serialordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_stream(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_syncio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_syncwrite(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_target(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -136,6 +145,7 @@ int xddfunc_verify(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
 int xddfunc_unverbose(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_verbose(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_version(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_workerpool(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_xni(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_ibdevice(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_invalid_option(int32_t argc, char *argv[], uint32_t flags);
@@ -0,0 +1,415 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that implement the "-replay" option.
+ * They read a blkparse trace or an xdd binary timestamp dump, set up the
+ * target so that the trace can be replayed, and compare the op times of the
+ * replay with the op times in the trace at the end of the run.
+ */
+#include "xint.h"
+
+#define XINT_REPLAY_ENTRIES_INITIAL	4096	// Initial number of entries in the table
+
+/*----------------------------------------------------------------------------*/
+/* xint_replay_add_entry() - Return a pointer to a new entry at the end of
+ * the table, making the table bigger if needed, or NULL if out of memory.
+ */
+static xint_replay_entry_t *
+xint_replay_add_entry(xint_replay_t *replayp, int64_t *sizep) {
+	xint_replay_entry_t	*entriesp;	// The bigger table
+
+
+	if (replayp->replay_ops == *sizep) {
+		*sizep = (*sizep) ? (*sizep) * 2 : XINT_REPLAY_ENTRIES_INITIAL;
+		entriesp = realloc(replayp->replay_entries, (*sizep) * sizeof(xint_replay_entry_t));
+		if (entriesp == NULL)
+			return(NULL);
+		replayp->replay_entries = entriesp;
+	}
+	memset(&replayp->replay_entries[replayp->replay_ops], 0, sizeof(xint_replay_entry_t));
+	return(&replayp->replay_entries[replayp->replay_ops++]);
+} // End of xint_replay_add_entry()
+
+/*----------------------------------------------------------------------------*/
+/* xint_replay_load_blkparse() - Read the text output of blkparse.
+ * Each line of the default output format looks like
+ *    8,0    3       11     0.009507758   697  D   W 223490 + 8 [kjournald]
+ * The operations are the "D" (issued to the device) events and their op times
+ * run to the matching "C" (completed) events. If the trace has no "D" events
+ * the "Q" (queued) events are used instead.
+ * Returns 0 on success or -1 on failure.
+ */
+static int32_t
+xint_replay_load_blkparse(target_data_t *tdp, FILE *fp) {
+	xint_replay_t		*replayp;		// The replay for this target
+	xint_replay_entry_t	*rep;			// The entry for the current line
+	char				line[1024];		// One line of the trace
+	char				action[8];		// The action field of a line
+	char				rwbs[16];		// The RWBS field of a line
+	unsigned long long	seconds;		// Time of the event
+	unsigned long long	nanoseconds;
+	unsigned long long	sector;			// Location in 512-byte sectors
+	unsigned int		sectors;		// Size in 512-byte sectors
+	int					major, minor, cpu, pid;
+	unsigned int		sequence;
+	char				issue_action;	// 'D' or 'Q'
+	char				operation;		// SO_OP_READ or SO_OP_WRITE
+	nclk_t				event_time;		// Time of the event in nanoseconds
+	nclk_t				first_time;		// Time of the first operation
+	int64_t				size;			// Number of entries the table can hold
+	int64_t				*outstandingp;	// Entries issued but not completed yet
+	int64_t				outstanding;	// Number of entries in outstandingp
+	int64_t				outstanding_size;// Number of entries outstandingp can hold
+	int64_t				*newp;
+	int64_t				completions;	// Number of completions matched
+	int64_t				i;
+
+
+	replayp = tdp->td_replayp;
+	outstandingp = NULL;
+	outstanding_size = 0;
+	for (issue_action = 'D'; ; issue_action = 'Q') {
+		rewind(fp);
+		replayp->replay_ops = 0;
+		size = 0;
+		outstanding = 0;
+		completions = 0;
+		first_time = 0;
+		while (fgets(line, sizeof(line), fp)) {
+			if (sscanf(line, "%d,%d %d %u %llu.%llu %d %7s %15s %llu + %u",
+					&major, &minor, &cpu, &sequence, &seconds, &nanoseconds, &pid, action, rwbs, &sector, &sectors) != 11)
+				continue;
+			if ((action[1] != '\0') || ((action[0] != issue_action) && (action[0] != 'C')) || (sectors == 0))
+				continue;
+			if (strchr(rwbs, 'W'))
+				operation = SO_OP_WRITE;
+			else if (strchr(rwbs, 'R'))
+				operation = SO_OP_READ;
+			else continue; // Discards, flushes and the like are not replayed
+			event_time = (nclk_t)(seconds * BILLION + nanoseconds);
+
+			if (action[0] == 'C') { // Find the oldest outstanding operation that this completes
+				for (i = 0; i < outstanding; i++) {
+					rep = &replayp->replay_entries[outstandingp[i]];
+					if ((rep->re_offset == sector * 512) && (rep->re_size == (int64_t)sectors * 512) && (rep->re_operation == operation))
+						break;
+				}
+				if (i == outstanding)
+					continue;
+				rep = &replayp->replay_entries[outstandingp[i]];
+				rep->re_latency = event_time - first_time - rep->re_issue_time;
+				outstanding--;
+				memmove(&outstandingp[i], &outstandingp[i + 1], (outstanding - i) * sizeof(int64_t));
+				completions++;
+				continue;
+			}
+
+			rep = xint_replay_add_entry(replayp, &size);
+			if (rep == NULL) {
+				free(outstandingp);
+				return(-1);
+			}
+			if (replayp->replay_ops == 1)
+				first_time = event_time;
+			rep->re_offset = sector * 512;
+			rep->re_size = (int64_t)sectors * 512;
+			rep->re_operation = operation;
+			rep->re_issue_time = event_time - first_time;
+			if (outstanding == outstanding_size) {
+				outstanding_size = (outstanding_size) ? outstanding_size * 2 : 64;
+				newp = realloc(outstandingp, outstanding_size * sizeof(int64_t));
+				if (newp == NULL) {
+					free(outstandingp);
+					return(-1);
+				}
+				outstandingp = newp;
+			}
+			outstandingp[outstanding++] = replayp->replay_ops - 1;
+			if ((outstanding > replayp->replay_concurrency) && (issue_action == 'D'))
+				replayp->replay_concurrency = outstanding;
+		}
+		if ((replayp->replay_ops > 0) || (issue_action == 'Q'))
+			break;
+	}
+	free(outstandingp);
+	// Without completions there is nothing to say how many operations were outstanding
+	if (completions == 0)
+		replayp->replay_concurrency = 0;
+	return(0);
+} // End of xint_replay_load_blkparse()
+
+/*----------------------------------------------------------------------------*/
+/* xint_replay_compare_start() - qsort() comparison of the start times of two
+ * timestamp table entries.
+ */
+static int
+xint_replay_compare_start(const void *a, const void *b) {
+	const xdd_ts_tte_t	*ap = a;
+	const xdd_ts_tte_t	*bp = b;
+
+	if (ap->tte_disk_start < bp->tte_disk_start)
+		return(-1);
+	return(ap->tte_disk_start > bp->tte_disk_start);
+} // End of xint_replay_compare_start()
+
+/*----------------------------------------------------------------------------*/
+/* xint_replay_compare_time() - qsort() comparison of two times.
+ */
+static int
+xint_replay_compare_time(const void *a, const void *b) {
+	const nclk_t	*ap = a;
+	const nclk_t	*bp = b;
+
+	if (*ap < *bp)
+		return(-1);
+	return(*ap > *bp);
+} // End of xint_replay_compare_time()
+
+/*----------------------------------------------------------------------------*/
+/* xint_replay_load_tsdump() - Read an xdd binary timestamp dump.
+ * Streamed dumps hold their entries in the order they were drained so the
+ * entries are sorted by the time the disk operation started. Entries of all
+ * the passes in the dump are replayed as one sequence.
+ * Returns 0 on success or -1 on failure.
+ */
+static int32_t
+xint_replay_load_tsdump(target_data_t *tdp, FILE *fp) {
+	xint_replay_t		*replayp;		// The replay for this target
+	xint_replay_entry_t	*rep;			// The entry for the current operation
+	xdd_ts_header_t		*hdrp;			// The dump
+	xdd_ts_tte_t		*ttep;			// One entry of the dump
+	nclk_t				*endp;			// End times of the operations, sorted
+	nclk_t				first_start;	// Start time of the first operation
+	long				file_size;		// Number of bytes in the file
+	int64_t				entries;		// Number of entries in the dump
+	int64_t				size;			// Number of entries the table can hold
+	int64_t				i, j;
+
+
+	replayp = tdp->td_replayp;
+	fseek(fp, 0, SEEK_END);
+	file_size = ftell(fp);
+	rewind(fp);
+	if (file_size < (long)offsetof(xdd_ts_header_t, tsh_tte)) {
+		fprintf(xgp->errout,"%s: xint_replay_load_tsdump: Target %d: ERROR: Timestamp dump '%s' is truncated\n",
+			xgp->progname, tdp->td_target_number, replayp->replay_filename);
+		return(-1);
+	}
+	hdrp = malloc(file_size);
+	if (hdrp == NULL)
+		return(-1);
+	if (fread(hdrp, file_size, 1, fp) != 1) {
+		free(hdrp);
+		return(-1);
+	}
+	entries = (file_size - offsetof(xdd_ts_header_t, tsh_tte)) / sizeof(xdd_ts_tte_t);
+	if ((hdrp->tsh_magic == XDD_TS_MAGIC) && (hdrp->tsh_numents < entries))
+		entries = hdrp->tsh_numents;
+	qsort(hdrp->tsh_tte, entries, sizeof(xdd_ts_tte_t), xint_replay_compare_start);
+
+	size = 0;
+	first_start = 0;
+	replayp->replay_ops = 0;
+	for (i = 0; i < entries; i++) {
+		ttep = &hdrp->tsh_tte[i];
+		if ((ttep->tte_disk_start == 0) || (ttep->tte_disk_xfer_size <= 0))
+			continue;
+		if ((ttep->tte_op_type != TASK_OP_TYPE_READ) && (ttep->tte_op_type != TASK_OP_TYPE_WRITE))
+			continue;
+		rep = xint_replay_add_entry(replayp, &size);
+		if (rep == NULL) {
+			free(hdrp);
+			return(-1);
+		}
+		rep->re_offset = ttep->tte_byte_offset;
+		rep->re_size = ttep->tte_disk_xfer_size;
+		rep->re_operation = (ttep->tte_op_type == TASK_OP_TYPE_WRITE) ? SO_OP_WRITE : SO_OP_READ;
+		if (replayp->replay_ops == 1)
+			first_start = ttep->tte_disk_start;
+		rep->re_issue_time = ttep->tte_disk_start - first_start;
+		if (ttep->tte_disk_end > ttep->tte_disk_start)
+			rep->re_latency = ttep->tte_disk_end - ttep->tte_disk_start;
+	}
+
+	// The most operations outstanding at once is found by walking the start and end times in order
+	endp = malloc((replayp->replay_ops + 1) * sizeof(nclk_t));
+	if (endp == NULL) {
+		free(hdrp);
+		return(-1);
+	}
+	for (i = 0; i < replayp->replay_ops; i++)
+		endp[i] = replayp->replay_entries[i].re_issue_time + replayp->replay_entries[i].re_latency;
+	qsort(endp, replayp->replay_ops, sizeof(nclk_t), xint_replay_compare_time);
+	j = 0;
+	for (i = 0; i < replayp->replay_ops; i++) {
+		while ((j < i) && (endp[j] <= replayp->replay_entries[i].re_issue_time))
+			j++;
+		if (i - j + 1 > replayp->replay_concurrency)
+			replayp->replay_concurrency = (int32_t)(i - j + 1);
+	}
+	free(endp);
+	free(hdrp);
+	return(0);
+} // End of xint_replay_load_tsdump()
+
+/*----------------------------------------------------------------------------*/
+/* xint_replay_setup() - Read the trace the first time through and set up the
+ * target to replay it. The block size is made small enough to divide every
+ * location and size in the trace, the request size is set to the largest
+ * operation so that the I/O buffers are big enough, and the queue depth is
+ * raised to the number of operations that were outstanding at once in the
+ * trace so that the original concurrency can be reproduced. The read/write
+ * ratio is set to the one in the trace so that the target is opened for
+ * the kinds of operations that are in it.
+ * Returns 0 on success or -1 on failure.
+ */
+int32_t
+xint_replay_setup(target_data_t *tdp) {
+	xint_replay_t		*replayp;		// The replay for this target
+	xint_replay_entry_t	*rep;			// One entry of the trace
+	FILE				*fp;			// The trace file
+	uint32_t			magic;			// First word of the file
+	int64_t				block_size;		// Block size that divides everything
+	int64_t				largest;		// Largest operation in bytes
+	int64_t				reads;			// Number of read operations
+	int64_t				a, b, t;
+	int64_t				i;
+	int32_t				status;
+
+
+	replayp = tdp->td_replayp;
+	if (replayp->replay_entries == NULL) {
+		fp = fopen(replayp->replay_filename, "r");
+		if (fp == NULL) {
+			fprintf(xgp->errout,"%s: xint_replay_setup: Target %d: ERROR: Cannot open trace file '%s': %s\n",
+				xgp->progname, tdp->td_target_number, replayp->replay_filename, strerror(errno));
+			return(-1);
+		}
+		if ((fread(&magic, sizeof(magic), 1, fp) == 1) && ((magic == XDD_TS_MAGIC) || (magic == XDD_TS_STREAM_MAGIC))) {
+			replayp->replay_format = XINT_REPLAY_TSDUMP;
+			status = xint_replay_load_tsdump(tdp, fp);
+		} else {
+			replayp->replay_format = XINT_REPLAY_BLKPARSE;
+			status = xint_replay_load_blkparse(tdp, fp);
+		}
+		fclose(fp);
+		if (status < 0) {
+			fprintf(xgp->errout,"%s: xint_replay_setup: Target %d: ERROR: Cannot read trace file '%s'\n",
+				xgp->progname, tdp->td_target_number, replayp->replay_filename);
+			return(-1);
+		}
+		if (replayp->replay_ops == 0) {
+			fprintf(xgp->errout,"%s: xint_replay_setup: Target %d: ERROR: There are no read or write operations in trace file '%s'\n",
+				xgp->progname, tdp->td_target_number, replayp->replay_filename);
+			return(-1);
+		}
+		replayp->replay_bytes = 0;
+		for (i = 0; i < replayp->replay_ops; i++) {
+			rep = &replayp->replay_entries[i];
+			replayp->replay_bytes += rep->re_size;
+			if (rep->re_latency)
+				xint_lh_record(&replayp->replay_original_hist, rep->re_latency);
+		}
+	}
+
+	// Find the largest block size that divides the current one and every location and size
+	block_size = tdp->td_block_size;
+	largest = 0;
+	reads = 0;
+	for (i = 0; i < replayp->replay_ops; i++) {
+		rep = &replayp->replay_entries[i];
+		if (rep->re_size > largest)
+			largest = rep->re_size;
+		if (rep->re_operation == SO_OP_READ)
+			reads++;
+		a = block_size;
+		b = (int64_t)(rep->re_offset % block_size);
+		while (b) {
+			t = a % b;
+			a = b;
+			b = t;
+		}
+		b = rep->re_size % a;
+		while (b) {
+			t = a % b;
+			a = b;
+			b = t;
+		}
+		block_size = a;
+	}
+	if (block_size != tdp->td_block_size) {
+		fprintf(xgp->output,"%s: xint_replay_setup: Target %d: INFORMATION: Block size changed from %d to %lld bytes to fit the locations and sizes in trace file '%s'\n",
+			xgp->progname, tdp->td_target_number, tdp->td_block_size, (long long int)block_size, replayp->replay_filename);
+		tdp->td_block_size = (int32_t)block_size;
+	}
+	tdp->td_reqsize = (int32_t)(largest / block_size);
+	tdp->td_rwratio = (double)reads / (double)replayp->replay_ops;
+
+	if (replayp->replay_concurrency > tdp->td_queue_depth) {
+		fprintf(xgp->output,"%s: xint_replay_setup: Target %d: INFORMATION: Queue depth raised from %d to %d to match the concurrency in trace file '%s'\n",
+			xgp->progname, tdp->td_target_number, tdp->td_queue_depth, replayp->replay_concurrency, replayp->replay_filename);
+		tdp->td_queue_depth = replayp->replay_concurrency;
+	}
+	return(0);
+} // End of xint_replay_setup()
+
+/*----------------------------------------------------------------------------*/
+/* xint_replay_display() - Display the op times of the trace next to the op
+ * times of the replay for the whole run.
+ */
+void
+xint_replay_display(target_data_t *tdp, FILE *out) {
+	xint_replay_t				*replayp;	// The replay for this target
+	xint_latency_histogram_t	*lhp;		// The histogram being displayed
+	int32_t						i;
+
+
+	replayp = tdp->td_replayp;
+	fprintf(out,"Replay of %s trace '%s' for Target %d, %lld ops, speedup %.2f, %d ops outstanding in the trace\n",
+		(replayp->replay_format == XINT_REPLAY_TSDUMP) ? "xdd timestamp" : "blkparse",
+		replayp->replay_filename,
+		tdp->td_target_number,
+		(long long int)replayp->replay_ops,
+		replayp->replay_speedup,
+		replayp->replay_concurrency);
+	fprintf(out,"%12s %12s %10s %10s %10s %10s %10s\n",
+		"Op_Times","Ops","LatMin","LatP50","LatP90","LatP99","LatMax");
+	fprintf(out,"%12s %12s %10s %10s %10s %10s %10s\n",
+		"source","#ops","microsec","microsec","microsec","microsec","microsec");
+	for (i = 0; i < 2; i++) {
+		lhp = (i == 0) ? &replayp->replay_original_hist : &replayp->replay_replayed_hist;
+		fprintf(out,"%12s %12lld %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+			(i == 0) ? "trace" : "replay",
+			(long long int)lhp->lh_total,
+			(double)lhp->lh_min / FLOAT_THOUSAND,
+			(double)xint_lh_percentile(lhp, 50.0) / FLOAT_THOUSAND,
+			(double)xint_lh_percentile(lhp, 90.0) / FLOAT_THOUSAND,
+			(double)xint_lh_percentile(lhp, 99.0) / FLOAT_THOUSAND,
+			(double)lhp->lh_max / FLOAT_THOUSAND);
+	}
+	fprintf(out,"Replay ops issued late, %lld, average lateness, %.1f, microsec, longest lateness, %.1f, microsec\n",
+		(long long int)replayp->replay_late_ops,
+		(replayp->replay_late_ops) ? (replayp->replay_lag_sum / replayp->replay_late_ops) / FLOAT_THOUSAND : 0.0,
+		(double)replayp->replay_lag_max / FLOAT_THOUSAND);
+} // End of xint_replay_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,277 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that implement the "-reqsizemix" option.
+ * They parse the list of request sizes and weights, deal out the request size
+ * of each operation, work out how many bytes and operations a pass has, and
+ * display the results of each request size at the end of the run.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xint_reqsize_mix_parse() - Parse a list of request sizes and weights of the
+ * form "size:weight,size:weight,..." such as "4k:50,64k:30,1m:20".
+ * Sizes are in bytes and may end in k, m or g for units of 1024 bytes,
+ * 1024*1024 bytes or 1024*1024*1024 bytes. Weights are whole numbers.
+ * Returns 0 on success or -1 if the list is not valid.
+ */
+int32_t
+xint_reqsize_mix_parse(xint_reqsize_mix_t *rsmp, char *listp) {
+	char		*cp;		// Current position in the list
+	char		*endp;		// End of the number just parsed
+	int64_t		bytes;		// Request size in bytes
+	long		weight;		// Weight of this request size
+	int32_t		i;
+
+
+	memset(rsmp, 0, sizeof(*rsmp));
+	rsmp->rsm_deck_number = -1;
+	cp = listp;
+	while (*cp) {
+		if (rsmp->rsm_classes == XINT_REQSIZE_MAX_CLASSES) {
+			fprintf(xgp->errout,"%s: ERROR: No more than %d request sizes can be specified in '%s'\n",
+				xgp->progname, XINT_REQSIZE_MAX_CLASSES, listp);
+			return(-1);
+		}
+		bytes = strtoll(cp, &endp, 10);
+		if (endp == cp)
+			break;
+		switch (*endp) {
+			case 'k': case 'K': bytes *= 1024; endp++; break;
+			case 'm': case 'M': bytes *= 1024 * 1024; endp++; break;
+			case 'g': case 'G': bytes *= 1024 * 1024 * 1024; endp++; break;
+			default: break;
+		}
+		if (*endp != ':')
+			break;
+		cp = endp + 1;
+		weight = strtol(cp, &endp, 10);
+		if ((endp == cp) || (bytes <= 0) || (weight <= 0))
+			break;
+		for (i = 0; i < rsmp->rsm_classes; i++) {
+			if (rsmp->rsm_bytes[i] == bytes) {
+				fprintf(xgp->errout,"%s: ERROR: The request size %lld is specified more than once in '%s'\n",
+					xgp->progname, (long long int)bytes, listp);
+				return(-1);
+			}
+		}
+		rsmp->rsm_bytes[rsmp->rsm_classes] = bytes;
+		rsmp->rsm_weight[rsmp->rsm_classes] = (int32_t)weight;
+		rsmp->rsm_classes++;
+		cp = endp;
+		if (*cp == ',')
+			cp++;
+		else if (*cp != '\0')
+			break;
+	}
+	if ((*cp != '\0') || (rsmp->rsm_classes == 0)) {
+		fprintf(xgp->errout,"%s: ERROR: Request size mix '%s' is not valid. It must look like 4k:50,64k:30,1m:20\n",
+			xgp->progname, listp);
+		return(-1);
+	}
+	return(0);
+} // End of xint_reqsize_mix_parse()
+
+/*----------------------------------------------------------------------------*/
+/* xint_reqsize_mix_setup() - Turn the request sizes into blocks, set the
+ * request size of the target to the largest of them so that the I/O buffers
+ * are big enough for any operation, and build the deck.
+ * Returns 0 on success or -1 if something is wrong.
+ */
+int32_t
+xint_reqsize_mix_setup(target_data_t *tdp) {
+	xint_reqsize_mix_t	*rsmp;		// The request size mix of this target
+	int32_t				divisor;	// Greatest common divisor of the weights
+	int32_t				a, b, t;
+	int32_t				i;
+
+
+	rsmp = tdp->td_rsmp;
+	if (tdp->td_block_size <= 0)
+		return(-1);
+	tdp->td_reqsize = 0;
+	for (i = 0; i < rsmp->rsm_classes; i++) {
+		if (rsmp->rsm_bytes[i] % tdp->td_block_size) {
+			fprintf(xgp->errout,"%s: xint_reqsize_mix_setup: Target %d: ERROR: Request size %lld is not a multiple of the block size of %d bytes\n",
+				xgp->progname, tdp->td_target_number, (long long int)rsmp->rsm_bytes[i], tdp->td_block_size);
+			return(-1);
+		}
+		rsmp->rsm_reqsize[i] = rsmp->rsm_bytes[i] / tdp->td_block_size;
+		if (rsmp->rsm_reqsize[i] > tdp->td_reqsize)
+			tdp->td_reqsize = rsmp->rsm_reqsize[i];
+	}
+
+	// Reduce the weights so that "50,30,20" deals from a deck of 10 rather than 100
+	divisor = rsmp->rsm_weight[0];
+	for (i = 1; i < rsmp->rsm_classes; i++) {
+		a = divisor;
+		b = rsmp->rsm_weight[i];
+		while (b) {
+			t = a % b;
+			a = b;
+			b = t;
+		}
+		divisor = a;
+	}
+	rsmp->rsm_deck_size = 0;
+	rsmp->rsm_deck_bytes = 0;
+	for (i = 0; i < rsmp->rsm_classes; i++) {
+		rsmp->rsm_count[i] = rsmp->rsm_weight[i] / divisor;
+		rsmp->rsm_deck_size += rsmp->rsm_count[i];
+		rsmp->rsm_deck_bytes += rsmp->rsm_count[i] * rsmp->rsm_bytes[i];
+	}
+	if (rsmp->rsm_deck_size > XINT_REQSIZE_MAX_DECK) {
+		fprintf(xgp->errout,"%s: xint_reqsize_mix_setup: Target %d: ERROR: The reduced weights of the request sizes add up to %d which is more than %d\n",
+			xgp->progname, tdp->td_target_number, rsmp->rsm_deck_size, XINT_REQSIZE_MAX_DECK);
+		return(-1);
+	}
+
+	if (rsmp->rsm_deck == NULL) {
+		rsmp->rsm_deck = malloc(rsmp->rsm_deck_size * sizeof(int32_t));
+		rsmp->rsm_run_statsp = calloc(rsmp->rsm_classes, sizeof(xint_reqsize_stats_t));
+		if ((rsmp->rsm_deck == NULL) || (rsmp->rsm_run_statsp == NULL)) {
+			fprintf(xgp->errout,"%s: xint_reqsize_mix_setup: Target %d: ERROR: Cannot allocate memory for the request size mix\n",
+				xgp->progname, tdp->td_target_number);
+			return(-1);
+		}
+	}
+	rsmp->rsm_deck_number = -1;
+	return(0);
+} // End of xint_reqsize_mix_setup()
+
+/*----------------------------------------------------------------------------*/
+/* xint_reqsize_mix_class() - Return the request size class of operation
+ * number "op_number". Operations are dealt from shuffled decks so that the
+ * same seed always gives the same sizes. A deck is only shuffled when the
+ * first operation in it is asked for, so this is constant time per operation
+ * when the operations are asked for in order.
+ * This is only called by the Target Thread.
+ */
+int32_t
+xint_reqsize_mix_class(target_data_t *tdp, int64_t op_number) {
+	xint_reqsize_mix_t	*rsmp;		// The request size mix of this target
+	int64_t				deck;		// Number of the deck that holds this operation
+	xint_rng_t			rng;		// Random numbers for shuffling this deck
+	int32_t				i, j, k, t;
+
+
+	rsmp = tdp->td_rsmp;
+	deck = op_number / rsmp->rsm_deck_size;
+	if (deck != rsmp->rsm_deck_number) {
+		k = 0;
+		for (i = 0; i < rsmp->rsm_classes; i++)
+			for (j = 0; j < rsmp->rsm_count[i]; j++)
+				rsmp->rsm_deck[k++] = i;
+		xint_rng_init(&rng, (uint64_t)tdp->td_seekhdr.seek_seed, tdp->td_target_number, XINT_RNG_REQSIZE, deck);
+		for (i = rsmp->rsm_deck_size - 1; i > 0; i--) {
+			j = (int32_t)(xint_rng_double(&rng) * (i + 1));
+			t = rsmp->rsm_deck[i];
+			rsmp->rsm_deck[i] = rsmp->rsm_deck[j];
+			rsmp->rsm_deck[j] = t;
+		}
+		rsmp->rsm_deck_number = deck;
+	}
+	return(rsmp->rsm_deck[op_number % rsmp->rsm_deck_size]);
+} // End of xint_reqsize_mix_class()
+
+/*----------------------------------------------------------------------------*/
+/* xint_reqsize_mix_bytes() - Return the number of bytes transferred by the
+ * first "ops" operations.
+ */
+uint64_t
+xint_reqsize_mix_bytes(target_data_t *tdp, int64_t ops) {
+	xint_reqsize_mix_t	*rsmp;		// The request size mix of this target
+	uint64_t			bytes;		// Bytes in the operations counted so far
+	int64_t				op;
+
+
+	rsmp = tdp->td_rsmp;
+	bytes = (uint64_t)(ops / rsmp->rsm_deck_size) * rsmp->rsm_deck_bytes;
+	for (op = ops - (ops % rsmp->rsm_deck_size); op < ops; op++)
+		bytes += rsmp->rsm_bytes[xint_reqsize_mix_class(tdp, op)];
+	return(bytes);
+} // End of xint_reqsize_mix_bytes()
+
+/*----------------------------------------------------------------------------*/
+/* xint_reqsize_mix_ops() - Return the number of operations needed to
+ * transfer "bytes" bytes. The last one may be cut short.
+ */
+int64_t
+xint_reqsize_mix_ops(target_data_t *tdp, uint64_t bytes) {
+	xint_reqsize_mix_t	*rsmp;		// The request size mix of this target
+	uint64_t			remaining;	// Bytes left after the whole decks
+	int64_t				op;
+
+
+	rsmp = tdp->td_rsmp;
+	op = (int64_t)(bytes / rsmp->rsm_deck_bytes) * rsmp->rsm_deck_size;
+	remaining = bytes % rsmp->rsm_deck_bytes;
+	while (remaining > 0) {
+		if (remaining <= (uint64_t)rsmp->rsm_bytes[xint_reqsize_mix_class(tdp, op)])
+			remaining = 0;
+		else remaining -= rsmp->rsm_bytes[xint_reqsize_mix_class(tdp, op)];
+		op++;
+	}
+	return(op);
+} // End of xint_reqsize_mix_ops()
+
+/*----------------------------------------------------------------------------*/
+/* xint_reqsize_mix_display() - Display the operations, bytes and op times of
+ * each request size of a target for the whole run.
+ */
+void
+xint_reqsize_mix_display(target_data_t *tdp, FILE *out) {
+	xint_reqsize_mix_t		*rsmp;		// The request size mix of this target
+	xint_reqsize_stats_t	*rsp;		// Statistics of one request size
+	int64_t					total_ops;	// Operations of all sizes
+	int64_t					total_bytes;// Bytes of all sizes
+	int32_t					i;
+
+
+	rsmp = tdp->td_rsmp;
+	total_ops = 0;
+	total_bytes = 0;
+	for (i = 0; i < rsmp->rsm_classes; i++) {
+		total_ops += rsmp->rsm_run_statsp[i].rs_ops;
+		total_bytes += rsmp->rsm_run_statsp[i].rs_bytes;
+	}
+	fprintf(out,"Request size mix for Target %d\n", tdp->td_target_number);
+	fprintf(out,"%12s %12s %8s %16s %8s %10s %10s %10s %10s\n",
+		"Xfer_Size","Ops","Pct_Ops","Bytes_Xfered","Pct_Byte","LatAvg","LatP50","LatP99","LatMax");
+	fprintf(out,"%12s %12s %8s %16s %8s %10s %10s %10s %10s\n",
+		"bytes","#ops","percent","Bytes","percent","microsec","microsec","microsec","microsec");
+	for (i = 0; i < rsmp->rsm_classes; i++) {
+		rsp = &rsmp->rsm_run_statsp[i];
+		fprintf(out,"%12lld %12lld %8.2f %16lld %8.2f %10.1f %10.1f %10.1f %10.1f\n",
+			(long long int)rsmp->rsm_bytes[i],
+			(long long int)rsp->rs_ops,
+			(total_ops) ? (100.0 * rsp->rs_ops) / total_ops : 0.0,
+			(long long int)rsp->rs_bytes,
+			(total_bytes) ? (100.0 * rsp->rs_bytes) / total_bytes : 0.0,
+			(rsp->rs_ops) ? ((double)rsp->rs_op_time / rsp->rs_ops) / FLOAT_THOUSAND : 0.0,
+			(double)xint_lh_percentile(&rsp->rs_hist, 50.0) / FLOAT_THOUSAND,
+			(double)xint_lh_percentile(&rsp->rs_hist, 99.0) / FLOAT_THOUSAND,
+			(double)rsp->rs_hist.lh_max / FLOAT_THOUSAND);
+	}
+} // End of xint_reqsize_mix_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -77,6 +77,19 @@ struct results {
 	double		read_iops;				// Measured read I/O Operations per second from start of first op to end of last op 
 	double		write_iops;				// Measured write I/O Operations per second from start of first op to end of last op 
 	double		latency; 				// Latency in milliseconds 
+	double		latency_p50; 			// Median op time in microseconds from the latency histogram
+	double		latency_p90; 			// 90th percentile op time in microseconds
+	double		latency_p99; 			// 99th percentile op time in microseconds
+	double		latency_p999; 			// 99.9th percentile op time in microseconds
+	double		latency_p9999; 			// 99.99th percentile op time in microseconds
+	double		latency_max; 			// Longest op time in microseconds
+
+	// Open-loop arrival information from the -arrivals option
+	int64_t		arrival_ops;			// Number of operations issued from the arrival schedule
+	double		backlog_sum;			// Sum of the number of arrivals waiting behind each operation as it was issued
+	double		backlog_avg;			// Average number of arrivals waiting behind an operation as it was issued
+	double		backlog_max;			// Largest number of arrivals waiting behind an operation as it was issued
+	double		issue_lag_max;			// Longest time in microseconds from an arrival to the issue of its operation
 
 	// CPU Utilization Information >> see user_time, system_time, and us_time below
 	double		user_time; 				// Amount of CPU time used by the application for this pass 
@@ -141,6 +154,9 @@ struct results {
 	double		lowest_iops;			// Lowest individual op I/O Operations per second 
 	double		lowest_read_iops;		// Lowest individual op read I/O Operations per second 
 	double		lowest_write_iops;		// Lowest individual op write I/O Operations per second 
+
+	// Op time histogram - the percentiles above are calculated from this
+	xint_latency_histogram_t	latency_hist;
 }; 
 typedef struct results results_t; 
 
@@ -161,6 +177,15 @@ void xdd_results_fmt_iops(results_t *rp);
 void xdd_results_fmt_read_iops(results_t *rp);
 void xdd_results_fmt_write_iops(results_t *rp);
 void xdd_results_fmt_latency(results_t *rp);
+void xdd_results_fmt_latency_p50(results_t *rp);
+void xdd_results_fmt_latency_p90(results_t *rp);
+void xdd_results_fmt_latency_p99(results_t *rp);
+void xdd_results_fmt_latency_p999(results_t *rp);
+void xdd_results_fmt_latency_p9999(results_t *rp);
+void xdd_results_fmt_latency_max(results_t *rp);
+void xdd_results_fmt_backlog_max(results_t *rp);
+void xdd_results_fmt_backlog_avg(results_t *rp);
+void xdd_results_fmt_issue_lag_max(results_t *rp);
 void xdd_results_fmt_elapsed_time_from_1st_op(results_t *rp);
 void xdd_results_fmt_elapsed_time_from_pass_start(results_t *rp);
 void xdd_results_fmt_elapsed_over_head_time(results_t *rp);
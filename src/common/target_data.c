@@ -54,8 +54,11 @@ xdd_init_new_target_data(target_data_t *tdp, int32_t n) {
 	tdp->td_dpp->data_pattern_prefix_length = DEFAULT_DATA_PATTERN_PREFIX_LENGTH;
 	tdp->td_block_size = DEFAULT_BLOCKSIZE;
 	tdp->td_mem_align = getpagesize();
+	tdp->td_hugepage_size = 0;
+	tdp->td_buffer_poolp = NULL;
 
 	tdp->td_processor = -1;
+	tdp->td_numa_node = XINT_NUMA_OFF;
 	tdp->td_start_delay = DEFAULT_START_DELAY;
 	/* Init the Trigger Structure members if there is a trigger struct */
 	if (tdp->td_trigp) {
@@ -108,6 +111,7 @@ xdd_init_new_target_data(target_data_t *tdp, int32_t n) {
 	tdp->xni_ibdevice = DEFAULT_IB_DEVICE;  /* can be changed by '-ibdevice' CLO */
 
 	tdp->xni_tcp_congestion = XNI_TCP_DEFAULT_CONGESTION;  /* can be changed by '-congestion' CLO */
+	tdp->xni_tcp_flags = XNI_TCP_DEFAULT_FLAGS;  /* can be changed by '-xni tcp-zerocopy' CLO */
 
 	sprintf(tdp->td_occupant_name,"TARGET%04d",tdp->td_target_number);
 	xdd_init_barrier_occupant(&tdp->td_occupant, tdp->td_occupant_name, XDD_OCCUPANT_TYPE_TARGET, (void *)tdp);
@@ -129,6 +133,46 @@ xdd_calculate_xfer_info(target_data_t *tdp) {
 	// The following calculates the number of I/O requests (numreqs) to issue to a "target"
 	// This value represents the total number of I/O operations that will be performed on this target.
 	/* Now lets get down to business... */
+	// Block checksums need room at the end of each block
+	if ((tdp->td_target_options & TO_VERIFY_CHECKSUM) && (tdp->td_block_size < XDD_CHECKSUM_MIN_BLOCK_SIZE)) {
+		fprintf(xgp->errout,"%s: xdd_calculate_xfer_info: Target %d: WARNING: Block size of %d is too small for checksums - the block size must be at least %d bytes - checksums are not used\n",
+			xgp->progname, tdp->td_target_number, tdp->td_block_size, XDD_CHECKSUM_MIN_BLOCK_SIZE);
+		tdp->td_target_options &= ~TO_VERIFY_CHECKSUM;
+	}
+	// A replay takes the operations, their sizes and the number of them from the trace
+	if (tdp->td_replayp) {
+		if (tdp->td_target_options & TO_ENDTOEND) {
+			fprintf(xgp->errout,"%s: xdd_calculate_xfer_info: Target %d: WARNING: Replay is not used for End-to-End operations\n",
+				xgp->progname, tdp->td_target_number);
+			tdp->td_replayp = NULL;
+		} else {
+			if (tdp->td_rsmp) {
+				fprintf(xgp->errout,"%s: xdd_calculate_xfer_info: Target %d: WARNING: The request size mix is not used when a trace is replayed\n",
+					xgp->progname, tdp->td_target_number);
+				tdp->td_rsmp = NULL;
+			}
+			if (xint_replay_setup(tdp) < 0) {
+				tdp->td_target_bytes_to_xfer_per_pass = 0;
+				return;
+			}
+			tdp->td_xfer_size = tdp->td_reqsize * tdp->td_block_size;
+			tdp->td_numreqs = tdp->td_replayp->replay_ops;
+			tdp->td_target_bytes_to_xfer_per_pass = tdp->td_replayp->replay_bytes;
+			tdp->td_target_ops = tdp->td_replayp->replay_ops;
+			return;
+		}
+	}
+	// A request size mix sets the request size to the largest of its sizes
+	if (tdp->td_rsmp) {
+		if (tdp->td_target_options & TO_ENDTOEND) {
+			fprintf(xgp->errout,"%s: xdd_calculate_xfer_info: Target %d: WARNING: The request size mix is not used for End-to-End operations\n",
+				xgp->progname, tdp->td_target_number);
+			tdp->td_rsmp = NULL;
+		} else if (xint_reqsize_mix_setup(tdp) < 0) {
+			tdp->td_target_bytes_to_xfer_per_pass = 0;
+			return;
+		}
+	}
 	tdp->td_xfer_size = tdp->td_reqsize * tdp->td_block_size;
 	if (tdp->td_xfer_size == 0) {
 		fprintf(xgp->errout,"%s: xdd_calculate_xfer_info: ALERT! iothread for target %d has an iosize of 0, reqsize of %d, blocksize of %d\n",
@@ -137,7 +181,9 @@ xdd_calculate_xfer_info(target_data_t *tdp) {
 		tdp->td_target_bytes_to_xfer_per_pass = 0;
 		return;
 	}
-	if (tdp->td_numreqs) 
+	if (tdp->td_numreqs && tdp->td_rsmp) 
+		tdp->td_target_bytes_to_xfer_per_pass = xint_reqsize_mix_bytes(tdp, tdp->td_numreqs);
+	else if (tdp->td_numreqs) 
 		tdp->td_target_bytes_to_xfer_per_pass = (uint64_t)(tdp->td_numreqs * tdp->td_xfer_size);
 	else if (tdp->td_bytes)
 		tdp->td_target_bytes_to_xfer_per_pass = (uint64_t)tdp->td_bytes;
@@ -163,6 +209,12 @@ xdd_calculate_xfer_info(target_data_t *tdp) {
 		}
 	}
 
+	// With a request size mix the sizes of the operations are added up until there are enough bytes
+	if (tdp->td_rsmp) {
+		tdp->td_target_ops = xint_reqsize_mix_ops(tdp, tdp->td_target_bytes_to_xfer_per_pass);
+		return;
+	}
+
 	// This calculates the number of iosize (or smaller) operations that need to be performed. 
 	tdp->td_target_ops = tdp->td_target_bytes_to_xfer_per_pass / tdp->td_xfer_size;
 
@@ -201,6 +253,7 @@ xdd_create_worker_data(target_data_t *tdp, int32_t q) {
 	wdp->wd_next_wdp = NULL; 
 	wdp->wd_worker_number = q;
 	wdp->wd_sgiop = NULL;
+	wdp->wd_numa_node = XINT_NUMA_OFF;
         
 	if (tdp->td_target_options & TO_SGIO) {
 #if HAVE_SCSI_SG_H
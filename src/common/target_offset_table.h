@@ -33,73 +33,40 @@
 // The tot_entries are assigned based on the block number being processed.
 // The tot_entry number is the block number mod the size of the block table.
 //
-// Each Worker Thread Data structure contains a tot_wait structure. The
-// tot_wait structure contains the condition variable that is waited on
-// by a Worker Thread that needs to use a particular tot_entry. 
-// In the event that more than one Worker Thread needs to use a specific
-// tot_entry, the tot_wait structures of each Worker Thread will be chained
-// together with the tot_entry being the anchor of the chain.
+// When -ordering serial or loose is in effect the TOT is also used to 
+// hand each op off to the next one. Each tot_entry holds a sequence
+// number, tot_sequence, which is set to (op number + 1) by the Worker
+// Thread that releases the op owning that entry. The Worker Thread doing
+// op N waits until the entry for op N-1 holds N. Together the entries form
+// a sliding window of completed sequence numbers that is updated with
+// atomic stores and no locks.
 //
-// +----------------+
-// | TOT ENTRY      |
-// |    tot_mutex   |  +-------------------+
-// |    tot_waitp----->| TOT WAIT Worker 0 |  +-------------------+
-// |     :          |  |   totw_nextp-------->| TOT WAIT Worker 2 |
-// +----------------+  |   totw_condition  |  |   totw_nextp=0    |
-//                     +-------------------+  |   totw_condition  |
-//                                            +-------------------+
-// The purpose of the TOT WAIT chain is to prevent TOT Collisions which
-// is the situation when one Worker Thread has "ownership" of a specific
-// tot_entry and a second Worker Thread needs to use it. This TOT WAIT
-// chain forces any subsequent Worker Threads to wait until the 
-// current Worker Thread completes its I/O operation and releases the
-// specific tot_entry.
+// +------------------+   +------------------+   +------------------+
+// | TOT ENTRY 0      |   | TOT ENTRY 1      |   | TOT ENTRY 2      |
+// |  tot_sequence=1  |   |  tot_sequence=2  |   |  tot_sequence=0  | ...
+// |  tot_waiters=0   |   |  tot_waiters=0   |   |  tot_waiters=1   |
+// +------------------+   +------------------+   +------------------+
+//   op 0 released          op 1 released          op 2 in progress,
+//                                                 op 3 is waiting
 //
-// For example, consider the following, a target with 4 worker threads.
-// For the sake of aregument, say the TOT has only 4 enties.
-//     t=0: Worker0 is assigned to write block0 of a target tot_entry=0
-//     t=1: Worker1 is assigned to write block1 of a target tot_entry=1
-//     t=2: Worker2 is assigned to write block1 of a target tot_entry=2
-//     t=3: Worker3 is assigned to write block1 of a target tot_entry=3
-//      :
-//      :
-//     t=75 Worker0 completes block0, now assigned block 4 tot_entry 0
-//      :
-//     t=77 Worker2 completes block2, now assigned block 5 tot_entry 1
-//      :
-//     t=79 Worker0 completes block4, now assigned block 6 tot_entry 2
-//      :
-// The problem comes at time t=77 when Worker2 tries to get ownership
-// of tot_entry 1 which is currently owned by Worker1. At this point 
-// Worker2 will have to wait for Worker1 to complete. 
+// A Worker Thread that finds its predecessor has not been released yet
+// spins for a short while. After that it increments tot_waiters and
+// sleeps in a futex on tot_sequence. The releasing Worker Thread only
+// calls into the kernel to wake it when tot_waiters is non-zero.
 //
-// In a real-world workload, some Worker Threads get starved for cycles
-// and take an inordinate amount of time to complete. A starved Worker
-// Thread can be thousands of blocks behind all the other Worker Threads.
-// So, for example, Worker1 could be trying to process block 1 but 
-// because it is getting starved, the other Worker Threads could be
-// processing block numbers in the thousands (if there were no 
-// mechanism to prevent it).
+// Every entry is reused once every tot_entries ops. tot_entries is much
+// larger than the queue depth, so no two ops in flight ever need the same
+// entry.
+//
+// The tot_entry also records the most recent op to use it - the byte
+// offset, size, worker numbers and time stamps - for the interactive
+// "show tot" command.
 //
-#define TOT_ENTRY_AVAILABLE 1
-#define TOT_ENTRY_UNAVAILABLE 0
-/**
- * The Target Offset Table WAIT structure 
- * There is one of these per worker thread.
- */
-struct tot_wait {
-	struct tot_wait 		*totw_nextp;	// Pointer to the next tot_wait 
-	struct xint_worker_data	*totw_wdp;		// Pointer to the Worker that owns this tot_wait
-    pthread_cond_t 			totw_condition; 
-    int 					totw_is_released;
-	
-};
-typedef struct tot_wait tot_wait_t;
-
 /** typedef unsigned long long iotimer_t; */
 struct tot_entry {
-    pthread_mutex_t tot_mutex;		// Mutex that is locked when updating items in this entry
-	struct	tot_wait	*tot_waitp;			// Pointer to the first tot_wait struct in the chain.
+    pthread_mutex_t tot_mutex;		// Mutex that is locked by tot_update() when updating items in this entry
+	uint32_t	tot_sequence;				// (Op number + 1) of the last op released through this entry - also the futex word
+	uint32_t	tot_waiters;				// Number of Worker Threads sleeping on tot_sequence
     nclk_t tot_wait_ts;						// Time that another Worker Thread starts to wait on this
     nclk_t tot_post_ts;						// Time that the responsible Worker Thread posts this semaphore
     nclk_t tot_update_ts;					// Time that the responsible Worker Thread updates the byte_location and io_size
@@ -109,7 +76,6 @@ struct tot_entry {
     int32_t tot_wait_worker_thread_number;	// Number of the Worker Thread that is waiting for this TOT entry to be posted
     int32_t tot_post_worker_thread_number;	// Number of the Worker Thread that posted this TOT entry 
     int32_t tot_update_worker_thread_number;// Number of the Worker Thread that last updated this TOT Entry
-	int32_t	tot_status;						// Either TOT_ENTRY_AVAILABLE or TOT_ENTRY_UNAVAILABLE
 };
 typedef struct tot_entry tot_entry_t;
 
@@ -15,6 +15,7 @@
  * operations during an xdd run.
  */
 #include "xint.h"
+#include <sys/mman.h>
 
 /*----------------------------------------------------------------------------*/
 /* xdd_ts_overhead() - determine time stamp overhead
@@ -48,7 +49,8 @@ xdd_ts_setup(target_data_t *tdp) {
 	nclk_t		cycleval; /* resolution of the clock in nanoseconds per ticl */
 	time_t 		t;  /* Time */
 	size_t 	    tt_entries; /* number of entries in the time stamp table */
-	int32_t 	tt_bytes; /* size of time stamp table in bytes */
+	int64_t 	tt_bytes; /* size of time stamp table in bytes */
+	int64_t 	alloc_bytes; /* number of bytes actually allocated for the table */
 	int32_t		ts_filename_size; // Number of bytes in the size of the file name
 
 
@@ -68,7 +70,8 @@ xdd_ts_setup(target_data_t *tdp) {
 
 	/* Calculate size of the time stamp table and malloc it */
 	tt_entries = tsp->ts_size; 
-	if (tt_entries < ((tdp->td_planp->passes * tdp->td_target_ops) + tdp->td_queue_depth)) { /* Display a NOTICE message if ts_wrap or ts_oneshot have not been specified to compensate for a short time stamp buffer */
+	if ((tsp->ts_options & TS_STREAM) == 0 &&
+		(tt_entries < ((tdp->td_planp->passes * tdp->td_target_ops) + tdp->td_queue_depth))) { /* Display a NOTICE message if ts_wrap or ts_oneshot have not been specified to compensate for a short time stamp buffer */
 		if (((tsp->ts_options & TS_WRAP) == 0) &&
 			((tsp->ts_options & TS_ONESHOT) == 0)) {
 			fprintf(xgp->errout,"%s: ***NOTICE*** The size specified for timestamp table for target %d is too small - enabling time stamp wrapping to compensate\n",xgp->progname,tdp->td_target_number);
@@ -77,25 +80,29 @@ xdd_ts_setup(target_data_t *tdp) {
 		}
 	}
 	/* calculate the total size in bytes of the time stamp table */
-	tt_bytes = (int)((sizeof(struct xdd_ts_header)) + (tt_entries * sizeof(struct xdd_ts_tte)));
+	tt_bytes = (int64_t)((sizeof(struct xdd_ts_header)) + (tt_entries * sizeof(struct xdd_ts_tte)));
+	/* When streaming, the entries live on the Worker Thread trace rings so only the header is needed */
+	if (tsp->ts_options & TS_STREAM) 
+		alloc_bytes = sizeof(struct xdd_ts_header);
+	else alloc_bytes = tt_bytes;
 #if (LINUX || SOLARIS || AIX || DARWIN)
-	tdp->td_ts_table.ts_hdrp = (struct xdd_ts_header *)valloc(tt_bytes);
+	tdp->td_ts_table.ts_hdrp = (struct xdd_ts_header *)valloc(alloc_bytes);
 if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_setup: Target: %d: Worker: -: TS INITIALIZATION td_ts_table.ts_hdrp: %p: %d: entries\n ", (long long int)pclk_now(),tdp->td_target_number,tdp->td_ts_table.ts_hdrp,(int)tt_entries);
 #else
-	tdp->td_ts_table.ts_hdrp = (struct xdd_ts_header *)malloc(tt_bytes);
+	tdp->td_ts_table.ts_hdrp = (struct xdd_ts_header *)malloc(alloc_bytes);
 #endif
 	if (tdp->td_ts_table.ts_hdrp == 0) {
-		fprintf(xgp->errout,"%s: xdd_ts_setup: Target %d: ERROR: Cannot allocate %d bytes of memory for timestamp table\n",
-			xgp->progname,tdp->td_target_number, tt_bytes);
+		fprintf(xgp->errout,"%s: xdd_ts_setup: Target %d: ERROR: Cannot allocate %lld bytes of memory for timestamp table\n",
+			xgp->progname,tdp->td_target_number, (long long)alloc_bytes);
 		fflush(xgp->errout);
 		perror("Reason");
 		tsp->ts_options &= ~TS_ON;
 		return;
 	}
 	/* Lock the time stamp table in memory */
-	xdd_lock_memory((unsigned char *)tdp->td_ts_table.ts_hdrp, tt_bytes, "TIMESTAMP");
+	xdd_lock_memory((unsigned char *)tdp->td_ts_table.ts_hdrp, alloc_bytes, "TIMESTAMP");
 	/* clear everything out of the trace table */
-	memset(tdp->td_ts_table.ts_hdrp,0, tt_bytes);
+	memset(tdp->td_ts_table.ts_hdrp,0, alloc_bytes);
 	/* get access to the high-res clock*/
 	nclk_initialize(&cycleval);
 	if (cycleval == NCLK_BAD) {
@@ -107,7 +114,9 @@ if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_se
 	xdd_ts_overhead(tdp->td_ts_table.ts_hdrp);
 
         /* Set the XDD Version into the timestamp header */
-        tdp->td_ts_table.ts_hdrp->tsh_magic = 0xDEADBEEF;
+        if (tsp->ts_options & TS_STREAM)
+            tdp->td_ts_table.ts_hdrp->tsh_magic = XDD_TS_STREAM_MAGIC;
+        else tdp->td_ts_table.ts_hdrp->tsh_magic = XDD_TS_MAGIC;
         snprintf(tdp->td_ts_table.ts_hdrp->tsh_version, sizeof(tdp->td_ts_table.ts_hdrp->tsh_version), "%s", PACKAGE_STRING);
         
 	/* init entries in the trace table header */
@@ -131,6 +140,9 @@ if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_se
 	tdp->td_ts_table.ts_hdrp->tsh_tte_indx = 0;
 	tdp->td_ts_table.ts_hdrp->tsh_delta = tdp->td_planp->gts_delta;
 	tsp->ts_current_entry = 0;
+	tsp->ts_stream_fd = -1;
+	tsp->ts_stream_entries = 0;
+	tsp->ts_flusher_started = 0;
 
 	// Generate the name(s) of the ASCII and/or binary output files
 
@@ -166,6 +178,403 @@ if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_se
 if (xgp->global_options & GO_DEBUG_TS) xdd_show_ts_table(&tdp->td_ts_table, tdp->td_target_number);
 	return;
 } /* end of xdd_ts_setup() */
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_assign_entry() - Assign a time stamp table entry to the operation 
+ * that is about to be handed to the specified Worker Thread, fill in the 
+ * fields that are common to all operations and return a pointer to the entry.
+ * When streaming, the entry is the Worker Thread's own wd_ts_tte and it is put
+ * on the trace ring by xdd_ts_commit_entry() when the operation is complete.
+ * This is called by the Target Thread.
+ */
+xdd_ts_tte_t *
+xdd_ts_assign_entry(target_data_t *tdp, worker_data_t *wdp) {
+	xint_timestamp_t	*tsp;	// Pointer to the time stamp table info
+	xdd_ts_tte_t		*ttep;	// Pointer to the entry for this operation
+
+
+	tsp = &tdp->td_ts_table;
+	wdp->wd_ts_entry = tsp->ts_current_entry;	
+	if (tsp->ts_options & TS_STREAM) {
+		ttep = &wdp->wd_ts_tte;
+		memset(ttep, 0, sizeof(*ttep));
+		wdp->wd_ts_pending = 1;
+	} else ttep = &tsp->ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+	wdp->wd_ts_ttep = ttep;
+	tsp->ts_current_entry++;
+	if (tsp->ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
+		if (tsp->ts_current_entry == tsp->ts_size)
+			tsp->ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
+	} else if (tsp->ts_options & TS_WRAP) {
+		tsp->ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
+	}
+	ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
+	ttep->tte_worker_thread_number = wdp->wd_worker_number;
+	ttep->tte_thread_id = wdp->wd_thread_id;
+	return(ttep);
+} /* end of xdd_ts_assign_entry() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_flusher_wake() - Wake up the flusher thread if it is sleeping
+ */
+static void
+xdd_ts_flusher_wake(xint_timestamp_t *tsp) {
+	__atomic_add_fetch(&tsp->ts_flusher_signal, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&tsp->ts_flusher_waiting, __ATOMIC_SEQ_CST))
+		xint_futex_wake(&tsp->ts_flusher_signal, 1);
+} /* end of xdd_ts_flusher_wake() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_commit_entry() - Put the time stamp entry of the operation that the
+ * specified Worker Thread just finished on its trace ring.
+ * This does nothing unless the TS_STREAM option assigned an entry to this
+ * operation. If the ring is full then the Worker Thread waits for the flusher
+ * thread to make room rather than dropping the entry.
+ * This is called by the Worker Thread (or the Target Thread for io_uring) 
+ * before the Worker Thread is made available for another task.
+ */
+void
+xdd_ts_commit_entry(worker_data_t *wdp) {
+	xint_timestamp_t	*tsp;	// Pointer to the time stamp table info
+	xint_ts_ring_t		*ringp;	// Pointer to the trace ring of this Worker Thread
+	uint32_t			head;	// Snapshot of the flusher position
+	uint32_t			tail;	// Next entry to fill in
+	int					spin;	// Number of polls before sleeping
+	int					spin_limit;	// Number of polls allowed before sleeping
+
+
+	if (wdp->wd_ts_pending == 0)
+		return;
+	wdp->wd_ts_pending = 0;
+	tsp = &wdp->wd_tdp->td_ts_table;
+	ringp = wdp->wd_ts_ringp;
+	if (ringp == NULL) 
+		return;
+
+	tail = ringp->tr_tail;
+	head = __atomic_load_n(&ringp->tr_head, __ATOMIC_ACQUIRE);
+	if ((tail - head) > ringp->tr_mask) {
+		// The ring is full - kick the flusher and wait for it to make room
+		ringp->tr_stalls++;
+		xdd_ts_flusher_wake(tsp);
+		spin = 0;
+		spin_limit = xint_handoff_spin_count();
+		while ((tail - head) > ringp->tr_mask) {
+			if (spin < spin_limit) {
+				spin++;
+				XINT_CPU_RELAX();
+			} else {
+				__atomic_store_n(&ringp->tr_waiting, 1, __ATOMIC_SEQ_CST);
+				if (__atomic_load_n(&ringp->tr_head, __ATOMIC_SEQ_CST) == head)
+					xint_futex_wait(&ringp->tr_head, head);
+				__atomic_store_n(&ringp->tr_waiting, 0, __ATOMIC_SEQ_CST);
+			}
+			head = __atomic_load_n(&ringp->tr_head, __ATOMIC_ACQUIRE);
+		}
+	}
+	ringp->tr_entries[tail & ringp->tr_mask] = wdp->wd_ts_tte;
+	__atomic_store_n(&ringp->tr_tail, tail + 1, __ATOMIC_RELEASE);
+
+	// Let the flusher know each time another half of the ring has been filled
+	if (((tail + 1) & (ringp->tr_mask >> 1)) == 0)
+		xdd_ts_flusher_wake(tsp);
+} /* end of xdd_ts_commit_entry() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_write() - Write "nbytes" from "bp" to the streamed timestamp
+ * file, retrying short writes.
+ * Return value is 0 if everything was written or -1 if there was an error.
+ */
+static int32_t
+xdd_ts_stream_write(xint_timestamp_t *tsp, void *bp, size_t nbytes) {
+	ssize_t		status;		// Number of bytes written by one call
+	char		*cp;		// Next byte to write
+
+
+	cp = (char *)bp;
+	while (nbytes > 0) {
+		status = write(tsp->ts_stream_fd, cp, nbytes);
+		if (status < 0) {
+			if (errno == EINTR)
+				continue;
+			return(-1);
+		}
+		cp += status;
+		nbytes -= status;
+	}
+	return(0);
+} /* end of xdd_ts_stream_write() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_drain() - Write every entry that is on the trace rings of the 
+ * Worker Threads of the specified target to the streamed timestamp file.
+ * Return value is the number of entries that were taken off the rings.
+ */
+static int64_t
+xdd_ts_drain(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;		// Pointer to the time stamp table info
+	worker_data_t		*wdp;		// Worker Thread whose ring is being drained
+	xint_ts_ring_t		*ringp;		// Pointer to the trace ring of this Worker Thread
+	uint32_t			head;		// First entry to write
+	uint32_t			tail;		// One past the last entry to write
+	uint32_t			count;		// Number of entries to write
+	uint32_t			first;		// Number of entries before the end of the ring
+	int64_t				drained;	// Number of entries taken off all rings
+	int32_t				status;		// Status of the writes
+
+
+	tsp = &tdp->td_ts_table;
+	drained = 0;
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		ringp = wdp->wd_ts_ringp;
+		if (ringp == NULL)
+			continue;
+		head = ringp->tr_head;
+		tail = __atomic_load_n(&ringp->tr_tail, __ATOMIC_ACQUIRE);
+		if (head == tail)
+			continue;
+		// The entries may wrap around the end of the ring in which case they are written in two pieces
+		count = tail - head;
+		first = (ringp->tr_mask + 1) - (head & ringp->tr_mask);
+		if (first > count)
+			first = count;
+		if (tsp->ts_stream_fd >= 0) {
+			status = xdd_ts_stream_write(tsp, &ringp->tr_entries[head & ringp->tr_mask], first * sizeof(xdd_ts_tte_t));
+			if ((status == 0) && (count > first))
+				status = xdd_ts_stream_write(tsp, &ringp->tr_entries[0], (count - first) * sizeof(xdd_ts_tte_t));
+			if (status) {
+				// Keep draining so that the Worker Threads never block but throw the entries away
+				fprintf(xgp->errout,"%s: xdd_ts_drain: Target %d: ERROR: Cannot write to timestamp binary output file %s - no more entries will be written\n",
+					xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+				perror("Reason");
+				close(tsp->ts_stream_fd);
+				tsp->ts_stream_fd = -1;
+			} else tsp->ts_stream_entries += count;
+		}
+
+		// Give the space back to the Worker Thread and wake it up if it is waiting for it
+		__atomic_store_n(&ringp->tr_head, tail, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&ringp->tr_waiting, __ATOMIC_SEQ_CST))
+			xint_futex_wake(&ringp->tr_head, 1);
+		drained += count;
+	}
+	return(drained);
+} /* end of xdd_ts_drain() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_flusher() - The flusher thread for one target. It drains the trace
+ * rings of the Worker Threads whenever one of them wakes it up and exits once
+ * it has been told to stop and the rings are empty.
+ */
+static void *
+xdd_ts_flusher(void *pin) {
+	target_data_t		*tdp;		// Target whose rings are being drained
+	xint_timestamp_t	*tsp;		// Pointer to the time stamp table info
+	uint32_t			signal;		// Snapshot of the futex word
+
+
+	tdp = (target_data_t *)pin;
+	tsp = &tdp->td_ts_table;
+	while (1) {
+		if (xdd_ts_drain(tdp))
+			continue;
+		if (__atomic_load_n(&tsp->ts_flusher_stop, __ATOMIC_SEQ_CST)) {
+			// One more pass in case something was put on a ring after the last drain
+			if (xdd_ts_drain(tdp) == 0)
+				break;
+			continue;
+		}
+		signal = __atomic_load_n(&tsp->ts_flusher_signal, __ATOMIC_SEQ_CST);
+		__atomic_store_n(&tsp->ts_flusher_waiting, 1, __ATOMIC_SEQ_CST);
+		if ((xdd_ts_drain(tdp) == 0) && (__atomic_load_n(&tsp->ts_flusher_stop, __ATOMIC_SEQ_CST) == 0))
+			xint_futex_wait(&tsp->ts_flusher_signal, signal);
+		__atomic_store_n(&tsp->ts_flusher_waiting, 0, __ATOMIC_SEQ_CST);
+	}
+	return(0);
+} /* end of xdd_ts_flusher() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_start() - Allocate the Worker Thread trace rings, create the
+ * binary timestamp file, write the header to it and start the flusher thread.
+ * This must be called after the Worker Threads have been created and before
+ * the first task is issued. It does nothing unless the TS_STREAM option is on.
+ * Return value is 0 if everything succeeded or -1 if there was a failure.
+ */
+int32_t
+xdd_ts_stream_start(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;		// Pointer to the time stamp table info
+	worker_data_t		*wdp;		// Worker Thread that gets a ring
+	xint_ts_ring_t		*ringp;		// Pointer to a trace ring
+	int32_t				status;		// Status of subroutine calls
+
+
+	tsp = &tdp->td_ts_table;
+	if (((tsp->ts_options & TS_ON) == 0) || ((tsp->ts_options & TS_STREAM) == 0))
+		return(0);
+
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		ringp = malloc(sizeof(xint_ts_ring_t));
+		if (ringp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot allocate %d bytes of memory for a timestamp trace ring\n",
+				xgp->progname, tdp->td_target_number, (int)sizeof(xint_ts_ring_t));
+			return(-1);
+		}
+		memset(ringp, 0, sizeof(xint_ts_ring_t));
+		ringp->tr_mask = XDD_TS_RING_ENTRIES - 1;
+		ringp->tr_entries = malloc(XDD_TS_RING_ENTRIES * sizeof(xdd_ts_tte_t));
+		if (ringp->tr_entries == NULL) {
+			fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot allocate %d bytes of memory for a timestamp trace ring\n",
+				xgp->progname, tdp->td_target_number, (int)(XDD_TS_RING_ENTRIES * sizeof(xdd_ts_tte_t)));
+			free(ringp);
+			return(-1);
+		}
+		wdp->wd_ts_ringp = ringp;
+		wdp->wd_ts_pending = 0;
+	}
+
+	tsp->ts_stream_fd = open(tsp->ts_binary_filename, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+	if (tsp->ts_stream_fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot open timestamp binary output file %s\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		perror("Reason");
+		return(-1);
+	}
+	// The header is written again with the final number of entries when the run is done
+	status = xdd_ts_stream_write(tsp, tsp->ts_hdrp, offsetof(xdd_ts_header_t, tsh_tte));
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot write timestamp binary output file %s\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		perror("Reason");
+		return(-1);
+	}
+	tsp->ts_stream_entries = 0;
+	tsp->ts_flusher_signal = 0;
+	tsp->ts_flusher_waiting = 0;
+	tsp->ts_flusher_stop = 0;
+	status = pthread_create(&tsp->ts_flusher_thread, NULL, xdd_ts_flusher, tdp);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot create the timestamp flusher thread, status=%d\n",
+			xgp->progname, tdp->td_target_number, status);
+		return(-1);
+	}
+	tsp->ts_flusher_started = 1;
+if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_stream_start: Target: %d: Worker: -: streaming to %s with %d entries per Worker Thread\n ", (long long int)pclk_now(),tdp->td_target_number,tsp->ts_binary_filename,XDD_TS_RING_ENTRIES);
+	return(0);
+} /* end of xdd_ts_stream_start() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_stop() - Stop the flusher thread after it has written out
+ * everything on the trace rings, put the final number of entries in the 
+ * header of the binary timestamp file and close it.
+ * This must be called after the last operation of the run has completed.
+ */
+void
+xdd_ts_stream_stop(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;		// Pointer to the time stamp table info
+	worker_data_t		*wdp;		// Worker Thread whose ring is freed
+	int64_t				stalls;		// Number of times a Worker Thread waited for the flusher
+
+
+	tsp = &tdp->td_ts_table;
+	if (tsp->ts_flusher_started == 0)
+		return;
+	__atomic_store_n(&tsp->ts_flusher_stop, 1, __ATOMIC_SEQ_CST);
+	xdd_ts_flusher_wake(tsp);
+	pthread_join(tsp->ts_flusher_thread, NULL);
+	tsp->ts_flusher_started = 0;
+
+	tsp->ts_hdrp->tsh_numents = tsp->ts_stream_entries;
+	tsp->ts_hdrp->tsh_tte_indx = tsp->ts_stream_entries;
+	if (tsp->ts_stream_fd >= 0) {
+		if (pwrite(tsp->ts_stream_fd, tsp->ts_hdrp, offsetof(xdd_ts_header_t, tsh_tte), 0) < 0) {
+			fprintf(xgp->errout,"%s: xdd_ts_stream_stop: Target %d: ERROR: Cannot update the header of timestamp binary output file %s\n",
+				xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+			perror("Reason");
+		}
+		close(tsp->ts_stream_fd);
+		tsp->ts_stream_fd = -1;
+	}
+
+	stalls = 0;
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		if (wdp->wd_ts_ringp == NULL)
+			continue;
+		stalls += wdp->wd_ts_ringp->tr_stalls;
+		free(wdp->wd_ts_ringp->tr_entries);
+		free(wdp->wd_ts_ringp);
+		wdp->wd_ts_ringp = NULL;
+	}
+if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_stream_stop: Target: %d: Worker: -: %lld entries streamed, Worker Threads waited for the flusher %lld times\n ", (long long int)pclk_now(),tdp->td_target_number,(long long int)tsp->ts_stream_entries,(long long int)stalls);
+} /* end of xdd_ts_stream_stop() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_compare_entries() - qsort() comparison routine that puts streamed 
+ * time stamp entries back in the order of the time stamp table: by pass, then
+ * by operation number with the End-of-File entries at the end of each pass.
+ */
+static int
+xdd_ts_compare_entries(const void *a, const void *b) {
+	const xdd_ts_tte_t	*ap = (const xdd_ts_tte_t *)a;
+	const xdd_ts_tte_t	*bp = (const xdd_ts_tte_t *)b;
+	int					a_eof, b_eof;
+
+
+	if (ap->tte_pass_number != bp->tte_pass_number)
+		return((ap->tte_pass_number < bp->tte_pass_number) ? -1 : 1);
+	a_eof = (ap->tte_op_type == TASK_OP_TYPE_EOF);
+	b_eof = (bp->tte_op_type == TASK_OP_TYPE_EOF);
+	if (a_eof != b_eof)
+		return(a_eof - b_eof);
+	if (ap->tte_op_number != bp->tte_op_number)
+		return((ap->tte_op_number < bp->tte_op_number) ? -1 : 1);
+	return(0);
+} /* end of xdd_ts_compare_entries() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_map() - Map the streamed timestamp file of a target so that
+ * it can be used in place of the in-memory time stamp table. The mapping is
+ * private so the entries are sorted into operation order without changing 
+ * the file. The number of entries is taken from the size of the file.
+ * Return value is a pointer to the mapped header or NULL if there was an 
+ * error. The caller must munmap() "*map_bytesp" bytes when it is done.
+ */
+static xdd_ts_header_t *
+xdd_ts_stream_map(target_data_t *tdp, size_t *map_bytesp) {
+	xint_timestamp_t	*tsp;		// Pointer to the time stamp table info
+	xdd_ts_header_t		*ts_hdrp;	// The mapped header
+	struct stat			statbuf;	// Size of the file
+	int					fd;			// File descriptor of the streamed file
+	int64_t				entries;	// Number of complete entries in the file
+
+
+	tsp = &tdp->td_ts_table;
+	fd = open(tsp->ts_binary_filename, O_RDONLY);
+	if (fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_map: Target %d: ERROR: Cannot open timestamp binary file %s\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		perror("Reason");
+		return(NULL);
+	}
+	if ((fstat(fd, &statbuf) < 0) || ((size_t)statbuf.st_size < offsetof(xdd_ts_header_t, tsh_tte))) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_map: Target %d: ERROR: Timestamp binary file %s is too short\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		close(fd);
+		return(NULL);
+	}
+	ts_hdrp = mmap(NULL, statbuf.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (ts_hdrp == MAP_FAILED) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_map: Target %d: ERROR: Cannot map timestamp binary file %s\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		perror("Reason");
+		return(NULL);
+	}
+	entries = (statbuf.st_size - offsetof(xdd_ts_header_t, tsh_tte)) / sizeof(xdd_ts_tte_t);
+	ts_hdrp->tsh_numents = entries;
+	qsort(ts_hdrp->tsh_tte, entries, sizeof(xdd_ts_tte_t), xdd_ts_compare_entries);
+	*map_bytesp = statbuf.st_size;
+	return(ts_hdrp);
+} /* end of xdd_ts_stream_map() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_ts_write() - write the timestamp entried to a file. 
  */
@@ -182,6 +591,12 @@ xdd_ts_write(target_data_t *tdp) {
 	ts_hdrp = tsp->ts_hdrp;
 	if ((tsp->ts_options & TS_DUMP) == 0)  /* dump only if DUMP was specified */
 		return;
+	if (tsp->ts_options & TS_STREAM) { /* the entries were written during the run */
+		fprintf(xgp->output,"Timestamp entries streamed to %s - %lld entries, %lld bytes\n",
+			tsp->ts_binary_filename, (long long)tsp->ts_stream_entries,
+			(long long)(offsetof(xdd_ts_header_t, tsh_tte) + (tsp->ts_stream_entries * sizeof(struct xdd_ts_tte))));
+		return;
+	}
 	ttfd = open(tsp->ts_binary_filename,O_WRONLY|O_CREAT,0666);
 	if (ttfd < 0) {
 		fprintf(xgp->errout,"%s: cannot open timestamp table binary output file %s\n", xgp->progname,tsp->ts_binary_filename);
@@ -253,6 +668,7 @@ xdd_ts_reports(target_data_t *tdp) {
     char  *opc;  /* pointer to the operation string */
     char  opc2[8];
 	FILE	*tsfp;	// The output file pointer
+    size_t  map_bytes; /* size of the mapped streamed file */
 
 	tsp = &tdp->td_ts_table;
 	tsfp = tsp->ts_tsfp;
@@ -263,6 +679,13 @@ xdd_ts_reports(target_data_t *tdp) {
 #endif
     if(tsp->ts_options & TS_SUPPRESS_OUTPUT)
 	return;
+    /* Streamed entries are read back from the binary file */
+    map_bytes = 0;
+    if (tsp->ts_options & TS_STREAM) {
+	ts_hdrp = xdd_ts_stream_map(tdp, &map_bytes);
+	if (ts_hdrp == NULL)
+	    return;
+    }
     if (!(tdp->td_current_state & TARGET_CURRENT_STATE_PASS_COMPLETE)) {
 	fprintf(xgp->errout,"%s: ALERT! ts_reports: target %d has not yet completed! Results beyond this point are unpredictable!\n",
 		xgp->progname, tdp->td_target_number);
@@ -299,6 +722,8 @@ xdd_ts_reports(target_data_t *tdp) {
 		xgp->progname);
 	fflush(xgp->errout);
 	perror("Reason");
+	if (map_bytes)
+	    munmap(ts_hdrp, map_bytes);
 	return;
     }
     if (tsp->ts_options & TS_DETAILED) { /* Generate the detailed and summary report */
@@ -542,6 +967,8 @@ xdd_ts_reports(target_data_t *tdp) {
     fflush(tsfp);
     if (tsfp != stdout)
 	fclose(tsfp);
+    if (map_bytes)
+	munmap(ts_hdrp, map_bytes);
 #ifdef WIN32 /* Allow the next thread to write its file */
     ReleaseMutex(tsp->ts_serializer_mutex);
 #endif
@@ -0,0 +1,59 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+
+// ------------------ Arrival stuff --------------------------------------------------
+// The following structure is used by the -arrivals option
+// With open-loop arrivals the time at which each operation is due is drawn
+// from an arrival schedule that does not depend on how fast the Worker Threads
+// complete. The Target Thread keeps the arrivals that are due but not yet
+// issued in a FIFO: its length when an operation is issued is the backlog and
+// the latency of the operation is measured from the time at its head rather
+// than from the time a Worker Thread actually started it.
+struct xint_arrival {
+		double				arrival_rate;		// Mean number of operations per second
+		int32_t				arrival_burst;		// Number of operations that arrive together for the bursty type
+		uint32_t      		arrival_type; 		// Arrival type
+#define XINT_ARRIVAL_CONSTANT	0x00000001  	// Evenly spaced arrivals
+#define XINT_ARRIVAL_POISSON	0x00000002  	// Exponentially distributed time between arrivals
+#define XINT_ARRIVAL_BURSTY		0x00000004  	// Bursts of arrival_burst operations with Poisson arrivals of the bursts
+		int32_t				arrival_started;	// Set when the first operation of the pass has been issued
+		nclk_t				arrival_start;		// Time the first operation of this pass was issued
+		double				arrival_next;		// Time of the next arrival that is not in the FIFO yet in nanoseconds after arrival_start
+		int32_t				arrival_burst_left;	// Number of arrivals left in the current burst
+		nclk_t				arrival_intended;	// Absolute time at which the operation being issued was due
+		nclk_t				*arrival_due;		// FIFO of the absolute times of arrivals that are due but not issued yet
+		int64_t				arrival_due_head;	// Index of the oldest entry in arrival_due
+		int64_t				arrival_due_count;	// Number of entries in arrival_due
+		int64_t				arrival_due_size;	// Number of entries arrival_due can hold
+		unsigned short		arrival_xsubi[3];	// Random number state for the arrival times
+		// Statistics for this pass
+		int64_t				arrival_ops;			// Number of operations issued
+		int64_t				arrival_backlog_max;	// Largest number of arrivals waiting behind an operation as it was issued
+		double				arrival_backlog_sum;	// Sum of the backlog seen by each operation
+		nclk_t				arrival_lag_max;		// Longest time from an arrival to the issue of its operation
+};
+
+#define XINT_DEFAULT_ARRIVAL_BURST		8			// Default number of operations in a burst
+#define XINT_ARRIVAL_DUE_INITIAL		1024		// Initial number of entries in the FIFO of due arrivals
+
+typedef struct xint_arrival xint_arrival_t;
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
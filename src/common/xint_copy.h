@@ -0,0 +1,54 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_COPY_H
+#define XINT_COPY_H
+
+// ------------------ Local copy engine stuff ----------------------------------------
+// The following structure is used by the "-copyfrom" option.
+// The target is the destination of a local copy and each write operation
+// copies the same range of the source file into it inside the kernel, so the
+// data never comes up to user space. The Worker Threads each copy their own
+// range so the file is split across -queuedepth workers.
+// Each range is cloned with the FICLONERANGE ioctl (a reflink that shares the
+// blocks) if the file system can do it, otherwise it is copied with
+// copy_file_range(), otherwise it is read into the I/O buffer and written out.
+// The first time a method fails because the file systems cannot do it the
+// target drops to the next method for the rest of the run. A clone that is
+// refused only for its range (such as an unaligned tail) is copied with the
+// next method and the target keeps cloning.
+struct xint_copy {
+	char				*copy_source;		// Name of the source file
+	int32_t				copy_fd;			// File descriptor of the source file
+	int64_t				copy_source_size;	// Size of the source file when it was last looked at
+	uint32_t			copy_options;		// Options from the -copyfrom option
+#define XINT_COPY_NOCLONE		0x00000001		// Do not try FICLONERANGE
+	int32_t				copy_method;		// Method used to copy the ranges now
+#define XINT_COPY_CLONE			0				// FICLONERANGE
+#define XINT_COPY_OFFLOAD		1				// copy_file_range()
+#define XINT_COPY_READWRITE		2				// pread() into the I/O buffer and pwrite()
+#define XINT_COPY_METHODS		3
+	int64_t				copy_bytes[XINT_COPY_METHODS];	// Number of bytes copied with each method for the whole run
+};
+typedef struct xint_copy xint_copy_t;
+
+#endif // XINT_COPY_H
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -29,6 +29,7 @@
 #define DP_INVERSE_PATTERN             0x0000000000002000ULL  // Apply a 1's compliment to the data pattern 
 #define DP_NAME_PATTERN                0x0000000000004000ULL  // Use the specified name at the beginning of the data pattern
 #define DP_RANDOM_BY_TARGET_PATTERN    0x0000000000008000ULL  // Use random data pattern for write operations, seed by target number
+#define DP_REDUCIBLE_PATTERN           0x0000000000010000ULL  // Blocks that are unique per op with a given compression ratio and dedupe ratio
 
 struct xint_data_pattern {
     // Type of data pattern options to use
@@ -47,8 +48,24 @@ struct xint_data_pattern {
     int32_t data_pattern_name_length;	// Length of the data pattern name string 
     char *data_pattern_filename; 	// Name of a file that contains a data pattern to use 
     int64_t data_pattern_compare_errors;	// Number of content/sequence compare errors from the verify() subroutines
+    // The reducible data pattern
+    double data_pattern_compress_ratio;	// Compression ratio of each block
+    double data_pattern_dedupe_ratio;	// Number of blocks written for each unique block
+    int32_t data_pattern_random_length;	// Number of random bytes at the start of each block - the rest are 0's
+    uint64_t data_pattern_unique_limit;	// A block is unique if its key is below this - otherwise it is a copy of a library block
+    unsigned char *data_pattern_library;	// Blocks that the duplicate blocks are copied from
+    int32_t data_pattern_library_blocks;	// Number of blocks in the library
 }; 
 typedef struct xint_data_pattern xint_data_pattern_t;
+
+// Block checksums for "-verify checksum"
+#define XDD_CHECKSUM_SIZE				4	// Number of bytes at the end of each block that hold its CRC32C
+#define XDD_CHECKSUM_MIN_BLOCK_SIZE		16	// Smallest block size that can hold a checksum
+
+// Block library for the reducible data pattern
+#define XDD_DP_RANDOM_SEED				72058				// Seed of the random data patterns
+#define XDD_DP_LIBRARY_BLOCKS			1024				// Largest number of blocks in the library
+#define XDD_DP_LIBRARY_BYTES			(16*1024*1024)		// Largest size of the library in bytes
 #ifdef XDD_DATA_PATTERN
 /*----------------------------------------------------------------------------*/
 /* 
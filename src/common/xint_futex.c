@@ -0,0 +1,96 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the low-level wait/wake primitives used by the
+ * lock-free synchronization code. On Linux these are thin wrappers around
+ * the futex system call. On other systems the wait degrades to a short sleep
+ * and the wake is a no-op, so callers must always re-check their condition
+ * after xint_futex_wait() returns.
+ */
+#include "xint.h"
+#if (LINUX)
+#include <linux/futex.h>
+#endif
+
+// Number of times the handoff waits poll before they sleep - see xint_handoff_spin_init()
+static int	xint_handoff_spin;
+
+/*----------------------------------------------------------------------------*/
+/* xint_handoff_spin_init() - Decide how long the handoff waits spin before 
+ * they sleep in a futex. "threads" is the number of threads that hand work
+ * to each other during the run. Spinning only pays off when the thread being 
+ * waited for is running on another processor, so the waits only spin when 
+ * there are more online processors than threads. Otherwise the spinning 
+ * thread would take processor time from the thread it is waiting for.
+ * This is the same rule that xdd_init_barrier() uses for the barriers.
+ */
+void
+xint_handoff_spin_init(int64_t threads) {
+	if (threads < sysconf(_SC_NPROCESSORS_ONLN))
+		xint_handoff_spin = XINT_HANDOFF_SPIN_COUNT;
+	else xint_handoff_spin = 0;
+} // End of xint_handoff_spin_init()
+
+/*----------------------------------------------------------------------------*/
+/* xint_handoff_spin_count() - Return the number of times a handoff wait 
+ * should poll before it sleeps in a futex. This is 0 until 
+ * xint_handoff_spin_init() has been called.
+ */
+int
+xint_handoff_spin_count(void) {
+	return(xint_handoff_spin);
+} // End of xint_handoff_spin_count()
+
+/*----------------------------------------------------------------------------*/
+/* xint_futex_wait() - Block the calling thread as long as the 32-bit word
+ * at "uaddr" still contains "val". 
+ * This may return early for any reason (signals, spurious wakeups) so the caller 
+ * must re-check the condition it is waiting for.
+ */
+void
+xint_futex_wait(uint32_t *uaddr, uint32_t val) {
+#if (LINUX) && defined(SYS_futex)
+	syscall(SYS_futex, uaddr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+#else
+	struct timespec	req;	// Time to sleep before the caller re-checks
+
+
+	if (__atomic_load_n(uaddr, __ATOMIC_ACQUIRE) != val)
+		return;
+	req.tv_sec = 0;
+	req.tv_nsec = XINT_FUTEX_POLL_NSEC;
+	nanosleep(&req, NULL);
+#endif
+} // End of xint_futex_wait()
+
+/*----------------------------------------------------------------------------*/
+/* xint_futex_wake() - Wake up to "count" threads blocked in xint_futex_wait()
+ * on the 32-bit word at "uaddr".
+ */
+void
+xint_futex_wake(uint32_t *uaddr, int32_t count) {
+#if (LINUX) && defined(SYS_futex)
+	syscall(SYS_futex, uaddr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+#endif
+} // End of xint_futex_wake()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
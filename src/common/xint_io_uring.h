@@ -0,0 +1,61 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_IO_URING_H
+#define XINT_IO_URING_H
+
+// ------------------ io_uring I/O engine stuff --------------------------------------
+// The following structure is used by the "-ioengine uring" option.
+// When this engine is selected the Target Thread issues all I/O operations for
+// the target through a single io_uring submission/completion ring pair. 
+// Each Worker Data Struct is used as an I/O "slot" that owns an I/O buffer, a task, 
+// and a set of counters so the existing per-op accounting is unchanged. 
+// The ring pointers are kept as untyped pointers so that this header does not 
+// depend on <linux/io_uring.h>.
+struct xint_io_uring {
+	int32_t				ring_fd;			// File descriptor returned by io_uring_setup()
+	uint32_t			ring_entries;		// Number of entries in the submission queue
+	int32_t				ring_inflight;		// Number of operations submitted but not yet reaped
+	int32_t				ring_to_submit;		// Number of SQEs queued but not yet passed to io_uring_enter()
+	// Submission Queue ring
+	void				*sq_ring_ptr;		// Address of the mmap()ed submission queue ring
+	size_t				sq_ring_size;		// Size of the submission queue ring mapping
+	uint32_t			*sq_head;			// Kernel-owned head index
+	uint32_t			*sq_tail;			// Application-owned tail index
+	uint32_t			*sq_ring_mask;		// Mask to apply to the head/tail indices
+	uint32_t			*sq_array;			// Index array into the SQEs
+	void				*sqes;				// Address of the mmap()ed SQE array
+	size_t				sqes_size;			// Size of the SQE array mapping
+	// Completion Queue ring
+	void				*cq_ring_ptr;		// Address of the mmap()ed completion queue ring (may equal sq_ring_ptr)
+	size_t				cq_ring_size;		// Size of the completion queue ring mapping
+	uint32_t			*cq_head;			// Application-owned head index
+	uint32_t			*cq_tail;			// Kernel-owned tail index
+	uint32_t			*cq_ring_mask;		// Mask to apply to the head/tail indices
+	void				*cqes;				// Address of the CQE array inside the CQ ring
+	// I/O slots
+	struct xint_worker_data	**free_wdp;		// Stack of Worker Data Structs not currently in flight
+	int32_t				free_count;			// Number of entries on the free stack
+};
+typedef struct xint_io_uring xint_io_uring_t;
+
+#endif // XINT_IO_URING_H
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,71 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_LATENCY_HISTOGRAM_H
+#define XINT_LATENCY_HISTOGRAM_H
+
+/*
+ * Log-linear ("HDR" style) histogram of I/O operation times in nanoseconds.
+ * Values below 2^(XINT_LH_SUB_BITS+1) get a bucket each. Above that every
+ * power of two is split into 2^XINT_LH_SUB_BITS equal sub-buckets so the
+ * relative error of any reported value is less than 1/2^XINT_LH_SUB_BITS.
+ * Values above XINT_LH_MAX_VALUE (about 36 minutes) land in the last bucket
+ * but the exact maximum is still kept in lh_max.
+ */
+#define XINT_LH_SUB_BITS		7
+#define XINT_LH_SUB_COUNT		(1 << XINT_LH_SUB_BITS)
+#define XINT_LH_MAX_BITS		41
+#define XINT_LH_MAX_VALUE		((1ULL << XINT_LH_MAX_BITS) - 1)
+#define XINT_LH_BUCKETS			((XINT_LH_MAX_BITS - XINT_LH_SUB_BITS + 1) * XINT_LH_SUB_COUNT)
+
+struct xint_latency_histogram {
+	uint64_t	lh_total;					// Number of values recorded
+	uint64_t	lh_min;						// Smallest value recorded in nanoseconds
+	uint64_t	lh_max;						// Largest value recorded in nanoseconds
+	uint64_t	lh_counts[XINT_LH_BUCKETS];	// Number of values recorded in each bucket
+};
+typedef struct xint_latency_histogram xint_latency_histogram_t;
+
+/*----------------------------------------------------------------------------*/
+/* xint_lh_record() - Add one value in nanoseconds to a histogram.
+ * This is called for every I/O operation so it is inline and does no locking;
+ * each histogram must only be updated by a single thread.
+ */
+static inline void
+xint_lh_record(xint_latency_histogram_t *lhp, uint64_t value) {
+	uint64_t	v;		// Value clamped to the histogram range
+	int			shift;	// Number of low-order bits dropped for this magnitude
+
+
+	v = (value > XINT_LH_MAX_VALUE) ? XINT_LH_MAX_VALUE : value;
+	shift = 0;
+	if (v >= (2 * XINT_LH_SUB_COUNT))
+		shift = (63 - __builtin_clzll(v)) - XINT_LH_SUB_BITS;
+	lhp->lh_counts[(shift << XINT_LH_SUB_BITS) + (v >> shift)]++;
+	if ((lhp->lh_total == 0) || (value < lhp->lh_min))
+		lhp->lh_min = value;
+	if (value > lhp->lh_max)
+		lhp->lh_max = value;
+	lhp->lh_total++;
+} // End of xint_lh_record()
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
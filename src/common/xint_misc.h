@@ -30,6 +30,7 @@
 #define MILLION  	1000000LL 		/**< 10^6, as opposed to 2^20 */
 #define BILLION  	1000000000LL 	/**< 10^9, as opposed to 2^30 */
 #define TRILLION 	1000000000000LL /**< 10^12, as opposed to 2^40 */
+#define FLOAT_THOUSAND 	1000.0 			/**< 10^3 as floating point */
 #define FLOAT_MILLION 	1000000.0 		/**< 10^6 as floating point */
 #define FLOAT_BILLION 	1000000000.0 	/**< 10^9 as floating point */
 #define FLOAT_TRILLION 	1000000000000.0 /**< 10^12 as floating point */
@@ -0,0 +1,53 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_MMAP_H
+#define XINT_MMAP_H
+
+// ------------------ mmap I/O engine stuff ------------------------------------------
+// The following structure is used by the "-ioengine mmap" and "-mmap" options.
+// When this engine is selected the target file is mapped into memory and each
+// read or write operation is a memcpy() from or to the mapping, so the time of an
+// operation includes the page faults it takes. 
+// A large piece of address space is reserved when the target is opened and the
+// file is mapped into it from the start. The part that is mapped grows as the
+// operations reach further into the file so the locations do not have to be
+// known ahead of time. A write that goes past the end of the file makes the file
+// longer first, just like pwrite() does.
+struct xint_mmap {
+	uint32_t			mmap_options;		// Options from the -mmap option
+#define XINT_MMAP_POPULATE		0x00000001		// Map with MAP_POPULATE to fault in the pages ahead of time
+#define XINT_MMAP_SYNC			0x00000002		// Map with MAP_SYNC - the file has to be on a DAX file system
+	int32_t				mmap_advice;		// madvise() hint for the mapping or -1 for none
+	char				*mmap_advice_name;	// Name of the hint for the output
+	pthread_mutex_t		mmap_lock;			// Held while the mapping or the file is made longer
+	unsigned char		*mmap_addr;			// Start of the reserved address space
+	size_t				mmap_reserved;		// Size of the reserved address space
+	size_t				mmap_mapped;		// Number of bytes of the file that are mapped
+	uint64_t			mmap_file_size;		// Size of the file that is mapped
+};
+typedef struct xint_mmap xint_mmap_t;
+
+#define XINT_MMAP_RESERVE		((sizeof(size_t) > 4) ? ((size_t)1 << 40) : ((size_t)1 << 30))	// Address space reserved for a target
+#define XINT_MMAP_GROW			(64*1024*1024)	// The mapping grows by at least this many bytes at a time
+
+#endif // XINT_MMAP_H
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -12,6 +12,16 @@
  */
 /*
  * This set of routines is used in accessing a system clock.
+ *
+ * On x86_64 Linux systems with an invariant TSC, nclk_now() reads the TSC
+ * instead of calling clock_gettime(). The TSC rate is calibrated against
+ * CLOCK_MONOTONIC_RAW when the clock is initialized and the TSC count is
+ * then scaled to nanoseconds and added to the CLOCK_REALTIME value taken at
+ * the same moment, so time stamps stay relative to the Epoch but do not jump
+ * if NTP steps the system clock during a run. Before the TSC is used it is
+ * read on every CPU this process may run on and compared against
+ * CLOCK_MONOTONIC_RAW; if the CPUs disagree, or there is no invariant TSC,
+ * the clock falls back to CLOCK_REALTIME.
  */
 /* -------- */
 /* Includes */
@@ -22,13 +32,173 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <sys/time.h>
+#include <pthread.h>
 #include "xint_nclk.h" /* nclk_t, prototype compatibility */
+#if (LINUX) && defined(__x86_64__)
+#define NCLK_HAVE_TSC 1
+#include <sched.h>
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
 
 /* --------------- */
 /* Private globals */
 /* --------------- */
 /* Nothing works until the nclk subsystem is initialized. */
 static bool     nclk_initialized = false;
+static pthread_once_t nclk_once = PTHREAD_ONCE_INIT;
+static char		nclk_source_name[64] = "system clock";
+
+#ifdef NCLK_HAVE_TSC
+#define NCLK_TSC_SHIFT				32			// Fraction bits in nclk_tsc_mult
+#define NCLK_TSC_CALIBRATE_NSEC		50000000	// Time to calibrate the TSC rate over
+#define NCLK_TSC_MAX_SKEW_NSEC		1000		// Largest difference allowed between CPUs
+#define NCLK_TSC_MAX_CPUS			1024		// Most CPUs to check the TSC on
+
+static bool		nclk_use_tsc = false;	// Set once the TSC has been calibrated and checked
+static uint64_t	nclk_tsc_base;			// TSC value at nclk_base_ns
+static nclk_t	nclk_base_ns;			// CLOCK_REALTIME in nanoseconds at nclk_tsc_base
+static uint64_t	nclk_tsc_mult;			// Nanoseconds per TSC tick << NCLK_TSC_SHIFT
+
+/*----------------------------------------------------------------------------*/
+/* nclk_tsc_invariant() - Return true if the CPU says its TSC runs at a
+ * constant rate in all power states.
+ */
+static bool
+nclk_tsc_invariant(void) {
+	unsigned int	eax, ebx, ecx, edx;
+
+
+	if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0)
+		return(false);
+	if (eax < 0x80000007)
+		return(false);
+	__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+	return((edx & (1 << 8)) ? true : false);
+}
+
+/*----------------------------------------------------------------------------*/
+/* nclk_tsc_sample() - Read the TSC and the given clock as close together as
+ * possible. The best of a few tries is kept so that an interrupt between the
+ * reads does not spoil the sample.
+ */
+static void
+nclk_tsc_sample(clockid_t clock, uint64_t *tscp, nclk_t *nsp) {
+	struct timespec	ts;
+	uint64_t		before, after, best;
+	int				i;
+
+
+	*tscp = 0;
+	*nsp = 0;
+	best = ~0ULL;
+	for (i = 0; i < 5; i++) {
+		before = __rdtsc();
+		clock_gettime(clock, &ts);
+		after = __rdtsc();
+		if ((after - before) < best) {
+			best = after - before;
+			*tscp = before + ((after - before) / 2);
+			*nsp = ((nclk_t)ts.tv_sec * BILLION) + (nclk_t)ts.tv_nsec;
+		}
+	}
+}
+
+/*----------------------------------------------------------------------------*/
+/* nclk_tsc_to_ns() - Convert a number of TSC ticks into nanoseconds
+ */
+static inline nclk_t
+nclk_tsc_to_ns(uint64_t ticks) {
+	return((nclk_t)(((unsigned __int128)ticks * nclk_tsc_mult) >> NCLK_TSC_SHIFT));
+}
+
+/*----------------------------------------------------------------------------*/
+/* nclk_tsc_synchronized() - Move this thread to each CPU it is allowed to
+ * run on and check that the TSC there agrees with CLOCK_MONOTONIC_RAW using
+ * the calibration from "tsc0"/"raw0". The original CPU affinity of the
+ * thread is put back before returning.
+ */
+static bool
+nclk_tsc_synchronized(uint64_t tsc0, nclk_t raw0) {
+	cpu_set_t	allowed, one;
+	uint64_t	tsc;
+	nclk_t		raw;
+	int64_t		skew;
+	bool		synchronized;
+	int			cpu;
+
+
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return(false);
+	synchronized = true;
+	for (cpu = 0; (cpu < CPU_SETSIZE) && (cpu < NCLK_TSC_MAX_CPUS); cpu++) {
+		if (!CPU_ISSET(cpu, &allowed))
+			continue;
+		CPU_ZERO(&one);
+		CPU_SET(cpu, &one);
+		if (sched_setaffinity(0, sizeof(one), &one) != 0)
+			continue;
+		nclk_tsc_sample(CLOCK_MONOTONIC_RAW, &tsc, &raw);
+		if (tsc < tsc0) {
+			synchronized = false;
+			break;
+		}
+		skew = (int64_t)(nclk_tsc_to_ns(tsc - tsc0) - (raw - raw0));
+		if ((skew > NCLK_TSC_MAX_SKEW_NSEC) || (skew < -NCLK_TSC_MAX_SKEW_NSEC)) {
+			synchronized = false;
+			break;
+		}
+	}
+	sched_setaffinity(0, sizeof(allowed), &allowed);
+	return(synchronized);
+}
+
+/*----------------------------------------------------------------------------*/
+/* nclk_tsc_calibrate() - Work out the TSC rate and decide whether nclk_now()
+ * can use the TSC. This is run once by nclk_initialize().
+ */
+static void
+nclk_tsc_calibrate(void) {
+	struct timespec	pause;
+	uint64_t		tsc0, tsc1, tsc2;
+	nclk_t			raw0, raw1, real;
+
+
+	if (!nclk_tsc_invariant())
+		return;
+
+	nclk_tsc_sample(CLOCK_MONOTONIC_RAW, &tsc0, &raw0);
+	pause.tv_sec = 0;
+	pause.tv_nsec = NCLK_TSC_CALIBRATE_NSEC;
+	nanosleep(&pause, NULL);
+	nclk_tsc_sample(CLOCK_MONOTONIC_RAW, &tsc1, &raw1);
+	if ((tsc1 <= tsc0) || (raw1 <= raw0))
+		return;
+	nclk_tsc_mult = (uint64_t)(((unsigned __int128)(raw1 - raw0) << NCLK_TSC_SHIFT) / (tsc1 - tsc0));
+
+	if (!nclk_tsc_synchronized(tsc1, raw1))
+		return;
+
+	// Tie the TSC to the Epoch
+	nclk_tsc_sample(CLOCK_REALTIME, &tsc2, &real);
+	nclk_tsc_base = tsc2;
+	nclk_base_ns = real;
+	snprintf(nclk_source_name, sizeof(nclk_source_name), "invariant TSC at %.3f MHz",
+		(double)(tsc1 - tsc0) * THOUSAND / (double)(raw1 - raw0));
+	nclk_use_tsc = true;
+}
+#endif /* NCLK_HAVE_TSC */
+
+/*----------------------------------------------------------------------------*/
+/* nclk_setup() - One time setup of the clock, run through pthread_once()
+ * because every Target Thread initializes the clock as well.
+ */
+static void
+nclk_setup(void) {
+#ifdef NCLK_HAVE_TSC
+	nclk_tsc_calibrate();
+#endif
+}
 /*----------------------------------------------------------------------------*/
 /* nclk_initialize()
  *
@@ -42,6 +212,7 @@ static bool     nclk_initialized = false;
 void
 nclk_initialize(nclk_t *nclkp) {
 
+	pthread_once(&nclk_once, nclk_setup);
 #if (LINUX)
 	// Since we use the "nanosecond" clocks in Linux, 
 	// the number of nanoseconds per nanosecond "tick" is 1
@@ -55,6 +226,16 @@ nclk_initialize(nclk_t *nclkp) {
     return;
 }
 /*----------------------------------------------------------------------------*/
+/*
+ * nclk_source()
+ *
+ * Return a description of the clock that nclk_now() reads.
+ */
+char *
+nclk_source(void) {
+	return(nclk_source_name);
+}
+/*----------------------------------------------------------------------------*/
 /*
  * nclk_shutdown()
  *
@@ -88,6 +269,12 @@ nclk_now(nclk_t *nclkp) {
 void
 nclk_now(nclk_t *nclkp) {
 
+#ifdef NCLK_HAVE_TSC
+	if (nclk_use_tsc) {
+		*nclkp = nclk_base_ns + nclk_tsc_to_ns(__rdtsc() - nclk_tsc_base);
+		return;
+	}
+#endif
 #ifdef _POSIX_TIMERS
         struct timespec current_time;
         clock_gettime(CLOCK_REALTIME, &current_time);
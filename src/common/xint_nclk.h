@@ -49,6 +49,12 @@ typedef struct nclk_time nclk_time_t;
  * the resolution of the clock (nanoseconds per tick), or -1 on error.
  */
 extern void nclk_initialize(nclk_t *nclkp);
+/*
+ * nclk_source()
+ *
+ * Return a description of the clock that nclk_now() reads.
+ */
+extern char *nclk_source(void);
 /*
  * nclk_shutdown()
  *
@@ -0,0 +1,334 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that implement the "-numa" option.
+ * They find the NUMA node that a target device or an End-to-End network
+ * interface is attached to, pin each WorkerThread to one of the CPUs of that
+ * node and bind the WorkerThread I/O buffers to the memory of that node.
+ *
+ * Everything here uses sysfs and the raw mbind() system call rather than
+ * libnuma so that it works the same way when xdd is built with --disable-numa.
+ * On systems other than Linux the "-numa" option is accepted and ignored.
+ */
+#include "xint.h"
+#if (LINUX)
+#include <sys/sysmacros.h>
+#include <ifaddrs.h>
+#include <linux/mempolicy.h>
+#endif
+
+#define XINT_NUMA_MAX_NODES		1024		// Largest node number that can be used in a node mask
+
+#if (LINUX)
+/*----------------------------------------------------------------------------*/
+/* xint_numa_read_node() - Read a "numa_node" file from sysfs.
+ * Returns the node number, -1 if the file exists but the kernel does not know
+ * the node, or -2 if there is no such file.
+ */
+static int32_t
+xint_numa_read_node(char *path) {
+	FILE	*fp;
+	int		node;
+
+
+	fp = fopen(path, "r");
+	if (fp == NULL)
+		return(-2);
+	if (fscanf(fp, "%d", &node) != 1)
+		node = -1;
+	fclose(fp);
+	return((node < 0) ? -1 : node);
+} // End of xint_numa_read_node()
+
+/*----------------------------------------------------------------------------*/
+/* xint_numa_sysfs_node() - Walk up the sysfs device tree starting at "path"
+ * until a directory with a "numa_node" attribute is found. For block devices
+ * this is normally the PCI function of the controller, which is a few levels
+ * above the disk or partition itself.
+ * Returns the node number or -1 if it is not known.
+ */
+static int32_t
+xint_numa_sysfs_node(char *path) {
+	char	device_path[PATH_MAX];
+	char	node_path[PATH_MAX + 16];
+	char	*cp;
+	int32_t	node;
+
+
+	if (realpath(path, device_path) == NULL)
+		return(-1);
+	while (strncmp(device_path, "/sys/devices/", 13) == 0) {
+		sprintf(node_path, "%s/numa_node", device_path);
+		node = xint_numa_read_node(node_path);
+		if (node != -2)
+			return(node);
+		cp = strrchr(device_path, '/');
+		if (cp == NULL)
+			break;
+		*cp = '\0';
+	}
+	return(-1);
+} // End of xint_numa_sysfs_node()
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* xint_numa_device_node() - Return the NUMA node of the storage controller
+ * that holds the target. For a block device this is the device itself and
+ * for a file it is the device that holds the file system.
+ * Returns -1 if the node cannot be determined.
+ */
+int32_t
+xint_numa_device_node(target_data_t *tdp) {
+#if (LINUX)
+	struct stat	statbuf;
+	dev_t		dev;
+	char		path[PATH_MAX];
+
+
+	if (stat(tdp->td_target_full_pathname, &statbuf) < 0)
+		return(-1);
+	if (S_ISBLK(statbuf.st_mode))
+		dev = statbuf.st_rdev;
+	else dev = statbuf.st_dev;
+	sprintf(path, "/sys/dev/block/%u:%u", major(dev), minor(dev));
+	return(xint_numa_sysfs_node(path));
+#else
+	return(-1);
+#endif
+} // End of xint_numa_device_node()
+
+/*----------------------------------------------------------------------------*/
+/* xint_numa_host_node() - Return the NUMA node of the network interface that
+ * is used to reach "hostname". On the destination side of an End-to-End
+ * operation this is the interface that owns the address the destination
+ * listens on, and on the source side it is the interface the kernel routes
+ * the connection through.
+ * Returns -1 if the node cannot be determined.
+ */
+int32_t
+xint_numa_host_node(char *hostname) {
+#if (LINUX)
+	struct addrinfo		hints;
+	struct addrinfo		*aip;
+	struct sockaddr_in	local;
+	socklen_t			local_len;
+	struct ifaddrs		*ifap, *ifp;
+	char				path[PATH_MAX];
+	int32_t				node;
+	int					sd;
+
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	if (getaddrinfo(hostname, "9", &hints, &aip) != 0)
+		return(-1);
+
+	// Connecting a datagram socket sends nothing but makes the kernel pick the local address
+	sd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sd < 0) {
+		freeaddrinfo(aip);
+		return(-1);
+	}
+	local_len = sizeof(local);
+	if ((connect(sd, aip->ai_addr, aip->ai_addrlen) < 0) ||
+		(getsockname(sd, (struct sockaddr *)&local, &local_len) < 0)) {
+		close(sd);
+		freeaddrinfo(aip);
+		return(-1);
+	}
+	close(sd);
+	freeaddrinfo(aip);
+
+	if (getifaddrs(&ifap) < 0)
+		return(-1);
+	node = -1;
+	for (ifp = ifap; ifp; ifp = ifp->ifa_next) {
+		if ((ifp->ifa_addr == NULL) || (ifp->ifa_addr->sa_family != AF_INET))
+			continue;
+		if (((struct sockaddr_in *)ifp->ifa_addr)->sin_addr.s_addr != local.sin_addr.s_addr)
+			continue;
+		sprintf(path, "/sys/class/net/%s/device", ifp->ifa_name);
+		node = xint_numa_sysfs_node(path);
+		break;
+	}
+	freeifaddrs(ifap);
+	return(node);
+#else
+	return(-1);
+#endif
+} // End of xint_numa_host_node()
+
+/*----------------------------------------------------------------------------*/
+/* xint_numa_target_node() - Return the NUMA node that the WorkerThreads of a
+ * target should be placed on, or -1 for no placement.
+ * For "-numa auto" this is the node of the target device or, for End-to-End
+ * operations, the node of the network interface for the first address.
+ * Each End-to-End address may use a different interface so the node of the
+ * other addresses is looked up as the WorkerThreads are started.
+ * When no node can be found a warning is displayed and -1 is returned.
+ */
+int32_t
+xint_numa_target_node(target_data_t *tdp) {
+	int32_t		node;
+
+
+	if (tdp->td_numa_node != XINT_NUMA_AUTO)
+		return(tdp->td_numa_node);
+
+	if (tdp->td_target_options & TO_ENDTOEND)
+		node = xint_numa_host_node(tdp->td_e2ep->e2e_address_table[0].hostname);
+	else node = xint_numa_device_node(tdp);
+
+	if (node < 0) {
+		fprintf(xgp->errout,"%s: xint_numa_target_node: Target %d: WARNING: Cannot determine the NUMA node for '%s' - NUMA placement disabled\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(tdp->td_target_options & TO_ENDTOEND) ? tdp->td_e2ep->e2e_address_table[0].hostname : tdp->td_target_full_pathname);
+		return(-1);
+	}
+	if (xgp->global_options & GO_VERBOSE)
+		fprintf(xgp->output,"%s: INFORMATION: Target %d is local to NUMA node %d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			node);
+	return(node);
+} // End of xint_numa_target_node()
+
+#if defined(HAVE_CPU_SET_T) && defined(HAVE_PTHREAD_ATTR_SETAFFINITY_NP)
+/*----------------------------------------------------------------------------*/
+/* xint_numa_node_cpus() - Fill in the set of CPUs that belong to a NUMA node
+ * and that this process is allowed to run on.
+ * Returns the number of CPUs in the set.
+ */
+static int32_t
+xint_numa_node_cpus(int32_t node, cpu_set_t *cpusetp) {
+	cpu_set_t	allowed;
+	char		path[PATH_MAX];
+	FILE		*fp;
+	int			first, last, i;
+	int32_t		count;
+	char		separator;
+
+
+	CPU_ZERO(cpusetp);
+	sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+	fp = fopen(path, "r");
+	if (fp == NULL)
+		return(0);
+	// The list looks like "0-7,16-23"
+	while (fscanf(fp, "%d", &first) == 1) {
+		last = first;
+		separator = fgetc(fp);
+		if (separator == '-') {
+			if (fscanf(fp, "%d", &last) != 1)
+				break;
+			separator = fgetc(fp);
+		}
+		for (i = first; (i <= last) && (i < CPU_SETSIZE); i++)
+			CPU_SET(i, cpusetp);
+		if (separator != ',')
+			break;
+	}
+	fclose(fp);
+
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+		CPU_AND(cpusetp, cpusetp, &allowed);
+	count = CPU_COUNT(cpusetp);
+	return(count);
+} // End of xint_numa_node_cpus()
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* xint_numa_worker_affinity() - Set the thread attributes so that WorkerThread
+ * number "worker_number" runs on one of the CPUs of NUMA node "node".
+ * The WorkerThreads of a target are spread round-robin over the CPUs of
+ * the node so that they do not pile up on the same core.
+ * Returns 0 on success or -1 if the affinity could not be set.
+ */
+int32_t
+xint_numa_worker_affinity(pthread_attr_t *attrp, int32_t node, int32_t worker_number) {
+#if defined(HAVE_CPU_SET_T) && defined(HAVE_PTHREAD_ATTR_SETAFFINITY_NP)
+	cpu_set_t	node_cpus;
+	cpu_set_t	worker_cpu;
+	int32_t		count;
+	int32_t		n, i;
+
+
+	count = xint_numa_node_cpus(node, &node_cpus);
+	if (count == 0)
+		return(-1);
+	n = worker_number % count;
+	for (i = 0; i < CPU_SETSIZE; i++) {
+		if (!CPU_ISSET(i, &node_cpus))
+			continue;
+		if (n == 0)
+			break;
+		n--;
+	}
+	CPU_ZERO(&worker_cpu);
+	CPU_SET(i, &worker_cpu);
+	if (pthread_attr_setaffinity_np(attrp, sizeof(worker_cpu), &worker_cpu) != 0)
+		return(-1);
+	return(0);
+#else
+	return(-1);
+#endif
+} // End of xint_numa_worker_affinity()
+
+/*----------------------------------------------------------------------------*/
+/* xint_numa_bind_buffer() - Bind the pages of an I/O buffer to NUMA node
+ * "node" and fault them in. Pages that are already resident somewhere else,
+ * for example because the heap reused memory freed by another thread, are
+ * migrated. The policy is "preferred" rather than "bind" so that a full node
+ * slows things down instead of failing the allocation.
+ * The buffer must start on a page boundary.
+ * Returns 0 on success or -1 if the policy could not be set.
+ */
+int32_t
+xint_numa_bind_buffer(unsigned char *bufp, size_t size, int32_t node) {
+#if (LINUX) && defined(SYS_mbind)
+	unsigned long	nodemask[XINT_NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+	size_t			page_size;
+	size_t			i;
+	int				status;
+
+
+	if ((node < 0) || (node >= XINT_NUMA_MAX_NODES))
+		return(-1);
+	memset(nodemask, 0, sizeof(nodemask));
+	nodemask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+	status = syscall(SYS_mbind, bufp, size, MPOL_PREFERRED, nodemask, XINT_NUMA_MAX_NODES + 1, MPOL_MF_MOVE);
+	if (status < 0)
+		return(-1);
+
+	// First touch from the WorkerThread, which is already running on the node
+	page_size = getpagesize();
+	for (i = 0; i < size; i += page_size)
+		bufp[i] = 0;
+	return(0);
+#else
+	return(-1);
+#endif
+} // End of xint_numa_bind_buffer()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -16,8 +16,10 @@
 #include <sys/utsname.h>
 #include <sys/socket.h>
 #include <pthread.h>
+#include "xint_rng.h"
 #include "access_pattern.h"
 #include "barrier.h"
+#include "xint_latency_histogram.h"
 #include "results.h"
 #include "end_to_end.h"
 #include "target_offset_table.h"
@@ -27,6 +29,14 @@
 #include "xint_datapatterns.h"
 #include "xint_extended_stats.h"
 #include "xint_throttle.h"
+#include "xint_arrival.h"
+#include "xint_reqsize_mix.h"
+#include "xint_replay.h"
+#include "xint_io_uring.h"
+#include "xint_mmap.h"
+#include "xint_copy.h"
+#include "xint_worker_ring.h"
+#include "xint_worker_pool.h"
 #include "xint_common.h"
 #include "xint_nclk.h"
 #include "xint_task.h"
@@ -57,7 +67,8 @@
 #define PLAN_EXTENDED_STATS		0x0000000000010000ULL  /* Calculate Extended stats on each operation */
 #define PLAN_DRYRUN				0x0000000000020000ULL  /* Indicates a dry run - chicken! */
 #define PLAN_HEARTBEAT			0x0000000000040000ULL  /* Indicates that a heartbeat has been requested */
-#define PLAN_AVAILABLE2			0x0000000000080000ULL  /* AVAILABLE */
+#define PLAN_ARRIVALS			0x0000000000080000ULL  /* Open-loop arrivals - be sure to add the backlog headers for the results display */
+#define PLAN_STREAMS			0x0000000000100000ULL  /* Workload streams - display the results of each stream */
 #define PLAN_INTERACTIVE		0x0000000400000000ULL  /* Enter Interactive Mode - oh what FUN! */
 #define PLAN_INTERACTIVE_EXIT	0x0000000800000000ULL  /* Exit Interactive Mode */
 #define PLAN_INTERACTIVE_STOP	0x0000001000000000ULL  /* Stop at various points in Interactive Mode */
@@ -87,6 +98,8 @@ struct xint_plan {
 	int32_t			number_of_processors;   			/* Number of processors */
 
 	int32_t			clock_tick;							/* Number of clock ticks per second */
+	int32_t			worker_pool_threads;				/* Number of threads in the shared Worker Thread pool - 0 means each target has its own Worker Threads */
+	xint_worker_pool_t	*worker_poolp;					/* The shared Worker Thread pool */
 // Indicators that are used to control exit conditions and the like
 	int 			e2e_TCP_Win;						/* TCP Window Size - used by e2e */
 	struct linger	e2e_SO_Linger;						/* Used by the SO_LINGER Socket Option - used by e2e */
@@ -19,7 +19,9 @@
 
 /* XDD function prototypes */
 // access_pattern.c
-void	xdd_init_seek_list(target_data_t *p);
+int32_t	xdd_init_seek_list(target_data_t *p);
+void	xdd_generate_seek_entry(target_data_t *p, int64_t op_index, seek_t *sep);
+seek_t	*xdd_get_seek_entry(target_data_t *p, int64_t op_index);
 void	xdd_save_seek_list(target_data_t *p);
 int32_t	xdd_load_seek_list(target_data_t *p);
 
@@ -31,10 +33,25 @@ int32_t	xdd_init_barrier(xdd_plan_t* planp, struct xdd_barrier *bp, int32_t thre
 void	xdd_destroy_barrier(xdd_plan_t* planp, struct xdd_barrier *bp);
 int32_t	xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner);
 
+// checksum.c
+uint32_t	xdd_crc32c(uint32_t crc, const unsigned char *bufp, size_t length);
+uint32_t	xdd_checksum_block(const unsigned char *blockp, int32_t block_size, int64_t byte_offset);
+uint32_t	xdd_checksum_get(const unsigned char *blockp, int32_t block_size);
+void	xdd_checksum_stamp(unsigned char *bufp, size_t length, int64_t byte_offset, int32_t block_size);
+
 // datapatterns.c
 void	xdd_datapattern_buffer_init(worker_data_t *wdp);
+int32_t	xdd_datapattern_library_init(target_data_t *tdp);
+int32_t	xdd_datapattern_generate(target_data_t *tdp, unsigned char *bufp, size_t length, int32_t pass_number, int64_t op_number);
 void	xdd_datapattern_fill(worker_data_t *wdp);
 
+// datapatterns_simd.c
+void	xdd_dp_sequence_fill(uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval);
+size_t	xdd_dp_sequence_check(const uint64_t *bufp, size_t count, uint64_t start, uint64_t orval, uint64_t xorval);
+void	xdd_dp_random_fill(uint64_t *bufp, size_t count, uint64_t seed);
+void	xdd_dp_replicate_fill(unsigned char *bufp, size_t length, const unsigned char *patternp, size_t pattern_length);
+int32_t	xdd_dp_replicate_check(const unsigned char *bufp, size_t length, const unsigned char *patternp, size_t pattern_length);
+
 // debug.c
 void	xdd_show_plan(xdd_plan_t *planp);
 void	xdd_show_target_data(target_data_t *tdp);
@@ -77,6 +94,19 @@ int32_t	xdd_sockets_init(void);
 in_addr_t xdd_init_global_clock_network(char *hostname);
 void	xdd_init_global_clock(nclk_t *nclkp);
 
+// xint_futex.c
+void	xint_futex_wait(uint32_t *uaddr, uint32_t val);
+void	xint_futex_wake(uint32_t *uaddr, int32_t count);
+void	xint_handoff_spin_init(int64_t threads);
+int		xint_handoff_spin_count(void);
+
+// xint_numa.c
+int32_t	xint_numa_device_node(target_data_t *tdp);
+int32_t	xint_numa_host_node(char *hostname);
+int32_t	xint_numa_target_node(target_data_t *tdp);
+int32_t	xint_numa_worker_affinity(pthread_attr_t *attrp, int32_t node, int32_t worker_number);
+int32_t	xint_numa_bind_buffer(unsigned char *bufp, size_t size, int32_t node);
+
 // xint_global_data.c
 xdd_global_data_t* xint_global_data_initialization(char *progname);
 
@@ -131,6 +161,13 @@ void	xdd_interactive_show_barrier(int32_t tokens, char *cmdline, uint32_t flags,
 
 // io_buffers.c
 unsigned char *xdd_init_io_buffers(worker_data_t *wdp);
+int32_t	xdd_init_io_buffer_pool(target_data_t *tdp, int32_t numa_node);
+void	xdd_io_buffer_pool_cleanup(target_data_t *tdp);
+
+// latency_histogram.c
+void	xint_lh_reset(xint_latency_histogram_t *lhp);
+void	xint_lh_merge(xint_latency_histogram_t *to, xint_latency_histogram_t *from);
+uint64_t	xint_lh_percentile(xint_latency_histogram_t *lhp, double percentile);
 
 // lockstep.c
 int32_t	xdd_lockstep(target_data_t *p);
@@ -158,6 +195,11 @@ xint_restart_t 			*xdd_get_restartp(target_data_t *tdp);
 xint_raw_t				*xdd_get_rawp(target_data_t *tdp);
 xint_e2e_t 				*xdd_get_e2ep(void);
 xint_throttle_t 		*xdd_get_throtp(target_data_t *tdp);
+xint_arrival_t 		*xdd_get_arrivalp(target_data_t *tdp);
+xint_reqsize_mix_t 		*xdd_get_rsmp(target_data_t *tdp);
+xint_replay_t 			*xdd_get_replayp(target_data_t *tdp);
+xint_mmap_t 			*xdd_get_mmapp(target_data_t *tdp);
+xint_copy_t 			*xdd_get_copyp(target_data_t *tdp);
 xint_triggers_t 		*xdd_get_trigp(target_data_t *tdp);
 xint_extended_stats_t 	*xdd_get_esp(target_data_t *tdp);
 int32_t					xdd_linux_cpu_count(void);
@@ -193,7 +235,14 @@ worker_data_t 	*xdd_create_worker_data(target_data_t *tdp, int32_t q);
 void	xdd_build_target_data_substructure(xdd_plan_t* planp);
 void	xdd_build_target_data_substructure_e2e(xdd_plan_t* planp, target_data_t *tdp);
 
+// worker_pool.c
+int32_t	xint_worker_pool_init(xdd_plan_t *planp);
+void	xint_worker_pool_attach(target_data_t *tdp);
+int32_t	xint_worker_pool_add_worker(target_data_t *tdp, worker_data_t *wdp);
+void	xint_worker_pool_put(xint_worker_pool_t *poolp, worker_data_t *wdp);
+
 // worker_thread.c
+int32_t	xdd_worker_thread_do_task(worker_data_t *wdp);
 void 	*xdd_worker_thread(void *pin);
 
 // worker_thread_cleanup.c
@@ -210,9 +259,23 @@ void	xdd_worker_thread_update_local_counters(worker_data_t *wdp);
 void	xdd_worker_thread_update_target_counters(worker_data_t *wdp);
 void	xdd_worker_thread_check_io_status(worker_data_t *wdp);
 
+// worker_thread_io_copy.c
+int32_t	xint_copy_init(target_data_t *tdp);
+ssize_t	xint_copy_io(worker_data_t *wdp);
+void	xint_copy_display(target_data_t *tdp, results_t *rp, FILE *out);
+void	xint_copy_cleanup(target_data_t *tdp);
+
 // worker_thread_io_for_os.c
 void	xdd_io_for_os(worker_data_t *wdp);
 
+// worker_thread_io_mmap.c
+int32_t	xint_mmap_init(target_data_t *tdp);
+int32_t	xint_mmap_map(target_data_t *tdp);
+void	xint_mmap_unmap(target_data_t *tdp);
+int32_t	xint_mmap_sync(target_data_t *tdp);
+ssize_t	xint_mmap_io(worker_data_t *wdp);
+void	xint_mmap_cleanup(target_data_t *tdp);
+
 // worker_thread_ttd_after_io_op.c
 void	xdd_threshold_after_io_op(worker_data_t *wdp);
 void	xdd_status_after_io_op(worker_data_t *wdp);
@@ -226,9 +289,20 @@ void	xdd_worker_thread_ttd_after_io_op(worker_data_t *wdp);
 void	xdd_dio_before_io_op(worker_data_t *wdp);
 void	xdd_raw_before_io_op(worker_data_t *wdp);
 int32_t	xdd_e2e_before_io_op(worker_data_t *wdp);
-void	xdd_throttle_before_io_op(worker_data_t *wdp);
 int32_t	xdd_worker_thread_ttd_before_io_op(worker_data_t *wdp);
 
+// replay.c
+int32_t		xint_replay_setup(target_data_t *tdp);
+void		xint_replay_display(target_data_t *tdp, FILE *out);
+
+// reqsize_mix.c
+int32_t		xint_reqsize_mix_parse(xint_reqsize_mix_t *rsmp, char *listp);
+int32_t		xint_reqsize_mix_setup(target_data_t *tdp);
+int32_t		xint_reqsize_mix_class(target_data_t *tdp, int64_t op_number);
+uint64_t	xint_reqsize_mix_bytes(target_data_t *tdp, int64_t ops);
+int64_t		xint_reqsize_mix_ops(target_data_t *tdp, uint64_t bytes);
+void		xint_reqsize_mix_display(target_data_t *tdp, FILE *out);
+
 // read_after_write.c
 void	xdd_raw_err(char const *fmt, ...);
 int32_t	xdd_raw_setup_reader_socket(target_data_t *tdp);
@@ -262,6 +336,12 @@ void	xdd_results_fmt_iops(results_t *rp);
 void	xdd_results_fmt_read_iops(results_t *rp);
 void	xdd_results_fmt_write_iops(results_t *rp);
 void	xdd_results_fmt_latency(results_t *rp);
+void	xdd_results_fmt_latency_p50(results_t *rp);
+void	xdd_results_fmt_latency_p90(results_t *rp);
+void	xdd_results_fmt_latency_p99(results_t *rp);
+void	xdd_results_fmt_latency_p999(results_t *rp);
+void	xdd_results_fmt_latency_p9999(results_t *rp);
+void	xdd_results_fmt_latency_max(results_t *rp);
 void	xdd_results_fmt_elapsed_time_from_1st_op(results_t *rp);
 void	xdd_results_fmt_elapsed_time_from_pass_start(results_t *rp);
 void	xdd_results_fmt_elapsed_over_head_time(results_t *rp);
@@ -287,7 +367,7 @@ void	xdd_results_fmt_e2e_first_read_time(results_t *rp);
 void	xdd_results_fmt_e2e_last_write_time(results_t *rp);
 void	xdd_results_fmt_delimiter(results_t *rp);
 void 	*xdd_results_display(results_t *rp);
-void	xdd_results_format_id_add( char *sp, char *format_stringp  );
+char	*xdd_results_format_id_add( char *sp, char *format_stringp  );
 
 // results_manager.c
 void    *xdd_results_manager(void *data);
@@ -297,6 +377,7 @@ void    *xdd_process_pass_results(xdd_plan_t *planp);
 void    *xdd_process_run_results(xdd_plan_t *planp);
 void    xdd_combine_results(results_t *to, results_t *from, xdd_plan_t *planp);
 void    *xdd_extract_pass_results(results_t *rp, target_data_t *p, xdd_plan_t *planp);
+void    xdd_results_latency_percentiles(results_t *rp);
 
 // schedule.c
 void	xdd_schedule_options(void);
@@ -344,9 +425,21 @@ void	xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp);
 void	xdd_targetpass_e2e_eof_src(target_data_t *tdp);
 void	xdd_targetpass_e2e_monitor(target_data_t *tdp);
 
+// target_pass_io_uring.c
+int32_t	xint_io_uring_init(target_data_t *tdp);
+void	xint_io_uring_cleanup(target_data_t *tdp);
+void	xdd_target_pass_io_uring_loop(xdd_plan_t* planp, target_data_t *tdp);
+
 // target_pass_qt_locator.c
 worker_data_t	*xdd_get_specific_worker_thread(target_data_t *tdp, int32_t q);
 worker_data_t	*xdd_get_any_available_worker_thread(target_data_t *tdp);
+int32_t	xint_worker_ring_init(target_data_t *tdp);
+void	xdd_worker_ring_put(target_data_t *tdp, worker_data_t *wdp);
+worker_data_t	*xdd_worker_ring_get(target_data_t *tdp);
+void	xdd_worker_ring_collect_all(target_data_t *tdp);
+void	xdd_worker_thread_return(target_data_t *tdp, worker_data_t *wdp);
+void	xdd_worker_thread_release(target_data_t *tdp, worker_data_t *wdp);
+void	xdd_worker_thread_wait_for_task(worker_data_t *wdp);
 
 // target_thread.c
 void 	*xdd_target_thread(void *pin);
@@ -359,6 +452,10 @@ void	xdd_syncio_before_io_op(target_data_t *p);
 int32_t	xdd_start_trigger_before_io_op(target_data_t *p);
 int32_t	xdd_timelimit_before_io_op(target_data_t *p);
 int32_t	xdd_runtime_before_io_op(target_data_t *p);
+int32_t	xdd_stream_before_io_op(target_data_t *tdp);
+void	xdd_throttle_before_io_op(target_data_t *tdp);
+int32_t	xdd_arrival_before_io_op(target_data_t *tdp);
+void	xdd_replay_before_io_op(target_data_t *tdp);
 int32_t	xdd_target_ttd_before_io_op(target_data_t *tdp, worker_data_t *wdp);
 int32_t	xdd_target_ttd_after_io_op(target_data_t *tdp, worker_data_t *wdp);
 
@@ -367,6 +464,10 @@ void	xdd_timer_calibration_before_pass(void);
 void	xdd_start_delay_before_pass(target_data_t *tdp);
 void	xdd_raw_before_pass(target_data_t *tdp);
 void	xdd_e2e_before_pass(target_data_t *tdp);
+void	xdd_throttle_before_pass(target_data_t *tdp);
+void	xdd_arrival_before_pass(target_data_t *tdp);
+void	xdd_replay_before_pass(target_data_t *tdp);
+void	xdd_stream_before_pass(target_data_t *tdp);
 void	xdd_init_target_data_before_pass(target_data_t *tdp);
 void	xdd_init_worker_data_before_pass(worker_data_t *wdp);
 int32_t	xdd_target_ttd_before_pass(target_data_t *tdp);
@@ -374,6 +475,10 @@ int32_t	xdd_target_ttd_before_pass(target_data_t *tdp);
 // timestamp.c
 void	xdd_ts_overhead(struct xdd_ts_header *ts_hdrp); 
 void	xdd_ts_setup(target_data_t *p);
+xdd_ts_tte_t	*xdd_ts_assign_entry(target_data_t *tdp, worker_data_t *wdp);
+void	xdd_ts_commit_entry(worker_data_t *wdp);
+int32_t	xdd_ts_stream_start(target_data_t *tdp);
+void	xdd_ts_stream_stop(target_data_t *tdp);
 void	xdd_ts_write(target_data_t *p);
 void	xdd_ts_cleanup(struct xdd_ts_header *ts_hdrp);
 void	xdd_ts_reports(target_data_t *p);
@@ -389,6 +494,7 @@ int32_t	xdd_verify_checksum(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_hex(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_sequence(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op);
+int32_t	xdd_verify_generated(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_contents(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_location(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify(worker_data_t *wdp, int64_t current_op);
@@ -0,0 +1,69 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_REPLAY_H
+#define XINT_REPLAY_H
+
+// ------------------ Replay stuff --------------------------------------------------
+// The following structures are used by the -replay option
+// A trace is read from the text output of blkparse(1) or from an xdd binary
+// timestamp dump (-ts dump or -ts stream) and turned into one entry per
+// operation. The seek list is generated from the entries so that each
+// operation has the location, size and type it had in the trace, and the
+// Target Thread holds each operation back until the time it was issued in
+// the trace, divided by the speedup factor.
+
+// One operation of the trace
+struct xint_replay_entry {
+	uint64_t			re_offset;			// Location in bytes
+	int64_t				re_size;			// Number of bytes transferred
+	char				re_operation;		// SO_OP_READ or SO_OP_WRITE
+	nclk_t				re_issue_time;		// Time in nanoseconds after the first operation of the trace was issued
+	nclk_t				re_latency;			// Time the operation took in the trace or 0 if it is not known
+};
+typedef struct xint_replay_entry xint_replay_entry_t;
+
+struct xint_replay {
+	char				*replay_filename;		// Name of the trace file
+	double				replay_speedup;			// The trace is replayed this many times faster than it was captured
+	uint32_t			replay_format;			// Format of the trace file
+#define XINT_REPLAY_BLKPARSE	0x00000001		// Text output of blkparse
+#define XINT_REPLAY_TSDUMP		0x00000002		// xdd binary timestamp dump
+	xint_replay_entry_t	*replay_entries;		// The operations of the trace in the order they were issued
+	int64_t				replay_ops;				// Number of entries
+	uint64_t			replay_bytes;			// Number of bytes transferred by all the entries
+	int32_t				replay_concurrency;		// Largest number of operations outstanding at once in the trace or 0 if not known
+	// State of the current pass
+	int32_t				replay_started;			// Set when the first operation of the pass has been issued
+	nclk_t				replay_start;			// Time the first operation of this pass was issued
+	// Statistics for the whole run
+	int64_t				replay_late_ops;		// Number of operations that were issued late
+	nclk_t				replay_lag_max;			// Longest time an operation was issued after it was due
+	double				replay_lag_sum;			// Sum of the times the late operations were issued after they were due
+	xint_latency_histogram_t	replay_original_hist;	// Op times in the trace
+	xint_latency_histogram_t	replay_replayed_hist;	// Op times of the replay
+};
+typedef struct xint_replay xint_replay_t;
+
+#define XINT_REPLAY_LATE			100000		// An operation issued more than this many nanoseconds after it was due is late
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,60 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_REQSIZE_MIX_H
+#define XINT_REQSIZE_MIX_H
+
+// ------------------ Request size mix stuff -------------------------------------------
+// The following structures are used by the -reqsizemix option
+// Each operation gets one of up to XINT_REQSIZE_MAX_CLASSES request sizes.
+// The sizes are dealt from a "deck" that holds each size as many times as
+// its weight (reduced by the greatest common divisor of the weights). Every
+// deck is shuffled with its own repeatable random number stream so that any
+// run of operations the length of a deck has exactly the requested mix, and
+// the number of bytes in a pass can be worked out without generating it.
+#define XINT_REQSIZE_MAX_CLASSES	16			// Largest number of different request sizes
+#define XINT_REQSIZE_MAX_DECK		65536		// Largest sum of the reduced weights
+
+// Operations, bytes and op times of one request size
+struct xint_reqsize_stats {
+	int64_t						rs_ops;			// Number of operations of this size
+	int64_t						rs_bytes;		// Number of bytes transferred by operations of this size
+	nclk_t						rs_op_time;		// Accumulated op time in nanoseconds
+	xint_latency_histogram_t	rs_hist;		// Op time histogram
+};
+typedef struct xint_reqsize_stats xint_reqsize_stats_t;
+
+struct xint_reqsize_mix {
+	int32_t					rsm_classes;							// Number of request sizes
+	int64_t					rsm_bytes[XINT_REQSIZE_MAX_CLASSES];	// Request size in bytes
+	int32_t					rsm_reqsize[XINT_REQSIZE_MAX_CLASSES];	// Request size in blocks
+	int32_t					rsm_weight[XINT_REQSIZE_MAX_CLASSES];	// Weight of each request size as specified
+	int32_t					rsm_count[XINT_REQSIZE_MAX_CLASSES];	// Number of times each request size is in a deck
+	int32_t					rsm_deck_size;			// Number of operations in a deck
+	int64_t					rsm_deck_bytes;			// Number of bytes in a deck
+	int32_t					*rsm_deck;				// Request size class of each operation in the current deck
+	int64_t					rsm_deck_number;		// Number of the deck in rsm_deck or -1
+	xint_reqsize_stats_t	*rsm_run_statsp;		// Statistics of each request size for the whole run
+};
+typedef struct xint_reqsize_mix xint_reqsize_mix_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,106 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_RNG_H
+#define XINT_RNG_H
+
+#include <stdint.h>
+
+// ------------------ Counter-based random numbers -----------------------------------
+// The random numbers for the seek locations, the request size mix, and the
+// random data patterns are not drawn from a stream that has to be walked in
+// order. Instead the n-th number of a stream is worked out directly from a key
+// and n with the SplitMix64 output function. Each stream has its own key that is
+// made from the seed, the target number, what the numbers are used for, and
+// (usually) the operation number, so any thread can work out the numbers of any
+// operation at any time and always gets the same ones for the same seed.
+#define XINT_RNG_GAMMA			0x9e3779b97f4a7c15ULL	// Weyl sequence increment (2^64 / golden ratio)
+
+// What the numbers are used for - keeps the streams of a target apart
+#define XINT_RNG_SEEK			1	// Random seek locations and throttle variances of an operation
+#define XINT_RNG_REQSIZE		2	// Shuffle of one deck of a request size mix
+#define XINT_RNG_DATA			3	// Random data pattern of a buffer
+#define XINT_RNG_REDUCIBLE		4	// Blocks of the reducible data pattern written by an operation
+#define XINT_RNG_LIBRARY		5	// Block library of the reducible data pattern
+
+struct xint_rng {
+	uint64_t	rng_key;		// Key of this stream
+	uint64_t	rng_counter;	// Number of values drawn from this stream
+};
+typedef struct xint_rng xint_rng_t;
+
+/*----------------------------------------------------------------------------*/
+/* xint_rng_mix() - Scramble 64 bits (the SplitMix64 finalizer) */
+static inline uint64_t
+xint_rng_mix(uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return(x ^ (x >> 31));
+}
+
+/*----------------------------------------------------------------------------*/
+/* xint_rng_key() - Make the key of the stream for the specified seed,
+ * target number, use, and number (usually the operation number).
+ */
+static inline uint64_t
+xint_rng_key(uint64_t seed, int32_t target, uint64_t use, int64_t number) {
+	uint64_t	key;
+
+
+	key = xint_rng_mix(seed + XINT_RNG_GAMMA);
+	key = xint_rng_mix(key ^ ((uint64_t)(uint32_t)target * XINT_RNG_GAMMA));
+	key = xint_rng_mix(key ^ (use * 0xd1b54a32d192ed03ULL));
+	return(xint_rng_mix(key ^ (uint64_t)number));
+}
+
+/*----------------------------------------------------------------------------*/
+/* xint_rng_at() - Return value number "n" of the stream with this key */
+static inline uint64_t
+xint_rng_at(uint64_t key, uint64_t n) {
+	return(xint_rng_mix(key + ((n + 1) * XINT_RNG_GAMMA)));
+}
+
+/*----------------------------------------------------------------------------*/
+/* xint_rng_init() - Start drawing from the stream for the specified seed,
+ * target number, use, and number.
+ */
+static inline void
+xint_rng_init(xint_rng_t *rngp, uint64_t seed, int32_t target, uint64_t use, int64_t number) {
+	rngp->rng_key = xint_rng_key(seed, target, use, number);
+	rngp->rng_counter = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* xint_rng_next() - Draw the next 64-bit value from a stream */
+static inline uint64_t
+xint_rng_next(xint_rng_t *rngp) {
+	return(xint_rng_at(rngp->rng_key, rngp->rng_counter++));
+}
+
+/*----------------------------------------------------------------------------*/
+/* xint_rng_double() - Draw the next value from a stream as a double in [0,1) */
+static inline double
+xint_rng_double(xint_rng_t *rngp) {
+	return((double)(xint_rng_next(rngp) >> 11) * (1.0 / 9007199254740992.0));
+}
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
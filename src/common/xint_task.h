@@ -32,7 +32,7 @@ struct xint_task {
 	size_t				task_xfer_size;				// Number of bytes to transfer
 	off_t				task_byte_offset;			// Offset into the file where this transfer starts
 	uint64_t			task_e2e_sequence_number;	// Sequence number of this task when part of an End-to-End operation
-	nclk_t				task_time_to_issue;			// Time to issue the I/O operation or 0 if not used
+	nclk_t				task_time_to_issue;			// Time the I/O operation was due with open-loop arrivals or 0 if not used
 	ssize_t				task_io_status;				// Returned status of this I/O associated with this task
 	int32_t				task_errno;					// Returned errno of this I/O associated with this task
 };
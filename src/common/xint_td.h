@@ -29,6 +29,7 @@
 #define TO_LOCKSTEP                    0x0000000000004000ULL  // Normal Lock step mode 
 #define TO_LOCKSTEPOVERLAPPED          0x0000000000008000ULL  // Overlapped lock step mode 
 #define TO_SHARED_MEMORY               0x0000000000010000ULL  // Use a shared memory segment instead of malloced memmory 
+#define TO_IO_URING                    0x0000000000020000ULL  // Issue I/O from the Target Thread through io_uring - the -ioengine option 
 #define TO_PCPU_ABSOLUTE               0x0000000080000000ULL  // Defines the meaning of the percent CPU values on the output 
 #define TO_REOPEN                      0x0000000100000000ULL  // Open/Close target on each pass and record time 
 #define TO_CREATE_NEW_FILES            0x0000000200000000ULL  // Create new targets for each pass 
@@ -44,6 +45,10 @@
 #define TO_ORDERING_NETWORK_SERIAL     0x0000100000000000ULL  // Serial Odering method applied to network
 #define TO_ORDERING_STORAGE_LOOSE      0x0000200000000000ULL  // Loose Odering method applied to storage
 #define TO_ORDERING_NETWORK_LOOSE      0x0000400000000000ULL  // Loose Odering method applied to network
+#define TO_VERIFY_CHECKSUM             0x0000800000000000ULL  // Stamp each block with a checksum on write and verify it on read
+#define TO_IO_MMAP                     0x0001000000000000ULL  // Read and write the target through a memory mapping - the -ioengine option 
+#define TO_IO_COPY                     0x0002000000000000ULL  // Copy a source file into the target inside the kernel - the -copyfrom option 
+#define TO_IO_ENGINE_MASK              (TO_IO_URING|TO_IO_MMAP|TO_IO_COPY) // All of the I/O engine selection bits
 
 // Per Thread Data Structure - one for each thread 
 struct xint_target_data {
@@ -119,6 +124,16 @@ struct xint_target_data {
 	char				*td_target_full_pathname;	// Fully qualified path name to the target device/file
 	char				td_target_extension[32]; 	// The target extension number 
 	int32_t				td_processor;  				// Processor/target assignments 
+	int32_t				td_numa_node;  				// NUMA node for WorkerThreads and their buffers, or one of the following
+#define XINT_NUMA_OFF		-1							// No NUMA placement
+#define XINT_NUMA_AUTO		-2							// Use the node of the target device or E2E network interface
+	char				*td_stream_name;			// Name of the workload stream this target runs or NULL - set by the -stream option
+	int32_t				td_stream_type;				// Type of workload stream
+#define XINT_STREAM_FOREGROUND	0x00000001				// Background streams stop when all foreground streams have finished a pass
+#define XINT_STREAM_BACKGROUND	0x00000002				// Stop issuing I/O when all the other targets have finished this pass
+	int32_t				td_stream_pass_complete;	// Number of the last pass this target finished issuing I/O for - written by its own Target Thread only
+	struct xint_target_data	**td_stream_foregroundpp;	// Foreground targets a background stream waits for - built before each pass
+	int32_t				td_stream_foregrounds;		// Number of entries in td_stream_foregroundpp
 	double				td_start_delay; 			// number of seconds to delay the start  of this operation 
 	nclk_t				td_start_delay_psec;		// number of nanoseconds to delay the start  of this operation 
 	char				td_random_init_state[256]; 	// Random number generator state initalizer array 
@@ -127,6 +142,13 @@ struct xint_target_data {
 	int64_t				td_preallocate; 			// File preallocation value 
 	int64_t				td_pretruncate; 			// File pretruncation value 
 	int32_t				td_mem_align;   			// Memory read/write buffer alignment value in bytes 
+	int64_t				td_hugepage_size;			// Size of the huge pages for the I/O buffer pool or 0 for none
+	unsigned char		*td_buffer_poolp;			// Huge page pool holding the I/O buffers of all WorkerThreads
+	size_t				td_buffer_pool_size;		// Size of the I/O buffer pool in bytes
+	size_t				td_buffer_pool_slice;		// Size of the I/O buffer pool slice of each WorkerThread
+	int32_t				td_buffer_pool_hugetlb;		// 1 if the pool is from hugetlb pages, 0 if transparent huge pages
+	unsigned char		*td_buffer_pool_mapp;		// Start of the mapping that holds the pool - for munmap()
+	size_t				td_buffer_pool_map_size;	// Size of the mapping that holds the pool
     //
     // ------------------ Heartbeat stuff --------------------------------------------------
 	// The following heartbeat structure and data is for the -heartbeat option
@@ -151,7 +173,11 @@ struct xint_target_data {
 	nclk_t        		td_open_end_time; 			// Time just after the open completes for this target 
 	pthread_mutex_t 	td_counters_mutex; 			// Mutex for locking when updating td_counters
 	struct xint_target_counters	td_counters;		// Pointer to the target counters
+	struct xint_latency_histogram	td_latency_hist;	// Op time histogram for this pass - merged from the Worker Threads after each pass
 	struct xint_throttle		*td_throtp;			// Pointer to the throttle sturcture
+	struct xint_arrival			*td_arrivalp;		// Pointer to the open-loop arrival structure used by the -arrivals option
+	struct xint_reqsize_mix		*td_rsmp;			// Pointer to the request size mix used by the -reqsizemix option
+	struct xint_replay			*td_replayp;		// Pointer to the trace replay structure used by the -replay option
 	struct xint_e2e				*td_e2ep;			// Pointer to the e2e struct when needed
 	struct xint_extended_stats	*td_esp;			// Extended Stats Structure Pointer
 	struct xint_triggers		*td_trigp;			// Triggers Structure Pointer
@@ -159,6 +185,11 @@ struct xint_target_data {
 	struct xint_raw				*td_rawp;          	// RAW Data Structure Pointer
 	struct lockstep				*td_lsp;			// Pointer to the lockstep structure used by the lockstep option
 	struct xint_restart			*td_restartp;		// Pointer to the restart structure used by the restart monitor
+	struct xint_io_uring		*td_uringp;			// Pointer to the io_uring engine structure used by the -ioengine option
+	struct xint_mmap			*td_mmapp;			// Pointer to the mmap engine structure used by the -ioengine and -mmap options
+	struct xint_copy			*td_copyp;			// Pointer to the local copy engine structure used by the -copyfrom option
+	struct xint_worker_ring		*td_worker_ringp;	// Pointer to the lock-free ring of available Worker Threads (NULL for E2E and lockstep)
+	struct xint_worker_pool		*td_worker_poolp;	// Pointer to the shared Worker Thread pool that runs the tasks of this target (NULL for dedicated Worker Threads)
 #if (LINUX || DARWIN)
 	struct stat					td_statbuf;			// Target File Stat buffer used by xdd_target_open()
 #elif (AIX || SOLARIS)
@@ -172,6 +203,7 @@ struct xint_target_data {
 	xni_context_t xni_ctx;	
 	const char *xni_ibdevice;
 	const char *xni_tcp_congestion;
+	int xni_tcp_flags;
 
 	unsigned char				td_magic_cookie[16]; // Magic cookie for checking network endpoints
 };
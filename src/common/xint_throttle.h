@@ -13,19 +13,34 @@
 
 // ------------------ Throttle stuff --------------------------------------------------
 // The following structure is used by the -throttle option
+// The throttle is a token bucket that is drained by the Target Thread as it
+// issues each operation. It is kept as a "theoretical arrival time" (the time
+// at which the bucket would be empty) so that no refill timer is needed: each
+// operation moves throttle_tat forward by its cost in nanoseconds and may be 
+// issued once the current time has reached the tat it was given. An operation
+// that is issued late is made up by the ones after it unless a burst size was
+// asked for, in which case no more than throttle_burst_nsec of lateness is kept.
 struct xint_throttle {
 		double				throttle;  			// Target Throttle assignments 
 		double				throttle_variance;  // Throttle Bandwidth variance: +-x.x MB/sec
+		double				throttle_burst;		// Size of the bucket in MB for BW or in ops for OPS - 0 is the default
 		uint32_t      		throttle_type; 		// Target Throttle type 
 #define XINT_THROTTLE_OPS   0x00000001  		// Throttle type of OPS 
 #define XINT_THROTTLE_BW    0x00000002  		// Throttle type of Bandwidth 
 #define XINT_THROTTLE_ABW   0x00000004  		// Throttle type of Average Bandwidth 
 #define XINT_THROTTLE_DELAY 0x00000008  		// Throttle type of a constant delay or time for each op 
+		int32_t				throttle_started;	// Set when the first operation of the pass has been issued
+		nclk_t				throttle_start;		// Time the first operation of this pass was issued
+		double				throttle_tat;		// Time at which the bucket is empty in nanoseconds after throttle_start
+		double				throttle_burst_nsec;// How far the current time may be behind throttle_tat - negative is no limit
+		unsigned short		throttle_xsubi[3];	// Random number state for the throttle variance
 };
 
 #define XINT_DEFAULT_THROTTLE   		1.0					// Default Throttle
 #define XINT_DEFAULT_THROTTLE_VARIANCE	0.0					// Default Throttle Variance
 #define XINT_DEFAULT_THROTTLE_TYPE		XINT_THROTTLE_BW	// Default Throttle type 
+#define XINT_THROTTLE_NO_BURST_LIMIT	-1.0				// Default bucket size for BW and OPS - all lateness is made up
+#define XINT_THROTTLE_SPIN_NSEC			50000				// Spin instead of sleeping for the last 50 microseconds before an operation
 
 typedef struct xint_throttle xint_throttle_t;
 /*
@@ -50,6 +50,18 @@
 //  |                                     | +--------------------------------+
 //  +----- End of xint_target_data -------+
 //
+// When the "stream" suboption is specified (TS_STREAM) the table above is not allocated - only
+// the header is. Instead each Worker Thread fills in a single timestamp table entry of its own
+// (wd_ts_tte) and, when the operation is complete, puts a copy of it on its own trace ring 
+// (struct xint_ts_ring). A per-target flusher thread drains all the trace rings of the target 
+// into the binary timestamp file while the run is in progress so the amount of memory used 
+// for time stamping does not depend on the length of the run. 
+// The streamed file is the header up to (but not including) tsh_tte[] followed by one 
+// xdd_ts_tte for each operation in the order in which they were drained - which is the same 
+// memory layout as an xdd_ts_header with tsh_numents entries. The tsh_magic is XDD_TS_STREAM_MAGIC 
+// so that readers know the entries are not in operation order and that tsh_numents may 
+// be stale if the run did not finish - the number of entries should be taken from the file size.
+//
 //------------------------------------------------------------------------------------------------//
 
 #define MAX_IDLEN 8192 // This is the maximum length of the Run ID Length field
@@ -142,8 +154,27 @@ typedef struct xdd_ts_header xdd_ts_header_t;
 #define TS_TRIGOP             0x00000800 /**< Time stamp trigger operation number */
 #define TS_TRIGGERED          0x00001000 /**< Time stamping has been triggered */
 #define TS_SUPPRESS_OUTPUT    0x00002000 /**< Suppress timestamp output */
+#define TS_STREAM             0x00004000 /**< Stream entries to the binary file during the run */
 #define DEFAULT_TS_OPTIONS 0x00000000
 
+#define XDD_TS_MAGIC          0xDEADBEEF /**< tsh_magic for a timestamp table dump */
+#define XDD_TS_STREAM_MAGIC   0xDEADBEF5 /**< tsh_magic for a streamed timestamp file */
+#define XDD_TS_RING_ENTRIES   4096       /**< Number of entries in each Worker Thread trace ring - must be a power of 2 */
+
+// Worker Thread trace ring used by TS_STREAM.
+// This is a single-producer/single-consumer ring: only the Worker Thread advances tr_tail 
+// and only the flusher thread advances tr_head. A Worker Thread that finds its ring full 
+// sleeps in a futex on tr_head until the flusher makes room.
+struct xint_ts_ring {
+	uint32_t			tr_head;		// Next entry to be written to the file - only touched by the flusher
+	uint32_t			tr_tail;		// Next entry to be filled in - only touched by the Worker Thread
+	uint32_t			tr_mask;		// Number of entries minus 1
+	uint32_t			tr_waiting;		// Set to 1 when the Worker Thread is sleeping on tr_head
+	int64_t				tr_stalls;		// Number of times the Worker Thread had to wait for the flusher
+	xdd_ts_tte_t		*tr_entries;	// The entries
+};
+typedef struct xint_ts_ring xint_ts_ring_t;
+
 // The timestamp structure is pointed to from the Target Data Structure. 
 // There is one timestamp structure for each Target that has timestamping enabled.
 struct xint_timestamp {
@@ -156,6 +187,14 @@ struct xint_timestamp {
 	char				*ts_output_filename; 	// Timestamp report output filename for this Target
 	FILE				*ts_tsfp;   			// Pointer to the time stamp output file 
 	xdd_ts_header_t		*ts_hdrp;				// Pointer to the actual time stamp header and entries
+	// The following are only used when the TS_STREAM option is on
+	int					ts_stream_fd;			// File descriptor of the binary output file
+	int64_t				ts_stream_entries;		// Number of entries written to the binary output file so far
+	pthread_t			ts_flusher_thread;		// Thread that drains the Worker Thread trace rings
+	uint32_t			ts_flusher_signal;		// Futex word incremented to wake up the flusher
+	uint32_t			ts_flusher_waiting;		// Set to 1 when the flusher is sleeping on ts_flusher_signal
+	uint32_t			ts_flusher_stop;		// Set to 1 to tell the flusher to drain everything and exit
+	int32_t				ts_flusher_started;		// Set to 1 if the flusher thread was created
 };
 typedef struct xint_timestamp xint_timestamp_t;
 
@@ -21,11 +21,18 @@ struct xint_worker_data {
 	int32_t   					wd_worker_number;	// My worker number within this target relative to 0
 	int32_t   					wd_thread_id;  		// My system thread ID (like a process ID) 
 	int32_t   					wd_pid;   			// My process ID 
+	int32_t   					wd_numa_node;  		// NUMA node for this Worker_Thread and its I/O buffer or -1 for none
 	unsigned char				*wd_bufp;			// Pointer to the generic I/O buffer
 	int							wd_buf_size;		// Size in bytes of the generic I/O buffer
 	int64_t						wd_ts_entry;		// The TimeStamp entry to use when time-stamping an operation
+	xdd_ts_tte_t				*wd_ts_ttep;		// Pointer to the TimeStamp entry for the current operation
+	xdd_ts_tte_t				wd_ts_tte;			// TimeStamp entry for the current operation when streaming
+	int32_t						wd_ts_pending;		// Set to 1 when wd_ts_tte needs to go on the trace ring
+	struct xint_ts_ring			*wd_ts_ringp;		// Trace ring for streamed time stamping
 	struct xint_task			wd_task;			// Task Structure
 	struct xint_target_counters	wd_counters;		// Counters specific to this worker for this target
+	struct xint_latency_histogram	wd_latency_hist;	// Op time histogram for this worker for this pass
+	struct xint_reqsize_stats	*wd_rsm_statsp;		// Statistics of each request size of the -reqsizemix option for this worker for this pass
 
 	// Worker Thread-specific locks and associated pointers
 	pthread_mutex_t				wd_worker_thread_target_sync_mutex;	// Used to serialize access to the Worker_Thread-Target Synchronization flags
@@ -36,10 +43,13 @@ struct xint_worker_data {
 #define	WTSYNC_EOF_RECEIVED		0x00000008		// This Worker_Thread received an EOF packet from the Source Side of an E2E Operation
     pthread_cond_t 				wd_this_worker_thread_is_available_condition;
 	xdd_barrier_t				*wd_current_barrier;	// The barrier where the Worker_Thread is currently at
-	xdd_barrier_t				wd_thread_targetpass_wait_for_task_barrier;	// The barrier where the Worker_Thread waits for targetpass() to release it with a task to perform
+	uint32_t					wd_task_doorbell;	// Incremented by the Target Thread each time it hands a task to this Worker_Thread - also the futex word
+	uint32_t					wd_task_doorbell_seen;	// The last doorbell value this Worker_Thread has acted on
+	uint32_t					wd_task_waiting;	// Set to 1 when this Worker_Thread is sleeping on the doorbell
+	struct xint_worker_data		*wd_pool_nextp;		// Next task on the same Worker Thread pool queue
+	int32_t						wd_pool_home;		// Worker Thread pool queue that the tasks of this Worker_Thread are put on
 	xdd_occupant_t				wd_occupant;		// Used by the barriers to keep track of what is in a barrier at any given time
 	char						wd_occupant_name[XDD_BARRIER_MAX_NAME_LENGTH];	// For a Target thread this is "TARGET####", for a Worker_Thread it is "TARGET####WORKER####"
-	tot_wait_t					wd_tot_wait;		// The TOT Wait structure for this worker
 	xint_e2e_t					*wd_e2ep;			// Pointer to the e2e struct when needed
 	xdd_sgio_t					*wd_sgiop;			// SGIO Structure Pointer
 	pthread_mutex_t 			wd_current_state_mutex; 	// Mutex for locking when checking or updating the state info
@@ -54,6 +64,7 @@ struct xint_worker_data {
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE		0x00000040	// Worker Thread is waiting for the TOT lock in order to release the next I/O
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS				0x00000080	// Worker Thread is waiting for the TOT lock to set the "wait" time stamp
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO				0x00000100	// Waiting on the previous I/O op semaphore
+#define	WORKER_CURRENT_STATE_WAITING_FOR_TASK						0x00000200	// Waiting for the Target Thread to hand over a task
 };
 typedef struct xint_worker_data worker_data_t;
 
@@ -0,0 +1,52 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_WORKER_POOL_H
+#define XINT_WORKER_POOL_H
+
+// ------------------ Shared Worker Thread Pool --------------------------------------
+// With "-workerpool" the Worker Thread Data Structs of normal targets are not
+// given a thread of their own. Instead the Target Thread hands the Worker Data
+// Struct with its task to a fixed set of Pool Threads that are shared by all
+// targets. Each Pool Thread has its own queue of tasks and takes tasks from
+// the queues of the other Pool Threads when its own queue is empty.
+// The queues are FIFO lists linked through wd_pool_nextp so no Worker Data 
+// Struct is ever waiting in more than one queue and the queues never fill up.
+// Idle Pool Threads spin briefly and then sleep in a futex on pool_signal.
+struct xint_worker_pool_queue {
+	pthread_mutex_t				queue_mutex;	// Protects the list
+	struct xint_worker_data		*queue_firstp;	// Next task to run
+	struct xint_worker_data		*queue_lastp;	// Last task queued
+	uint32_t					queue_count;	// Number of tasks on the list - read without the mutex by idle Pool Threads
+	struct xint_worker_pool		*queue_poolp;	// The pool that this queue belongs to
+	char						queue_pad[64];	// Keep the queues of different Pool Threads in different cache lines
+};
+struct xint_worker_pool {
+	int32_t							pool_threads;	// Number of Pool Threads
+	uint32_t						pool_signal;	// Futex word incremented on every put
+	uint32_t						pool_waiting;	// Number of Pool Threads sleeping on pool_signal
+	struct xint_worker_pool_queue	*pool_queues;	// One queue per Pool Thread
+	pthread_t						*pool_threadp;	// Handles of the Pool Threads
+};
+typedef struct xint_worker_pool xint_worker_pool_t;
+
+#endif // XINT_WORKER_POOL_H
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,65 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_WORKER_RING_H
+#define XINT_WORKER_RING_H
+
+// Number of times to poll before going to sleep in the futex when there are
+// processors to spare - see xint_handoff_spin_count()
+#define XINT_HANDOFF_SPIN_COUNT	2000
+// Time to sleep between polls on systems without futexes
+#define XINT_FUTEX_POLL_NSEC	20000
+
+// Tell the processor that we are in a spin-wait loop
+#if defined(__x86_64__) || defined(__i386__)
+#define XINT_CPU_RELAX()	__builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define XINT_CPU_RELAX()	__asm__ __volatile__("yield" ::: "memory")
+#else
+#define XINT_CPU_RELAX()	do { } while (0)
+#endif
+
+// ------------------ Available Worker Thread Ring -----------------------------------
+// The Worker Thread Ring is a bounded lock-free multi-producer/single-consumer
+// queue of pointers to Worker Threads that are available to be assigned a task. 
+// Worker Threads put themselves on the ring when they finish a task and the 
+// Target Thread takes them off the ring when it needs to issue a task. 
+// Each slot carries a sequence number so that producers can claim slots with 
+// a single compare-and-swap on the tail index (see Vyukov's bounded queue).
+// The Target Thread spins briefly and then sleeps in a futex on ring_signal 
+// when the ring is empty.
+struct xint_worker_ring_slot {
+	uint32_t					slot_sequence;	// Sequence number of this slot
+	struct xint_worker_data		*slot_wdp;		// Worker Thread Data Struct in this slot
+};
+struct xint_worker_ring {
+	uint32_t						ring_mask;		// Number of slots minus 1 (the number of slots is a power of 2)
+	uint32_t						ring_head;		// Next slot to take from - only touched by the Target Thread
+	uint32_t						ring_tail;		// Next slot to put into - shared by the Worker Threads
+	uint32_t						ring_signal;	// Futex word incremented on every put
+	uint32_t						ring_waiting;	// Set to 1 when the Target Thread is sleeping on ring_signal
+	struct xint_worker_ring_slot	*ring_slots;	// The slots
+	struct xint_worker_data			**ring_drainp;	// Scratch array used to collect all Worker Threads at the end of a pass
+};
+typedef struct xint_worker_ring xint_worker_ring_t;
+
+#endif // XINT_WORKER_RING_H
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -80,7 +80,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 
 	// The message header for this data packet precedes the data portion
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_processor_start = xdd_get_processor();
 	}
 
@@ -121,7 +121,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	nclk_now(&wdp->wd_counters.tc_current_net_end_time);
 	// Time stamp if requested
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_xfer_size = e2ep->e2e_xfer_size;
 		ttep->tte_net_start = wdp->wd_counters.tc_current_net_start_time;
 		ttep->tte_net_end = wdp->wd_counters.tc_current_net_end_time;
@@ -238,7 +238,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	for (e2ep->e2e_current_csd = 0; e2ep->e2e_current_csd < FD_SETSIZE; e2ep->e2e_current_csd++) { // Process all CSDs that are ready
 		if (FD_ISSET(e2ep->e2e_csd[e2ep->e2e_current_csd], &e2ep->e2e_readset)) { /* Process this csd */
 			if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-				ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+				ttep = wdp->wd_ts_ttep;
 				ttep->tte_net_processor_start = xdd_get_processor();
 			}
 
@@ -372,7 +372,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	for (e2ep->e2e_current_csd = 0; e2ep->e2e_current_csd < FD_SETSIZE; e2ep->e2e_current_csd++) { // Process all CSDs that are ready
 		if (FD_ISSET(e2ep->e2e_csd[e2ep->e2e_current_csd], &e2ep->e2e_readset)) { /* Process this csd */
 			if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-				ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+				ttep = wdp->wd_ts_ttep;
 				ttep->tte_net_processor_start = xdd_get_processor();
 			}
 
@@ -542,7 +542,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 
 	// If time stamping is on then we need to reset these values
 	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_start = wdp->wd_counters.tc_current_net_start_time;
 		ttep->tte_net_end = wdp->wd_counters.tc_current_net_end_time;
 		ttep->tte_net_processor_end = xdd_get_processor();
@@ -605,7 +605,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	memcpy(e2ehp->e2eh_cookie, tdp->td_magic_cookie, sizeof(e2ehp->e2eh_cookie));
 
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_processor_start = xdd_get_processor();
 	}
 	// This will send the E2E Header to the Destination
@@ -639,7 +639,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	e2ep->e2e_sr_time = (wdp->wd_counters.tc_current_net_end_time - wdp->wd_counters.tc_current_net_start_time);
 	// If time stamping is on then we need to reset these values
    	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_start = wdp->wd_counters.tc_current_net_start_time;
 		ttep->tte_net_end = wdp->wd_counters.tc_current_net_end_time;
 		ttep->tte_net_processor_end = xdd_get_processor();
@@ -47,7 +47,9 @@
 #define NET_XFER    offsetof(xdd_ts_tte_t, tte_net_xfer_size)
 
 /* magic number to make sure we can read the file */
-#define BIN_MAGIC_NUMBER 0xDEADBEEF
+#define BIN_MAGIC_NUMBER XDD_TS_MAGIC
+/* magic number of a file written with -ts stream */
+#define STREAM_MAGIC_NUMBER XDD_TS_STREAM_MAGIC
 
 #define MAX_WORKER_THREADS 1024
 int thread_id_src[MAX_WORKER_THREADS];
@@ -794,10 +796,14 @@ int xdd_readfile(char *filename, xdd_ts_header_t **tsdata, size_t *tsdata_size)
 		fprintf(stderr,"Error reading file: %s\n",filename);
 		return 0;
 	}
-	if (magic != BIN_MAGIC_NUMBER) {
+	if (magic != BIN_MAGIC_NUMBER && magic != STREAM_MAGIC_NUMBER) {
 		fprintf(stderr,"File is not in a readable format: %s\n",filename);
 		return 0;
 	}
+	if (magic == STREAM_MAGIC_NUMBER && tsize < offsetof(xdd_ts_header_t, tsh_tte)) {
+		fprintf(stderr,"Streamed timestamp file is truncated: %s\n",filename);
+		return 0;
+	}
 
 	/* read rest of structure */
 	result = fread(tdata,tsize,1,tsfd);
@@ -807,6 +813,14 @@ int xdd_readfile(char *filename, xdd_ts_header_t **tsdata, size_t *tsdata_size)
 		return 0;
 	}
 
+	/* A streamed file holds only the entries that were written, in the order
+	 * they were drained, and the header count is only updated at the end of
+	 * the run - so take the number of entries from the size of the file */
+	if (magic == STREAM_MAGIC_NUMBER) {
+		tdata->tsh_numents = (tsize - offsetof(xdd_ts_header_t, tsh_tte)) / sizeof(xdd_ts_tte_t);
+		tdata->tsh_tt_size = tdata->tsh_numents;
+	}
+
 	/* no empty sets */
 	if (tdata->tsh_tt_size < 1) {
 		fprintf(stderr,"Timestamp dump was empty: %s\n",filename);
@@ -134,7 +134,7 @@ int32_t xint_e2e_xni_send(worker_data_t *wdp) {
 
     /* Some timestamp code */
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_processor_start = xdd_get_processor();
 	}
 
@@ -176,7 +176,7 @@ int32_t xint_e2e_xni_send(worker_data_t *wdp) {
 	
 	// Time stamp if requested
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_xfer_size = e2ep->e2e_xfer_size;
 		ttep->tte_net_start = wdp->wd_counters.tc_current_net_start_time;
 		ttep->tte_net_end = wdp->wd_counters.tc_current_net_end_time;
@@ -270,7 +270,7 @@ int32_t xint_e2e_xni_recv(worker_data_t *wdp) {
 
 	/* Tabulate timestamp data */
 	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep = wdp->wd_ts_ttep;
 		ttep->tte_net_start = wdp->wd_counters.tc_current_net_start_time;
 		ttep->tte_net_end = wdp->wd_counters.tc_current_net_end_time;
 		ttep->tte_net_processor_end = xdd_get_processor();
@@ -49,9 +49,10 @@ int32_t xint_e2e_xni_init(target_data_t *tdp) {
 	/* Create the XNI control block */
 	size_t num_threads = tdp->td_planp->number_of_iothreads;
 	if (xni_protocol_tcp == tdp->xni_pcl)
-		rc = xni_allocate_tcp_control_block(num_threads,
-											tdp->xni_tcp_congestion,
-											&tdp->xni_cb);
+		rc = xni_allocate_tcp_control_block_flags(num_threads,
+												  tdp->xni_tcp_congestion,
+												  tdp->xni_tcp_flags,
+												  &tdp->xni_cb);
 #if HAVE_ENABLE_IB
 	else if (xni_protocol_ib == tdp->xni_pcl)
 		rc = xni_allocate_ib_control_block(tdp->xni_ibdevice,
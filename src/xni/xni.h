@@ -388,6 +388,10 @@ enum {
   XNI_TCP_DEFAULT_NUM_SOCKETS = 0,  /*!< \brief Use the default number of sockets. */
 };
 extern const char *XNI_TCP_DEFAULT_CONGESTION;  /*!< \brief Use the default TCP congestion avoidance algorithm. */
+enum {
+  XNI_TCP_DEFAULT_FLAGS = 0,  /*!< \brief Copy buffers into the kernel on send. */
+  XNI_TCP_ZEROCOPY = 1,  /*!< \brief Send buffers with MSG_ZEROCOPY where the kernel supports it. */
+};
 /*! \brief Create a control block for the TCP implementation.
  *
  * If \e num_sockets is #XNI_TCP_DEFAULT_NUM_SOCKETS then the number
@@ -397,6 +401,9 @@ extern const char *XNI_TCP_DEFAULT_CONGESTION;  /*!< \brief Use the default TCP
  * If \e congestion is #XNI_TCP_DEFAULT_CONGESTION then the system
  * default congestion avoidance algorithm will be used.
  *
+ * This is the same as xni_allocate_tcp_control_block_flags() with
+ * #XNI_TCP_DEFAULT_FLAGS.
+ *
  * \param num_sockets The number of TCP sockets to create per connection.
  * \param congestion the congestion control algorithm to use
  * \param[out] control_block The newly allocated control block.
@@ -404,9 +411,40 @@ extern const char *XNI_TCP_DEFAULT_CONGESTION;  /*!< \brief Use the default TCP
  * \return #XNI_OK if the control block was successfully created.
  * \return #XNI_ERR if the control block could not be created.
  *
+ * \sa xni_allocate_tcp_control_block_flags()
  * \sa xni_free_tcp_control_block()
  */
 int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, xni_control_block_t *control_block);
+/*! \brief Create a control block for the TCP implementation with flags.
+ *
+ * As xni_allocate_tcp_control_block(), and in addition:
+ *
+ * If \e flags contains #XNI_TCP_ZEROCOPY then the sending side of a
+ * connection transmits target buffers with MSG_ZEROCOPY. The pages of
+ * the buffer are handed to the NIC rather than copied into socket
+ * buffers, so the kernel may still be reading them after
+ * xni_send_target_buffer() returns. The sent buffer stays busy until
+ * the kernel reports that it is done with it, and only then can
+ * xni_request_target_buffer() hand it out again. The caller must not
+ * touch a buffer after sending it, and must close the connection
+ * (which waits for every outstanding send) before freeing the memory
+ * of the registered buffers. The completions are collected by later
+ * calls to xni_send_target_buffer() on the same socket, and by
+ * xni_request_target_buffer() when it has no free buffer to return.
+ * Sockets on which the kernel refuses SO_ZEROCOPY silently fall back
+ * to copying.
+ *
+ * \param num_sockets The number of TCP sockets to create per connection.
+ * \param congestion the congestion control algorithm to use
+ * \param flags #XNI_TCP_DEFAULT_FLAGS or #XNI_TCP_ZEROCOPY
+ * \param[out] control_block The newly allocated control block.
+ *
+ * \return #XNI_OK if the control block was successfully created.
+ * \return #XNI_ERR if the control block could not be created.
+ *
+ * \sa xni_free_tcp_control_block()
+ */
+int xni_allocate_tcp_control_block_flags(int num_sockets, const char *congestion, int flags, xni_control_block_t *control_block);
 /*! \brief Free a TCP control block.
  *
  * It is forbidden to call this function more than once with the same
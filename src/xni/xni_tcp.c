@@ -14,6 +14,11 @@
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <sys/select.h>
+#include <sys/uio.h>
+#include <poll.h>
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
 
 #include "config.h"
 #include "xni.h"
@@ -30,6 +35,7 @@ static const size_t TCP_DATA_MESSAGE_HEADER_SIZE = 12;
 struct tcp_control_block {
   size_t num_sockets;
   char congestion[16];
+  int flags;
 };
 
 struct tcp_context {
@@ -47,10 +53,17 @@ struct tcp_context {
 
 };
 
+// Number of MSG_ZEROCOPY sends that may be in flight on one socket
+#define TCP_ZC_WINDOW 1024
+
 struct tcp_socket {
   int sockd;
   int busy;
   int eof;
+  int zerocopy;  // SO_ZEROCOPY is enabled on this socket
+  uint32_t zc_sent;  // number of MSG_ZEROCOPY sends issued
+  uint32_t zc_done;  // every send before this one has been finished with by the kernel
+  uint64_t zc_bits[TCP_ZC_WINDOW/64];  // finished sends after zc_done, indexed by seq % TCP_ZC_WINDOW
 };
 
 struct tcp_connection {
@@ -75,10 +88,18 @@ struct tcp_target_buffer {
   // added by tcp_target_buffer
   int busy;
   void *header;
+  struct tcp_connection *zc_conn;  // connection of a MSG_ZEROCOPY send still in flight
+  struct tcp_socket *zc_socket;  // socket of that send, NULL if the kernel is done
+  uint32_t zc_seq;  // the buffer is free once zc_socket->zc_done reaches this
 };
 
 
 int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, xni_control_block_t *cb_)
+{
+  return xni_allocate_tcp_control_block_flags(num_sockets, congestion, XNI_TCP_DEFAULT_FLAGS, cb_);
+}
+
+int xni_allocate_tcp_control_block_flags(int num_sockets, const char *congestion, int flags, xni_control_block_t *cb_)
 {
   struct tcp_control_block **cb = (struct tcp_control_block**)cb_;
 
@@ -93,6 +114,7 @@ int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, xni_
   struct tcp_control_block *tmp = calloc(1, sizeof(*tmp));
   tmp->num_sockets = num_sockets;
   strncpy(tmp->congestion, congestion, (sizeof(tmp->congestion) - 1));
+  tmp->flags = flags;
   *cb = tmp;
   return XNI_OK;
 }
@@ -164,6 +186,9 @@ static int tcp_register_buffer(xni_context_t ctx_, void* buf, size_t nbytes, siz
 	tb->data_length = -1;
 	tb->busy = 0;
 	tb->header = (void*)(datap - TCP_DATA_MESSAGE_HEADER_SIZE);
+	tb->zc_conn = NULL;
+	tb->zc_socket = NULL;
+	tb->zc_seq = 0;
 	ctx->registered_buffers[ctx->num_registered] = *tb;
 	ctx->num_registered++;
 	pthread_mutex_unlock(&ctx->buffer_mutex);
@@ -195,6 +220,10 @@ static int tcp_accept_connection(xni_context_t ctx_, struct xni_endpoint* local,
 		clients[i].sockd = -1;
 		clients[i].busy = 0;
 		clients[i].eof = 0;
+		clients[i].zerocopy = 0;
+		clients[i].zc_sent = 0;
+		clients[i].zc_done = 0;
+		memset(clients[i].zc_bits, 0, sizeof(clients[i].zc_bits));
 	}
 
 	struct tcp_connection *tmpconn = calloc(1, sizeof(*tmpconn));
@@ -284,6 +313,17 @@ static int tcp_accept_connection(xni_context_t ctx_, struct xni_endpoint* local,
   return XNI_ERR;
 }
 
+// Turn on SO_ZEROCOPY for a socket; returns 1 if it is enabled
+static int tcp_enable_zerocopy(int sockd)
+{
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+  int optval = 1;
+  if (setsockopt(sockd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval)) == 0)
+    return 1;
+#endif  // SO_ZEROCOPY && MSG_ZEROCOPY
+  return 0;
+}
+
 static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_connection_t* conn_)
 {
 	struct tcp_context *ctx = (struct tcp_context*)ctx_;
@@ -297,6 +337,10 @@ static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_conn
 		servers[i].sockd = -1;
 		servers[i].busy = 0;
 		servers[i].eof = 1;
+		servers[i].zerocopy = 0;
+		servers[i].zc_sent = 0;
+		servers[i].zc_done = 0;
+		memset(servers[i].zc_bits, 0, sizeof(servers[i].zc_bits));
 	}
   
 	struct tcp_connection *tmpconn = calloc(1, sizeof(*tmpconn));
@@ -333,6 +377,10 @@ static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_conn
 			perror("connect");
 			goto error_out;
 		}
+
+		// zero-copy is best effort; fall back to copying if the kernel refuses it
+		if (ctx->control_block.flags & XNI_TCP_ZEROCOPY)
+			servers[i].zerocopy = tcp_enable_zerocopy(servers[i].sockd);
 	}
 
 	//TODO: allocate target buffer list and attach
@@ -364,6 +412,10 @@ static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_conn
   return XNI_ERR;
 }
 
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+static int tcp_complete_zerocopy(struct tcp_context *ctx, struct tcp_socket *socket, int wait);
+#endif  // SO_ZEROCOPY && MSG_ZEROCOPY
+
 //XXX: this is not going to be thread safe??
 //alternatives: a flag that signals shutdown state
 //and freeing the buffers as they become available on freelist
@@ -373,6 +425,14 @@ static int tcp_close_connection(xni_connection_t *conn_)
 
   struct tcp_connection *c = *conn;
 
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+  // the buffers of zero-copy sends still in flight refer to these sockets
+  for (int i = 0; i < c->num_sockets; i++)
+    while (c->sockets[i].zc_done != c->sockets[i].zc_sent)
+      if (tcp_complete_zerocopy(c->context, c->sockets+i, 1))
+        break;
+#endif  // SO_ZEROCOPY && MSG_ZEROCOPY
+
   for (int i = 0; i < c->num_sockets; i++)
     if (c->sockets[i].sockd != -1)
       close(c->sockets[i].sockd);
@@ -404,8 +464,39 @@ static int tcp_request_target_buffer(xni_context_t ctx_, xni_target_buffer_t *ta
 			  break;
 		  }
 	  }
-	  if (tb == NULL)
+	  if (tb == NULL) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+		  // collect completions for a buffer the kernel may still be sending
+		  struct tcp_target_buffer *pending = NULL;
+		  for (size_t i = 0; i < ctx->num_registered && pending == NULL; i++)
+			  if (ctx->registered_buffers[i].zc_socket != NULL)
+				  pending = ctx->registered_buffers + i;
+		  if (pending != NULL) {
+			  struct tcp_connection *conn = pending->zc_conn;
+			  struct tcp_socket *socket = pending->zc_socket;
+			  pthread_mutex_unlock(&ctx->buffer_mutex);
+
+			  pthread_mutex_lock(&conn->socket_mutex);
+			  while (socket->busy)
+				  pthread_cond_wait(&conn->socket_cond, &conn->socket_mutex);
+			  socket->busy = 1;
+			  pthread_mutex_unlock(&conn->socket_mutex);
+
+			  int rc = tcp_complete_zerocopy(ctx, socket, 1);
+
+			  pthread_mutex_lock(&conn->socket_mutex);
+			  socket->busy = 0;
+			  pthread_cond_broadcast(&conn->socket_cond);
+			  pthread_mutex_unlock(&conn->socket_mutex);
+
+			  if (rc)
+				  return XNI_ERR;
+			  pthread_mutex_lock(&ctx->buffer_mutex);
+			  continue;
+		  }
+#endif  // SO_ZEROCOPY && MSG_ZEROCOPY
 		  pthread_cond_wait(&ctx->buffer_cond, &ctx->buffer_mutex);
+	  }
   }
   pthread_mutex_unlock(&ctx->buffer_mutex);
     
@@ -413,6 +504,141 @@ static int tcp_request_target_buffer(xni_context_t ctx_, xni_target_buffer_t *ta
   return XNI_OK;
 }
 
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+// Mark the sends [lo, hi] of a socket as finished and move zc_done over
+// every finished send that now follows it. The kernel does not promise
+// that the ranges arrive in order or that each one starts where the last
+// ended, so zc_done only moves over sends that are known to be finished.
+static void tcp_mark_zerocopy(struct tcp_socket *socket, uint32_t lo, uint32_t hi)
+{
+  for (uint32_t seq = lo; ; seq++) {
+    // ignore sends already counted and any that were never issued
+    if ((int32_t)(seq - socket->zc_done) >= 0 && (int32_t)(seq - socket->zc_sent) < 0)
+      socket->zc_bits[(seq % TCP_ZC_WINDOW) / 64] |= (1ULL << (seq % 64));
+    if (seq == hi)
+      break;
+  }
+
+  while (socket->zc_done != socket->zc_sent) {
+    uint64_t *word = &socket->zc_bits[(socket->zc_done % TCP_ZC_WINDOW) / 64];
+    uint64_t bit = (1ULL << (socket->zc_done % 64));
+    if (!(*word & bit))
+      break;
+    *word &= ~bit;
+    socket->zc_done++;
+  }
+}
+
+// Read zero-copy completion notifications from the socket error queue.
+// Each notification covers a range of sends [ee_info, ee_data]. If
+// 'wait' is set then block until at least one notification arrives.
+static int tcp_reap_zerocopy(struct tcp_socket *socket, int wait)
+{
+  for (;;) {
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + CMSG_SPACE(64)];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    if (recvmsg(socket->sockd, &msg, MSG_ERRQUEUE|MSG_DONTWAIT) == -1) {
+      if (errno == EINTR)
+        continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        perror("recvmsg");
+        return -1;
+      }
+      if (!wait)
+        return 0;
+      // the error queue always reports POLLERR, so no events are requested
+      struct pollfd pfd = { .fd = socket->sockd, .events = 0, .revents = 0 };
+      if (poll(&pfd, 1, -1) == -1 && errno != EINTR) {
+        perror("poll");
+        return -1;
+      }
+      continue;
+    }
+
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+      if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+            (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+        continue;
+      struct sock_extended_err *serr = (struct sock_extended_err*)CMSG_DATA(cm);
+      if (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY || serr->ee_errno != 0)
+        continue;
+      tcp_mark_zerocopy(socket, serr->ee_info, serr->ee_data);
+    }
+    wait = 0;
+  }
+}
+
+// Free the buffers whose zero-copy sends on a socket owned by the caller
+// have all completed. If 'wait' is set then first block until at least
+// one more send completes, unless none are outstanding.
+static int tcp_complete_zerocopy(struct tcp_context *ctx, struct tcp_socket *socket, int wait)
+{
+  if (socket->zc_done == socket->zc_sent)
+    wait = 0;
+  if (tcp_reap_zerocopy(socket, wait))
+    return -1;
+
+  int freed = 0;
+  pthread_mutex_lock(&ctx->buffer_mutex);
+  for (size_t i = 0; i < ctx->num_registered; i++) {
+    struct tcp_target_buffer *tb = ctx->registered_buffers + i;
+    if (tb->zc_socket == socket && (int32_t)(socket->zc_done - tb->zc_seq) >= 0) {
+      tb->zc_conn = NULL;
+      tb->zc_socket = NULL;
+      tb->busy = 0;
+      freed = 1;
+    }
+  }
+  if (freed)
+    pthread_cond_broadcast(&ctx->buffer_cond);
+  pthread_mutex_unlock(&ctx->buffer_mutex);
+  return 0;
+}
+
+// Send a buffer with MSG_ZEROCOPY. The kernel may still be reading its
+// pages on return, so the caller must keep the buffer busy until
+// socket->zc_done reaches the socket->zc_sent this leaves behind
+static int tcp_send_zerocopy(struct tcp_socket *socket, char *buf, size_t total)
+{
+  for (size_t sent = 0; sent < total;) {
+    // keep the sends in flight within the window of zc_bits
+    if (socket->zc_sent - socket->zc_done >= TCP_ZC_WINDOW) {
+      if (tcp_reap_zerocopy(socket, 1))
+        return -1;
+      continue;
+    }
+
+    struct iovec iov = { .iov_base = buf+sent, .iov_len = (total - sent) };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    ssize_t cnt = sendmsg(socket->sockd, &msg, MSG_ZEROCOPY);
+    if (cnt > 0) {
+      sent += cnt;
+      socket->zc_sent++;
+    } else if (cnt == -1 && errno == ENOBUFS) {
+      // out of pinned-page budget (optmem); wait for earlier sends to finish
+      if (socket->zc_done == socket->zc_sent) {
+        perror("sendmsg");
+        return -1;
+      }
+      if (tcp_reap_zerocopy(socket, 1))
+        return -1;
+    } else if (cnt == -1 && errno != EINTR) {
+      perror("sendmsg");
+      return -1;
+    }
+  }
+  return 0;
+}
+#endif  // SO_ZEROCOPY && MSG_ZEROCOPY
+
 //TODO: what happens on error? stream state is trashed
 static int tcp_send_target_buffer(xni_connection_t conn_, xni_target_buffer_t *targetbuf_)
 {
@@ -446,6 +672,30 @@ static int tcp_send_target_buffer(xni_connection_t conn_, xni_target_buffer_t *t
 
   // send the message (header + data payload)
   const size_t total = (size_t)((char*)tb->data - (char*)tb->header) + tb->data_length;
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+  if (socket->zerocopy) {
+    if (tcp_send_zerocopy(socket, (char*)tb->header, total))
+      return XNI_ERR;
+
+    // the buffer stays busy until its completion is collected, either
+    // here on a later send or by tcp_request_target_buffer()
+    pthread_mutex_lock(&tb->context->buffer_mutex);
+    tb->zc_conn = conn;
+    tb->zc_socket = socket;
+    tb->zc_seq = socket->zc_sent;
+    pthread_mutex_unlock(&tb->context->buffer_mutex);
+    if (tcp_complete_zerocopy(tb->context, socket, 0))
+      return XNI_ERR;
+
+    pthread_mutex_lock(&conn->socket_mutex);
+    socket->busy = 0;
+    pthread_cond_broadcast(&conn->socket_cond);
+    pthread_mutex_unlock(&conn->socket_mutex);
+
+    *targetbuf = NULL;
+    return XNI_OK;
+  } else
+#endif  // SO_ZEROCOPY && MSG_ZEROCOPY
   for (size_t sent = 0; sent < total;) {
     ssize_t cnt = send(socket->sockd, (char*)tb->header+sent, (total - sent), 0);
     //TODO: fix adding after EINTR logic
@@ -460,7 +710,7 @@ static int tcp_send_target_buffer(xni_connection_t conn_, xni_target_buffer_t *t
   // mark the socket as free
   pthread_mutex_lock(&conn->socket_mutex);
   socket->busy = 0;
-  pthread_cond_signal(&conn->socket_cond);
+  pthread_cond_broadcast(&conn->socket_cond);
   pthread_mutex_unlock(&conn->socket_mutex);
 
   // mark the buffer as free
@@ -537,14 +787,18 @@ static int tcp_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t
     pthread_mutex_unlock(&conn->socket_mutex);
   }
 
+  // MSG_WAITALL lets the kernel fill the whole request in one call
+  // instead of returning each time a segment arrives
   char *recvbuf = (char*)tb->header;
   size_t total = (size_t)((char*)tb->data - (char*)tb->header);
   for (size_t received = 0; received < total;) {
-    ssize_t cnt = recv(socket->sockd, recvbuf+received, (total - received), 0);
+    ssize_t cnt = recv(socket->sockd, recvbuf+received, (total - received), MSG_WAITALL);
     if (cnt == 0) {  //TODO: handle true EOF; true EOF only on first read
       return_code = XNI_EOF;
       goto socket_out;
-    } else if (cnt == -1) {  //TODO: handle EINTR
+    } else if (cnt == -1 && errno == EINTR) {
+      continue;
+    } else if (cnt == -1) {
       perror("recv");
       goto socket_out;
     } else
@@ -556,13 +810,18 @@ static int tcp_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t
   uint32_t data_length;
   memcpy(&data_length, recvbuf+8, 4);
 
+  // The payload length is only known once the header has been read, so
+  // it cannot be scattered into the same call without risking reading
+  // into the next message on this socket
   recvbuf = (char*)tb->data;
   total = data_length;
   for (size_t received = 0; received < total;) {
-    ssize_t cnt = recv(socket->sockd, recvbuf+received, (total - received), 0);
+    ssize_t cnt = recv(socket->sockd, recvbuf+received, (total - received), MSG_WAITALL);
     if (cnt == 0)  // failure EOF
       goto socket_out;
-    else if (cnt == -1) {  //TODO: EINTR
+    else if (cnt == -1 && errno == EINTR)
+      continue;
+    else if (cnt == -1) {
       perror("recv");
       goto socket_out;
     } else
@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Test the local copy engine of XDD
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Make a source file that does not end on a request boundary
+# 
+fsize=$((1024*1024*16 + 12345))
+generate_local_filename sfile
+$XDDTEST_XDD_EXE -op write -target $sfile -reqsize 1 -blocksize $((1024*1024)) -bytes $fsize -datapattern random >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "Unable to generate test file data of size: $fsize"
+    finalize_test 2
+fi
+
+#
+# Copy it with and without block sharing and compare the copies to the source
+#
+for clone in "" noclone; do
+    generate_local_filename dfile
+    $XDDTEST_XDD_EXE -op write -target $dfile -copyfrom $sfile $clone -queuedepth 4 -reqsize 1 -blocksize $((1024*1024)) -bytes $fsize >/dev/null 2>&1
+    if [ 0 -ne $? ]; then
+        echo "XDD copy $clone failed"
+        finalize_test 1
+    fi
+    cmp -s $sfile $dfile
+    if [ 0 -ne $? ]; then
+        echo "XDD copy $clone differs from the source"
+        finalize_test 1
+    fi
+done
+finalize_test 0
@@ -0,0 +1,28 @@
+#!/bin/bash
+#
+# Test that the generated data patterns of XDD do not depend on the queue depth
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+fsize=$((1024*1024*4))
+
+#
+# Write with many Worker Threads and verify the contents with one, so every
+# op is checked by a different thread than the one that wrote it
+# 
+for pattern in random "reducible 2.0 2.0"; do
+    generate_local_filename qfile
+    $XDDTEST_XDD_EXE -op write -target $qfile -queuedepth 8 -reqsize 16 -blocksize 4096 -bytes $fsize -datapattern $pattern >/dev/null 2>&1
+    if [ 0 -ne $? ]; then
+        echo "XDD write of the $pattern data pattern failed"
+        finalize_test 1
+    fi
+    errors=$($XDDTEST_XDD_EXE -op read -target $qfile -queuedepth 1 -reqsize 16 -blocksize 4096 -bytes $fsize -datapattern $pattern -verify contents 2>&1 |grep -c "ERROR")
+    if [ "$errors" != "0" ]; then
+        echo "Reading back the $pattern data pattern at another queue depth reported $errors errors"
+        finalize_test 1
+    fi
+done
+finalize_test 0
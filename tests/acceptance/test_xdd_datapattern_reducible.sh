@@ -0,0 +1,45 @@
+#!/bin/bash
+#
+# Test the reducible data pattern of XDD
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+fsize=$((1024*1024*4))
+
+#
+# Write a file with a compression ratio of 2 and read it back with content verification
+# 
+generate_local_filename rfile
+$XDDTEST_XDD_EXE -op write -target $rfile -queuedepth 4 -reqsize 16 -blocksize 4096 -bytes $fsize -datapattern reducible 2.0 1.0 -seek seed 7 >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write of the reducible data pattern failed"
+    finalize_test 1
+fi
+errors=$($XDDTEST_XDD_EXE -op read -target $rfile -queuedepth 4 -reqsize 16 -blocksize 4096 -bytes $fsize -datapattern reducible 2.0 1.0 -seek seed 7 -verify contents 2>&1 |grep -c "ERROR")
+if [ "$errors" != "0" ]; then
+    echo "Reading back the reducible data pattern reported $errors errors"
+    finalize_test 1
+fi
+
+#
+# The contents depend on the seed, so a different seed must not verify
+#
+errors=$($XDDTEST_XDD_EXE -op read -target $rfile -queuedepth 4 -reqsize 16 -blocksize 4096 -bytes $fsize -datapattern reducible 2.0 1.0 -seek seed 8 -verify contents 2>&1 |grep -c "ERROR")
+if [ "$errors" = "0" ]; then
+    echo "Reading back the reducible data pattern with another seed reported no errors"
+    finalize_test 1
+fi
+
+#
+# The file should compress to about half its size
+#
+csize=$(gzip -c $rfile |wc -c)
+result=1
+if [ $csize -gt $((fsize*4/10)) -a $csize -lt $((fsize*6/10)) ]; then
+    result=0
+else
+    echo "Reducible data pattern of $fsize bytes compressed to $csize bytes"
+fi
+finalize_test $result
@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Test the mmap I/O engine of XDD
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+fsize=$((1024*1024*16))
+
+#
+# Write a file through the mmap engine at a queue depth greater than 1
+# 
+generate_local_filename mfile
+$XDDTEST_XDD_EXE -op write -target $mfile -ioengine mmap -queuedepth 4 -reqsize 16 -blocksize 4096 -bytes $fsize -datapattern sequenced >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write with the mmap engine failed"
+    finalize_test 1
+fi
+asize=$($XDDTEST_XDD_GETFILESIZE_EXE $mfile)
+if [ "$asize" != "$fsize" ]; then
+    echo "XDD write with the mmap engine wrote $asize bytes"
+    finalize_test 1
+fi
+
+#
+# Read it back through the mmap engine and make sure every block is where it belongs
+#
+errors=$($XDDTEST_XDD_EXE -op read -target $mfile -ioengine mmap -queuedepth 4 -reqsize 16 -blocksize 4096 -bytes $fsize -verify location 2>&1 |grep -c "ERROR")
+result=1
+if [ "$errors" = "0" ]; then
+    result=0
+else
+    echo "Reading back with the mmap engine reported $errors errors"
+fi
+finalize_test $result
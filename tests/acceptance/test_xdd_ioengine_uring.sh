@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Test the io_uring I/O engine of XDD
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Write a file with the io_uring engine at a queue depth greater than 1
+# 
+generate_local_filename ufile
+$XDDTEST_XDD_EXE -op write -target $ufile -ioengine uring -queuedepth 8 -reqsize 1 -blocksize $((64*1024)) -bytes $((1024*1024*16)) -datapattern sequenced >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write with the io_uring engine failed"
+    finalize_test 1
+fi
+
+#
+# Make sure every byte was written
+#
+asize=$($XDDTEST_XDD_GETFILESIZE_EXE $ufile)
+if [ "$asize" != "$((1024*1024*16))" ]; then
+    echo "XDD write with the io_uring engine wrote $asize bytes"
+    finalize_test 1
+fi
+
+#
+# Read it back with the io_uring engine and make sure every block is where it belongs
+#
+errors=$($XDDTEST_XDD_EXE -op read -target $ufile -ioengine uring -queuedepth 8 -reqsize 1 -blocksize $((64*1024)) -bytes $((1024*1024*16)) -verify location 2>&1 |grep -c "ERROR")
+result=1
+if [ "$errors" = "0" ]; then
+    result=0
+fi
+finalize_test $result
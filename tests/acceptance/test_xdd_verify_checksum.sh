@@ -0,0 +1,40 @@
+#!/bin/bash
+#
+# Test the checksum verification of XDD
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+bsize=4096
+fsize=$((1024*1024))
+
+#
+# Write a file with checksummed blocks and read it back without errors
+# 
+generate_local_filename cfile
+$XDDTEST_XDD_EXE -op write -target $cfile -reqsize 16 -blocksize $bsize -bytes $fsize -datapattern random -verify checksum >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write with checksums failed"
+    finalize_test 1
+fi
+errors=$($XDDTEST_XDD_EXE -op read -target $cfile -reqsize 16 -blocksize $bsize -bytes $fsize -verify checksum 2>&1 |grep -c "ERROR")
+if [ "$errors" != "0" ]; then
+    echo "Reading back the checksummed file reported $errors errors"
+    finalize_test 1
+fi
+
+#
+# Flip one byte of block 37 and make sure that exactly that block is reported
+#
+offset=$((bsize*37 + 100))
+byte=$(od -An -tu1 -j $offset -N 1 $cfile)
+printf "\\$(printf '%03o' $((byte ^ 0xff)))" |dd of=$cfile bs=1 seek=$offset conv=notrunc >/dev/null 2>&1
+mismatches=$($XDDTEST_XDD_EXE -op read -target $cfile -reqsize 16 -blocksize $bsize -bytes $fsize -verify checksum 2>&1 |grep "Checksum mismatch")
+result=1
+if [ $(echo "$mismatches" |grep -c "mismatch") -eq 1 -a -n "$(echo "$mismatches" |grep "block 37 at byte offset $((bsize*37)),")" ]; then
+    result=0
+else
+    echo "Expected one checksum mismatch at byte offset $((bsize*37)), got: $mismatches"
+fi
+finalize_test $result